@@ -0,0 +1,246 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "ConnectionPoolTest.h"
+
+#include <KDbConnection>
+#include <KDbConnectionPool>
+#include <KDbTableSchema>
+
+#include <QAtomicInt>
+#include <QTest>
+#include <QThread>
+
+QTEST_GUILESS_MAIN(ConnectionPoolTest)
+
+namespace {
+//! Acquires connections from the pool and counts persons using them
+class WorkerThread : public QThread
+{
+public:
+    WorkerThread(KDbConnectionPool *pool, int expectedCount)
+        : m_pool(pool), m_expectedCount(expectedCount) {}
+    void run() override {
+        for (int i = 0; i < 20; ++i) {
+            KDbConnectionPoolGuard guard(m_pool);
+            if (!guard.connection()) {
+                return;
+            }
+            int count;
+            if (true != guard.connection()->querySingleNumber(
+                    KDbEscapedString("SELECT COUNT(*) FROM persons"), &count)
+                || count != m_expectedCount)
+            {
+                return;
+            }
+        }
+        succeeded.store(1);
+    }
+    QAtomicInt succeeded;
+private:
+    KDbConnectionPool * const m_pool;
+    const int m_expectedCount;
+};
+}
+
+void ConnectionPoolTest::initTestCase()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionPoolTest"));
+}
+
+void ConnectionPoolTest::testAcquireRelease()
+{
+    KDbConnectionPool pool(utils.driver, utils.connection()->data());
+    QCOMPARE(pool.databaseName(), utils.connection()->data().databaseName());
+    QCOMPARE(pool.healthCheck(), KDbConnectionPool::HealthCheck::Ping);
+    pool.setMaximumSize(0); // ignored
+    QVERIFY(pool.maximumSize() >= 1);
+    pool.setMaximumSize(2);
+    QCOMPARE(pool.maximumSize(), 2);
+
+    KDbResult result;
+    KDbConnection *conn1 = pool.acquire(-1, &result);
+    QVERIFY2(conn1, qPrintable(result.messageTitle() + result.message()));
+    QVERIFY(conn1 != utils.connection());
+    QVERIFY(conn1->isConnected());
+    QCOMPARE(conn1->currentDatabase(), pool.databaseName());
+    KDbConnection *conn2 = pool.acquire();
+    QVERIFY(conn2);
+    QVERIFY(conn1 != conn2);
+    QVERIFY(!pool.acquire(10, &result)); // maximum reached
+    QVERIFY(result.isError());
+
+    KDbConnectionPool::Metrics metrics = pool.metrics();
+    QCOMPARE(metrics.createdCount, quint64(2));
+    QCOMPARE(metrics.acquiredCount, quint64(2));
+    QCOMPARE(metrics.waitCount, quint64(1));
+    QCOMPARE(metrics.timeoutCount, quint64(1));
+    QCOMPARE(metrics.inUseCount, 2);
+    QCOMPARE(metrics.idleCount, 0);
+
+    pool.release(conn2);
+    QCOMPARE(pool.metrics().idleCount, 1);
+    result = KDbResult();
+    QCOMPARE(pool.acquire(10, &result), conn2); // reused
+    QVERIFY(!result.isError());
+    pool.release(conn1);
+    pool.release(conn2);
+    pool.release(conn2); // not acquired, ignored
+    metrics = pool.metrics();
+    QCOMPARE(metrics.createdCount, quint64(2));
+    QCOMPARE(metrics.destroyedCount, quint64(0));
+    QCOMPARE(metrics.acquiredCount, quint64(3));
+    QCOMPARE(metrics.inUseCount, 0);
+    QCOMPARE(metrics.idleCount, 2);
+    {
+        KDbConnectionPoolGuard guard(&pool);
+        QCOMPARE(guard.connection(), conn2); // most recently released
+        QCOMPARE(pool.metrics().inUseCount, 1);
+    }
+    QCOMPARE(pool.metrics().inUseCount, 0);
+    pool.clear();
+    QCOMPARE(pool.metrics().idleCount, 0);
+    QCOMPARE(pool.metrics().destroyedCount, quint64(2));
+}
+
+void ConnectionPoolTest::testSchemaCache()
+{
+    KDbConnectionPool pool(utils.driver, utils.connection()->data());
+    pool.setMaximumSize(1);
+    KDbConnection *conn = pool.acquire();
+    QVERIFY(conn);
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    KDbTransaction transaction = conn->beginTransaction();
+    QVERIFY(transaction.isActive());
+    pool.release(conn); // rolls back the transaction
+    QVERIFY(!transaction.isActive());
+
+    QCOMPARE(pool.acquire(), conn);
+    QCOMPARE(conn->tableSchema("persons"), persons);
+    pool.release(conn);
+}
+
+void ConnectionPoolTest::testHealthCheck()
+{
+    KDbConnectionPool pool(utils.driver, utils.connection()->data());
+    pool.setHealthCheck(KDbConnectionPool::HealthCheck::ServerVersion);
+    QCOMPARE(pool.healthCheck(), KDbConnectionPool::HealthCheck::ServerVersion);
+    KDbConnection *conn = pool.acquire();
+    QVERIFY(conn);
+    pool.release(conn);
+    QCOMPARE(pool.acquire(), conn);
+
+    // connection disconnected by the user is not returned to the pool
+    QVERIFY(conn->disconnect());
+    pool.release(conn);
+    KDbConnectionPool::Metrics metrics = pool.metrics();
+    QCOMPARE(metrics.idleCount, 0);
+    QCOMPARE(metrics.destroyedCount, quint64(1));
+
+    // connection that stopped working while idle is dropped by acquire()
+    pool.setHealthCheck(KDbConnectionPool::HealthCheck::Ping);
+    conn = pool.acquire();
+    QVERIFY(conn);
+    pool.release(conn);
+    QCOMPARE(pool.metrics().idleCount, 1);
+    QVERIFY(conn->closeDatabase()); // simulate failure of the idle connection
+    KDbConnection *newConn = pool.acquire();
+    QVERIFY(newConn);
+    QVERIFY(newConn->isDatabaseUsed());
+    metrics = pool.metrics();
+    QCOMPARE(metrics.failedHealthCheckCount, quint64(1));
+    QCOMPARE(metrics.destroyedCount, quint64(2));
+    QCOMPARE(metrics.inUseCount, 1);
+    pool.release(newConn);
+
+    KDbConnectionPool invalidPool(utils.driver, utils.connection()->data(),
+                                  QLatin1String("/nonexisting/ConnectionPoolTest.kexi"));
+    KDbResult result;
+    QVERIFY(!invalidPool.acquire(-1, &result));
+    QVERIFY(result.isError());
+    QCOMPARE(invalidPool.metrics().createdCount, quint64(0));
+}
+
+void ConnectionPoolTest::testMinimumSizeAndEviction()
+{
+    KDbConnectionPool pool(utils.driver, utils.connection()->data());
+    QCOMPARE(pool.minimumSize(), 0);
+    QCOMPARE(pool.idleTimeout(), 60000);
+    pool.setMaximumSize(4);
+    pool.setMinimumSize(2);
+    QVERIFY(pool.fill());
+    KDbConnectionPool::Metrics metrics = pool.metrics();
+    QCOMPARE(metrics.createdCount, quint64(2));
+    QCOMPARE(metrics.idleCount, 2);
+
+    KDbConnection *conn1 = pool.acquire();
+    KDbConnection *conn2 = pool.acquire();
+    KDbConnection *conn3 = pool.acquire();
+    QVERIFY(conn1 && conn2 && conn3);
+    QCOMPARE(pool.metrics().createdCount, quint64(3));
+    pool.release(conn1);
+    pool.release(conn2);
+    pool.release(conn3);
+    QCOMPARE(pool.evictIdleConnections(), 0); // not expired yet
+
+    pool.setIdleTimeout(0);
+    QTest::qWait(5);
+    QCOMPARE(pool.evictIdleConnections(), 1); // minimum size is kept
+    metrics = pool.metrics();
+    QCOMPARE(metrics.idleCount, 2);
+    QCOMPARE(metrics.evictedCount, quint64(1));
+    QCOMPARE(metrics.destroyedCount, quint64(1));
+
+    pool.setMinimumSize(0);
+    QCOMPARE(pool.evictIdleConnections(), 2);
+    QCOMPARE(pool.metrics().idleCount, 0);
+    pool.setIdleTimeout(-1);
+    QCOMPARE(pool.idleTimeout(), -1);
+}
+
+void ConnectionPoolTest::testThreads()
+{
+    int personsCount;
+    QCOMPARE(utils.connection()->querySingleNumber(
+                 KDbEscapedString("SELECT COUNT(*) FROM persons"), &personsCount), tristate(true));
+    KDbConnectionPool pool(utils.driver, utils.connection()->data());
+    pool.setMaximumSize(2);
+    QList<WorkerThread*> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.append(new WorkerThread(&pool, personsCount));
+        threads.last()->start();
+    }
+    for (WorkerThread *thread : threads) {
+        QVERIFY(thread->wait(60000));
+        QCOMPARE(thread->succeeded.load(), 1);
+    }
+    qDeleteAll(threads);
+    const KDbConnectionPool::Metrics metrics = pool.metrics();
+    QVERIFY(metrics.createdCount <= 2);
+    QCOMPARE(metrics.acquiredCount, quint64(4 * 20));
+    QCOMPARE(metrics.inUseCount, 0);
+}
+
+void ConnectionPoolTest::cleanupTestCase()
+{
+    if (utils.connection()) {
+        QVERIFY(utils.testDisconnectAndDropDb());
+    }
+}
@@ -0,0 +1,52 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDBCONNECTIONPOOLTEST_H
+#define KDBCONNECTIONPOOLTEST_H
+
+#include "KDbTestUtils.h"
+
+class ConnectionPoolTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+
+    //! Test reusing of connections, limits and timeouts of KDbConnectionPool::acquire()
+    void testAcquireRelease();
+
+    //! Test that schemas cached by a pooled connection survive release and acquire
+    void testSchemaCache();
+
+    //! Test health checks and dropping of connections that are no longer usable
+    void testHealthCheck();
+
+    //! Test KDbConnectionPool::fill() and eviction of idle connections
+    void testMinimumSizeAndEviction();
+
+    //! Test acquiring connections and querying in multiple threads
+    void testThreads();
+
+    void cleanupTestCase();
+
+private:
+    KDbTestUtils utils;
+};
+
+#endif
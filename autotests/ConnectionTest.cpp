@@ -19,12 +19,21 @@
 
 #include "ConnectionTest.h"
 
+#include <KDbAdmin>
 #include <KDbConnectionData>
 #include <KDbDriverManager>
 #include <KDbDriverMetaData>
+#include <KDbLookupFieldSchema>
+#include <KDbQueryColumnInfo>
+#include <KDbQuerySchema>
+#include <KDbRecordData>
+#include <KDbRecordEditBuffer>
+#include <KDbSqlRecord>
+#include <KDbSqlResult>
 
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QTest>
 
 QTEST_GUILESS_MAIN(ConnectionTest)
@@ -128,6 +137,662 @@ void ConnectionTest::testConnectToNonexistingDb()
     QVERIFY2(!utils.connection()->isConnected(), "Should not be connected");
 }
 
+void ConnectionTest::testSqliteStatementCache()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    const KDbUtils::Property sizeProperty = conn->options()->property("sqliteStatementCacheSize");
+    QVERIFY2(!sizeProperty.isNull(), "sqliteStatementCacheSize property not found");
+    QVERIFY(sizeProperty.value().toInt() > 0);
+
+    const KDbEscapedString sql("SELECT COUNT(*) FROM persons");
+    int count = 0;
+    QVERIFY(conn->querySingleNumber(sql, &count) == true);
+    QCOMPARE(count, 4);
+    const qulonglong hits = conn->options()->property("sqliteStatementCacheHits").value().toULongLong();
+    const qulonglong misses = conn->options()->property("sqliteStatementCacheMisses").value().toULongLong();
+    QVERIFY(misses > 0);
+    QVERIFY(conn->options()->isReadOnlyOption("sqliteStatementCacheHits"));
+    conn->options()->setValue("sqliteStatementCacheHits", qulonglong(0));
+    QCOMPARE(conn->options()->property("sqliteStatementCacheHits").value().toULongLong(), hits);
+
+    count = 0;
+    QVERIFY(conn->querySingleNumber(sql, &count) == true); // compiled statement is reused
+    QCOMPARE(count, 4);
+    QVERIFY(conn->options()->property("sqliteStatementCacheHits").value().toULongLong() > hits);
+    QCOMPARE(conn->options()->property("sqliteStatementCacheMisses").value().toULongLong(), misses);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testSqlitePerformanceProfiles()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbConnectionOptions *options = conn->options();
+    QCOMPARE(options->property("sqlitePerformanceProfile").value().toString(),
+             QLatin1String("durable"));
+    QCOMPARE(options->property("sqliteJournalMode").value().toString(), QLatin1String("delete"));
+    QCOMPARE(options->property("sqliteSecureDelete").value().toString(), QLatin1String("1"));
+
+    QVERIFY(conn->closeDatabase());
+    options->setValue("sqlitePerformanceProfile", QLatin1String("balanced"));
+    KDB_VERIFY(conn, conn->useDatabase(), "Failed to use database with the balanced profile");
+    QCOMPARE(options->property("sqliteJournalMode").value().toString(), QLatin1String("wal"));
+    QCOMPARE(options->property("sqliteSynchronous").value().toString(), QLatin1String("1"));
+    QCOMPARE(options->property("sqliteCacheSize").value().toString(), QLatin1String("-16384"));
+    QCOMPARE(options->property("sqliteTempStore").value().toString(), QLatin1String("2"));
+    QCOMPARE(options->property("sqliteSecureDelete").value().toString(), QLatin1String("0"));
+    int count = 0;
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT COUNT(*) FROM persons"), &count)
+            == true);
+    QCOMPARE(count, 4);
+
+    // WAL mode is stored in the file, the durable profile does not change the journal mode
+    QVERIFY(conn->closeDatabase());
+    options->setValue("sqlitePerformanceProfile", QLatin1String("durable"));
+    KDB_VERIFY(conn, conn->useDatabase(), "Failed to use database with the durable profile");
+    QCOMPARE(options->property("sqliteJournalMode").value().toString(), QLatin1String("wal"));
+    QCOMPARE(options->property("sqliteSecureDelete").value().toString(), QLatin1String("1"));
+
+    // values in effect cannot be changed by the user
+    QVERIFY(options->isReadOnlyOption("sqliteJournalMode"));
+    QVERIFY(!options->isReadOnlyOption("sqlitePerformanceProfile"));
+    options->setValue("sqliteJournalMode", QLatin1String("delete"));
+    options->insert("sqliteJournalMode", QLatin1String("delete"));
+    options->remove("sqliteJournalMode");
+    QCOMPARE(options->property("sqliteJournalMode").value().toString(), QLatin1String("wal"));
+
+    QVERIFY(conn->closeDatabase());
+    options->setValue("sqlitePerformanceProfile", QLatin1String("bulk-load"));
+    KDB_VERIFY(conn, conn->useDatabase(), "Failed to use database with the bulk-load profile");
+    QCOMPARE(options->property("sqliteSynchronous").value().toString(), QLatin1String("0"));
+    QVERIFY(conn->executeSql(KDbEscapedString("DELETE FROM persons WHERE id=1")));
+
+    QVERIFY(conn->closeDatabase());
+    options->setValue("sqlitePerformanceProfile", QLatin1String("nonexisting"));
+    KDB_EXPECT_FAIL(conn, conn->useDatabase(), ERR_OBJECT_NOT_FOUND,
+                    "Unknown performance profile should not be accepted");
+    QVERIFY(!conn->isDatabaseUsed());
+    options->setValue("sqlitePerformanceProfile", QLatin1String("durable"));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testSqliteVacuum()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    // create free pages
+    QList<QList<QVariant>> records;
+    for (int id = 100; id < 5100; ++id) {
+        records << (QList<QVariant>() << id << 20 << QString(100, QLatin1Char('x'))
+                                      << QLatin1String("Surname"));
+    }
+    QVERIFY(conn->insertRecords(persons, records));
+    QVERIFY(conn->executeSql(KDbEscapedString("DELETE FROM persons WHERE id>=100")));
+    const KDbConnectionData data(conn->data());
+    const QString fileName(data.databaseName());
+    const qint64 size = QFileInfo(fileName).size();
+
+    // the database stays open, compacting is performed online
+    KDbAdminTools &admin = utils.driver->adminTools();
+    admin.setProgressFunction([](int) { return false; });
+    KDB_VERIFY(&admin, admin.vacuum(data, fileName), "Cancelled compacting should not fail");
+    QCOMPARE(QFileInfo(fileName).size(), size); // unchanged
+
+    QList<int> percents;
+    admin.setProgressFunction([&percents](int percent) {
+        percents.append(percent);
+        return true;
+    });
+    KDB_VERIFY(&admin, admin.vacuum(data, fileName), "Failed to compact database");
+    admin.setProgressFunction(KDbAdminTools::ProgressFunction());
+    QVERIFY(!percents.isEmpty());
+    QCOMPARE(percents.first(), 0);
+    QCOMPARE(percents.last(), 100);
+    for (int i = 1; i < percents.count(); ++i) {
+        QVERIFY(percents[i - 1] < percents[i]);
+    }
+    QVERIFY(QFileInfo(fileName).size() < size);
+    int count = 0;
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT COUNT(*) FROM persons"), &count)
+            == true);
+    QCOMPARE(count, 4);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testSqliteBufferedCursor()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbTableSchema *persons = utils.connection()->tableSchema("persons");
+    QVERIFY(persons);
+    KDbCursor *cursor = utils.connection()->executeQuery(persons, KDbCursor::Option::Buffered);
+    QVERIFY(cursor);
+    QVERIFY(cursor->isBuffered());
+    QVERIFY(cursor->moveFirst());
+    QCOMPARE(cursor->value(0).toInt(), 1);
+    QVERIFY(cursor->moveNext());
+    QCOMPARE(cursor->value(0).toInt(), 2);
+    QCOMPARE(cursor->value(2).toString(), QLatin1String("Lech"));
+    QVERIFY(cursor->movePrev()); // from the buffer
+    QCOMPARE(cursor->at(), qint64(0));
+    QCOMPARE(cursor->value(0).toInt(), 1);
+    QVERIFY(cursor->moveNext()); // from the buffer
+    QCOMPARE(cursor->value(0).toInt(), 2);
+    QVERIFY(cursor->moveNext()); // fetched
+    QCOMPARE(cursor->value(0).toInt(), 3);
+    QVERIFY(cursor->moveLast());
+    QCOMPARE(cursor->value(0).toInt(), 4);
+    QCOMPARE(cursor->value(2).toString(), QLatin1String("John"));
+    QVERIFY(cursor->moveFirst());
+    QCOMPARE(cursor->value(0).toInt(), 1);
+    int count = 1;
+    while (cursor->moveNext()) {
+        ++count;
+        QCOMPARE(cursor->value(0).toInt(), count);
+    }
+    QCOMPARE(count, 4);
+    QVERIFY(cursor->eof());
+    QVERIFY(cursor->movePrev()); // back from after-last
+    QCOMPARE(cursor->value(0).toInt(), 4);
+    QVERIFY(cursor->movePrev());
+    QCOMPARE(cursor->value(0).toInt(), 3);
+    const char **recordData = cursor->recordData(); // text created from typed cells
+    QVERIFY(recordData);
+    QCOMPARE(recordData[0], "3");
+    QCOMPARE(recordData[1], "45");
+    QCOMPARE(recordData[2], "Bill");
+    QVERIFY(utils.connection()->deleteCursor(cursor));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testInsertRecords()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    QList<QList<QVariant>> records;
+    for (int i = 0; i < 1000; ++i) {
+        records.append(QList<QVariant>() << (100 + i) << (20 + i % 50)
+                       << QString::fromLatin1("Name\t%1").arg(i) << QLatin1String("Surname"));
+    }
+    records.append(QList<QVariant>() << 2000 << 30); // missing values are inserted as null
+    QVERIFY(conn->insertRecords(persons, records));
+    int count = 0;
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT COUNT(*) FROM persons"), &count) == true);
+    QCOMPARE(count, 4 + 1001);
+    QString name;
+    QVERIFY(conn->querySingleString(KDbEscapedString("SELECT name FROM persons WHERE id=599"),
+                                    &name) == true);
+    QCOMPARE(name, QLatin1String("Name\t499"));
+    QVERIFY(conn->querySingleNumber(
+                KDbEscapedString("SELECT COUNT(*) FROM persons WHERE surname IS NULL"), &count) == true);
+    QCOMPARE(count, 1);
+
+    QVERIFY(conn->insertRecords(persons, QList<QList<QVariant>>())); // nothing to do
+    records.clear();
+    records.append(QList<QVariant>() << 1 << 40); // duplicated primary key
+    QVERIFY(!conn->insertRecords(persons, records));
+    QVERIFY(conn->result().isError());
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testUpdateAndDeleteRecord()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    KDbQuerySchema *query = persons->query();
+    const KDbQueryColumnInfo::Vector fieldsExpanded(query->fieldsExpanded(conn));
+    QCOMPARE(fieldsExpanded.count(), 4);
+    KDbRecordData data(fieldsExpanded.count());
+    KDbRecordEditBuffer buf(true);
+    for (int id = 1; id <= 3; ++id) { // the same prepared statement is used
+        data[0] = id;
+        buf.clear();
+        buf.insert(fieldsExpanded.at(2), QString::fromLatin1("Name %1").arg(id));
+        buf.insert(fieldsExpanded.at(3), QString::fromLatin1("Surname's %1").arg(id));
+        QVERIFY(conn->updateRecord(query, &data, &buf));
+        QCOMPARE(data.at(2).toString(), QString::fromLatin1("Name %1").arg(id));
+    }
+    buf.clear();
+    buf.insert(fieldsExpanded.at(1), 99);
+    QVERIFY(conn->updateRecord(query, &data, &buf));
+    QString name;
+    QVERIFY(conn->querySingleString(KDbEscapedString("SELECT surname FROM persons WHERE id=2"),
+                                    &name) == true);
+    QCOMPARE(name, QLatin1String("Surname's 2"));
+    int count = 0;
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT age FROM persons WHERE id=3"),
+                                    &count) == true);
+    QCOMPARE(count, 99);
+    data[0] = QVariant();
+    QVERIFY(!conn->updateRecord(query, &data, &buf));
+    QCOMPARE(conn->result().code(), ERR_UPDATE_NULL_PKEY_FIELD);
+
+    for (int id = 1; id <= 2; ++id) {
+        data[0] = id;
+        QVERIFY(conn->deleteRecord(query, &data));
+    }
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT COUNT(*) FROM persons"), &count) == true);
+    QCOMPARE(count, 2);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testParsedQueryCache()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    const QStringList statements({ QLatin1String("SELECT name FROM persons WHERE age > 50"),
+                                   QLatin1String("SELECT name FROM persons WHERE age > 50"),
+                                   QLatin1String("SELECT  name FROM persons WHERE age > 50"),
+                                   QLatin1String("SELECT name FROM persons WHERE age > [a  b]"),
+                                   QLatin1String("SELECT name FROM persons WHERE age > [a b]") });
+    QList<int> ids;
+    for (int i = 0; i < statements.count(); ++i) {
+        KDbQuerySchema query;
+        query.setName(QString::fromLatin1("query%1").arg(i + 1));
+        query.setCaption(QString::fromLatin1("Query %1").arg(i + 1));
+        QVERIFY(conn->storeNewObjectData(&query));
+        QVERIFY(conn->storeDataBlock(query.id(), statements.at(i), QLatin1String("sql")));
+        ids.append(query.id());
+    }
+    KDbQuerySchema *query1 = conn->querySchema(QLatin1String("query1"));
+    QVERIFY(query1);
+    // the second query is copied from the first one because of identical statements
+    KDbQuerySchema *query2 = conn->querySchema(QLatin1String("query2"));
+    QVERIFY(query2);
+    QVERIFY(query1 != query2);
+    QCOMPARE(query2->id(), ids.at(1));
+    QCOMPARE(query2->name(), QLatin1String("query2"));
+    QCOMPARE(query2->caption(), QLatin1String("Query 2"));
+    QCOMPARE(query2->fieldCount(), 1);
+    QCOMPARE(query2->field(0)->name(), QLatin1String("name"));
+    QCOMPARE(query2->masterTable(), conn->tableSchema("persons"));
+    KDbCursor *cursor = conn->executeQuery(query2);
+    QVERIFY(cursor);
+    QVERIFY(conn->deleteCursor(cursor));
+    QVERIFY(conn->querySchema(QLatin1String("query3"))); // differs in white space, parsed again
+
+    // white space is significant within parameter names
+    KDbQuerySchema *query4 = conn->querySchema(QLatin1String("query4"));
+    QVERIFY(query4);
+    KDbQuerySchema *query5 = conn->querySchema(QLatin1String("query5"));
+    QVERIFY(query5);
+    QCOMPARE(query4->parameters(conn).count(), 1);
+    QCOMPARE(query4->parameters(conn).first().message(), QLatin1String("a  b"));
+    QCOMPARE(query5->parameters(conn).count(), 1);
+    QCOMPARE(query5->parameters(conn).first().message(), QLatin1String("a b"));
+
+    // altering the table invalidates the cache, so the query can't be loaded anymore
+    QVERIFY(conn->alterTableName(conn->tableSchema("persons"), QLatin1String("persons2")));
+    QVERIFY(conn->setQuerySchemaObsolete(QLatin1String("query2")));
+    QVERIFY(!conn->querySchema(QLatin1String("query2")));
+    QCOMPARE(conn->result().code(), ERR_SQL_PARSE_ERROR);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+//! @return names of fields and their extended properties for tables @a tableNames of @a conn
+static QStringList tableSchemaSummary(KDbConnection *conn, const QStringList &tableNames)
+{
+    QStringList result;
+    for (const QString &tableName : tableNames) {
+        const KDbTableSchema *table = conn->tableSchema(tableName);
+        if (!table) {
+            return QStringList();
+        }
+        result.append(QString::number(table->id()) + QLatin1Char(' ') + table->name());
+        for (const KDbField *field : *table->fields()) {
+            result.append(QString::fromLatin1("  %1 %2 %3 %4")
+                          .arg(field->name()).arg(field->type())
+                          .arg(field->visibleDecimalPlaces())
+                          .arg(field->caption()));
+        }
+    }
+    return result;
+}
+
+void ConnectionTest::testTableSchemaPreloading()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    QCOMPARE(conn->options()->tableSchemaPreloading(),
+             KDbConnectionOptions::TableSchemaPreloading::None);
+    const QStringList tableNames(conn->tableNames());
+    QVERIFY(!tableNames.isEmpty());
+    const QStringList expected(tableSchemaSummary(conn, tableNames));
+    QVERIFY(!expected.isEmpty());
+
+    for (KDbConnectionOptions::TableSchemaPreloading preloading
+         : { KDbConnectionOptions::TableSchemaPreloading::Lazy,
+             KDbConnectionOptions::TableSchemaPreloading::Eager })
+    {
+        QVERIFY(conn->closeDatabase());
+        conn->options()->setTableSchemaPreloading(preloading);
+        QCOMPARE(conn->options()->tableSchemaPreloading(), preloading);
+        QVERIFY(conn->useDatabase());
+        QCOMPARE(tableSchemaSummary(conn, tableNames), expected);
+        QVERIFY(!conn->tableSchema(QLatin1String("nonexisting")));
+        // tables looked up by identifier
+        const int id = conn->tableSchema(tableNames.first())->id();
+        QVERIFY(conn->closeDatabase());
+        QVERIFY(conn->useDatabase());
+        QVERIFY(conn->tableSchema(id));
+        QCOMPARE(conn->tableSchema(id)->name(), tableNames.first());
+    }
+    conn->options()->setTableSchemaPreloading(KDbConnectionOptions::TableSchemaPreloading::None);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testParsedQueryCacheWithExpressions()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    const QString statement(QLatin1String("SELECT age + 1, name FROM persons ORDER BY id"));
+    for (int i = 0; i < 2; ++i) {
+        KDbQuerySchema query;
+        query.setName(QString::fromLatin1("exprquery%1").arg(i + 1));
+        QVERIFY(conn->storeNewObjectData(&query));
+        QVERIFY(conn->storeDataBlock(query.id(), statement, QLatin1String("sql")));
+    }
+    KDbQuerySchema *query1 = conn->querySchema(QLatin1String("exprquery1"));
+    QVERIFY(query1);
+    KDbQuerySchema *query2 = conn->querySchema(QLatin1String("exprquery2")); // copied
+    QVERIFY(query2);
+    QCOMPARE(query2->fieldCount(), 2);
+    QVERIFY(query2->field(0)->isExpression());
+    QVERIFY(query2->field(0) != query1->field(0)); // expression fields are not shared
+    QCOMPARE(query2->field(0)->parent(), static_cast<KDbFieldList*>(query2));
+
+    KDbCursor *cursor1 = conn->executeQuery(query1);
+    QVERIFY(cursor1);
+    KDbCursor *cursor2 = conn->executeQuery(query2);
+    QVERIFY(cursor2);
+    QVERIFY(cursor1->moveFirst());
+    QVERIFY(cursor2->moveFirst());
+    const int age = cursor1->value(0).toInt();
+    QCOMPARE(cursor2->value(0).toInt(), age);
+
+    // renaming a table clears the cache of parsed queries, open cursors are not affected
+    QVERIFY(conn->alterTableName(conn->tableSchema("cars"), QLatin1String("cars2")));
+    QCOMPARE(query1->fieldsExpanded(conn).count(), 2);
+    QCOMPARE(query2->fieldsExpanded(conn).count(), 2);
+    QVERIFY(cursor1->moveNext());
+    QVERIFY(cursor2->moveNext());
+    QCOMPARE(cursor2->value(0), cursor1->value(0));
+    QCOMPARE(cursor2->value(1), cursor1->value(1));
+    QVERIFY(conn->deleteCursor(cursor1));
+    QVERIFY(conn->deleteCursor(cursor2));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testExtendedTableSchemaData()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *table = new KDbTableSchema(QLatin1String("trucks"));
+    KDbField *f = new KDbField(QLatin1String("id"), KDbField::Integer);
+    f->setPrimaryKey(true);
+    QVERIFY(table->addField(f));
+    f = new KDbField(QLatin1String("price"), KDbField::Double);
+    f->setVisibleDecimalPlaces(2);
+    f->setCustomProperty("currency", QLatin1String("EUR"));
+    QVERIFY(table->addField(f));
+    f = new KDbField(QLatin1String("owner"), KDbField::Integer);
+    QVERIFY(table->addField(f));
+    KDbLookupFieldSchema *lookup = new KDbLookupFieldSchema;
+    KDbLookupFieldSchemaRecordSource recordSource;
+    recordSource.setType(KDbLookupFieldSchemaRecordSource::Type::Table);
+    recordSource.setName(QLatin1String("persons"));
+    lookup->setRecordSource(recordSource);
+    lookup->setBoundColumn(0);
+    lookup->setVisibleColumns(QList<int>() << 2);
+    QVERIFY(table->setLookupFieldSchema(QLatin1String("owner"), lookup));
+    QVERIFY(conn->createTable(table));
+    const int id = table->id();
+
+    QVERIFY(conn->closeDatabase());
+    QVERIFY(conn->useDatabase());
+    table = conn->tableSchema(QLatin1String("trucks"));
+    QVERIFY(table);
+    QCOMPARE(table->field(QLatin1String("price"))->visibleDecimalPlaces(), 2);
+    QCOMPARE(table->field(QLatin1String("price"))->customProperty("currency"),
+             QVariant(QLatin1String("EUR")));
+    lookup = table->lookupFieldSchema(QLatin1String("owner"));
+    QVERIFY(lookup);
+    QCOMPARE(lookup->recordSource(), recordSource);
+    QCOMPARE(lookup->boundColumn(), 0);
+    QCOMPARE(lookup->visibleColumns(), QList<int>() << 2);
+    QVERIFY(!table->lookupFieldSchema(QLatin1String("price")));
+
+    // data stored by older versions is still readable
+    const QString legacyData(QLatin1String(
+        "<!DOCTYPE EXTENDED_TABLE_SCHEMA>\n"
+        "<EXTENDED_TABLE_SCHEMA version=\"2\">\n"
+        "    <field name=\"price\">\n"
+        "        <property name=\"visibleDecimalPlaces\">\n"
+        "            <number>3</number>\n"
+        "        </property>\n"
+        "        <property custom=\"true\" name=\"currency\">\n"
+        "            <string>PLN</string>\n"
+        "        </property>\n"
+        "    </field>\n"
+        "    <field name=\"nonexisting\">\n"
+        "        <property custom=\"true\" name=\"foo\">\n"
+        "            <bool>true</bool>\n"
+        "        </property>\n"
+        "    </field>\n"
+        "</EXTENDED_TABLE_SCHEMA>\n"));
+    QVERIFY(conn->storeDataBlock(id, legacyData, QLatin1String("extended_schema")));
+    QVERIFY(conn->closeDatabase());
+    QVERIFY(conn->useDatabase());
+    table = conn->tableSchema(QLatin1String("trucks"));
+    QVERIFY(table);
+    QCOMPARE(table->field(QLatin1String("price"))->visibleDecimalPlaces(), 3);
+    QCOMPARE(table->field(QLatin1String("price"))->customProperty("currency"),
+             QVariant(QLatin1String("PLN")));
+    QVERIFY(!table->lookupFieldSchema(QLatin1String("owner")));
+
+    // invalid data is reported
+    QVERIFY(conn->storeDataBlock(id, QLatin1String("<!DOCTYPE EXTENDED_TABLE_SCHEMA><foo>"),
+                                 QLatin1String("extended_schema")));
+    QVERIFY(conn->closeDatabase());
+    QVERIFY(conn->useDatabase());
+    QVERIFY(!conn->tableSchema(QLatin1String("trucks")));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testQueryResultCache()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    QCOMPARE(conn->options()->queryResultCacheSize(), qint64(0));
+    const KDbEscapedString countSql("SELECT COUNT(*) FROM persons");
+    int count;
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    const int personsCount = count;
+    QCOMPARE(conn->queryResultCacheStatistics().entryCount, 0); // disabled by default
+
+    conn->options()->setQueryResultCacheSize(1024 * 1024);
+    QStringList names;
+    KDbRecordData record;
+    for (int i = 0; i < 2; ++i) { // the second iteration uses cached results
+        count = -1;
+        QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+        QCOMPARE(count, personsCount);
+        QVERIFY(conn->queryStringList(KDbEscapedString("SELECT name FROM persons ORDER BY id"),
+                                      &names));
+        QCOMPARE(names.count(), personsCount);
+        record.clear();
+        QVERIFY(conn->querySingleRecord(
+                    KDbEscapedString("SELECT id, name FROM persons WHERE id=1"), &record) == true);
+        QCOMPARE(record.count(), 2);
+        QCOMPARE(record.at(0).toInt(), 1);
+        QCOMPARE(record.at(1).toString(), names.first());
+        QVERIFY(conn->querySingleRecord(
+                    KDbEscapedString("SELECT id FROM persons WHERE id=-1"), &record) == cancelled);
+    }
+    int carsCount;
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT COUNT(*) FROM cars"), &carsCount) == true);
+    KDbConnection::QueryResultCacheStatistics statistics = conn->queryResultCacheStatistics();
+    QCOMPARE(statistics.hits, quint64(4));
+    QCOMPARE(statistics.misses, quint64(5));
+    QCOMPARE(statistics.entryCount, 5);
+    QCOMPARE(statistics.maximumSize, qint64(1024 * 1024));
+    QVERIFY(statistics.memoryUsage > 0);
+    QVERIFY(statistics.memoryUsage <= statistics.maximumSize);
+
+    // inserting to "persons" invalidates its results but not results for "cars"
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    QVERIFY(conn->insertRecord(persons, QList<QVariant>() << 100 << 30
+                                            << QLatin1String("Name") << QLatin1String("Surname")));
+    statistics = conn->queryResultCacheStatistics();
+    QCOMPARE(statistics.entryCount, 1);
+    QCOMPARE(statistics.invalidations, quint64(4));
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(count, personsCount + 1);
+    QCOMPARE(conn->recordCount(*persons), personsCount + 1);
+
+    // data manipulation using executeSql() and rollback of a transaction
+    KDbTransaction transaction = conn->beginTransaction();
+    QVERIFY(transaction.isActive());
+    QVERIFY(conn->executeSql(KDbEscapedString("DELETE FROM persons WHERE id=100")));
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(count, personsCount);
+    QVERIFY(conn->rollbackTransaction(transaction));
+    QCOMPARE(conn->queryResultCacheStatistics().entryCount, 0);
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(count, personsCount + 1);
+
+    // explicit invalidation
+    conn->invalidateQueryResultCache(QLatin1String("cars"));
+    QCOMPARE(conn->queryResultCacheStatistics().entryCount, 1);
+    conn->invalidateQueryResultCache(QLatin1String("Persons"));
+    QCOMPARE(conn->queryResultCacheStatistics().entryCount, 0);
+
+    // results are neither used nor stored with NoResultCache
+    QVERIFY(conn->queryStringList(KDbEscapedString("SELECT name FROM persons ORDER BY id"),
+                                  &names, 0, KDbConnection::QueryRecordOption::NoResultCache));
+    QCOMPARE(names.count(), personsCount + 1);
+    QCOMPARE(conn->queryResultCacheStatistics().entryCount, 0);
+
+    // results of queries defined by schema are cached as well
+    const quint64 hits = conn->queryResultCacheStatistics().hits;
+    for (int i = 0; i < 2; ++i) {
+        names.clear();
+        QVERIFY(conn->queryStringList(persons->query(), &names, 2)); // "name" column
+        QCOMPARE(names.count(), personsCount + 1);
+        QVERIFY(names.contains(QLatin1String("Name")));
+    }
+    statistics = conn->queryResultCacheStatistics();
+    QCOMPARE(statistics.entryCount, 1);
+    QCOMPARE(statistics.hits, hits + 1);
+
+    // the cache is bounded by memory
+    conn->options()->setQueryResultCacheSize(1024);
+    for (int id = 1; id <= 20; ++id) {
+        QVERIFY(conn->querySingleString(
+                    KDbEscapedString("SELECT name FROM persons WHERE id=%1").arg(id), nullptr)
+                != false);
+    }
+    statistics = conn->queryResultCacheStatistics();
+    QVERIFY(statistics.entryCount > 0);
+    QVERIFY(statistics.entryCount < 20);
+    QVERIFY(statistics.memoryUsage <= 1024);
+
+    conn->options()->setQueryResultCacheSize(0);
+    QVERIFY(conn->querySingleNumber(countSql, &count) == true);
+    QCOMPARE(conn->queryResultCacheStatistics().entryCount, 0);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testRecordCountEstimates()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    const qint64 personsCount = conn->recordCount(*persons);
+    QVERIFY(personsCount > 0);
+    QCOMPARE(conn->cachedRecordCount(*persons), personsCount);
+    QCOMPARE(conn->estimatedRecordCount(*persons), personsCount); // no statistics yet
+
+    // the cached number is kept up to date by modifications
+    QVERIFY(conn->insertRecord(persons, QList<QVariant>() << 100 << 30
+                                            << QLatin1String("Name") << QLatin1String("Surname")));
+    QCOMPARE(conn->cachedRecordCount(*persons), personsCount + 1);
+    QList<QList<QVariant>> records;
+    records << (QList<QVariant>() << 101 << 31 << QLatin1String("A") << QLatin1String("B"))
+            << (QList<QVariant>() << 102 << 32 << QLatin1String("C") << QLatin1String("D"));
+    QVERIFY(conn->insertRecords(persons, records));
+    QCOMPARE(conn->cachedRecordCount(*persons), personsCount + 3);
+    QCOMPARE(conn->cachedRecordCount(*persons), qint64(conn->recordCount(*persons)));
+
+    // data manipulation using executeSql() invalidates the cached number
+    QVERIFY(conn->executeSql(KDbEscapedString("DELETE FROM persons WHERE id>=100")));
+    QCOMPARE(conn->cachedRecordCount(*persons), personsCount);
+
+    // statistics of the database are used when available
+    QVERIFY(conn->executeSql(KDbEscapedString("ANALYZE")));
+    conn->invalidateQueryResultCache(persons->name());
+    const qint64 estimate = conn->estimatedRecordCount(*persons);
+    QVERIFY(estimate >= 0);
+    QVERIFY(!conn->result().isError());
+
+    // statistics are not stored in the query result cache, so updated statistics are used
+    QVERIFY(conn->executeSql(KDbEscapedString(
+        "INSERT INTO persons (id, age, name, surname) VALUES (100, 30, 'A', 'B')")));
+    QVERIFY(conn->executeSql(KDbEscapedString("ANALYZE")));
+    QCOMPARE(conn->estimatedRecordCount(*persons), estimate + 1);
+
+    // deleting a record that does not exist does not change the number
+    QCOMPARE(conn->cachedRecordCount(*persons), personsCount + 1);
+    KDbRecordData missingRecord(persons->fieldCount());
+    missingRecord[0] = 12345;
+    QVERIFY(conn->deleteRecord(persons->query(), &missingRecord));
+    QCOMPARE(conn->cachedRecordCount(*persons), personsCount + 1);
+
+    QVERIFY(conn->deleteAllRecords(persons->query()));
+    QCOMPARE(conn->cachedRecordCount(*persons), qint64(0));
+    QCOMPARE(conn->estimatedRecordCount(*persons), qint64(0)); // cached number is preferred
+    QCOMPARE(conn->recordCount(*persons), 0);
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void ConnectionTest::testSqlRecordValues()
+{
+    QVERIFY(utils.testCreateDbWithTables("ConnectionTest"));
+    KDbConnection *conn = utils.connection();
+    QSharedPointer<KDbSqlResult> result = conn->prepareSql(
+        KDbEscapedString("SELECT 1099511627776, -7, 2.5, NULL, 'text', 0, 'true'"));
+    QVERIFY(result);
+    QSharedPointer<KDbSqlRecord> record = result->fetchRecord();
+    QVERIFY(record);
+    QCOMPARE(record->int64Value(0), Q_INT64_C(1099511627776));
+    QVERIFY(!record->isNull(0));
+    QCOMPARE(record->int64Value(1), qint64(-7));
+    QVERIFY(record->boolValue(1));
+    QCOMPARE(record->doubleValue(2), 2.5);
+    QVERIFY(record->isNull(3));
+    QCOMPARE(record->int64Value(3), qint64(0));
+    QCOMPARE(record->doubleValue(3), 0.0);
+    QVERIFY(!record->boolValue(3));
+    QVERIFY(record->blobView(3).isEmpty());
+    const KDbSqlString text = record->blobView(4);
+    QCOMPARE(text.rawDataToByteArray(), QByteArray("text"));
+    QCOMPARE(record->toByteArray(4), QByteArray("text"));
+    QVERIFY(!record->isNull(4));
+    QVERIFY(!record->boolValue(5));
+    QVERIFY(record->boolValue(6));
+    record.clear();
+    result.clear();
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
 void ConnectionTest::cleanupTestCase()
 {
 }
@@ -30,6 +30,31 @@ private Q_SLOTS:
     void testConnectionData();
     void testCreateDb();
     void testConnectToNonexistingDb();
+    void testSqliteStatementCache();
+    //! Test PRAGMAs applied by SQLite performance profiles
+    void testSqlitePerformanceProfiles();
+    //! Test online compacting of SQLite databases with progress and cancellation
+    void testSqliteVacuum();
+    //! Test scrolling a buffered cursor back and forth
+    void testSqliteBufferedCursor();
+    //! Test inserting multiple records with KDbConnection::insertRecords()
+    void testInsertRecords();
+    //! Test updating and deleting records using KDbConnection::updateRecord() and deleteRecord()
+    void testUpdateAndDeleteRecord();
+    //! Test loading of stored queries that have the same SQL statements
+    void testParsedQueryCache();
+    //! Test that copies of cached queries with expression columns are independent
+    void testParsedQueryCacheWithExpressions();
+    //! Test lazy and eager preloading of table schemas in KDbConnection::useDatabase()
+    void testTableSchemaPreloading();
+    //! Test storing and loading of extended table schema data, also in the legacy layout
+    void testExtendedTableSchemaData();
+    //! Test hits and invalidation of the query result cache
+    void testQueryResultCache();
+    //! Test cached and estimated numbers of records of tables
+    void testRecordCountEstimates();
+    //! Test typed accessors of KDbSqlRecord
+    void testSqlRecordValues();
     void cleanupTestCase();
 
 private:
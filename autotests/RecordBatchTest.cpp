@@ -0,0 +1,235 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "RecordBatchTest.h"
+
+#include <KDbConnection>
+#include <KDbCursor>
+#include <KDbRecordBatch>
+#include <KDbRecordData>
+
+#include <QTest>
+
+#include <limits>
+
+QTEST_GUILESS_MAIN(RecordBatchTest)
+
+namespace {
+//! Produces @a total persons with ids starting at 100
+class PersonsProducer : public KDbRecordBatchProducer
+{
+public:
+    explicit PersonsProducer(int total) : m_total(total) {}
+    bool produceRecords(KDbRecordBatch *batch) override {
+        for (; m_produced < m_total && !batch->isFull(); ++m_produced) {
+            const int row = batch->appendRecord();
+            batch->setInteger(row, 0, 100 + m_produced);
+            batch->setInteger(row, 1, 20 + m_produced % 50);
+            batch->setText(row, 2, QString::fromLatin1("Name\t%1").arg(m_produced));
+            if (m_produced % 2) {
+                batch->setNull(row, 3);
+            } else {
+                batch->setText(row, 3, QLatin1String("Surname"));
+            }
+        }
+        return true;
+    }
+private:
+    const int m_total;
+    int m_produced = 0;
+};
+
+//! Counts consumed records, cancels after @a limit records if @a limit is not -1
+class PersonsConsumer : public KDbRecordBatchConsumer
+{
+public:
+    explicit PersonsConsumer(int limit = -1) : m_limit(limit) {}
+    bool consumeRecords(const KDbRecordBatch &batch) override {
+        for (int row = 0; row < batch.count(); ++row) {
+            if (batch.integerValue(row, 0) == 599) {
+                name = batch.textValue(row, 2);
+                surnameIsNull = batch.isNull(row, 3);
+            }
+        }
+        count += batch.count();
+        return m_limit == -1 || count < m_limit;
+    }
+    int count = 0;
+    QString name;
+    bool surnameIsNull = false;
+private:
+    const int m_limit;
+};
+}
+
+void RecordBatchTest::initTestCase()
+{
+}
+
+void RecordBatchTest::testValues()
+{
+    const QVector<KDbRecordBatch::ColumnType> types {
+        KDbRecordBatch::ColumnType::Integer, KDbRecordBatch::ColumnType::Double,
+        KDbRecordBatch::ColumnType::Boolean, KDbRecordBatch::ColumnType::Text,
+        KDbRecordBatch::ColumnType::Binary, KDbRecordBatch::ColumnType::Variant };
+    KDbRecordBatch batch(types, 10);
+    QCOMPARE(batch.columnCount(), types.count());
+    QCOMPARE(batch.capacity(), 10);
+    QVERIFY(batch.isEmpty());
+
+    const int row = batch.appendRecord();
+    QCOMPARE(row, 0);
+    for (int col = 0; col < batch.columnCount(); ++col) {
+        QVERIFY(batch.isNull(row, col));
+        QVERIFY(batch.at(row, col).isNull());
+    }
+    batch.setInteger(row, 0, Q_INT64_C(1) << 40);
+    batch.setDouble(row, 1, 3.5);
+    batch.setBoolean(row, 2, true);
+    batch.setText(row, 3, QString::fromUtf8("Zażółć"));
+    batch.setValue(row, 4, QByteArray("\0\1\2", 3));
+    batch.setValue(row, 5, QDate(2017, 1, 2));
+    QCOMPARE(batch.integerValue(row, 0), Q_INT64_C(1) << 40);
+    QCOMPARE(batch.doubleValue(row, 1), 3.5);
+    QVERIFY(batch.booleanValue(row, 2));
+    QCOMPARE(batch.textValue(row, 3), QString::fromUtf8("Zażółć"));
+    QCOMPARE(batch.stringView(row, 3).rawDataToByteArray(), QByteArray("Zażółć"));
+    QCOMPARE(batch.binaryValue(row, 4), QByteArray("\0\1\2", 3));
+    QCOMPARE(batch.at(row, 5), QVariant(QDate(2017, 1, 2)));
+
+    const int row2 = batch.appendRecord();
+    QCOMPARE(row2, 1);
+    batch.setValue(row2, 0, QLatin1String("not a number"));
+    QVERIFY(batch.isNull(row2, 0));
+    batch.setValue(row2, 3, QVariant());
+    QVERIFY(batch.isNull(row2, 3));
+    QVERIFY(!batch.isNull(row, 3)); // other records are not affected
+
+    KDbRecordData data;
+    batch.toRecordData(row, &data);
+    QCOMPARE(data.count(), types.count());
+    QCOMPARE(data.at(3).toString(), QString::fromUtf8("Zażółć"));
+
+    while (batch.appendRecord() >= 0) {
+    }
+    QVERIFY(batch.isFull());
+    QCOMPARE(batch.count(), 10);
+    batch.clear();
+    QVERIFY(batch.isEmpty());
+    QCOMPARE(batch.appendRecord(), 0);
+    QVERIFY(batch.isNull(0, 0));
+
+    // unsigned big integers above LLONG_MAX do not fit the integer storage
+    KDbField bigInteger(QLatin1String("big"), KDbField::BigInteger);
+    QCOMPARE(KDbRecordBatch::columnType(bigInteger), KDbRecordBatch::ColumnType::Integer);
+    bigInteger.setUnsigned(true);
+    QCOMPARE(KDbRecordBatch::columnType(bigInteger), KDbRecordBatch::ColumnType::Variant);
+    batch.setValue(0, 5, std::numeric_limits<quint64>::max());
+    QCOMPARE(batch.at(0, 5).toULongLong(), std::numeric_limits<quint64>::max());
+}
+
+void RecordBatchTest::testStoreCurrentRecord()
+{
+    QVERIFY(utils.testCreateDbWithTables("RecordBatchTest"));
+    KDbTableSchema *persons = utils.connection()->tableSchema("persons");
+    QVERIFY(persons);
+    KDbCursor *cursor = utils.connection()->executeQuery(persons);
+    QVERIFY(cursor);
+    QScopedPointer<KDbRecordBatch> batch(cursor->createRecordBatch(3));
+    QVERIFY(batch);
+    QCOMPARE(batch->columnCount(), cursor->fieldCount() + (cursor->containsRecordIdInfo() ? 1 : 0));
+    QCOMPARE(batch->columnType(0), KDbRecordBatch::ColumnType::Integer);
+    QCOMPARE(batch->columnType(2), KDbRecordBatch::ColumnType::Text);
+    int count = 0;
+    for (cursor->moveFirst(); !cursor->eof(); cursor->moveNext()) {
+        if (batch->isFull()) {
+            QVERIFY(!cursor->storeCurrentRecord(batch.data()));
+            break;
+        }
+        QVERIFY(cursor->storeCurrentRecord(batch.data()));
+        ++count;
+    }
+    QCOMPARE(count, 3);
+    QCOMPARE(batch->integerValue(0, 0), qint64(1));
+    QCOMPARE(batch->integerValue(0, 1), qint64(27));
+    QCOMPARE(batch->textValue(0, 2), QLatin1String("Jaroslaw"));
+    QCOMPARE(batch->at(2, 3).toString(), QLatin1String("Gates"));
+    QVERIFY(utils.connection()->deleteCursor(cursor));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void RecordBatchTest::testFetchBatch()
+{
+    QVERIFY(utils.testCreateDbWithTables("RecordBatchTest"));
+    KDbTableSchema *persons = utils.connection()->tableSchema("persons");
+    QVERIFY(persons);
+    KDbCursor *cursor = utils.connection()->executeQuery(persons);
+    QVERIFY(cursor);
+    QScopedPointer<KDbRecordBatch> batch(cursor->createRecordBatch(3));
+    QVERIFY(batch);
+    QCOMPARE(cursor->fetchBatch(batch.data(), 2), 2);
+    QCOMPARE(batch->count(), 2);
+    QCOMPARE(cursor->fetchBatch(batch.data()), 1); // limited by capacity
+    QVERIFY(batch->isFull());
+    QVERIFY(!cursor->eof());
+    QCOMPARE(cursor->at(), qint64(2));
+    QCOMPARE(cursor->value(0).toInt(), 3); // the last fetched record is current
+    QCOMPARE(batch->integerValue(0, 0), qint64(1));
+    QCOMPARE(batch->textValue(1, 2), QLatin1String("Lech"));
+    QCOMPARE(batch->textValue(2, 3), QLatin1String("Gates"));
+
+    batch->clear();
+    QCOMPARE(cursor->fetchBatch(batch.data()), 1); // 4 persons in total
+    QVERIFY(cursor->eof());
+    QCOMPARE(batch->integerValue(0, 1), qint64(35));
+    QCOMPARE(batch->textValue(0, 2), QLatin1String("John"));
+    QCOMPARE(cursor->fetchBatch(batch.data()), 0);
+    QVERIFY(!cursor->result().isError());
+    QVERIFY(utils.connection()->deleteCursor(cursor));
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void RecordBatchTest::testImportExportRecords()
+{
+    QVERIFY(utils.testCreateDbWithTables("RecordBatchTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *persons = conn->tableSchema("persons");
+    QVERIFY(persons);
+    PersonsProducer producer(1000);
+    QVERIFY(conn->importRecords(persons, &producer, 64));
+    int count = 0;
+    QVERIFY(conn->querySingleNumber(KDbEscapedString("SELECT COUNT(*) FROM persons"), &count) == true);
+    QCOMPARE(count, 4 + 1000);
+
+    PersonsConsumer consumer;
+    QVERIFY(conn->exportRecords(persons, &consumer, 64));
+    QCOMPARE(consumer.count, 4 + 1000);
+    QCOMPARE(consumer.name, QLatin1String("Name\t499"));
+    QVERIFY(consumer.surnameIsNull);
+
+    PersonsConsumer cancellingConsumer(100);
+    QVERIFY(!conn->exportRecords(persons, &cancellingConsumer, 64));
+    QCOMPARE(cancellingConsumer.count, 128); // two batches
+    QVERIFY(conn->result().isError());
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
+
+void RecordBatchTest::cleanupTestCase()
+{
+}
@@ -0,0 +1,49 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDBRECORDBATCHTEST_H
+#define KDBRECORDBATCHTEST_H
+
+#include "KDbTestUtils.h"
+
+class RecordBatchTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+
+    //! Test storing and retrieving typed values and nulls
+    void testValues();
+
+    //! Test filling a batch by a cursor for "SELECT * FROM persons"
+    void testStoreCurrentRecord();
+
+    //! Test KDbCursor::fetchBatch() for "SELECT * FROM persons"
+    void testFetchBatch();
+
+    //! Test KDbConnection::importRecords() and KDbConnection::exportRecords() for "persons"
+    void testImportExportRecords();
+
+    void cleanupTestCase();
+
+private:
+    KDbTestUtils utils;
+};
+
+#endif
@@ -0,0 +1,333 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "TableViewDataTest.h"
+
+#include <KDbLookupFieldSchema>
+#include <KDbParser>
+#include <KDbRecordEditBuffer>
+#include <KDbTableViewColumn>
+#include <KDbTableViewData>
+#include <KDbTableViewDataLoader>
+
+#include <QSignalSpy>
+#include <QTest>
+
+QTEST_GUILESS_MAIN(TableViewDataTest)
+
+//! @return values of column @a column of all records of @a data
+static QList<QVariant> columnValues(KDbTableViewData *data, int column)
+{
+    QList<QVariant> result;
+    for (KDbTableViewDataConstIterator it = data->constBegin(); it != data->constEnd(); ++it) {
+        result.append((*it)->at(column));
+    }
+    return result;
+}
+
+void TableViewDataTest::testSortIntegers()
+{
+    const QList<QVariant> keys({ 5, QVariant(), 3, -7, 100, 3 });
+    const QList<QVariant> values({ "a", "b", "c", "d", "e", "f" });
+    KDbTableViewData data(keys, values, KDbField::Integer, KDbField::Text);
+    data.setSorting(0);
+    data.sort();
+    QCOMPARE(columnValues(&data, 0), QList<QVariant>({ QVariant(), -7, 3, 3, 5, 100 }));
+    QCOMPARE(columnValues(&data, 1), QList<QVariant>({ "b", "d", "c", "f", "a", "e" }));
+    data.setSorting(0, KDbOrderByColumn::SortOrder::Descending);
+    data.sort();
+    QCOMPARE(columnValues(&data, 0), QList<QVariant>({ 100, 5, 3, 3, -7, QVariant() }));
+}
+
+void TableViewDataTest::testSortText()
+{
+    const QList<QVariant> keys({ 1, 2, 3, 4, 5, 6 });
+    const QList<QVariant> values({ "pear", "apple", QVariant(), "Banana", "apples", "cherry" });
+    KDbTableViewData data(keys, values, KDbField::Integer, KDbField::Text);
+    data.setSorting(1);
+    QCOMPARE(data.sortColumn(), 1);
+    data.sort();
+    QCOMPARE(columnValues(&data, 1),
+             QList<QVariant>({ QVariant(), "apple", "apples", "Banana", "cherry", "pear" }));
+    data.setSorting(-1);
+    QCOMPARE(data.sortColumn(), -1);
+    data.sort(); // no-op
+    QCOMPARE(columnValues(&data, 0), QList<QVariant>({ 3, 2, 5, 4, 6, 1 }));
+}
+
+void TableViewDataTest::testSortLargeData()
+{
+    const int count = 100000;
+    QList<QVariant> keys;
+    QList<QVariant> values;
+    for (int i = 0; i < count; ++i) {
+        keys.append(i);
+        values.append(QString::number((i * 7919) % 1000));
+    }
+    KDbTableViewData data(keys, values, KDbField::Integer, KDbField::Text);
+    data.setSorting(1);
+    data.sort();
+    QCOMPARE(data.count(), count);
+    const KDbRecordData *previous = nullptr;
+    for (KDbTableViewDataConstIterator it = data.constBegin(); it != data.constEnd(); ++it) {
+        if (previous) {
+            const int previousValue = previous->at(1).toString().toInt();
+            const int value = (*it)->at(1).toString().toInt();
+            // "1" < "10" < "2" but for numbers of the same length the order is numeric
+            if (previous->at(1).toString().length() == (*it)->at(1).toString().length()) {
+                QVERIFY(previousValue <= value);
+            }
+            if (previous->at(1) == (*it)->at(1)) {
+                // stable: equal values keep the original order
+                QVERIFY(previous->at(0).toInt() < (*it)->at(0).toInt());
+            }
+        }
+        previous = *it;
+    }
+}
+
+void TableViewDataTest::testSortMultipleColumns()
+{
+    const QList<QVariant> keys({ 1, 2, 3, 4, 5, 6 });
+    const QList<QVariant> values({ "b", "a", "b", QVariant(), "a", "c" });
+    KDbTableViewData data(keys, values, KDbField::Integer, KDbField::Text);
+    KDbOrderByColumnList orderBy;
+    orderBy.appendField(data.column(1)->field());
+    orderBy.appendField(data.column(0)->field(), KDbOrderByColumn::SortOrder::Descending);
+    QVERIFY(data.setSorting(orderBy));
+    QCOMPARE(data.sortColumns(), QList<int>({ 1, 0 }));
+    QCOMPARE(data.sortColumn(), 1);
+    data.sort();
+    QCOMPARE(columnValues(&data, 0), QList<QVariant>({ 4, 5, 2, 3, 1, 6 }));
+
+    KDbField otherField(QLatin1String("other"), KDbField::Text);
+    KDbOrderByColumnList otherOrderBy;
+    otherOrderBy.appendField(&otherField);
+    QVERIFY(!data.setSorting(otherOrderBy));
+    QCOMPARE(data.sortColumn(), -1);
+    QVERIFY(data.sortColumns().isEmpty());
+}
+
+void TableViewDataTest::testSortingMaintained()
+{
+    const QList<QVariant> keys({ 10, 20, 30, 40 });
+    const QList<QVariant> values({ "a", "b", "c", "d" });
+    KDbTableViewData data(keys, values, KDbField::Integer, KDbField::Text);
+    QVERIFY(!data.isSortingMaintained());
+    data.setSortingMaintained(true);
+    QVERIFY(data.isSortingMaintained());
+    data.setSorting(0);
+    data.sort();
+
+    KDbRecordData *record = data.createItem();
+    (*record)[0] = 25;
+    (*record)[1] = "e";
+    QCOMPARE(data.insertRecordSorted(record), 2);
+    QCOMPARE(columnValues(&data, 0), QList<QVariant>({ 10, 20, 25, 30, 40 }));
+
+    QList<int> moves;
+    connect(&data, &KDbTableViewData::recordRepositioned,
+            [&moves](KDbRecordData *, int oldIndex, int newIndex) { moves << oldIndex << newIndex; });
+    data.clearRecordEditBuffer();
+    QVERIFY(data.updateRecordEditBuffer(record, 0, 50));
+    QVERIFY(data.saveRecordChanges(record));
+    QCOMPARE(columnValues(&data, 0), QList<QVariant>({ 10, 20, 30, 40, 50 }));
+    QCOMPARE(moves, QList<int>({ 2, 4 }));
+
+    // no move needed
+    moves.clear();
+    data.clearRecordEditBuffer();
+    QVERIFY(data.updateRecordEditBuffer(record, 0, 45));
+    QVERIFY(data.saveRecordChanges(record));
+    QCOMPARE(columnValues(&data, 0), QList<QVariant>({ 10, 20, 30, 40, 45 }));
+    QVERIFY(moves.isEmpty());
+
+    data.clearRecordEditBuffer();
+    QVERIFY(data.updateRecordEditBuffer(record, 0, 5));
+    QVERIFY(data.saveRecordChanges(record));
+    QCOMPARE(columnValues(&data, 0), QList<QVariant>({ 5, 10, 20, 30, 40 }));
+    QCOMPARE(moves, QList<int>({ 4, 0 }));
+}
+
+void TableViewDataTest::testLoader()
+{
+    QVERIFY(utils.testCreateDbWithTables("TableViewDataTest"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *table = conn->tableSchema("persons");
+    QVERIFY(table);
+    const int recordCount = conn->recordCount(*table);
+    QVERIFY(recordCount > 1);
+    KDbQuerySchema query(table);
+    KDbCursor *cursor = conn->prepareQuery(&query);
+    QVERIFY(cursor);
+    KDbTableViewData data(cursor);
+    KDbTableViewDataLoader loader(&data);
+    QCOMPARE(loader.data(), &data);
+    QCOMPARE(loader.chunkSize(), 1000);
+    loader.setChunkSize(1);
+    QCOMPARE(loader.chunkSize(), 1);
+    QSignalSpy recordsLoadedSpy(&loader, &KDbTableViewDataLoader::recordsLoaded);
+    QSignalSpy finishedSpy(&loader, &KDbTableViewDataLoader::finished);
+    QVERIFY(loader.start());
+    QVERIFY(loader.isRunning());
+    QVERIFY(!loader.start()); // already running
+    QVERIFY(finishedSpy.wait());
+    QVERIFY(!loader.isRunning());
+    QCOMPARE(finishedSpy.first().first().toBool(), true);
+    QVERIFY(!loader.result().isError());
+    QCOMPARE(data.count(), recordCount);
+    QCOMPARE(loader.loadedRecordCount(), recordCount);
+    QCOMPARE(loader.totalRecordCount(), recordCount);
+    QCOMPARE(recordsLoadedSpy.count(), recordCount);
+    for (int i = 0; i < recordsLoadedSpy.count(); ++i) {
+        QCOMPARE(recordsLoadedSpy.at(i).at(0).toInt(), i);
+        QCOMPARE(recordsLoadedSpy.at(i).at(1).toInt(), 1);
+    }
+    QCOMPARE(data.at(0)->at(0), QVariant(1));
+    QCOMPARE(data.at(0)->at(2), QVariant("Jaroslaw"));
+
+    // records of non-db-aware data can't be loaded
+    KDbTableViewData otherData;
+    KDbTableViewDataLoader otherLoader(&otherData);
+    QVERIFY(!otherLoader.start());
+    QVERIFY(otherLoader.result().isError());
+
+    QVERIFY(conn->deleteCursor(cursor));
+}
+
+void TableViewDataTest::testLoaderCancel()
+{
+    KDbConnection *conn = utils.connection();
+    QVERIFY(conn);
+    KDbQuerySchema query(conn->tableSchema("persons"));
+    KDbCursor *cursor = conn->prepareQuery(&query);
+    QVERIFY(cursor);
+    {
+        KDbTableViewData data(cursor);
+        KDbTableViewDataLoader loader(&data);
+        QSignalSpy finishedSpy(&loader, &KDbTableViewDataLoader::finished);
+        QVERIFY(loader.start());
+        loader.cancel();
+        QVERIFY(loader.isCanceled());
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(finishedSpy.first().first().toBool(), false);
+        QVERIFY(data.isEmpty()); // records fetched after canceling are dropped
+
+        // destroying a running loader is safe
+        KDbTableViewDataLoader *loader2 = new KDbTableViewDataLoader(&data);
+        QVERIFY(loader2->start());
+        delete loader2;
+    }
+    QVERIFY(conn->deleteCursor(cursor));
+}
+
+void TableViewDataTest::testLoaderQueries()
+{
+    KDbConnection *conn = utils.connection();
+    QVERIFY(conn);
+    // query of a table is passed to the worker by table name
+    KDbTableSchema *table = conn->tableSchema("persons");
+    QVERIFY(table);
+    KDbCursor *cursor = conn->prepareQuery(table->query());
+    QVERIFY(cursor);
+    {
+        KDbTableViewData data(cursor);
+        KDbTableViewDataLoader loader(&data);
+        QSignalSpy finishedSpy(&loader, &KDbTableViewDataLoader::finished);
+        QVERIFY(loader.start());
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(finishedSpy.first().first().toBool(), true);
+        QCOMPARE(data.count(), 4);
+    }
+    QVERIFY(conn->deleteCursor(cursor));
+
+    // other queries are passed as statements, with expressions and parameters
+    KDbParser parser(conn);
+    QVERIFY(parser.parse(
+        KDbEscapedString("SELECT id, age + 1 FROM persons WHERE id > [min id] ORDER BY id")));
+    QScopedPointer<KDbQuerySchema> query(parser.query());
+    QVERIFY(query);
+    cursor = conn->prepareQuery(query.data(), QList<QVariant>() << 2);
+    QVERIFY(cursor);
+    {
+        KDbTableViewData data(cursor);
+        KDbTableViewDataLoader loader(&data);
+        QSignalSpy finishedSpy(&loader, &KDbTableViewDataLoader::finished);
+        QVERIFY(loader.start());
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(finishedSpy.first().first().toBool(), true);
+        QVERIFY(!loader.result().isError());
+        QCOMPARE(loader.totalRecordCount(), 2);
+        QCOMPARE(columnValues(&data, 0), QList<QVariant>({ 3, 4 }));
+        QCOMPARE(columnValues(&data, 1), QList<QVariant>({ 46, 36 }));
+    }
+    QVERIFY(conn->deleteCursor(cursor));
+}
+
+void TableViewDataTest::testLoaderLookupColumns()
+{
+    KDbConnection *conn = utils.connection();
+    QVERIFY(conn);
+    // stored lookup field schema is also known to the connection of the worker
+    KDbTableSchema *table = conn->tableSchema("cars");
+    QVERIFY(table);
+    KDbLookupFieldSchema *lookup = new KDbLookupFieldSchema;
+    KDbLookupFieldSchemaRecordSource recordSource;
+    recordSource.setType(KDbLookupFieldSchemaRecordSource::Type::Table);
+    recordSource.setName(QLatin1String("persons"));
+    lookup->setRecordSource(recordSource);
+    lookup->setBoundColumn(0);
+    lookup->setVisibleColumns(QList<int>() << 2);
+    QVERIFY(table->setLookupFieldSchema(QLatin1String("owner"), lookup));
+    KDB_VERIFY(conn, conn->storeExtendedTableSchemaData(table), "Failed to store lookup field");
+
+    KDbParser parser(conn);
+    QVERIFY(parser.parse(
+        KDbEscapedString("SELECT id, owner, model FROM cars WHERE id > [min id] ORDER BY id")));
+    QScopedPointer<KDbQuerySchema> query(parser.query());
+    QVERIFY(query);
+    KDbCursor *cursor = conn->prepareQuery(query.data(), QList<QVariant>() << 3);
+    QVERIFY(cursor);
+    {
+        KDbTableViewData data(cursor);
+        KDbTableViewDataLoader loader(&data);
+        QSignalSpy finishedSpy(&loader, &KDbTableViewDataLoader::finished);
+        QVERIFY(loader.start());
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(finishedSpy.first().first().toBool(), true);
+        QVERIFY(!loader.result().isError());
+        QCOMPARE(loader.totalRecordCount(), 2);
+        // the visible lookup column follows the columns of the query, nothing is shifted
+        QCOMPARE(columnValues(&data, 0), QList<QVariant>({ 4, 5 }));
+        QCOMPARE(columnValues(&data, 1), QList<QVariant>({ 3, 4 }));
+        QCOMPARE(columnValues(&data, 2), QList<QVariant>({ "BMW", "Volvo" }));
+        QCOMPARE(columnValues(&data, 3), QList<QVariant>({ "Bill", "John" }));
+    }
+    QVERIFY(conn->deleteCursor(cursor));
+
+    QVERIFY(table->setLookupFieldSchema(QLatin1String("owner"), nullptr));
+    KDB_VERIFY(conn, conn->storeExtendedTableSchemaData(table), "Failed to remove lookup field");
+}
+
+void TableViewDataTest::cleanupTestCase()
+{
+    if (utils.connection()) {
+        QVERIFY(utils.testDisconnectAndDropDb());
+    }
+}
@@ -0,0 +1,62 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDBTABLEVIEWDATATEST_H
+#define KDBTABLEVIEWDATATEST_H
+
+#include "KDbTestUtils.h"
+
+class TableViewDataTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    //! Test sorting by integer column in both orders, with NULL values
+    void testSortIntegers();
+
+    //! Test sorting by text column
+    void testSortText();
+
+    //! Test sorting of data large enough to be sorted by multiple threads, and its stability
+    void testSortLargeData();
+
+    //! Test sorting by multiple columns defined by KDbOrderByColumnList
+    void testSortMultipleColumns();
+
+    //! Test keeping the order after inserting and changing records
+    void testSortingMaintained();
+
+    //! Test loading records in background using KDbTableViewDataLoader
+    void testLoader();
+
+    //! Test canceling of KDbTableViewDataLoader
+    void testLoaderCancel();
+
+    //! Test loading records of a table query and of a parsed query with parameters
+    void testLoaderQueries();
+
+    //! Test loading records of a query with a lookup field, including the visible lookup column
+    void testLoaderLookupColumns();
+
+    void cleanupTestCase();
+
+private:
+    KDbTestUtils utils;
+};
+
+#endif
@@ -0,0 +1,256 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbBenchmarks.h"
+
+#include <KDbNativeStatementBuilder>
+#include <KDbParser>
+#include <KDbPreparedStatement>
+#include <KDbQuerySchema>
+#include <KDbRecordData>
+#include <KDbTableViewData>
+#include <KDbTransactionGuard>
+
+#include <QTest>
+
+QTEST_GUILESS_MAIN(KDbBenchmarks)
+
+//! Number of records generated for the benchmark table
+static const int recordCount = 10000;
+
+//! Number of records inserted in a single iteration of insert benchmarks
+static const int insertCount = 100;
+
+//! @return deterministic pseudo-random number for @a seed, so results are comparable between runs
+static int pseudoRandom(int seed)
+{
+    return int((quint32(seed) * 1103515245u + 12345u) % 0x7fffffffu);
+}
+
+//! @return generated text value for @a seed
+static QString generatedText(int seed)
+{
+    static const char *const words[] = { "lorem", "ipsum", "dolor", "sit", "amet", "consectetur",
+                                         "adipiscing", "elit", "sed", "do", "eiusmod", "tempor" };
+    const int wordCount = sizeof(words) / sizeof(words[0]);
+    QString text;
+    for (int i = 0; i < 4; ++i) {
+        if (i > 0) {
+            text += QLatin1Char(' ');
+        }
+        text += QLatin1String(words[pseudoRandom(seed + i) % wordCount]);
+    }
+    return text;
+}
+
+//! @return generated values of a record of the "benchmark" table for @a seed
+static QList<QVariant> generatedRecord(int id, int seed)
+{
+    return QList<QVariant>() << id << generatedText(seed) << pseudoRandom(seed) % 100000
+                             << double(pseudoRandom(seed + 1) % 10000) / 100.0;
+}
+
+void KDbBenchmarks::initTestCase()
+{
+    QVERIFY(utils.testCreateDbWithTables("KDbBenchmarks"));
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *table = new KDbTableSchema(QLatin1String("benchmark"));
+    KDbField *f = new KDbField(QLatin1String("id"), KDbField::Integer);
+    f->setPrimaryKey(true);
+    QVERIFY(table->addField(f));
+    QVERIFY(table->addField(new KDbField(QLatin1String("name"), KDbField::Text)));
+    QVERIFY(table->addField(new KDbField(QLatin1String("amount"), KDbField::Integer)));
+    QVERIFY(table->addField(new KDbField(QLatin1String("price"), KDbField::Double)));
+    KDB_VERIFY(conn, conn->createTable(table), "Failed to create table");
+
+    QList<QList<QVariant>> records;
+    for (int i = 0; i < recordCount; ++i) {
+        records.append(generatedRecord(i + 1, i));
+    }
+    KDB_VERIFY(conn, conn->insertRecords(table, records), "Failed to insert records");
+}
+
+void KDbBenchmarks::benchmarkCursorIteration()
+{
+    KDbConnection *conn = utils.connection();
+    int count = 0;
+    QBENCHMARK {
+        KDbCursor *cursor = conn->executeQuery(KDbEscapedString("SELECT * FROM benchmark"));
+        QVERIFY(cursor);
+        count = 0;
+        for (cursor->moveFirst(); !cursor->eof(); cursor->moveNext()) {
+            ++count;
+        }
+        QVERIFY(conn->deleteCursor(cursor));
+    }
+    QCOMPARE(count, recordCount);
+}
+
+void KDbBenchmarks::benchmarkStoreCurrentRecord()
+{
+    KDbConnection *conn = utils.connection();
+    int count = 0;
+    QBENCHMARK {
+        KDbCursor *cursor = conn->executeQuery(KDbEscapedString("SELECT * FROM benchmark"));
+        QVERIFY(cursor);
+        count = 0;
+        KDbRecordData data;
+        for (cursor->moveFirst(); !cursor->eof(); cursor->moveNext()) {
+            QVERIFY(cursor->storeCurrentRecord(&data));
+            ++count;
+        }
+        QVERIFY(conn->deleteCursor(cursor));
+    }
+    QCOMPARE(count, recordCount);
+}
+
+void KDbBenchmarks::benchmarkInsertRecord()
+{
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *table = conn->tableSchema(QLatin1String("benchmark"));
+    QVERIFY(table);
+    // inserted records are rolled back so the table stays the same for other benchmarks
+    KDbTransactionGuard guard(conn);
+    int id = recordCount;
+    QBENCHMARK {
+        for (int i = 0; i < insertCount; ++i) {
+            ++id;
+            QVERIFY(conn->insertRecord(table, generatedRecord(id, id)));
+        }
+    }
+    QVERIFY(guard.rollback());
+}
+
+void KDbBenchmarks::benchmarkPreparedStatement()
+{
+    KDbConnection *conn = utils.connection();
+    KDbTableSchema *table = conn->tableSchema(QLatin1String("benchmark"));
+    QVERIFY(table);
+    KDbPreparedStatement statement(conn->prepareStatement(KDbPreparedStatement::InsertStatement,
+                                                          table));
+    QVERIFY(statement.isValid());
+    KDbTransactionGuard guard(conn);
+    int id = recordCount;
+    QBENCHMARK {
+        for (int i = 0; i < insertCount; ++i) {
+            ++id;
+            QVERIFY(statement.execute(generatedRecord(id, id)));
+        }
+    }
+    QVERIFY(guard.rollback());
+}
+
+void KDbBenchmarks::benchmarkGenerateSelectStatement()
+{
+    KDbConnection *conn = utils.connection();
+    KDbParser parser(conn);
+    QVERIFY(parser.parse(KDbEscapedString("SELECT id, name, amount * price FROM benchmark "
+                                          "WHERE amount > 100 AND name LIKE 'lorem%' "
+                                          "ORDER BY name, id DESC")));
+    QScopedPointer<KDbQuerySchema> query(parser.query());
+    QVERIFY(query);
+    KDbEscapedString sql;
+    QBENCHMARK {
+        QVERIFY(utils.driverBuilder()->generateSelectStatement(&sql, query.data()));
+    }
+    QVERIFY(!sql.isEmpty());
+}
+
+void KDbBenchmarks::benchmarkParse_data()
+{
+    QTest::addColumn<QString>("sql");
+    QTest::newRow("simple") << "SELECT * FROM benchmark";
+    QTest::newRow("expressions")
+        << "SELECT id, name, amount * price AS total FROM benchmark "
+           "WHERE amount > 100 AND (price < 10.5 OR name LIKE 'lorem%') ORDER BY total DESC";
+    QTest::newRow("join")
+        << "SELECT b.id, p.name FROM benchmark b, persons p WHERE b.id = p.id ORDER BY 2";
+}
+
+void KDbBenchmarks::benchmarkParse()
+{
+    QFETCH(QString, sql);
+    KDbParser parser(utils.connection());
+    const KDbEscapedString statement(sql);
+    QBENCHMARK {
+        QVERIFY(parser.parse(statement));
+        delete parser.query();
+    }
+}
+
+void KDbBenchmarks::benchmarkEscapeString()
+{
+    QString text;
+    for (int i = 0; i < 100; ++i) {
+        text += generatedText(i) + QLatin1String("'s \"quoted\"\ttext\\\n");
+    }
+    QString escaped;
+    QBENCHMARK {
+        escaped = KDb::escapeString(text);
+    }
+    QVERIFY(escaped.length() > text.length());
+}
+
+void KDbBenchmarks::benchmarkEscapeBLOB_data()
+{
+    QTest::addColumn<KDb::BLOBEscapingType>("type");
+    QTest::newRow("XHex") << KDb::BLOBEscapingType::XHex;
+    QTest::newRow("ZeroXHex") << KDb::BLOBEscapingType::ZeroXHex;
+    QTest::newRow("Hex") << KDb::BLOBEscapingType::Hex;
+    QTest::newRow("Octal") << KDb::BLOBEscapingType::Octal;
+    QTest::newRow("ByteaHex") << KDb::BLOBEscapingType::ByteaHex;
+}
+
+void KDbBenchmarks::benchmarkEscapeBLOB()
+{
+    QFETCH(KDb::BLOBEscapingType, type);
+    QByteArray array(64 * 1024, '\0');
+    for (int i = 0; i < array.size(); ++i) {
+        array[i] = char(pseudoRandom(i) % 256);
+    }
+    QString escaped;
+    QBENCHMARK {
+        escaped = KDb::escapeBLOB(array, type);
+    }
+    QVERIFY(!escaped.isEmpty());
+}
+
+void KDbBenchmarks::benchmarkTableViewDataSort()
+{
+    QList<QVariant> keys;
+    QList<QVariant> values;
+    for (int i = 0; i < recordCount; ++i) {
+        keys.append(pseudoRandom(i));
+        values.append(generatedText(i));
+    }
+    KDbTableViewData data(keys, values, KDbField::Integer, KDbField::Text);
+    QCOMPARE(data.count(), recordCount);
+    int column = 0;
+    QBENCHMARK {
+        // sort by the other column each time so the records are never already sorted
+        column = 1 - column;
+        data.setSorting(column);
+        data.sort();
+    }
+}
+
+void KDbBenchmarks::cleanupTestCase()
+{
+    QVERIFY(utils.testDisconnectAndDropDb());
+}
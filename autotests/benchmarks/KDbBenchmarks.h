@@ -0,0 +1,59 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_BENCHMARKS_H
+#define KDB_BENCHMARKS_H
+
+#include "KDbTestUtils.h"
+
+//! Benchmarks of KDb hot paths using a SQLite database with generated data
+/*! Results can be stored in machine-readable form using options of QTest,
+ e.g. "kdb_benchmarks -o results.xml,xml" or "kdb_benchmarks -csv". */
+class KDbBenchmarks : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    //! Iterating over all records of a cursor
+    void benchmarkCursorIteration();
+    //! Iterating over all records of a cursor and storing them using KDbCursor::storeCurrentRecord()
+    void benchmarkStoreCurrentRecord();
+    //! KDbConnection::insertRecord() executed within a transaction
+    void benchmarkInsertRecord();
+    //! Inserting records using KDbPreparedStatement
+    void benchmarkPreparedStatement();
+    //! KDbNativeStatementBuilder::generateSelectStatement() for a query with condition and sorting
+    void benchmarkGenerateSelectStatement();
+    void benchmarkParse_data();
+    //! KDbParser::parse() for a few typical statements
+    void benchmarkParse();
+    //! KDb::escapeString() for text with characters that need escaping
+    void benchmarkEscapeString();
+    void benchmarkEscapeBLOB_data();
+    //! KDb::escapeBLOB() for all escaping types
+    void benchmarkEscapeBLOB();
+    //! KDbTableViewData::sort() by integer and text column
+    void benchmarkTableViewDataSort();
+    void cleanupTestCase();
+
+private:
+    KDbTestUtils utils;
+};
+
+#endif
@@ -0,0 +1,66 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "PostgresqlPlaceholdersTest.h"
+#include "PostgresqlPlaceholders.h"
+
+#include <QTest>
+
+QTEST_GUILESS_MAIN(PostgresqlPlaceholdersTest)
+
+void PostgresqlPlaceholdersTest::testPlaceholders_data()
+{
+    QTest::addColumn<QByteArray>("sql");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("empty") << QByteArray() << QByteArray();
+    QTest::newRow("no placeholders") << QByteArray("SELECT 1") << QByteArray("SELECT 1");
+    QTest::newRow("placeholders")
+        << QByteArray("INSERT INTO t VALUES (?,?, ?)")
+        << QByteArray("INSERT INTO t VALUES ($1,$2, $3)");
+    QTest::newRow("string")
+        << QByteArray("SELECT '?' FROM t WHERE a = ?")
+        << QByteArray("SELECT '?' FROM t WHERE a = $1");
+    QTest::newRow("identifier")
+        << QByteArray("SELECT \"a?\" FROM t WHERE \"b\" = ?")
+        << QByteArray("SELECT \"a?\" FROM t WHERE \"b\" = $1");
+    QTest::newRow("doubled quotes")
+        << QByteArray("SELECT 'it''s ?', \"a\"\"?\" FROM t WHERE a = ?")
+        << QByteArray("SELECT 'it''s ?', \"a\"\"?\" FROM t WHERE a = $1");
+    QTest::newRow("escape string") // as produced by PostgresqlDriver::escapeString()
+        << QByteArray("SELECT E'it\\'s ?', ? FROM t WHERE a = E'\\\\' AND b = ?")
+        << QByteArray("SELECT E'it\\'s ?', $1 FROM t WHERE a = E'\\\\' AND b = $2");
+    QTest::newRow("lowercase escape string")
+        << QByteArray("SELECT e'\\'?', ?")
+        << QByteArray("SELECT e'\\'?', $1");
+    QTest::newRow("backslash in standard string")
+        << QByteArray("SELECT 'a\\', ?")
+        << QByteArray("SELECT 'a\\', $1");
+    QTest::newRow("identifier ending with E")
+        << QByteArray("SELECT some'a\\', ?")
+        << QByteArray("SELECT some'a\\', $1");
+    QTest::newRow("unterminated string") << QByteArray("SELECT '?") << QByteArray("SELECT '?");
+}
+
+void PostgresqlPlaceholdersTest::testPlaceholders()
+{
+    QFETCH(QByteArray, sql);
+    QFETCH(QByteArray, expected);
+    QCOMPARE(postgresqlPlaceholders(KDbEscapedString(sql)), expected);
+}
@@ -26,6 +26,8 @@
 #include <KDbQuerySchema>
 #include <KDbToken>
 
+#include <QThread>
+
 Q_DECLARE_METATYPE(KDbEscapedString)
 
 QTEST_GUILESS_MAIN(SqlParserTest)
@@ -345,6 +347,63 @@ void SqlParserTest::testTokens()
     //! @todo add extra tokens: BETWEEN_AND, NOT_BETWEEN_AND
 }
 
+namespace {
+//! Parses valid and invalid statements in a loop using own parser object
+class ParserThread : public QThread
+{
+public:
+    ParserThread(KDbConnection *conn, const KDbEscapedString &invalidSql, int errorPosition)
+        : m_conn(conn), m_invalidSql(invalidSql), m_errorPosition(errorPosition) {}
+
+    void run() override {
+        KDbParser parser(m_conn);
+        const KDbEscapedString validSql("SELECT 1 + 2 AS a, 'abc' || 'def' AS b");
+        for (int i = 0; i < 500; ++i) {
+            if (!parser.parse(validSql)) {
+                return;
+            }
+            QScopedPointer<KDbQuerySchema> query(parser.query());
+            if (!query || query->fieldCount() != 2) {
+                return;
+            }
+            if (parser.parse(m_invalidSql) || parser.error().position() != m_errorPosition) {
+                return;
+            }
+        }
+        ok = true;
+    }
+
+    bool ok = false;
+
+private:
+    KDbConnection * const m_conn;
+    const KDbEscapedString m_invalidSql;
+    const int m_errorPosition;
+};
+}
+
+void SqlParserTest::testParseInThreads()
+{
+    // the same error position is expected in every thread
+    const KDbEscapedString invalidSql("SELECT 1 +");
+    QVERIFY(!m_parser->parse(invalidSql));
+    const int errorPosition = m_parser->error().position();
+    QVERIFY(errorPosition > 0);
+
+    QList<ParserThread*> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.append(new ParserThread(m_utils.connection(), invalidSql, errorPosition));
+    }
+    for (ParserThread *thread : threads) {
+        thread->start();
+    }
+    for (ParserThread *thread : threads) {
+        QVERIFY(thread->wait());
+        QVERIFY(thread->ok);
+    }
+    qDeleteAll(threads);
+}
+
 void SqlParserTest::cleanupTestCase()
 {
     QVERIFY(m_utils.testDisconnect());
@@ -36,6 +36,8 @@ private Q_SLOTS:
     void testParse();
     //! Tests a few tokens, they should have certain values, needed for maintaining BC
     void testTokens();
+    //! Tests parsing with separate parser objects in parallel threads
+    void testParseInThreads();
     void cleanupTestCase();
 
 private:
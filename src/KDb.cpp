@@ -49,6 +49,7 @@
 #include <QThread>
 #include <QProgressDialog>
 #include <QDomNode>
+#include <QXmlStreamReader>
 #include <QApplication>
 #include <QDir>
 #include <QProcess>
@@ -1120,9 +1121,10 @@ QString KDb::loadStringPropertyValueFromDom(const QDomNode& node, bool* ok)
     return QDomNode(node).toElement().text();
 }
 
-QVariant KDb::loadPropertyValueFromDom(const QDomNode& node, bool* ok)
+//! @internal @return property value of type @a valueType stored as @a text
+//! Used by loadPropertyValueFromDom() and loadPropertyValueFromXml().
+static QVariant propertyValueFromText(const QByteArray &valueType, const QString &text, bool *ok)
 {
-    QByteArray valueType = node.nodeName().toLatin1();
     if (valueType.isEmpty()) {
         if (ok)
             *ok = false;
@@ -1130,7 +1132,6 @@ QVariant KDb::loadPropertyValueFromDom(const QDomNode& node, bool* ok)
     }
     if (ok)
         *ok = true;
-    const QString text(QDomNode(node).toElement().text());
     bool _ok;
     if (valueType == "string") {
         return text;
@@ -1166,6 +1167,22 @@ QVariant KDb::loadPropertyValueFromDom(const QDomNode& node, bool* ok)
     return QVariant();
 }
 
+QVariant KDb::loadPropertyValueFromDom(const QDomNode& node, bool* ok)
+{
+    return propertyValueFromText(node.nodeName().toLatin1(), QDomNode(node).toElement().text(), ok);
+}
+
+QVariant KDb::loadPropertyValueFromXml(QXmlStreamReader *reader, bool *ok)
+{
+    if (!reader || !reader->isStartElement()) {
+        if (ok)
+            *ok = false;
+        return QVariant();
+    }
+    const QByteArray valueType(reader->name().toLatin1());
+    return propertyValueFromText(valueType, reader->readElementText(QXmlStreamReader::IncludeChildElements), ok);
+}
+
 QDomElement KDb::saveNumberElementToDom(QDomDocument *doc, QDomElement *parentEl,
         const QString& elementName, int value)
 {
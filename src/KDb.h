@@ -28,6 +28,7 @@
 class QDomNode;
 class QDomElement;
 class QDomDocument;
+class QXmlStreamReader;
 
 class KDbConnection;
 class KDbConnectionData;
@@ -367,6 +368,12 @@ KDB_EXPORT bool setFieldProperty(KDbField *field, const QByteArray &propertyName
  Validity of the returned value can be checked using the @a ok parameter and QVariant::type(). */
 KDB_EXPORT QVariant loadPropertyValueFromDom(const QDomNode& node, bool *ok);
 
+/*! Like loadPropertyValueFromDom() but loads the value from the current element of @a reader.
+ The element is read completely, so @a reader is then positioned at its end element.
+ For invalid values null QVariant is returned.
+ @since 3.2 */
+KDB_EXPORT QVariant loadPropertyValueFromXml(QXmlStreamReader *reader, bool *ok);
+
 /*! Convenience version of loadPropertyValueFromDom(). @return int value. */
 KDB_EXPORT int loadIntPropertyValueFromDom(const QDomNode& node, bool* ok);
 
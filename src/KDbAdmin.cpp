@@ -25,6 +25,7 @@ class Q_DECL_HIDDEN KDbAdminTools::Private
 public:
     Private() {}
     ~Private() {}
+    ProgressFunction progressFunction;
 private:
     Q_DISABLE_COPY(Private)
 };
@@ -46,3 +47,13 @@ bool KDbAdminTools::vacuum(const KDbConnectionData& data, const QString& databas
     clearResult();
     return false;
 }
+
+void KDbAdminTools::setProgressFunction(const ProgressFunction &function)
+{
+    d->progressFunction = function;
+}
+
+KDbAdminTools::ProgressFunction KDbAdminTools::progressFunction() const
+{
+    return d->progressFunction;
+}
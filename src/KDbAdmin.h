@@ -22,6 +22,8 @@
 
 #include "KDbResult.h"
 
+#include <functional>
+
 class KDbConnectionData;
 
 //! @short An interface containing a set of tools for database administration
@@ -39,10 +41,26 @@ public:
 
      Currently it is implemented for SQLite drivers.
 
-     @return true on success, false on failure
+     Progress is reported using the function set by setProgressFunction().
+
+     @return true on success or if the operation has been cancelled, false on failure
      (then you can get error status from the KDbAdminTools object). */
     virtual bool vacuum(const KDbConnectionData& data, const QString& databaseName);
 
+    /*! Function receiving progress of operations such as vacuum() in percent, from 0 to 100.
+     If the function returns false, the operation is cancelled.
+     @since 3.2 */
+    typedef std::function<bool(int percent)> ProgressFunction;
+
+    /*! Sets function receiving progress of operations such as vacuum().
+     The function is called in the thread that performs the operation.
+     @since 3.2 */
+    void setProgressFunction(const ProgressFunction &function);
+
+    //! @return function set by setProgressFunction()
+    //! @since 3.2
+    ProgressFunction progressFunction() const;
+
 private:
     Q_DISABLE_COPY(KDbAdminTools)
     class Private;
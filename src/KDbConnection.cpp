@@ -27,6 +27,7 @@
 #include "KDbNativeStatementBuilder.h"
 #include "KDbQuerySchema.h"
 #include "KDbQuerySchema_p.h"
+#include "KDbRecordBatch.h"
 #include "KDbRecordData.h"
 #include "KDbRecordEditBuffer.h"
 #include "KDbRelationship.h"
@@ -40,7 +41,8 @@
 
 #include <QDir>
 #include <QFileInfo>
-#include <QDomDocument>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 
 /*! Version number of extended table schema.
 
@@ -72,7 +74,7 @@ public:
     Private(const Private &other) {
         copy(other);
     }
-#define KDbConnectionOptionsPrivateArgs(o) std::tie(o.connection)
+#define KDbConnectionOptionsPrivateArgs(o) std::tie(o.connection, o.readOnlyOptions)
     void copy(const Private &other) {
         KDbConnectionOptionsPrivateArgs((*this)) = KDbConnectionOptionsPrivateArgs(other);
     }
@@ -80,12 +82,17 @@ public:
         return KDbConnectionOptionsPrivateArgs((*this)) == KDbConnectionOptionsPrivateArgs(other);
     }
     KDbConnection *connection;
+    QSet<QByteArray> readOnlyOptions;
 };
 
 KDbConnectionOptions::KDbConnectionOptions()
  : d(new Private)
 {
     KDbUtils::PropertySet::insert("readOnly", false, tr("Read only", "Read only connection"));
+    KDbUtils::PropertySet::insert("tableSchemaPreloading", QLatin1String("none"),
+                                  tr("Preloading of table schemas"));
+    KDbUtils::PropertySet::insert("queryResultCacheSize", qint64(0),
+                                  tr("Size of query result cache"));
 }
 
 KDbConnectionOptions::KDbConnectionOptions(const KDbConnectionOptions &other)
@@ -125,6 +132,9 @@ void KDbConnectionOptions::insert(const QByteArray &name, const QVariant &value,
         setReadOnly(value.toBool());
         return;
     }
+    if (d->readOnlyOptions.contains(name)) {
+        return;
+    }
     QString realCaption;
     if (property(name).caption().isEmpty()) { // don't allow to change the caption
         realCaption = caption;
@@ -146,17 +156,32 @@ void KDbConnectionOptions::setValue(const QByteArray &name, const QVariant &valu
         setReadOnly(value.toBool());
         return;
     }
+    if (d->readOnlyOptions.contains(name)) {
+        return;
+    }
     KDbUtils::PropertySet::setValue(name, value);
 }
 
 void KDbConnectionOptions::remove(const QByteArray &name)
 {
-    if (name == "readOnly") {
+    if (name == "readOnly" || d->readOnlyOptions.contains(name)) {
         return;
     }
     KDbUtils::PropertySet::remove(name);
 }
 
+bool KDbConnectionOptions::isReadOnlyOption(const QByteArray &name) const
+{
+    return d->readOnlyOptions.contains(name);
+}
+
+void KDbConnectionOptions::setReadOnlyOption(const QByteArray &name, const QVariant &value,
+                                             const QString &caption)
+{
+    d->readOnlyOptions.insert(name);
+    KDbUtils::PropertySet::insert(name, value, caption);
+}
+
 void KDbConnectionOptions::setReadOnly(bool set)
 {
     if (d->connection && d->connection->isConnected()) {
@@ -165,6 +190,44 @@ void KDbConnectionOptions::setReadOnly(bool set)
     KDbUtils::PropertySet::setValue("readOnly", set);
 }
 
+KDbConnectionOptions::TableSchemaPreloading KDbConnectionOptions::tableSchemaPreloading() const
+{
+    const QString mode(property("tableSchemaPreloading").value().toString());
+    if (mode == QLatin1String("lazy")) {
+        return TableSchemaPreloading::Lazy;
+    }
+    if (mode == QLatin1String("eager")) {
+        return TableSchemaPreloading::Eager;
+    }
+    return TableSchemaPreloading::None;
+}
+
+void KDbConnectionOptions::setTableSchemaPreloading(TableSchemaPreloading mode)
+{
+    QString value;
+    switch (mode) {
+    case TableSchemaPreloading::Lazy:
+        value = QLatin1String("lazy");
+        break;
+    case TableSchemaPreloading::Eager:
+        value = QLatin1String("eager");
+        break;
+    default:
+        value = QLatin1String("none");
+    }
+    KDbUtils::PropertySet::setValue("tableSchemaPreloading", value);
+}
+
+qint64 KDbConnectionOptions::queryResultCacheSize() const
+{
+    return qMax(qint64(0), property("queryResultCacheSize").value().toLongLong());
+}
+
+void KDbConnectionOptions::setQueryResultCacheSize(qint64 bytes)
+{
+    KDbUtils::PropertySet::setValue("queryResultCacheSize", qMax(qint64(0), bytes));
+}
+
 void KDbConnectionOptions::setConnection(KDbConnection *connection)
 {
     d->connection = connection;
@@ -188,6 +251,9 @@ KDbConnectionPrivate::~KDbConnectionPrivate()
     options.setConnection(nullptr);
     deleteAllCursors();
     delete m_parser;
+    clearRecordStatements();
+    clearParsedQueries();
+    clearPreloadedTableSchemas();
     qDeleteAll(tableSchemaChangeListeners);
     qDeleteAll(obsoleteQueries);
 }
@@ -280,6 +346,8 @@ void KDbConnectionPrivate::removeTable(int id)
         return;
     }
     KDbTableSchemaChangeListener::unregisterForChanges(conn, toDelete.data());
+    removeRecordStatements(toDelete.data());
+    clearParsedQueries();
     const int count = m_tablesByName.remove(toDelete->name());
     Q_ASSERT_X(count == 1, "KDbConnectionPrivate::removeTable", "Table to remove not found");
 }
@@ -291,11 +359,15 @@ void KDbConnectionPrivate::takeTable(KDbTableSchema* tableSchema)
     }
     m_tables.take(tableSchema->id());
     m_tablesByName.take(tableSchema->name());
+    removeRecordStatements(tableSchema);
+    clearParsedQueries();
 }
 
 void KDbConnectionPrivate::renameTable(KDbTableSchema* tableSchema, const QString& newName)
 {
     m_tablesByName.take(tableSchema->name());
+    removeRecordStatements(tableSchema); // the statements contain the old name
+    clearParsedQueries();
     tableSchema->setName(newName);
     m_tablesByName.insert(tableSchema->name(), tableSchema);
 }
@@ -304,10 +376,14 @@ void KDbConnectionPrivate::changeTableId(KDbTableSchema* tableSchema, int newId)
 {
     m_tables.take(tableSchema->id());
     m_tables.insert(newId, tableSchema);
+    clearParsedQueries();
 }
 
 void KDbConnectionPrivate::clearTables()
 {
+    clearRecordStatements();
+    clearParsedQueries();
+    clearPreloadedTableSchemas();
     m_tablesByName.clear();
     qDeleteAll(m_internalKDbTables);
     m_internalKDbTables.clear();
@@ -397,6 +473,131 @@ KDbTableSchema* KDbConnectionPrivate::setupTableSchema(KDbTableSchema *table)
     return newTable.take();
 }
 
+//! @internal Appends all records returned by @a sql to @a records
+static bool loadRecords(KDbConnection *conn, const KDbEscapedString &sql, QList<KDbRecordData*> *records)
+{
+    KDbCursor *cursor = conn->executeQuery(sql);
+    if (!cursor) {
+        return false;
+    }
+    bool ok = cursor->moveFirst() || (!cursor->result().isError() && cursor->eof());
+    while (ok && !cursor->eof()) {
+        QScopedPointer<KDbRecordData> data(new KDbRecordData);
+        if (!cursor->storeCurrentRecord(data.data())) {
+            ok = false;
+            break;
+        }
+        records->append(data.take());
+        cursor->moveNext();
+    }
+    if (!conn->deleteCursor(cursor)) {
+        ok = false;
+    }
+    return ok;
+}
+
+bool KDbConnectionPrivate::preloadTableSchemas(bool eager)
+{
+    clearPreloadedTableSchemas();
+    QList<KDbRecordData*> objects;
+    QList<KDbRecordData*> fields;
+    QList<KDbRecordData*> extendedSchemas;
+    bool ok = loadRecords(conn, KDbEscapedString("SELECT o_id, o_type, o_name, o_caption, o_desc "
+                                                 "FROM kexi__objects WHERE o_type=%1")
+                                    .arg(driver->valueToSql(KDbField::Integer, KDb::TableObjectType)),
+                          &objects)
+        && loadRecords(conn, KDbEscapedString("SELECT t_id, f_type, f_name, f_length, f_precision, "
+                                              "f_constraints, f_options, f_default, f_order, "
+                                              "f_caption, f_help FROM kexi__fields "
+                                              "ORDER BY t_id, f_order"),
+                       &fields)
+        && loadRecords(conn, KDbEscapedString("SELECT o_id, o_data FROM kexi__objectdata WHERE ")
+                                + KDb::sqlWhere(driver, KDbField::Text, QLatin1String("o_sub_id"),
+                                                QLatin1String("extended_schema")),
+                       &extendedSchemas);
+    if (ok) {
+        for (int i = 0; i < objects.count(); ++i) {
+            const int id = objects.at(i)->at(0).toInt();
+            if (id <= 0 || m_preloadedTables.contains(id)) {
+                continue;
+            }
+            KDbPreloadedTableSchema *table = new KDbPreloadedTableSchema;
+            table->object.reset(objects.at(i));
+            objects[i] = nullptr; // now owned by the table
+            m_preloadedTables.insert(id, table);
+            m_preloadedTableIds.insert(table->object->at(2).toString(), id);
+        }
+        for (KDbRecordData *field : qAsConst(fields)) {
+            KDbPreloadedTableSchema *table = m_preloadedTables.value(field->at(0).toInt());
+            if (table) {
+                table->fields.append(field);
+            } else {
+                delete field;
+            }
+        }
+        fields.clear(); // now owned by the tables
+        for (KDbRecordData *extendedSchema : qAsConst(extendedSchemas)) {
+            KDbPreloadedTableSchema *table = m_preloadedTables.value(extendedSchema->at(0).toInt());
+            if (table) {
+                table->extendedSchema = extendedSchema->at(1).toString();
+            }
+        }
+    }
+    qDeleteAll(objects);
+    qDeleteAll(fields);
+    qDeleteAll(extendedSchemas);
+    if (!ok) {
+        clearPreloadedTableSchemas();
+        return false;
+    }
+    if (eager) {
+        const QList<int> ids(m_preloadedTables.keys());
+        for (int id : ids) {
+            if (!setupPreloadedTableSchema(id)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+KDbTableSchema* KDbConnectionPrivate::setupPreloadedTableSchema(int id)
+{
+    QScopedPointer<KDbPreloadedTableSchema> preloaded(m_preloadedTables.take(id));
+    if (!preloaded) {
+        return nullptr;
+    }
+    m_preloadedTableIds.remove(preloaded->object->at(2).toString());
+    QScopedPointer<KDbTableSchema> newTable(new KDbTableSchema);
+    KDbTableSchema *table = newTable.data();
+    if (!conn->setupObjectData(*preloaded->object, table)) {
+        return nullptr;
+    }
+    if (preloaded->fields.isEmpty()) {
+        conn->m_result = KDbResult(tr("Table has no fields defined."));
+        return nullptr;
+    }
+    for (const KDbRecordData *fieldData : qAsConst(preloaded->fields)) {
+        KDbField *f = conn->setupField(*fieldData);
+        if (!f || !table->addField(f)) {
+            return nullptr;
+        }
+    }
+    if (!conn->loadExtendedTableSchemaData(table, preloaded->extendedSchema)) {
+        return nullptr;
+    }
+    //store locally:
+    insertTable(table);
+    return newTable.take();
+}
+
+void KDbConnectionPrivate::clearPreloadedTableSchemas()
+{
+    qDeleteAll(m_preloadedTables);
+    m_preloadedTables.clear();
+    m_preloadedTableIds.clear();
+}
+
 KDbQuerySchema* KDbConnectionPrivate::setupQuerySchema(KDbQuerySchema *query)
 {
     Q_ASSERT(query);
@@ -410,6 +611,18 @@ KDbQuerySchema* KDbConnectionPrivate::setupQuerySchema(KDbQuerySchema *query)
         return nullptr;
     }
     const QString queryName(query->name());
+    // The exact statement is the key; normalizing it without the scanner could make different
+    // statements equal, e.g. because of white space in [parameter] tokens.
+    const KDbQuerySchema *parsed = parsedQuery(sql);
+    if (parsed) { // parsed before, copy and use properties of the loaded object
+        KDbQuerySchema *copiedQuery = new KDbQuerySchema(*parsed, conn);
+        copiedQuery->setId(query->id());
+        copiedQuery->setName(query->name());
+        copiedQuery->setCaption(query->caption());
+        copiedQuery->setDescription(query->description());
+        insertQuery(copiedQuery);
+        return copiedQuery;
+    }
     if (!parser()->parse(KDbEscapedString(sql), query)) {
         newQuery.take(); // query is destroyed by the parser
         conn->m_result = KDbResult(
@@ -419,10 +632,26 @@ KDbQuerySchema* KDbConnectionPrivate::setupQuerySchema(KDbQuerySchema *query)
                                      .arg(queryName, sql));
         return nullptr;
     }
+    insertParsedQuery(sql, *query);
     insertQuery(query);
     return newQuery.take();
 }
 
+const KDbQuerySchema* KDbConnectionPrivate::parsedQuery(const QString &sql) const
+{
+    return m_parsedQueries.object(sql);
+}
+
+void KDbConnectionPrivate::insertParsedQuery(const QString &sql, const KDbQuerySchema &query)
+{
+    m_parsedQueries.insert(sql, new KDbQuerySchema(query, conn));
+}
+
+void KDbConnectionPrivate::clearParsedQueries()
+{
+    m_parsedQueries.clear();
+}
+
 KDbQuerySchemaFieldsExpanded *KDbConnectionPrivate::fieldsExpanded(const KDbQuerySchema *query)
 {
     return m_fieldsExpandedCache[query];
@@ -439,6 +668,106 @@ void KDbConnectionPrivate::removeFieldsExpanded(const KDbQuerySchema *query)
     m_fieldsExpandedCache.remove(query);
 }
 
+KDbPreparedStatement* KDbConnectionPrivate::recordStatement(KDbPreparedStatement::Type type,
+                                                            KDbTableSchema *table,
+                                                            const KDbFieldList &fields,
+                                                            const KDbField::List &keyFields)
+{
+    QString key(QString::number(type));
+    for (const KDbField *f : *fields.fields()) {
+        key += QLatin1Char(',') + f->name();
+    }
+    key += QLatin1Char(';');
+    QStringList keyFieldNames;
+    for (const KDbField *f : keyFields) {
+        key += f->name() + QLatin1Char(',');
+        keyFieldNames.append(f->name());
+    }
+    QHash<QString, KDbRecordStatement*> &statements = m_recordStatements[table];
+    KDbRecordStatement *recordStatement = statements.value(key);
+    if (recordStatement) {
+        // fields with the same names could have been replaced in the table meanwhile
+        if (*recordStatement->fields.fields() == *fields.fields()
+            && recordStatement->keyFields == keyFields)
+        {
+            return recordStatement->statement.isValid() ? &recordStatement->statement : nullptr;
+        }
+        delete statements.take(key);
+    }
+    recordStatement = new KDbRecordStatement;
+    for (KDbField *f : *fields.fields()) {
+        recordStatement->fields.addField(f);
+    }
+    for (KDbField *f : keyFields) {
+        recordStatement->keyFields.append(f);
+    }
+    // DELETE only needs the table
+    recordStatement->statement = conn->prepareStatement(type,
+        type == KDbPreparedStatement::DeleteStatement ? table : &recordStatement->fields,
+        keyFieldNames);
+    statements.insert(key, recordStatement); // also remember lack of support for prepared statements
+    return recordStatement->statement.isValid() ? &recordStatement->statement : nullptr;
+}
+
+void KDbConnectionPrivate::removeRecordStatements(const KDbTableSchema *table)
+{
+    qDeleteAll(m_recordStatements.take(table));
+}
+
+void KDbConnectionPrivate::clearRecordStatements()
+{
+    for (const QHash<QString, KDbRecordStatement*> &statements : qAsConst(m_recordStatements)) {
+        qDeleteAll(statements);
+    }
+    m_recordStatements.clear();
+}
+
+bool KDbConnectionPrivate::queryResultCacheStatement(KDbEscapedString *statement,
+                                                     KDbCursor **cursor,
+                                                     const KDbEscapedString &sql,
+                                                     KDbQuerySchema *query,
+                                                     const QList<QVariant> *params)
+{
+    *cursor = nullptr;
+    queryResultCache.setMaximumSize(options.queryResultCacheSize());
+    if (!queryResultCache.isEnabled()) {
+        return false;
+    }
+    if (!sql.isEmpty()) {
+        *statement = sql;
+        return true;
+    }
+    if (!query) {
+        return false;
+    }
+    KDbCursor *c = conn->prepareQuery(query, params ? *params : QList<QVariant>());
+    if (!c) {
+        return false;
+    }
+    if (!c->prepareStatement(statement)) {
+        CursorDeleter deleter(c);
+        return false;
+    }
+    *cursor = c;
+    return true;
+}
+
+KDbCursor* KDbConnectionPrivate::executeQuery(KDbCursor *cursor, const KDbEscapedString &sql,
+                                              KDbQuerySchema *query,
+                                              const QList<QVariant> *params)
+{
+    if (!cursor) {
+        return conn->executeQueryInternal(sql, query, params);
+    }
+    conn->clearResult();
+    if (!cursor->open()) {
+        conn->m_result = cursor->result();
+        CursorDeleter deleter(cursor);
+        return nullptr;
+    }
+    return cursor;
+}
+
 //================================================
 
 namespace {
@@ -471,9 +800,16 @@ void KDbConnection::destroy()
 {
     disconnect();
     //do not allow the driver to touch me: I will kill myself.
+    QMutexLocker locker(&d->driver->d->connectionsMutex);
     d->driver->d->connections.remove(this);
 }
 
+void KDbConnection::setReadOnlyOption(const QByteArray &name, const QVariant &value,
+                                      const QString &caption)
+{
+    d->options.setReadOnlyOption(name, value, caption);
+}
+
 KDbConnection::~KDbConnection()
 {
     KDbConnectionPrivate *thisD = d;
@@ -846,6 +1182,17 @@ bool KDbConnection::useDatabase(const QString &dbName, bool kexiCompatible, bool
         d->databaseVersion.setMinor(minor);
     }
     d->usedDatabase = my_dbName;
+
+    const KDbConnectionOptions::TableSchemaPreloading preloading = d->options.tableSchemaPreloading();
+    if (kexiCompatible && preloading != KDbConnectionOptions::TableSchemaPreloading::None) {
+        //-read definitions of all tables at once
+        if (!d->preloadTableSchemas(preloading == KDbConnectionOptions::TableSchemaPreloading::Eager)) {
+            kdbWarning() << "Could not preload table schemas:" << m_result;
+            // not critical, schemas will be loaded on request
+            d->clearPreloadedTableSchemas();
+            clearResult();
+        }
+    }
     return true;
 }
 
@@ -881,6 +1228,7 @@ bool KDbConnection::closeDatabase()
     //delete own schemas
     d->clearTables();
     d->clearQueries();
+    d->queryResultCache.clear();
 
     if (!drv_closeDatabase())
         return false;
@@ -994,7 +1342,8 @@ QStringList KDbConnection::objectNames(int objectType, bool* ok)
                                " ORDER BY o_id").arg(d->driver->valueToSql(KDbField::Integer, objectType));
     }
     QStringList list;
-    const bool success = queryStringListInternal(&sql, &list, nullptr, nullptr, 0, KDb::isIdentifier);
+    const bool success = queryStringListInternal(&sql, &list, nullptr, nullptr, 0, KDb::isIdentifier,
+                                                 QueryRecordOption::Default);
     if (ok) {
         *ok = success;
     }
@@ -1124,6 +1473,8 @@ QSharedPointer<KDbSqlResult> KDbConnection::insertRecordInternal(const QString &
     if (!drv_beforeInsert(tableSchemaName,fields )) {
         return res;
     }
+    // kept current, prepareSql() invalidates it
+    const qint64 recordCount = d->queryResultCache.recordCount(tableSchemaName);
     res = prepareSql(sql);
     if (!res || res->lastResult().isError()) {
         res.clear();
@@ -1141,6 +1492,8 @@ QSharedPointer<KDbSqlResult> KDbConnection::insertRecordInternal(const QString &
     }
     if (res->lastResult().isError()) {
         res.clear();
+    } else if (recordCount >= 0) {
+        d->queryResultCache.setRecordCount(tableSchemaName, recordCount + 1);
     }
     return res;
 }
@@ -1265,6 +1618,242 @@ QSharedPointer<KDbSqlResult> KDbConnection::insertRecord(KDbFieldList *fields,
     return res;
 }
 
+//! @internal Appends "(value1,value2,...)" for @a values of fields @a flist to @a sql
+static void appendValuesSql(KDbEscapedString *sql, const KDbDriver *driver,
+                            const KDbField::List *flist, const QList<QVariant> &values)
+{
+    *sql += '(';
+    int i = 0;
+    for (KDbField *f : *flist) {
+        if (i > 0) {
+            *sql += ',';
+        }
+        *sql += driver->valueToSql(f, i < values.count() ? values.at(i) : QVariant());
+        ++i;
+    }
+    *sql += ')';
+}
+
+bool KDbConnection::insertRecords(KDbFieldList *fields, const QList<QList<QVariant>> &records)
+{
+    clearResult();
+    if (!fields || fields->fieldCount() == 0 || !fields->field(0)->table()) {
+        m_result = KDbResult(ERR_OTHER, tr("No table fields specified for inserting records."));
+        return false;
+    }
+    if (!checkIsDatabaseUsed()) {
+        return false;
+    }
+    if (records.isEmpty()) {
+        return true;
+    }
+    const QString tableName(fields->field(0)->table()->name());
+    const qint64 recordCount = d->queryResultCache.recordCount(tableName);
+    d->queryResultCache.invalidate(tableName);
+    KDbTransactionGuard tg;
+    if (!beginAutoCommitTransaction(&tg)) {
+        return false;
+    }
+    if (!drv_beforeInsert(tableName, fields)
+        || !drv_insertRecords(tableName, fields, records)
+        || !drv_afterInsert(tableName, fields))
+    {
+        const KDbResult result(m_result); // keep the original error
+        rollbackAutoCommitTransaction(tg.transaction());
+        m_result = result;
+        return false;
+    }
+    if (!commitAutoCommitTransaction(tg.transaction())) {
+        return false;
+    }
+    if (recordCount >= 0) {
+        d->queryResultCache.setRecordCount(tableName, recordCount + records.count());
+    }
+    return true;
+}
+
+bool KDbConnection::drv_insertRecords(const QString &tableName, KDbFieldList *fields,
+                                      const QList<QList<QVariant>> &records)
+{
+    const KDbField::List *flist = fields->fields();
+    const KDbEscapedString prefix(KDbEscapedString("INSERT INTO ") + escapeIdentifier(tableName)
+                                  + " (" + fields->sqlFieldsList(this) + ") VALUES ");
+    KDbEscapedString sql;
+    for (const QList<QVariant> &values : records) {
+        sql = prefix;
+        appendValuesSql(&sql, d->driver, flist, values);
+        if (!executeSql(sql)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool KDbConnection::insertRecordsUsingMultipleValues(const QString &tableName,
+                                                     KDbFieldList *fields,
+                                                     const QList<QList<QVariant>> &records,
+                                                     int maxStatementLength)
+{
+    const KDbField::List *flist = fields->fields();
+    const KDbEscapedString prefix(KDbEscapedString("INSERT INTO ") + escapeIdentifier(tableName)
+                                  + " (" + fields->sqlFieldsList(this) + ") VALUES ");
+    KDbEscapedString sql;
+    KDbEscapedString valuesSql;
+    for (const QList<QVariant> &values : records) {
+        valuesSql.clear();
+        appendValuesSql(&valuesSql, d->driver, flist, values);
+        if (!sql.isEmpty() && sql.length() + 1 + valuesSql.length() > maxStatementLength) {
+            if (!executeSql(sql)) {
+                return false;
+            }
+            sql.clear();
+        }
+        if (sql.isEmpty()) {
+            sql = prefix;
+        } else {
+            sql += ',';
+        }
+        sql += valuesSql;
+    }
+    return sql.isEmpty() || executeSql(sql);
+}
+
+//! @internal @return new batch for records of @a table or nullptr with error set in @a result
+//! if memory for it could not be allocated
+static KDbRecordBatch* createRecordBatch(const KDbTableSchema &table, int capacity,
+                                         KDbResult *result)
+{
+    QVector<KDbRecordBatch::ColumnType> columnTypes;
+    columnTypes.reserve(table.fieldCount());
+    for (const KDbField *f : *table.fields()) {
+        columnTypes.append(KDbRecordBatch::columnType(*f));
+    }
+    KDbRecordBatch *batch = new KDbRecordBatch(columnTypes, qMax(1, capacity));
+    if (!batch->isValid()) {
+        delete batch;
+        *result = KDbResult(ERR_OTHER, KDbConnection::tr("Could not allocate memory for %1 records.")
+                                       .arg(qMax(1, capacity)));
+        return nullptr;
+    }
+    return batch;
+}
+
+bool KDbConnection::importRecords(KDbTableSchema *table, KDbRecordBatchProducer *producer,
+                                  int batchCapacity)
+{
+    clearResult();
+    if (!table || !producer || table->fieldCount() == 0) {
+        m_result = KDbResult(ERR_OTHER, tr("No table or records specified for importing."));
+        return false;
+    }
+    if (!checkIsDatabaseUsed()) {
+        return false;
+    }
+    QScopedPointer<KDbRecordBatch> batch(createRecordBatch(*table, batchCapacity, &m_result));
+    if (!batch) {
+        return false;
+    }
+    d->queryResultCache.invalidate(table->name());
+    KDbTransactionGuard tg;
+    if (!beginAutoCommitTransaction(&tg)) {
+        return false;
+    }
+    if (!drv_beforeInsert(table->name(), table)
+        || !drv_importRecords(table, producer, batch.data())
+        || !drv_afterInsert(table->name(), table))
+    {
+        if (!m_result.isError()) {
+            m_result = KDbResult(ERR_OTHER, tr("Importing records has been cancelled."));
+        }
+        const KDbResult result(m_result); // keep the original error
+        rollbackAutoCommitTransaction(tg.transaction());
+        m_result = result;
+        return false;
+    }
+    return commitAutoCommitTransaction(tg.transaction());
+}
+
+bool KDbConnection::drv_importRecords(KDbTableSchema *table, KDbRecordBatchProducer *producer,
+                                      KDbRecordBatch *batch)
+{
+    QList<QList<QVariant>> records;
+    QList<QVariant> values;
+    while (true) {
+        batch->clear();
+        if (!producer->produceRecords(batch)) {
+            return false;
+        }
+        if (batch->isEmpty()) {
+            return true;
+        }
+        records.clear();
+        for (int row = 0; row < batch->count(); ++row) {
+            values.clear();
+            for (int col = 0; col < batch->columnCount(); ++col) {
+                values.append(batch->at(row, col));
+            }
+            records.append(values);
+        }
+        if (!drv_insertRecords(table->name(), table, records)) {
+            return false;
+        }
+    }
+}
+
+bool KDbConnection::exportRecords(KDbTableSchema *table, KDbRecordBatchConsumer *consumer,
+                                  int batchCapacity)
+{
+    clearResult();
+    if (!table || !consumer || table->fieldCount() == 0) {
+        m_result = KDbResult(ERR_OTHER, tr("No table or records specified for exporting."));
+        return false;
+    }
+    if (!checkIsDatabaseUsed()) {
+        return false;
+    }
+    QScopedPointer<KDbRecordBatch> batch(createRecordBatch(*table, batchCapacity, &m_result));
+    if (!batch) {
+        return false;
+    }
+    if (!drv_exportRecords(table, consumer, batch.data())) {
+        if (!m_result.isError()) {
+            m_result = KDbResult(ERR_OTHER, tr("Exporting records has been cancelled."));
+        }
+        return false;
+    }
+    return true;
+}
+
+bool KDbConnection::drv_exportRecords(KDbTableSchema *table, KDbRecordBatchConsumer *consumer,
+                                      KDbRecordBatch *batch)
+{
+    KDbCursor *cursor = executeQuery(table);
+    if (!cursor) {
+        return false;
+    }
+    bool ok = true;
+    KDbResult fetchResult;
+    while (ok) {
+        batch->clear();
+        const int count = cursor->fetchBatch(batch);
+        if (count < 0) {
+            fetchResult = cursor->result();
+            ok = false;
+        } else if (count == 0) {
+            break;
+        } else {
+            ok = consumer->consumeRecords(*batch);
+        }
+    }
+    if (!deleteCursor(cursor)) {
+        return false;
+    }
+    if (fetchResult.isError()) {
+        m_result = fetchResult;
+    }
+    return ok;
+}
+
 inline static bool checkSql(const KDbEscapedString& sql, KDbResult* result)
 {
     Q_ASSERT(result);
@@ -1280,6 +1869,7 @@ inline static bool checkSql(const KDbEscapedString& sql, KDbResult* result)
 QSharedPointer<KDbSqlResult> KDbConnection::prepareSql(const KDbEscapedString& sql)
 {
     m_result.setSql(sql);
+    d->queryResultCache.invalidateForStatement(sql);
     return QSharedPointer<KDbSqlResult>(drv_prepareSql(sql));
 }
 
@@ -1289,6 +1879,7 @@ bool KDbConnection::executeSql(const KDbEscapedString& sql)
     if (!checkSql(sql, &m_result)) {
         return false;
     }
+    d->queryResultCache.invalidateForStatement(sql);
     if (!drv_executeSql(sql)) {
         m_result.setMessage(QString()); //clear as this could be most probably just "Unknown error" string.
         m_result.setErrorSql(sql);
@@ -1364,6 +1955,7 @@ bool KDbConnection::storeMainFieldSchema(KDbField *field)
 {
     if (!field || !field->table())
         return false;
+    d->clearParsedQueries(); // queries parsed before could depend on the field
     KDbFieldList *fl = createFieldListForKexi__Fields(d->table(QLatin1String("kexi__fields")));
     if (!fl)
         return false;
@@ -1683,6 +2275,7 @@ tristate KDbConnection::alterTable(KDbTableSchema* tableSchema, KDbTableSchema*
     }
 //! @todo (js) implement real altering
 //! @todo (js) update any structure (e.g. query) that depend on this table!
+    d->queryResultCache.invalidate(tableSchema->name());
     bool ok = true;
     bool empty;
 #if 0 //! @todo uncomment:
@@ -2053,6 +2646,8 @@ bool KDbConnection::rollbackTransaction(const KDbTransaction trans,
     bool ret = true;
     if (!(d->driver->behavior()->features & KDbDriver::IgnoreTransactions))
         ret = drv_rollbackTransaction(t.m_data);
+    // cached results could include changes that have been rolled back
+    d->queryResultCache.invalidateAll();
     if (t.m_data)
         t.m_data->setActive(false); //now this transaction if inactive
     if (!d->dontRemoveTransactions) //true=transaction obj will be later removed from list
@@ -2360,11 +2955,33 @@ tristate KDbConnection::querySingleRecordInternal(KDbRecordData *data, const KDb
         //! @todo does not work with non-SQL data sources
         m_result.setSql(d->driver->addLimitTo1(*sql, options & QueryRecordOption::AddLimitTo1));
     }
-    KDbCursor *cursor = executeQueryInternal(m_result.sql(), query, params);
+    KDbEscapedString cacheStatement;
+    QByteArray cacheKey;
+    KDbCursor *cursor = nullptr;
+    if (!(options & QueryRecordOption::NoResultCache)
+        && d->queryResultCacheStatement(&cacheStatement, &cursor, m_result.sql(), query, params))
+    {
+        cacheKey = KDbQueryResultCache::key(KDbQueryResultCache::Kind::Record, cacheStatement);
+        const KDbQueryResultCache::Entry *entry = d->queryResultCache.find(cacheKey);
+        if (entry) {
+            CursorDeleter deleter(cursor); // not opened, nullptr for raw statements
+            clearResult();
+            m_result.setSql(cacheStatement);
+            if (entry->result == true) {
+                data->resize(entry->values.count());
+                for (int i = 0; i < entry->values.count(); ++i) {
+                    (*data)[i] = entry->values.at(i);
+                }
+            }
+            return entry->result;
+        }
+    }
+    cursor = d->executeQuery(cursor, m_result.sql(), query, params);
     if (!cursor) {
         kdbWarning() << "!querySingleRecordInternal() " << m_result.sql();
         return false;
     }
+    KDbQueryResultCache::Entry *entry = nullptr;
     if (!cursor->moveFirst() || cursor->eof() || !cursor->storeCurrentRecord(data)) {
         const tristate result = cursor->result().isError() ? tristate(false) : tristate(cancelled);
         // kdbDebug() << "!cursor->moveFirst() || cursor->eof() || cursor->storeCurrentRecord(data)
@@ -2372,9 +2989,27 @@ tristate KDbConnection::querySingleRecordInternal(KDbRecordData *data, const KDb
         //          "m_result.sql()=" << m_result.sql();
         m_result = cursor->result();
         deleteCursor(cursor);
+        if (!cacheKey.isEmpty() && ~result) {
+            entry = new KDbQueryResultCache::Entry;
+            entry->result = cancelled;
+            d->queryResultCache.insert(cacheKey, cacheStatement, entry);
+        }
         return result;
     }
-    return deleteCursor(cursor);
+    if (!cacheKey.isEmpty()) {
+        entry = new KDbQueryResultCache::Entry;
+        for (int i = 0; i < data->count(); ++i) {
+            entry->values.append(data->at(i));
+        }
+    }
+    if (!deleteCursor(cursor)) {
+        delete entry;
+        return false;
+    }
+    if (entry) {
+        d->queryResultCache.insert(cacheKey, cacheStatement, entry);
+    }
+    return true;
 }
 
 tristate KDbConnection::querySingleRecord(const KDbEscapedString &sql, KDbRecordData *data,
@@ -2415,7 +3050,26 @@ tristate KDbConnection::querySingleStringInternal(const KDbEscapedString *sql, Q
         //! @todo does not work with non-SQL data sources
         m_result.setSql(d->driver->addLimitTo1(*sql, options & QueryRecordOption::AddLimitTo1));
     }
-    KDbCursor *cursor = executeQueryInternal(m_result.sql(), query, params);
+    KDbEscapedString cacheStatement;
+    QByteArray cacheKey;
+    KDbCursor *cursor = nullptr;
+    if (!(options & QueryRecordOption::NoResultCache)
+        && d->queryResultCacheStatement(&cacheStatement, &cursor, m_result.sql(), query, params))
+    {
+        cacheKey = KDbQueryResultCache::key(KDbQueryResultCache::Kind::String, cacheStatement,
+                                            column);
+        const KDbQueryResultCache::Entry *entry = d->queryResultCache.find(cacheKey);
+        if (entry) {
+            CursorDeleter deleter(cursor); // not opened, nullptr for raw statements
+            clearResult();
+            m_result.setSql(cacheStatement);
+            if (entry->result == true && value) {
+                *value = entry->strings.first();
+            }
+            return entry->result;
+        }
+    }
+    cursor = d->executeQuery(cursor, m_result.sql(), query, params);
     if (!cursor) {
         kdbWarning() << "!querySingleStringInternal()" << m_result.sql();
         return false;
@@ -2424,16 +3078,30 @@ tristate KDbConnection::querySingleStringInternal(const KDbEscapedString *sql, Q
         const tristate result = cursor->result().isError() ? tristate(false) : tristate(cancelled);
         // kdbDebug() << "!cursor->moveFirst() || cursor->eof()" << m_result.sql();
         deleteCursor(cursor);
+        if (!cacheKey.isEmpty() && ~result) {
+            KDbQueryResultCache::Entry *entry = new KDbQueryResultCache::Entry;
+            entry->result = cancelled;
+            d->queryResultCache.insert(cacheKey, cacheStatement, entry);
+        }
         return result;
     }
     if (!checkIfColumnExists(cursor, column)) {
         deleteCursor(cursor);
         return false;
     }
+    const QString str(cursor->value(column).toString());
     if (value) {
-        *value = cursor->value(column).toString();
+        *value = str;
+    }
+    if (!deleteCursor(cursor)) {
+        return false;
     }
-    return deleteCursor(cursor);
+    if (!cacheKey.isEmpty()) {
+        KDbQueryResultCache::Entry *entry = new KDbQueryResultCache::Entry;
+        entry->strings.append(str);
+        d->queryResultCache.insert(cacheKey, cacheStatement, entry);
+    }
+    return true;
 }
 
 tristate KDbConnection::querySingleString(const KDbEscapedString &sql, QString *value, int column,
@@ -2495,12 +3163,33 @@ tristate KDbConnection::querySingleNumber(KDbQuerySchema *query, int *number,
 
 bool KDbConnection::queryStringListInternal(const KDbEscapedString *sql, QStringList *list,
                                             KDbQuerySchema *query, const QList<QVariant> *params,
-                                            int column, bool (*filterFunction)(const QString &))
+                                            int column, bool (*filterFunction)(const QString &),
+                                            QueryRecordOptions options)
 {
     if (sql) {
         m_result.setSql(*sql);
     }
-    KDbCursor *cursor = executeQueryInternal(m_result.sql(), query, params);
+    KDbEscapedString cacheStatement;
+    QByteArray cacheKey;
+    KDbCursor *cursor = nullptr;
+    // results filtered by a function are not cached
+    if (!filterFunction && !(options & QueryRecordOption::NoResultCache)
+        && d->queryResultCacheStatement(&cacheStatement, &cursor, m_result.sql(), query, params))
+    {
+        cacheKey = KDbQueryResultCache::key(KDbQueryResultCache::Kind::StringList, cacheStatement,
+                                            column);
+        const KDbQueryResultCache::Entry *entry = d->queryResultCache.find(cacheKey);
+        if (entry) {
+            CursorDeleter deleter(cursor); // not opened, nullptr for raw statements
+            clearResult();
+            m_result.setSql(cacheStatement);
+            if (list) {
+                *list = entry->strings;
+            }
+            return true;
+        }
+    }
+    cursor = d->executeQuery(cursor, m_result.sql(), query, params);
     if (!cursor) {
         kdbWarning() << "!queryStringListInternal() " << m_result.sql();
         return false;
@@ -2533,24 +3222,34 @@ bool KDbConnection::queryStringListInternal(const KDbEscapedString *sql, QString
     if (list) {
         *list = listResult;
     }
-    return deleteCursor(cursor);
+    if (!deleteCursor(cursor)) {
+        return false;
+    }
+    if (!cacheKey.isEmpty()) {
+        KDbQueryResultCache::Entry *entry = new KDbQueryResultCache::Entry;
+        entry->strings = listResult;
+        d->queryResultCache.insert(cacheKey, cacheStatement, entry);
+    }
+    return true;
 }
 
 bool KDbConnection::queryStringList(const KDbEscapedString& sql, QStringList* list,
-                                    int column)
+                                    int column, QueryRecordOptions options)
 {
-    return queryStringListInternal(&sql, list, nullptr, nullptr, column, nullptr);
+    return queryStringListInternal(&sql, list, nullptr, nullptr, column, nullptr, options);
 }
 
-bool KDbConnection::queryStringList(KDbQuerySchema* query, QStringList* list, int column)
+bool KDbConnection::queryStringList(KDbQuerySchema* query, QStringList* list, int column,
+                                    QueryRecordOptions options)
 {
-    return queryStringListInternal(nullptr, list, query, nullptr, column, nullptr);
+    return queryStringListInternal(nullptr, list, query, nullptr, column, nullptr, options);
 }
 
 bool KDbConnection::queryStringList(KDbQuerySchema* query, QStringList* list,
-                                    const QList<QVariant>& params, int column)
+                                    const QList<QVariant>& params, int column,
+                                    QueryRecordOptions options)
 {
-    return queryStringListInternal(nullptr, list, query, &params, column, nullptr);
+    return queryStringListInternal(nullptr, list, query, &params, column, nullptr, options);
 }
 
 tristate KDbConnection::resultExists(const KDbEscapedString &sql, QueryRecordOptions options)
@@ -2598,136 +3297,101 @@ tristate KDbConnection::isEmpty(KDbTableSchema* table)
     return result == false;
 }
 
-//! Used by addFieldPropertyToExtendedTableSchemaData()
-static void createExtendedTableSchemaMainElementIfNeeded(
-    QDomDocument* doc, QDomElement* extendedTableSchemaMainEl,
-    bool* extendedTableSchemaStringIsEmpty)
-{
-    if (!*extendedTableSchemaStringIsEmpty)
-        return;
-    //init document
-    *extendedTableSchemaMainEl = doc->createElement(QLatin1String("EXTENDED_TABLE_SCHEMA"));
-    doc->appendChild(*extendedTableSchemaMainEl);
-    extendedTableSchemaMainEl->setAttribute(QLatin1String("version"),
-                                            QString::number(KDB_EXTENDED_TABLE_SCHEMA_VERSION));
-    *extendedTableSchemaStringIsEmpty = false;
-}
-
-//! Used by addFieldPropertyToExtendedTableSchemaData()
-static void createExtendedTableSchemaFieldElementIfNeeded(QDomDocument* doc,
-        QDomElement* extendedTableSchemaMainEl, const QString& fieldName, QDomElement* extendedTableSchemaFieldEl,
-        bool append = true)
-{
-    if (!extendedTableSchemaFieldEl->isNull())
-        return;
-    *extendedTableSchemaFieldEl = doc->createElement(QLatin1String("field"));
-    if (append)
-        extendedTableSchemaMainEl->appendChild(*extendedTableSchemaFieldEl);
-    extendedTableSchemaFieldEl->setAttribute(QLatin1String("name"), fieldName);
-}
-
 /*! @internal used by storeExtendedTableSchemaData()
- Creates DOM node for @a propertyName and @a propertyValue.
- Creates enclosing EXTENDED_TABLE_SCHEMA element if EXTENDED_TABLE_SCHEMA is true.
- Updates extendedTableSchemaStringIsEmpty and extendedTableSchemaMainEl afterwards.
- If extendedTableSchemaFieldEl is null, creates <field> element (with optional
- "custom" attribute is @a custom is false). */
-static void addFieldPropertyToExtendedTableSchemaData(
-    const KDbField& f, const QByteArray &propertyName, const QVariant& propertyValue,
-    QDomDocument* doc, QDomElement* extendedTableSchemaMainEl,
-    QDomElement* extendedTableSchemaFieldEl,
-    bool* extendedTableSchemaStringIsEmpty,
-    bool custom = false)
-{
-    createExtendedTableSchemaMainElementIfNeeded(doc,
-            extendedTableSchemaMainEl, extendedTableSchemaStringIsEmpty);
-    createExtendedTableSchemaFieldElementIfNeeded(
-        doc, extendedTableSchemaMainEl, f.name(), extendedTableSchemaFieldEl);
-
-    //create <property>
-    QDomElement extendedTableSchemaFieldPropertyEl = doc->createElement(QLatin1String("property"));
-    extendedTableSchemaFieldEl->appendChild(extendedTableSchemaFieldPropertyEl);
+ Writes <property> element for @a propertyName and @a propertyValue using @a writer.
+ The element has "custom" attribute set to "true" if @a custom is true. */
+static void writeExtendedTableSchemaFieldProperty(QXmlStreamWriter *writer,
+    const QByteArray &propertyName, const QVariant& propertyValue, bool custom = false)
+{
+    writer->writeStartElement(QLatin1String("property"));
     if (custom)
-        extendedTableSchemaFieldPropertyEl.setAttribute(QLatin1String("custom"), QLatin1String("true"));
-    extendedTableSchemaFieldPropertyEl.setAttribute(QLatin1String("name"), QLatin1String(propertyName));
-    QDomElement extendedTableSchemaFieldPropertyValueEl;
+        writer->writeAttribute(QLatin1String("custom"), QLatin1String("true"));
+    writer->writeAttribute(QLatin1String("name"), QLatin1String(propertyName));
+    QString valueType;
     switch (propertyValue.type()) {
     case QVariant::String:
-        extendedTableSchemaFieldPropertyValueEl = doc->createElement(QLatin1String("string"));
+        valueType = QLatin1String("string");
         break;
     case QVariant::ByteArray:
-        extendedTableSchemaFieldPropertyValueEl = doc->createElement(QLatin1String("cstring"));
+        valueType = QLatin1String("cstring");
         break;
     case QVariant::Int:
     case QVariant::Double:
     case QVariant::UInt:
     case QVariant::LongLong:
     case QVariant::ULongLong:
-        extendedTableSchemaFieldPropertyValueEl = doc->createElement(QLatin1String("number"));
+        valueType = QLatin1String("number");
         break;
     case QVariant::Bool:
-        extendedTableSchemaFieldPropertyValueEl = doc->createElement(QLatin1String("bool"));
+        valueType = QLatin1String("bool");
         break;
     default:
 //! @todo add more QVariant types
-        kdbCritical() << "addFieldPropertyToExtendedTableSchemaData(): impl. error";
+        kdbCritical() << "writeExtendedTableSchemaFieldProperty(): impl. error";
+    }
+    if (!valueType.isEmpty()) {
+        writer->writeTextElement(valueType, propertyValue.toString());
     }
-    extendedTableSchemaFieldPropertyEl.appendChild(extendedTableSchemaFieldPropertyValueEl);
-    extendedTableSchemaFieldPropertyValueEl.appendChild(
-        doc->createTextNode(propertyValue.toString()));
+    writer->writeEndElement(); // property
 }
 
 bool KDbConnection::storeExtendedTableSchemaData(KDbTableSchema* tableSchema)
 {
 //! @todo future: save in older versions if neeed
-    QDomDocument doc(QLatin1String("EXTENDED_TABLE_SCHEMA"));
-    QDomElement extendedTableSchemaMainEl;
+    QString extendedTableSchemaString;
+    QXmlStreamWriter writer(&extendedTableSchemaString);
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(1);
     bool extendedTableSchemaStringIsEmpty = true;
 
     //for each field:
     foreach(KDbField* f, *tableSchema->fields()) {
-        QDomElement extendedTableSchemaFieldEl;
         const KDbField::Type type = f->type(); // cache: evaluating type of expressions can be expensive
-        if (f->visibleDecimalPlaces() >= 0/*nondefault*/ && KDb::supportsVisibleDecimalPlacesProperty(type)) {
-            addFieldPropertyToExtendedTableSchemaData(
-                *f, "visibleDecimalPlaces", f->visibleDecimalPlaces(), &doc,
-                &extendedTableSchemaMainEl, &extendedTableSchemaFieldEl,
-                &extendedTableSchemaStringIsEmpty);
-        }
-        if (type == KDbField::Text) {
-            if (f->maxLengthStrategy() == KDbField::DefaultMaxLength) {
-                addFieldPropertyToExtendedTableSchemaData(
-                    *f, "maxLengthIsDefault", true, &doc,
-                    &extendedTableSchemaMainEl, &extendedTableSchemaFieldEl,
-                    &extendedTableSchemaStringIsEmpty);
-            }
+        const bool saveVisibleDecimalPlaces = f->visibleDecimalPlaces() >= 0/*nondefault*/
+                && KDb::supportsVisibleDecimalPlacesProperty(type);
+        const bool saveMaxLengthIsDefault = type == KDbField::Text
+                && f->maxLengthStrategy() == KDbField::DefaultMaxLength;
+        const KDbField::CustomPropertiesMap customProperties(f->customProperties());
+        const KDbLookupFieldSchema *lookupFieldSchema = tableSchema->lookupFieldSchema(*f);
+        // lookup field schema without record source is not saved, see KDbLookupFieldSchema::saveToXml()
+        const bool saveLookupFieldSchema
+                = lookupFieldSchema && !lookupFieldSchema->recordSource().name().isEmpty();
+        if (!saveVisibleDecimalPlaces && !saveMaxLengthIsDefault && customProperties.isEmpty()
+                && !saveLookupFieldSchema)
+        {
+            continue;
+        }
+        if (extendedTableSchemaStringIsEmpty) {
+            //init document
+            writer.writeDTD(QLatin1String("<!DOCTYPE EXTENDED_TABLE_SCHEMA>"));
+            writer.writeStartElement(QLatin1String("EXTENDED_TABLE_SCHEMA"));
+            writer.writeAttribute(QLatin1String("version"),
+                                  QString::number(KDB_EXTENDED_TABLE_SCHEMA_VERSION));
+            extendedTableSchemaStringIsEmpty = false;
+        }
+        writer.writeStartElement(QLatin1String("field"));
+        writer.writeAttribute(QLatin1String("name"), f->name());
+        if (saveVisibleDecimalPlaces) {
+            writeExtendedTableSchemaFieldProperty(&writer, "visibleDecimalPlaces",
+                                                  f->visibleDecimalPlaces());
+        }
+        if (saveMaxLengthIsDefault) {
+            writeExtendedTableSchemaFieldProperty(&writer, "maxLengthIsDefault", true);
         }
 
         // boolean field with "not null"
 
         // add custom properties
-        const KDbField::CustomPropertiesMap customProperties(f->customProperties());
         for (KDbField::CustomPropertiesMap::ConstIterator itCustom = customProperties.constBegin();
                 itCustom != customProperties.constEnd(); ++itCustom) {
-            addFieldPropertyToExtendedTableSchemaData(
-                *f, itCustom.key(), itCustom.value(), &doc,
-                &extendedTableSchemaMainEl, &extendedTableSchemaFieldEl, &extendedTableSchemaStringIsEmpty,
-                /*custom*/true);
+            writeExtendedTableSchemaFieldProperty(&writer, itCustom.key(), itCustom.value(),
+                                                  /*custom*/true);
         }
         // save lookup table specification, if present
-        KDbLookupFieldSchema *lookupFieldSchema = tableSchema->lookupFieldSchema(*f);
-        if (lookupFieldSchema) {
-            createExtendedTableSchemaFieldElementIfNeeded(
-                &doc, &extendedTableSchemaMainEl, f->name(), &extendedTableSchemaFieldEl, false/* !append */);
-            lookupFieldSchema->saveToDom(&doc, &extendedTableSchemaFieldEl);
-
-            if (extendedTableSchemaFieldEl.hasChildNodes()) {
-                // this element provides the definition, so let's append it now
-                createExtendedTableSchemaMainElementIfNeeded(&doc, &extendedTableSchemaMainEl,
-                        &extendedTableSchemaStringIsEmpty);
-                extendedTableSchemaMainEl.appendChild(extendedTableSchemaFieldEl);
-            }
+        if (saveLookupFieldSchema) {
+            lookupFieldSchema->saveToXml(&writer);
         }
+        writer.writeEndElement(); // field
     }
 
     // Store extended schema information (see ExtendedTableSchemaInformation in Kexi Wiki)
@@ -2738,11 +3402,12 @@ bool KDbConnection::storeExtendedTableSchemaData(KDbTableSchema* tableSchema)
         if (!removeDataBlock(tableSchema->id(), QLatin1String("extended_schema")))
             return false;
     } else {
+        writer.writeEndElement(); // EXTENDED_TABLE_SCHEMA
 #ifdef KDB_DEBUG_GUI
         KDb::alterTableActionDebugGUI(
-                    QLatin1String("** Extended table schema set to:\n") + doc.toString(4));
+                    QLatin1String("** Extended table schema set to:\n") + extendedTableSchemaString);
 #endif
-        if (!storeDataBlock(tableSchema->id(), doc.toString(1), QLatin1String("extended_schema")))
+        if (!storeDataBlock(tableSchema->id(), extendedTableSchemaString, QLatin1String("extended_schema")))
             return false;
     }
     return true;
@@ -2754,6 +3419,21 @@ bool KDbConnection::loadExtendedTableSchemaData(KDbTableSchema* tableSchema)
     { m_result = KDbResult(tr("Error while loading extended table schema.", \
                               "Extended schema for a table: loading error")); \
       return false; }
+
+    // Load extended schema information, if present (see ExtendedTableSchemaInformation in Kexi Wiki)
+    QString extendedTableSchemaString;
+    tristate res = loadDataBlock(tableSchema->id(),
+                                 &extendedTableSchemaString, QLatin1String("extended_schema"));
+    if (!res)
+        loadExtendedTableSchemaData_ERR;
+    // extendedTableSchemaString will be just empty if there is no such data block
+    return loadExtendedTableSchemaData(tableSchema, extendedTableSchemaString);
+#undef loadExtendedTableSchemaData_ERR
+}
+
+bool KDbConnection::loadExtendedTableSchemaData(KDbTableSchema* tableSchema,
+                                                const QString &extendedTableSchemaString)
+{
 #define loadExtendedTableSchemaData_ERR2(details) \
     { m_result = KDbResult(details); \
       m_result.setMessageTitle(tr("Error while loading extended table schema.", \
@@ -2764,92 +3444,99 @@ bool KDbConnection::loadExtendedTableSchemaData(KDbTableSchema* tableSchema)
       m_result.setMessageTitle(tr("Error while loading extended table schema.", \
                                   "Extended schema for a table: loading error")); \
       return false; }
-
-    // Load extended schema information, if present (see ExtendedTableSchemaInformation in Kexi Wiki)
-    QString extendedTableSchemaString;
-    tristate res = loadDataBlock(tableSchema->id(),
-                                 &extendedTableSchemaString, QLatin1String("extended_schema"));
-    if (!res)
-        loadExtendedTableSchemaData_ERR;
-    // extendedTableSchemaString will be just empty if there is no such data block
+#define loadExtendedTableSchemaData_XML_ERR(xml) \
+    loadExtendedTableSchemaData_ERR2( \
+        tr("Error in XML data: \"%1\" in line %2, column %3.\nXML data: %4") \
+           .arg(xml.errorString()).arg(xml.lineNumber()).arg(xml.columnNumber()) \
+           .arg(extendedTableSchemaString.left(1024)))
 
     if (extendedTableSchemaString.isEmpty())
         return true;
 
-    QDomDocument doc;
-    QString errorMsg;
-    int errorLine, errorColumn;
-    if (!doc.setContent(extendedTableSchemaString, &errorMsg, &errorLine, &errorColumn)) {
-        loadExtendedTableSchemaData_ERR2(
-            tr("Error in XML data: \"%1\" in line %2, column %3.\nXML data: %4")
-               .arg(errorMsg).arg(errorLine).arg(errorColumn).arg(extendedTableSchemaString.left(1024)));
+    // The data is read using a stream reader, no DOM tree is built
+    QXmlStreamReader xml(extendedTableSchemaString);
+    bool doctypeFound = false;
+    while (!xml.atEnd() && !xml.isStartElement()) {
+        xml.readNext();
+        if (xml.isDTD()) {
+            doctypeFound = xml.dtdName() == QLatin1String("EXTENDED_TABLE_SCHEMA");
+        }
+    }
+    if (xml.hasError()) {
+        loadExtendedTableSchemaData_XML_ERR(xml);
     }
 
 //! @todo look at the current format version (KDB_EXTENDED_TABLE_SCHEMA_VERSION)
 
-    if (doc.doctype().name() != QLatin1String("EXTENDED_TABLE_SCHEMA"))
+    if (!doctypeFound)
         loadExtendedTableSchemaData_ERR3(extendedTableSchemaString);
 
-    QDomElement docEl = doc.documentElement();
-    if (docEl.tagName() != QLatin1String("EXTENDED_TABLE_SCHEMA"))
+    if (xml.name() != QLatin1String("EXTENDED_TABLE_SCHEMA"))
         loadExtendedTableSchemaData_ERR3(extendedTableSchemaString);
 
-    for (QDomNode n = docEl.firstChild(); !n.isNull(); n = n.nextSibling()) {
-        QDomElement fieldEl = n.toElement();
-        if (fieldEl.tagName() == QLatin1String("field")) {
-            KDbField *f = tableSchema->field(fieldEl.attribute(QLatin1String("name")));
-            if (f) {
-                //set properties of the field:
+    while (xml.readNextStartElement()) {
+        if (xml.name() != QLatin1String("field")) {
+            xml.skipCurrentElement();
+            continue;
+        }
+        const QString fieldName(xml.attributes().value(QLatin1String("name")).toString());
+        KDbField *f = tableSchema->field(fieldName);
+        if (!f) {
+            kdbWarning() << "no such field:" << fieldName << "in table:" << tableSchema->name();
+            xml.skipCurrentElement();
+            continue;
+        }
+        //set properties of the field:
 //! @todo more properties
-                for (QDomNode propNode = fieldEl.firstChild();
-                     !propNode.isNull(); propNode = propNode.nextSibling())
-                {
-                    const QDomElement propEl = propNode.toElement();
-                    bool ok;
-                    int intValue;
-                    if (propEl.tagName() == QLatin1String("property")) {
-                        QByteArray propertyName = propEl.attribute(QLatin1String("name")).toLatin1();
-                        if (propEl.attribute(QLatin1String("custom")) == QLatin1String("true")) {
-                            //custom property
-                            const QVariant v(KDb::loadPropertyValueFromDom(propEl.firstChild(), &ok));
-                            if (ok) {
-                                f->setCustomProperty(propertyName, v);
-                            }
-                        }
-                        else if (propertyName == "visibleDecimalPlaces") {
-                            if (KDb::supportsVisibleDecimalPlacesProperty(f->type())) {
-                                intValue = KDb::loadIntPropertyValueFromDom(propEl.firstChild(), &ok);
-                                if (ok)
-                                    f->setVisibleDecimalPlaces(intValue);
-                            }
-                        }
-                        else if (propertyName == "maxLengthIsDefault") {
-                            if (f->type() == KDbField::Text) {
-                                const bool maxLengthIsDefault
-                                    = KDb::loadPropertyValueFromDom(propEl.firstChild(), &ok).toBool();
-                                if (ok) {
-                                    f->setMaxLengthStrategy(
-                                        maxLengthIsDefault ? KDbField::DefaultMaxLength : KDbField::DefinedMaxLength);
-                                }
-                            }
-                        }
-//! @todo more properties...
-                    } else if (propEl.tagName() == QLatin1String("lookup-column")) {
-                        KDbLookupFieldSchema *lookupFieldSchema = KDbLookupFieldSchema::loadFromDom(propEl);
-                        if (lookupFieldSchema) {
-                            kdbDebug() << f->name() << *lookupFieldSchema;
-                            tableSchema->setLookupFieldSchema(f->name(), lookupFieldSchema);
-                        }
+        while (xml.readNextStartElement()) {
+            if (xml.name() == QLatin1String("property")) {
+                const QByteArray propertyName
+                    = xml.attributes().value(QLatin1String("name")).toString().toLatin1();
+                const bool custom = xml.attributes().value(QLatin1String("custom")) == QLatin1String("true");
+                if (!xml.readNextStartElement()) { // no value
+                    continue;
+                }
+                bool ok;
+                const QVariant v(KDb::loadPropertyValueFromXml(&xml, &ok));
+                xml.skipCurrentElement(); // rest of the property element
+                if (!ok) {
+                    continue;
+                }
+                if (custom) {
+                    //custom property
+                    f->setCustomProperty(propertyName, v);
+                }
+                else if (propertyName == "visibleDecimalPlaces") {
+                    if (KDb::supportsVisibleDecimalPlacesProperty(f->type())) {
+                        if (v.type() == QVariant::Int)
+                            f->setVisibleDecimalPlaces(v.toInt());
                     }
                 }
+                else if (propertyName == "maxLengthIsDefault") {
+                    if (f->type() == KDbField::Text) {
+                        f->setMaxLengthStrategy(
+                            v.toBool() ? KDbField::DefaultMaxLength : KDbField::DefinedMaxLength);
+                    }
+                }
+//! @todo more properties...
+            } else if (xml.name() == QLatin1String("lookup-column")) {
+                KDbLookupFieldSchema *lookupFieldSchema = KDbLookupFieldSchema::loadFromXml(&xml);
+                if (lookupFieldSchema) {
+                    kdbDebug() << f->name() << *lookupFieldSchema;
+                    tableSchema->setLookupFieldSchema(f->name(), lookupFieldSchema);
+                }
             } else {
-                kdbWarning() << "no such field:" << fieldEl.attribute(QLatin1String("name"))
-                        << "in table:" << tableSchema->name();
+                xml.skipCurrentElement();
             }
         }
     }
-
+    if (xml.hasError()) {
+        loadExtendedTableSchemaData_XML_ERR(xml);
+    }
     return true;
+#undef loadExtendedTableSchemaData_ERR2
+#undef loadExtendedTableSchemaData_ERR3
+#undef loadExtendedTableSchemaData_XML_ERR
 }
 
 KDbField* KDbConnection::setupField(const KDbRecordData &data)
@@ -2907,6 +3594,11 @@ KDbTableSchema* KDbConnection::tableSchema(const QString& tableName)
     if (t || tableName.isEmpty()) {
         return t;
     }
+    const int preloadedTableId = d->preloadedTableId(tableName);
+    if (preloadedTableId > 0) {
+        clearResult();
+        return d->setupPreloadedTableSchema(preloadedTableId);
+    }
     //not found: retrieve schema
     QScopedPointer<KDbTableSchema> newTable(new KDbTableSchema);
     clearResult();
@@ -2921,6 +3613,11 @@ KDbTableSchema* KDbConnection::tableSchema(int tableId)
     KDbTableSchema *t = d->table(tableId);
     if (t)
         return t;
+    clearResult();
+    t = d->setupPreloadedTableSchema(tableId);
+    if (t || m_result.isError()) {
+        return t;
+    }
     //not found: retrieve schema
     QScopedPointer<KDbTableSchema> newTable(new KDbTableSchema);
     clearResult();
@@ -3121,27 +3818,18 @@ bool KDbConnection::updateRecord(KDbQuerySchema* query, KDbRecordData* data, KDb
 //! @todo perhaps we can try to update without using PKEY?
         return false;
     }
-    //update the record:
-    KDbEscapedString sql;
-    sql.reserve(4096);
-    sql = KDbEscapedString("UPDATE ") + escapeIdentifier(mt->name()) + " SET ";
-    KDbEscapedString sqlset, sqlwhere;
-    sqlset.reserve(1024);
-    sqlwhere.reserve(1024);
     KDbRecordEditBuffer::DbHash b = buf->dbBuffer();
 
     //gather the fields which are updated ( have values in KDbRecordEditBuffer)
     KDbFieldList affectedFields;
+    KDbPreparedStatementParameters parameters; // values for SET followed by values for WHERE
     for (KDbRecordEditBuffer::DbHash::ConstIterator it = b.constBegin();it != b.constEnd();++it) {
         if (it.key()->field()->table() != mt)
             continue; // skip values for fields outside of the master table (e.g. a "visible value" of the lookup field)
-        if (!sqlset.isEmpty())
-            sqlset += ',';
         KDbField* currentField = it.key()->field();
         const bool affectedFieldsAddOk = affectedFields.addField(currentField);
         Q_ASSERT(affectedFieldsAddOk);
-        sqlset += KDbEscapedString(escapeIdentifier(currentField->name())) + '=' +
-                  d->driver->valueToSql(currentField, it.value());
+        parameters.append(it.value());
     }
     if (pkey) {
         //kdbDebug() << pkey->fieldCount() << " ? " << query->pkeyFieldCount();
@@ -3155,8 +3843,6 @@ bool KDbConnection::updateRecord(KDbQuerySchema* query, KDbRecordData* data, KDb
             int i = 0;
             const QVector<int> pkeyFieldsOrder(query->pkeyFieldsOrder(this));
             for (KDbField *f : qAsConst(*pkey->fields())) {
-                if (!sqlwhere.isEmpty())
-                    sqlwhere += " AND ";
                 const QVariant val(data->at(pkeyFieldsOrder.at(i)));
                 if (val.isNull() || !val.isValid()) {
                     m_result = KDbResult(ERR_UPDATE_NULL_PKEY_FIELD,
@@ -3164,23 +3850,56 @@ bool KDbConnection::updateRecord(KDbQuerySchema* query, KDbRecordData* data, KDb
                     //js todo: pass the field's name somewhere!
                     return false;
                 }
+                parameters.append(val);
+                i++;
+            }
+        }
+    }
+    // statements for the same table and fields are reused
+    KDbPreparedStatement *statement = pkey
+        ? d->recordStatement(KDbPreparedStatement::UpdateStatement, mt, affectedFields, *pkey->fields())
+        : nullptr;
+    //update the record:
+    KDbEscapedString sql;
+    if (!statement) { // no pkey or no prepared statements: use literal values
+        sql.reserve(4096);
+        sql = KDbEscapedString("UPDATE ") + escapeIdentifier(mt->name()) + " SET ";
+        KDbEscapedString sqlset, sqlwhere;
+        sqlset.reserve(1024);
+        sqlwhere.reserve(1024);
+        int i = 0;
+        for (KDbField *f : *affectedFields.fields()) {
+            if (!sqlset.isEmpty())
+                sqlset += ',';
+            sqlset += KDbEscapedString(escapeIdentifier(f->name())) + '=' +
+                      d->driver->valueToSql(f, parameters.at(i));
+            i++;
+        }
+        if (pkey) {
+            for (KDbField *f : qAsConst(*pkey->fields())) {
+                if (!sqlwhere.isEmpty())
+                    sqlwhere += " AND ";
                 sqlwhere += KDbEscapedString(escapeIdentifier(f->name())) + '=' +
-                            d->driver->valueToSql(f, val);
+                            d->driver->valueToSql(f, parameters.at(i));
                 i++;
             }
+        } else { //use RecordId
+            sqlwhere = KDbEscapedString(escapeIdentifier(d->driver->behavior()->ROW_ID_FIELD_NAME)) + '='
+                       + d->driver->valueToSql(KDbField::BigInteger, (*data)[data->size() - 1]);
         }
-    } else { //use RecordId
-        sqlwhere = KDbEscapedString(escapeIdentifier(d->driver->behavior()->ROW_ID_FIELD_NAME)) + '='
-                   + d->driver->valueToSql(KDbField::BigInteger, (*data)[data->size() - 1]);
+        sql += (sqlset + " WHERE " + sqlwhere);
     }
-    sql += (sqlset + " WHERE " + sqlwhere);
     //kdbDebug() << " -- SQL == " << ((sql.length() > 400) ? (sql.left(400) + "[.....]") : sql);
 
     // preprocessing before update
     if (!drv_beforeUpdate(mt->name(), &affectedFields))
         return false;
 
-    bool res = executeSql(sql);
+    const qint64 recordCount = d->queryResultCache.recordCount(mt->name());
+    bool res = statement ? statement->execute(parameters) : executeSql(sql);
+    if (res && recordCount >= 0) { // updating does not change the number of records
+        d->queryResultCache.setRecordCount(mt->name(), recordCount);
+    }
 
     // postprocessing after update
     if (!drv_afterUpdate(mt->name(), &affectedFields))
@@ -3381,13 +4100,7 @@ bool KDbConnection::deleteRecord(KDbQuerySchema* query, KDbRecordData* data, boo
         return false;
     }
 
-    //update the record:
-    KDbEscapedString sql;
-    sql.reserve(4096);
-    sql = KDbEscapedString("DELETE FROM ") + escapeIdentifier(mt->name()) + " WHERE ";
-    KDbEscapedString sqlwhere;
-    sqlwhere.reserve(1024);
-
+    KDbPreparedStatementParameters parameters; // values for WHERE
     if (pkey) {
         const QVector<int> pkeyFieldsOrder(query->pkeyFieldsOrder(this));
         //kdbDebug() << pkey->fieldCount() << " ? " << query->pkeyFieldCount();
@@ -3399,8 +4112,6 @@ bool KDbConnection::deleteRecord(KDbQuerySchema* query, KDbRecordData* data, boo
         }
         int i = 0;
         foreach(KDbField *f, *pkey->fields()) {
-            if (!sqlwhere.isEmpty())
-                sqlwhere += " AND ";
             QVariant val(data->at(pkeyFieldsOrder.at(i)));
             if (val.isNull() || !val.isValid()) {
                 m_result = KDbResult(ERR_DELETE_NULL_PKEY_FIELD,
@@ -3408,22 +4119,45 @@ bool KDbConnection::deleteRecord(KDbQuerySchema* query, KDbRecordData* data, boo
 //js todo: pass the field's name somewhere!
                 return false;
             }
-            sqlwhere += KDbEscapedString(escapeIdentifier(f->name())) + '=' +
-                         d->driver->valueToSql(f, val);
+            parameters.append(val);
             i++;
         }
-    } else {//use RecordId
-        sqlwhere = KDbEscapedString(escapeIdentifier(d->driver->behavior()->ROW_ID_FIELD_NAME)) + '='
-                    + d->driver->valueToSql(KDbField::BigInteger, (*data)[data->size() - 1]);
     }
-    sql += sqlwhere;
+    // statements for the same table are reused
+    KDbPreparedStatement *statement = pkey
+        ? d->recordStatement(KDbPreparedStatement::DeleteStatement, mt, KDbFieldList(), *pkey->fields())
+        : nullptr;
+    //delete the record:
+    KDbEscapedString sql;
+    if (!statement) { // no pkey or no prepared statements: use literal values
+        sql.reserve(4096);
+        sql = KDbEscapedString("DELETE FROM ") + escapeIdentifier(mt->name()) + " WHERE ";
+        KDbEscapedString sqlwhere;
+        sqlwhere.reserve(1024);
+        if (pkey) {
+            int i = 0;
+            foreach(KDbField *f, *pkey->fields()) {
+                if (!sqlwhere.isEmpty())
+                    sqlwhere += " AND ";
+                sqlwhere += KDbEscapedString(escapeIdentifier(f->name())) + '=' +
+                             d->driver->valueToSql(f, parameters.at(i));
+                i++;
+            }
+        } else {//use RecordId
+            sqlwhere = KDbEscapedString(escapeIdentifier(d->driver->behavior()->ROW_ID_FIELD_NAME)) + '='
+                        + d->driver->valueToSql(KDbField::BigInteger, (*data)[data->size() - 1]);
+        }
+        sql += sqlwhere;
+    }
     //kdbDebug() << " -- SQL == " << sql;
 
-    if (!executeSql(sql)) {
+    if (statement ? !statement->execute(parameters) : !executeSql(sql)) {
         m_result = KDbResult(ERR_DELETE_SERVER_ERROR,
                              tr("Record deletion on the server failed."));
         return false;
     }
+    // the record may have been deleted already, so the number of records is not known
+    d->queryResultCache.invalidate(mt->name());
     return true;
 }
 
@@ -3447,6 +4181,7 @@ bool KDbConnection::deleteAllRecords(KDbQuerySchema* query)
                              tr("Record deletion on the server failed."));
         return false;
     }
+    d->queryResultCache.setRecordCount(mt->name(), 0);
     return true;
 }
 
@@ -3501,6 +4236,60 @@ int KDbConnection::recordCount(KDbTableOrQuerySchema* tableOrQuery, const QList<
     return -1;
 }
 
+qint64 KDbConnection::cachedRecordCount(const KDbTableSchema &tableSchema)
+{
+    qint64 count = d->queryResultCache.recordCount(tableSchema.name());
+    if (count >= 0) {
+        return count;
+    }
+    count = recordCount(tableSchema);
+    if (count >= 0) {
+        d->queryResultCache.setRecordCount(tableSchema.name(), count);
+    }
+    return count;
+}
+
+qint64 KDbConnection::estimatedRecordCount(const KDbTableSchema &tableSchema)
+{
+    const qint64 cachedCount = d->queryResultCache.recordCount(tableSchema.name());
+    if (cachedCount >= 0) {
+        return cachedCount;
+    }
+    qint64 count = -1;
+    const tristate result = drv_estimatedRecordCount(tableSchema, &count);
+    if (result == true && count >= 0) {
+        return count;
+    }
+    if (result == false) {
+        kdbWarning() << "Could not estimate number of records of table" << tableSchema.name()
+                     << m_result;
+        clearResult();
+    }
+    return cachedRecordCount(tableSchema);
+}
+
+tristate KDbConnection::drv_estimatedRecordCount(const KDbTableSchema &tableSchema, qint64 *count)
+{
+    Q_UNUSED(tableSchema);
+    Q_UNUSED(count);
+    return cancelled;
+}
+
+KDbConnection::QueryResultCacheStatistics KDbConnection::queryResultCacheStatistics() const
+{
+    return d->queryResultCache.statistics();
+}
+
+void KDbConnection::invalidateQueryResultCache(const QString &tableName)
+{
+    d->queryResultCache.invalidate(tableName);
+}
+
+void KDbConnection::clearQueryResultCache()
+{
+    d->queryResultCache.clear();
+}
+
 KDbConnectionOptions* KDbConnection::options()
 {
     return &d->options;
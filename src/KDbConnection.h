@@ -33,6 +33,9 @@ class KDbConnectionPrivate;
 class KDbConnectionProxy;
 class KDbDriver;
 class KDbProperties;
+class KDbRecordBatch;
+class KDbRecordBatchConsumer;
+class KDbRecordBatchProducer;
 class KDbRecordData;
 class KDbRecordEditBuffer;
 class KDbServerVersionInfo;
@@ -482,6 +485,9 @@ public:
     enum class QueryRecordOption {
         AddLimitTo1 = 1, //!< Adds a "LIMIT 1" clause to the query for optimization purposes
                          //!< (it should not include one already)
+        NoResultCache = 2, //!< Neither uses nor stores results in the query result cache,
+                           //!< e.g. for statistics that change without modifications of tables
+                           //!< (@since 3.2)
         Default = AddLimitTo1
     };
     Q_DECLARE_FLAGS(QueryRecordOptions, QueryRecordOption)
@@ -557,20 +563,25 @@ public:
      of every record inside @a list, where N is equal to @a column. The list is initially cleared.
      For efficiency it's recommended that a query defined by @a sql
      should have just one field (SELECT one_field FROM ....).
+     If @a options includes NoResultCache value, the query result cache is not used;
+     other options are ignored (@since 3.2).
      @return true if all values were fetched successfuly,
      false on data retrieving failure. Returning empty list can be still a valid result.
      On errors, the list is not cleared, it may contain a few retrieved values. */
-    bool queryStringList(const KDbEscapedString& sql, QStringList* list, int column = 0);
+    bool queryStringList(const KDbEscapedString& sql, QStringList* list, int column = 0,
+                         QueryRecordOptions options = QueryRecordOption::Default);
 
     /*! @overload
      Uses a QuerySchema object. */
-    bool queryStringList(KDbQuerySchema* query, QStringList* list, int column = 0);
+    bool queryStringList(KDbQuerySchema* query, QStringList* list, int column = 0,
+                         QueryRecordOptions options = QueryRecordOption::Default);
 
     /*! @overload
      Accepts @a params as parameters that will be inserted into places marked with "[]" before
      query execution. */
     bool queryStringList(KDbQuerySchema* query, QStringList* list,
-                         const QList<QVariant>& params, int column = 0);
+                         const QList<QVariant>& params, int column = 0,
+                         QueryRecordOptions options = QueryRecordOption::Default);
 
     /*! @return @c true if there is at least one record has been returned by executing query
      for a raw SQL statement @a sql or @c false if no such record exists.
@@ -619,6 +630,39 @@ public:
 
     QSharedPointer<KDbSqlResult> insertRecord(KDbFieldList *fields, const QList<QVariant> &values);
 
+    /*! Inserts multiple records into the table that owns fields @a fields.
+     Each element of @a records is a list of values for @a fields, in the same order;
+     missing values are inserted as null and excess values are ignored.
+
+     This is much faster than calling insertRecord() for every record. All the records are
+     inserted within a single transaction (started if there is no transaction yet) and drivers
+     use their native method for bulk insertion, see drv_insertRecords().
+     Unlike insertRecord() no result is returned for each record.
+     @return true on success. On failure no record is inserted unless a transaction has been
+     started before calling this method.
+     @since 3.2 */
+    bool insertRecords(KDbFieldList *fields, const QList<QList<QVariant>> &records);
+
+    /*! Imports records provided by @a producer into table @a table.
+     Records are requested in batches of @a batchCapacity records, with columns matching fields
+     of @a table. Values are encoded as for KDbDriver::valueToSql(). Like insertRecords(), all
+     the records are imported within a single transaction and drivers use their native bulk
+     method if available, e.g. "COPY ... FROM STDIN" for PostgreSQL; the memory used does not
+     depend on the number of records.
+     @return true on success
+     @since 3.2 */
+    bool importRecords(KDbTableSchema *table, KDbRecordBatchProducer *producer,
+                       int batchCapacity = 1024);
+
+    /*! Exports all records of table @a table to @a consumer.
+     Records are passed in batches of up to @a batchCapacity records, with columns matching
+     fields of @a table. Drivers use their native bulk method if available, e.g.
+     "COPY ... TO STDOUT" for PostgreSQL; otherwise a cursor is used.
+     @return true on success; false on error or if @a consumer cancelled the export
+     @since 3.2 */
+    bool exportRecords(KDbTableSchema *table, KDbRecordBatchConsumer *consumer,
+                       int batchCapacity = 1024);
+
     //! Options for creating table
     //! @since 3.1
     enum class CreateTableOption {
@@ -958,6 +1002,79 @@ public:
     int recordCount(KDbTableOrQuerySchema* tableOrQuery,
                                const QList<QVariant>& params = QList<QVariant>());
 
+    /**
+     * @brief Returns exact number of records of a table, cached by the connection
+     *
+     * The number is computed using recordCount() on first request. Later it is kept current
+     * by insertRecord(), insertRecords(), updateRecord() and deleteAllRecords() of this
+     * connection without querying the database. Other modifications of the table performed
+     * using this connection, such as deleteRecord(), importRecords(), data manipulation
+     * statements passed to executeSql() or rollback of a transaction, make the number computed
+     * again on the next request. Changes made by other connections are not detected;
+     * invalidateQueryResultCache() can be used in this case.
+     *
+     * -1 is returned on error.
+     *
+     * @since 3.2
+     */
+    qint64 cachedRecordCount(const KDbTableSchema &tableSchema);
+
+    /**
+     * @brief Returns approximate number of records of a table
+     *
+     * This is a fast alternative to recordCount() for uses such as sizing of scroll bars.
+     * The exact number is returned if it is cached, see cachedRecordCount(). Otherwise
+     * statistics maintained by the database are used if available, e.g. results of the ANALYZE
+     * command. If neither is available, the exact number is computed using cachedRecordCount().
+     *
+     * -1 is returned on error.
+     *
+     * @since 3.2
+     */
+    qint64 estimatedRecordCount(const KDbTableSchema &tableSchema);
+
+    /**
+     * @brief Statistics of the query result cache
+     *
+     * @see KDbConnectionOptions::queryResultCacheSize()
+     * @since 3.2
+     */
+    struct QueryResultCacheStatistics {
+        quint64 hits = 0;          //!< Number of results taken from the cache
+        quint64 misses = 0;        //!< Number of results not found in the cache
+        quint64 invalidations = 0; //!< Number of entries removed because of modifications
+        int entryCount = 0;        //!< Number of cached results
+        qint64 memoryUsage = 0;    //!< Approximate memory used by cached results, in bytes
+        qint64 maximumSize = 0;    //!< Maximum memory that can be used, in bytes
+    };
+
+    /**
+     * @brief Returns statistics of the query result cache of this connection
+     *
+     * Hit rate and memory use can be used to tune KDbConnectionOptions::queryResultCacheSize().
+     *
+     * @since 3.2
+     */
+    QueryResultCacheStatistics queryResultCacheStatistics() const;
+
+    /**
+     * @brief Removes cached query results that depend on table @a tableName
+     *
+     * Modifications performed using this connection invalidate the results automatically.
+     * Use this method after the table has been modified by other means, e.g. by another
+     * connection.
+     *
+     * @since 3.2
+     */
+    void invalidateQueryResultCache(const QString &tableName);
+
+    /**
+     * @brief Removes all cached query results
+     *
+     * @since 3.2
+     */
+    void clearQueryResultCache();
+
     //! Identifier escaping function in the associated KDbDriver.
     /*! Calls the identifier escaping function in this connection to
      escape table and column names.  This should be used when explicitly
@@ -985,6 +1102,13 @@ protected:
      @see ~KDbConnection() */
     void destroy();
 
+    /*! Sets value of read-only option @a name of this connection to @a value. The option
+     is inserted with @a caption if it does not exist. Drivers use it to report their state.
+     @see KDbConnectionOptions::isReadOnlyOption()
+     @since 3.2 */
+    void setReadOnlyOption(const QByteArray &name, const QVariant &value,
+                           const QString &caption = QString());
+
     /*! For implementation: connects to database.
       @return true on success. */
     virtual bool drv_connect() = 0;
@@ -1234,6 +1358,47 @@ protected:
         return true;
     }
 
+    /*! Inserts @a records into table @a tableName, see insertRecords().
+     Called within a transaction, between drv_beforeInsert() and drv_afterInsert().
+     The default implementation executes one INSERT statement per record.
+     Reimplement this method in your driver to use a faster method, e.g. a reused prepared
+     statement, INSERT statements with multiple VALUES lists (see insertRecordsUsingMultipleValues())
+     or a bulk copy protocol of the server.
+     @since 3.2 */
+    virtual bool drv_insertRecords(const QString &tableName, KDbFieldList *fields,
+                                   const QList<QList<QVariant>> &records);
+
+    /*! Helper for drv_insertRecords(): inserts @a records into table @a tableName using
+     INSERT statements with multiple VALUES lists. Records are split between statements so
+     that each statement is not longer than @a maxStatementLength bytes, unless a single
+     record is longer.
+     @since 3.2 */
+    bool insertRecordsUsingMultipleValues(const QString &tableName, KDbFieldList *fields,
+                                          const QList<QList<QVariant>> &records,
+                                          int maxStatementLength);
+
+    /*! Imports records from @a producer into @a table, see importRecords().
+     @a batch is an empty batch with columns matching fields of @a table.
+     Called within a transaction, between drv_beforeInsert() and drv_afterInsert().
+     The default implementation inserts records of each batch using drv_insertRecords().
+     @since 3.2 */
+    virtual bool drv_importRecords(KDbTableSchema *table, KDbRecordBatchProducer *producer,
+                                   KDbRecordBatch *batch);
+
+    /*! Exports records of @a table to @a consumer, see exportRecords().
+     @a batch is an empty batch with columns matching fields of @a table.
+     The default implementation fills the batch using a cursor, see KDbCursor::fetchBatch().
+     @since 3.2 */
+    virtual bool drv_exportRecords(KDbTableSchema *table, KDbRecordBatchConsumer *consumer,
+                                   KDbRecordBatch *batch);
+
+    /*! Estimates number of records of table @a tableSchema using statistics of the database
+     and stores it in @a count, see estimatedRecordCount().
+     @return true on success, cancelled if no statistics are available for the table
+     and false on error. The default implementation returns cancelled.
+     @since 3.2 */
+    virtual tristate drv_estimatedRecordCount(const KDbTableSchema &tableSchema, qint64 *count);
+
     /*! Preprocessing required by drivers before execution of an
         Update statement.
         Reimplement this method in your driver if there are any special processing steps to be
@@ -1368,7 +1533,8 @@ protected:
     /*! @internal used by queryStringList() methods. */
     bool queryStringListInternal(const KDbEscapedString *sql, QStringList* list,
                                  KDbQuerySchema* query, const QList<QVariant>* params,
-                                 int column, bool (*filterFunction)(const QString&));
+                                 int column, bool (*filterFunction)(const QString&),
+                                 QueryRecordOptions options);
 
     /*! @internal used by *Internal() methods.
      Executes query based on a raw SQL statement @a sql or @a query with optional @a params.
@@ -1382,6 +1548,13 @@ protected:
      @return true on success */
     bool loadExtendedTableSchemaData(KDbTableSchema* tableSchema);
 
+    /*! Loads extended schema information for table @a tableSchema from XML data
+     @a extendedSchema of the "extended_schema" data block. Nothing is loaded if
+     @a extendedSchema is empty.
+     @return true on success
+     @since 3.2 */
+    bool loadExtendedTableSchemaData(KDbTableSchema* tableSchema, const QString &extendedSchema);
+
     /*! Stores extended schema information for table @a tableSchema,
      (see ExtendedTableSchemaInformation in Kexi Wiki).
      The action is performed within the current transaction,
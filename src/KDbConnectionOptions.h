@@ -61,6 +61,42 @@ public:
      Only works if connection is not yet established. */
     void setReadOnly(bool set);
 
+    /*! Modes of loading table schemas for databases opened with KDbConnection::useDatabase().
+     @since 3.2 */
+    enum class TableSchemaPreloading {
+        None,  //!< Each table schema is loaded using separate queries on first request (the default)
+        Lazy,  //!< Definitions of all tables are read at once while opening the database,
+               //!< table schemas are created from them on first request
+        Eager  //!< Definitions of all tables are read at once while opening the database
+               //!< and all table schemas are created immediately
+    };
+
+    /*! @return mode of loading table schemas, stored as the "tableSchemaPreloading" option
+     Preloading reads definitions of all tables using three queries instead of two queries
+     per table, what can make opening databases with many tables much faster, especially
+     for network servers. The option is used when the database is opened.
+     @since 3.2 */
+    TableSchemaPreloading tableSchemaPreloading() const;
+
+    /*! Sets mode of loading table schemas to @a mode.
+     @since 3.2 */
+    void setTableSchemaPreloading(TableSchemaPreloading mode);
+
+    /*! @return maximum memory in bytes used for caching results of queries, stored as
+     the "queryResultCacheSize" option. 0, the default, disables the cache.
+     When enabled, results of KDbConnection::querySingleRecord(), querySingleString(),
+     querySingleNumber(), queryStringList() and recordCount() are reused for identical
+     statements until a table they depend on is modified using the same connection.
+     Changes made by other connections or applications are not detected.
+     @see KDbConnection::queryResultCacheStatistics()
+     @since 3.2 */
+    qint64 queryResultCacheSize() const;
+
+    /*! Sets maximum memory in bytes used for caching results of queries to @a bytes.
+     The option can be changed for an opened connection.
+     @since 3.2 */
+    void setQueryResultCacheSize(qint64 bytes);
+
     //! Inserts option with a given @a name, @a value and @a caption.
     //! If such option exists, value is updated but caption only if existing caption is empty.
     //! @a name must be a valid identifier (see KDb::isIdentifier()).
@@ -78,9 +114,20 @@ public:
     //! Removes option with a given @a name if exists.
     void remove(const QByteArray &name);
 
+    /*! @return true if option @a name is read-only.
+     Values of read-only options are provided by the connection, for example to report
+     settings of the database engine that are in effect. insert(), setValue() and remove()
+     do not change read-only options.
+     @since 3.2 */
+    bool isReadOnlyOption(const QByteArray &name) const;
+
 private:
     void setConnection(KDbConnection *connection);
 
+    //! Inserts read-only option @a name or updates its value, used by KDbConnection
+    void setReadOnlyOption(const QByteArray &name, const QVariant &value, const QString &caption);
+
+    friend class KDbConnection;
     friend class KDbConnectionPrivate;
 
     class Private;
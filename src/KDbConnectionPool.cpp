@@ -0,0 +1,405 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbConnectionPool.h"
+#include "KDbConnection.h"
+#include "KDbConnectionData.h"
+#include "KDbConnectionOptions.h"
+#include "KDbDriver.h"
+#include "KDbError.h"
+#include "KDbTransaction.h"
+#include "kdb_debug.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QSet>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <climits>
+
+//! @internal
+class Q_DECL_HIDDEN KDbConnectionPool::Private
+{
+public:
+    Private(KDbDriver *drv, const KDbConnectionData &data, const KDbConnectionOptions &opt,
+            const QString &dbName)
+        : driver(drv)
+        , connData(data)
+        , options(opt)
+        , databaseName(dbName.isEmpty() ? data.databaseName() : dbName)
+        , maximumSize(qMax(1, QThread::idealThreadCount()))
+    {
+    }
+
+    //! Connection waiting in the pool
+    struct IdleConnection {
+        KDbConnection *connection;
+        QElapsedTimer idleTime;
+    };
+
+    //! @return number of connections owned by the pool, including ones being opened
+    int count() const {
+        return idle.count() + inUse.count() + opening;
+    }
+
+    /*! Opens a new connection and uses the database. Called without the mutex locked.
+     The driver keeps result of createConnection() so calls are serialized for all pools. */
+    KDbConnection *open(KDbResult *result) {
+        KDbConnection *conn;
+        {
+            static QMutex driverMutex;
+            QMutexLocker locker(&driverMutex);
+            conn = driver->createConnection(connData, options);
+            if (!conn) {
+                *result = driver->result();
+                return nullptr;
+            }
+        }
+        if (!conn->connect() || !conn->useDatabase(databaseName)) {
+            *result = conn->result();
+            delete conn;
+            return nullptr;
+        }
+        return conn;
+    }
+
+    //! @return true if @a conn passes @a check. Called without the mutex locked.
+    bool isHealthy(KDbConnection *conn, HealthCheck check) const {
+        if (!conn->isConnected() || conn->currentDatabase() != databaseName) {
+            return false;
+        }
+        switch (check) {
+        case HealthCheck::None:
+            return true;
+        case HealthCheck::ServerVersion:
+            return !conn->serverVersion().isNull();
+        case HealthCheck::Ping: {
+            // a cached result would not prove that the server is still reachable
+            int number;
+            return true == conn->querySingleNumber(KDbEscapedString("SELECT 1"), &number, 0,
+                                                   KDbConnection::QueryRecordOption::NoResultCache);
+        }
+        }
+        return false;
+    }
+
+    /*! Takes connections idle longer than idleTimeout out of the pool as long as
+     the pool has more than minimumSize connections. Called with the mutex locked. */
+    QList<KDbConnection*> takeExpiredConnections() {
+        QList<KDbConnection*> expired;
+        if (idleTimeout < 0) {
+            return expired;
+        }
+        int total = count();
+        // the least recently released connections are at the beginning
+        while (!idle.isEmpty() && total > minimumSize
+               && idle.first().idleTime.hasExpired(idleTimeout))
+        {
+            expired.append(idle.takeFirst().connection);
+            --total;
+        }
+        metrics.evictedCount += expired.count();
+        metrics.destroyedCount += expired.count();
+        return expired;
+    }
+
+    KDbDriver * const driver;
+    const KDbConnectionData connData;
+    const KDbConnectionOptions options;
+    const QString databaseName;
+    mutable QMutex mutex;
+    QWaitCondition released; //!< Signaled when a connection returns or a slot is freed
+    QList<IdleConnection> idle; //!< Most recently released connections are at the end
+    QSet<KDbConnection*> inUse;
+    int opening = 0; //!< Number of connections being opened outside of the mutex
+    int minimumSize = 0;
+    int maximumSize;
+    int idleTimeout = 60000;
+    HealthCheck healthCheck = HealthCheck::Ping;
+    Metrics metrics;
+};
+
+KDbConnectionPool::KDbConnectionPool(KDbDriver *driver, const KDbConnectionData &connData,
+                                     const QString &databaseName)
+    : d(new Private(driver, connData, KDbConnectionOptions(), databaseName))
+{
+}
+
+KDbConnectionPool::KDbConnectionPool(KDbDriver *driver, const KDbConnectionData &connData,
+                                     const KDbConnectionOptions &options,
+                                     const QString &databaseName)
+    : d(new Private(driver, connData, options, databaseName))
+{
+}
+
+KDbConnectionPool::~KDbConnectionPool()
+{
+    if (!d->inUse.isEmpty()) {
+        kdbWarning() << "Closing" << d->inUse.count() << "connections that are still in use";
+    }
+    for (const Private::IdleConnection &idle : d->idle) {
+        delete idle.connection;
+    }
+    qDeleteAll(d->inUse);
+    delete d;
+}
+
+KDbDriver *KDbConnectionPool::driver() const
+{
+    return d->driver;
+}
+
+QString KDbConnectionPool::databaseName() const
+{
+    return d->databaseName;
+}
+
+void KDbConnectionPool::setMinimumSize(int size)
+{
+    QMutexLocker locker(&d->mutex);
+    d->minimumSize = qMax(0, size);
+}
+
+int KDbConnectionPool::minimumSize() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->minimumSize;
+}
+
+void KDbConnectionPool::setMaximumSize(int size)
+{
+    if (size < 1) {
+        return;
+    }
+    QMutexLocker locker(&d->mutex);
+    d->maximumSize = size;
+    d->released.wakeAll();
+}
+
+int KDbConnectionPool::maximumSize() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->maximumSize;
+}
+
+void KDbConnectionPool::setIdleTimeout(int msecs)
+{
+    QMutexLocker locker(&d->mutex);
+    d->idleTimeout = msecs;
+}
+
+int KDbConnectionPool::idleTimeout() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->idleTimeout;
+}
+
+void KDbConnectionPool::setHealthCheck(HealthCheck check)
+{
+    QMutexLocker locker(&d->mutex);
+    d->healthCheck = check;
+}
+
+KDbConnectionPool::HealthCheck KDbConnectionPool::healthCheck() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->healthCheck;
+}
+
+KDbConnection *KDbConnectionPool::acquire(int timeoutMsecs, KDbResult *result)
+{
+    QElapsedTimer waitTime;
+    QMutexLocker locker(&d->mutex);
+    const auto acquired = [this, &waitTime](KDbConnection *conn) {
+        d->inUse.insert(conn);
+        ++d->metrics.acquiredCount;
+        if (waitTime.isValid()) {
+            d->metrics.totalWaitTime += waitTime.elapsed();
+        }
+        return conn;
+    };
+    forever {
+        const QList<KDbConnection*> expired = d->takeExpiredConnections();
+        if (!expired.isEmpty()) {
+            locker.unlock();
+            qDeleteAll(expired);
+            locker.relock();
+        }
+        if (!d->idle.isEmpty()) {
+            KDbConnection *conn = d->idle.takeLast().connection;
+            const HealthCheck check = d->healthCheck;
+            ++d->opening; // keep the slot while checking
+            locker.unlock();
+            const bool healthy = d->isHealthy(conn, check);
+            if (!healthy) {
+                kdbWarning() << "Dropping connection that failed health check";
+                delete conn;
+            }
+            locker.relock();
+            --d->opening;
+            if (healthy) {
+                return acquired(conn);
+            }
+            ++d->metrics.failedHealthCheckCount;
+            ++d->metrics.destroyedCount;
+            continue; // the slot is free now
+        }
+        if (d->count() < d->maximumSize) {
+            ++d->opening;
+            locker.unlock();
+            KDbResult openResult;
+            KDbConnection *conn = d->open(&openResult);
+            locker.relock();
+            --d->opening;
+            if (!conn) {
+                if (result) {
+                    *result = openResult;
+                }
+                d->released.wakeOne(); // let another thread try
+                return nullptr;
+            }
+            ++d->metrics.createdCount;
+            return acquired(conn);
+        }
+        if (!waitTime.isValid()) {
+            waitTime.start();
+            ++d->metrics.waitCount;
+        }
+        unsigned long remaining = ULONG_MAX;
+        if (timeoutMsecs >= 0) {
+            const qint64 left = timeoutMsecs - waitTime.elapsed();
+            if (left <= 0) {
+                ++d->metrics.timeoutCount;
+                d->metrics.totalWaitTime += waitTime.elapsed();
+                if (result) {
+                    *result = KDbResult(ERR_OTHER,
+                                        tr("No connection available in the pool within %1 ms.")
+                                        .arg(timeoutMsecs));
+                }
+                return nullptr;
+            }
+            remaining = static_cast<unsigned long>(left);
+        }
+        d->released.wait(&d->mutex, remaining);
+    }
+}
+
+void KDbConnectionPool::release(KDbConnection *connection)
+{
+    if (!connection) {
+        return;
+    }
+    {
+        QMutexLocker locker(&d->mutex);
+        if (!d->inUse.contains(connection)) {
+            kdbWarning() << "Connection" << connection << "has not been acquired from the pool";
+            return;
+        }
+    }
+    // the connection is still counted as in use while it is being cleaned up
+    bool reusable = connection->isConnected() && connection->currentDatabase() == d->databaseName;
+    if (reusable) {
+        for (KDbTransaction transaction : connection->transactions()) {
+            if (transaction.isActive() && !connection->rollbackTransaction(transaction)) {
+                reusable = false;
+                break;
+            }
+        }
+    }
+    if (!reusable) {
+        delete connection;
+    }
+    QList<KDbConnection*> expired;
+    {
+        QMutexLocker locker(&d->mutex);
+        d->inUse.remove(connection);
+        if (reusable) {
+            Private::IdleConnection idle;
+            idle.connection = connection;
+            idle.idleTime.start();
+            d->idle.append(idle);
+        } else {
+            ++d->metrics.destroyedCount;
+        }
+        expired = d->takeExpiredConnections();
+        d->released.wakeOne();
+    }
+    qDeleteAll(expired);
+}
+
+bool KDbConnectionPool::fill(KDbResult *result)
+{
+    QMutexLocker locker(&d->mutex);
+    while (d->count() < qMin(d->minimumSize, d->maximumSize)) {
+        ++d->opening;
+        locker.unlock();
+        KDbResult openResult;
+        KDbConnection *conn = d->open(&openResult);
+        locker.relock();
+        --d->opening;
+        if (!conn) {
+            if (result) {
+                *result = openResult;
+            }
+            return false;
+        }
+        ++d->metrics.createdCount;
+        Private::IdleConnection idle;
+        idle.connection = conn;
+        idle.idleTime.start();
+        d->idle.append(idle);
+        d->released.wakeOne();
+    }
+    return true;
+}
+
+int KDbConnectionPool::evictIdleConnections()
+{
+    QList<KDbConnection*> expired;
+    {
+        QMutexLocker locker(&d->mutex);
+        expired = d->takeExpiredConnections();
+    }
+    qDeleteAll(expired);
+    return expired.count();
+}
+
+void KDbConnectionPool::clear()
+{
+    QList<KDbConnection*> connections;
+    {
+        QMutexLocker locker(&d->mutex);
+        for (const Private::IdleConnection &idle : d->idle) {
+            connections.append(idle.connection);
+        }
+        d->idle.clear();
+        d->metrics.destroyedCount += connections.count();
+    }
+    qDeleteAll(connections);
+}
+
+KDbConnectionPool::Metrics KDbConnectionPool::metrics() const
+{
+    QMutexLocker locker(&d->mutex);
+    Metrics metrics = d->metrics;
+    metrics.idleCount = d->idle.count();
+    metrics.inUseCount = d->inUse.count();
+    return metrics;
+}
@@ -0,0 +1,203 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_CONNECTIONPOOL_H
+#define KDB_CONNECTIONPOOL_H
+
+#include <QCoreApplication>
+
+#include "KDbResult.h"
+
+class KDbConnection;
+class KDbConnectionData;
+class KDbConnectionOptions;
+class KDbDriver;
+
+/*! @brief Thread-safe pool of database connections
+
+ KDbConnection objects are not thread-safe and are expensive to open: connecting, using
+ the database and loading schemas take time. The pool keeps a number of open connections
+ to a single database so they can be reused by worker threads. A connection is owned by
+ a single thread between acquire() and release(); any thread can acquire and release.
+
+ Connections are created using KDbDriver::createConnection() with the data and options
+ passed to the pool. Released connections are kept connected with the database used, so
+ schema objects they have cached stay valid for the next user. Transactions left active
+ are rolled back on release.
+
+ Example:
+ @code
+ KDbConnectionPool pool(driver, connData);
+ pool.setMaximumSize(4);
+ // in a worker thread:
+ KDbConnectionPoolGuard guard(&pool);
+ if (guard.connection()) {
+     KDbCursor *cursor = guard.connection()->executeQuery(...);
+     ...
+ }
+ @endcode
+
+ Idle connections exceeding minimumSize() are closed after idleTimeout(). This happens
+ on acquire(), release() and evictIdleConnections(); the pool does not use timers.
+
+ Since the pool is shared by threads, it has no result() of its own. Details of errors
+ are returned by acquire() and fill() using their @a result arguments.
+ @since 3.2 */
+class KDB_EXPORT KDbConnectionPool
+{
+    Q_DECLARE_TR_FUNCTIONS(KDbConnectionPool)
+public:
+    //! Method of checking connections before they are handed out by acquire()
+    enum class HealthCheck {
+        None,          //!< Only KDbConnection::isConnected() is checked
+        ServerVersion, //!< Server version must be known, i.e. KDbConnection::serverVersion()
+                       //!< must not be null; there is no roundtrip to the server
+        Ping           //!< A trivial query is executed, the default
+    };
+
+    //! Usage statistics of the pool, see metrics()
+    struct Metrics {
+        int idleCount = 0;                 //!< Connections waiting in the pool
+        int inUseCount = 0;                //!< Connections currently acquired
+        quint64 createdCount = 0;          //!< Connections opened so far
+        quint64 destroyedCount = 0;        //!< Connections closed so far
+        quint64 acquiredCount = 0;         //!< Successful calls of acquire()
+        quint64 waitCount = 0;             //!< Calls of acquire() that had to wait
+        quint64 timeoutCount = 0;          //!< Calls of acquire() that timed out
+        quint64 failedHealthCheckCount = 0; //!< Connections dropped by health checks
+        quint64 evictedCount = 0;          //!< Connections closed because of being idle
+        qint64 totalWaitTime = 0;          //!< Time spent waiting in acquire(), in milliseconds
+    };
+
+    /*! Creates pool of connections to database @a databaseName using @a driver,
+     @a connData and @a options. If @a databaseName is empty,
+     KDbConnectionData::databaseName() is used as for KDbConnection::useDatabase().
+     No connection is opened until acquire() or fill() is called. */
+    KDbConnectionPool(KDbDriver *driver, const KDbConnectionData &connData,
+                      const QString &databaseName = QString());
+
+    //! @overload
+    KDbConnectionPool(KDbDriver *driver, const KDbConnectionData &connData,
+                      const KDbConnectionOptions &options,
+                      const QString &databaseName = QString());
+
+    /*! Closes all connections of the pool. Connections that are still acquired
+     are closed too, so the pool should be destroyed after its users are done. */
+    ~KDbConnectionPool();
+
+    //! @return driver used for creating connections
+    KDbDriver *driver() const;
+
+    //! @return name of the database used by pooled connections
+    QString databaseName() const;
+
+    /*! Sets number of connections that are kept open even if they are idle.
+     The default is 0. Use fill() to open them in advance. */
+    void setMinimumSize(int size);
+
+    //! @return number of connections that are kept open even if they are idle
+    int minimumSize() const;
+
+    /*! Sets maximum number of connections that can be open at the same time.
+     acquire() waits for a released connection if the maximum is reached.
+     The default is QThread::idealThreadCount(). Values smaller than 1 are ignored. */
+    void setMaximumSize(int size);
+
+    //! @return maximum number of connections that can be open at the same time
+    int maximumSize() const;
+
+    /*! Sets time in milliseconds after which idle connections are closed.
+     Connections are not closed if the pool would have fewer than minimumSize() connections.
+     The default is 60000. Negative value disables eviction. */
+    void setIdleTimeout(int msecs);
+
+    //! @return time in milliseconds after which idle connections are closed
+    int idleTimeout() const;
+
+    //! Sets method of checking connections before they are handed out by acquire()
+    void setHealthCheck(HealthCheck check);
+
+    //! @return method of checking connections before they are handed out by acquire()
+    HealthCheck healthCheck() const;
+
+    /*! @return a connection that is open and has the database used.
+     If there is no idle connection and maximumSize() is reached, waits up to
+     @a timeoutMsecs milliseconds for a connection to be released; -1 means no limit.
+     The connection must be returned to the pool using release().
+     @c nullptr is returned on timeout or if a new connection could not be opened;
+     @a result is set to the details in this case if it is not @c nullptr. */
+    KDbConnection *acquire(int timeoutMsecs = -1, KDbResult *result = nullptr);
+
+    /*! Returns @a connection previously obtained with acquire() to the pool.
+     Active transactions of @a connection are rolled back. The connection is closed
+     if it has been disconnected or the database is no longer used. */
+    void release(KDbConnection *connection);
+
+    /*! Opens connections until the pool has at least minimumSize() connections.
+     @return false if a connection could not be opened; @a result is set to the details
+     in this case if it is not @c nullptr. */
+    bool fill(KDbResult *result = nullptr);
+
+    /*! Closes connections that have been idle longer than idleTimeout() as long as
+     the pool has more than minimumSize() connections.
+     @return number of connections closed. */
+    int evictIdleConnections();
+
+    //! Closes all idle connections regardless of minimumSize()
+    void clear();
+
+    //! @return current usage statistics of the pool
+    Metrics metrics() const;
+
+private:
+    Q_DISABLE_COPY(KDbConnectionPool)
+    class Private;
+    Private * const d;
+};
+
+/*! @brief Acquires a connection from KDbConnectionPool and releases it on destruction
+ @since 3.2 */
+class KDbConnectionPoolGuard
+{
+public:
+    //! Acquires connection from @a pool, see KDbConnectionPool::acquire()
+    explicit KDbConnectionPoolGuard(KDbConnectionPool *pool, int timeoutMsecs = -1,
+                                    KDbResult *result = nullptr)
+        : m_pool(pool)
+        , m_connection(pool->acquire(timeoutMsecs, result))
+    {
+    }
+
+    //! Releases the connection back to the pool
+    ~KDbConnectionPoolGuard() {
+        if (m_connection) {
+            m_pool->release(m_connection);
+        }
+    }
+
+    //! @return acquired connection or @c nullptr if it could not be acquired
+    KDbConnection *connection() const { return m_connection; }
+
+private:
+    Q_DISABLE_COPY(KDbConnectionPoolGuard)
+    KDbConnectionPool * const m_pool;
+    KDbConnection * const m_connection;
+};
+
+#endif
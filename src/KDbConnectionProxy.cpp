@@ -369,20 +369,22 @@ tristate KDbConnectionProxy::querySingleNumber(KDbQuerySchema* query, int* numbe
     return d->connection->querySingleNumber(query, number, params, column, options);
 }
 
-bool KDbConnectionProxy::queryStringList(const KDbEscapedString& sql, QStringList* list, int column)
+bool KDbConnectionProxy::queryStringList(const KDbEscapedString& sql, QStringList* list, int column,
+                                         QueryRecordOptions options)
 {
-    return d->connection->queryStringList(sql, list, column);
+    return d->connection->queryStringList(sql, list, column, options);
 }
 
-bool KDbConnectionProxy::queryStringList(KDbQuerySchema* query, QStringList* list, int column)
+bool KDbConnectionProxy::queryStringList(KDbQuerySchema* query, QStringList* list, int column,
+                                         QueryRecordOptions options)
 {
-    return d->connection->queryStringList(query, list, column);
+    return d->connection->queryStringList(query, list, column, options);
 }
 
 bool KDbConnectionProxy::queryStringList(KDbQuerySchema* query, QStringList* list,
-                     const QList<QVariant>& params, int column)
+                     const QList<QVariant>& params, int column, QueryRecordOptions options)
 {
-    return d->connection->queryStringList(query, list, params, column);
+    return d->connection->queryStringList(query, list, params, column, options);
 }
 
 tristate KDbConnectionProxy::resultExists(const KDbEscapedString& sql, QueryRecordOptions options)
@@ -807,9 +809,11 @@ tristate KDbConnectionProxy::querySingleNumberInternal(const KDbEscapedString* s
 
 bool KDbConnectionProxy::queryStringListInternal(const KDbEscapedString *sql, QStringList* list,
                              KDbQuerySchema* query, const QList<QVariant>* params,
-                             int column, bool (*filterFunction)(const QString&))
+                             int column, bool (*filterFunction)(const QString&),
+                             QueryRecordOptions options)
 {
-    return d->connection->queryStringListInternal(sql, list, query, params, column, filterFunction);
+    return d->connection->queryStringListInternal(sql, list, query, params, column, filterFunction,
+                                                  options);
 }
 
 KDbCursor* KDbConnectionProxy::executeQueryInternal(const KDbEscapedString& sql, KDbQuerySchema* query,
@@ -189,12 +189,15 @@ public:
                                const QList<QVariant>& params, int column = 0,
                                QueryRecordOptions options = QueryRecordOption::Default);
 
-    bool queryStringList(const KDbEscapedString& sql, QStringList* list, int column = 0);
+    bool queryStringList(const KDbEscapedString& sql, QStringList* list, int column = 0,
+                         QueryRecordOptions options = QueryRecordOption::Default);
 
-    bool queryStringList(KDbQuerySchema* query, QStringList* list, int column = 0);
+    bool queryStringList(KDbQuerySchema* query, QStringList* list, int column = 0,
+                         QueryRecordOptions options = QueryRecordOption::Default);
 
     bool queryStringList(KDbQuerySchema* query, QStringList* list,
-                         const QList<QVariant>& params, int column = 0);
+                         const QList<QVariant>& params, int column = 0,
+                         QueryRecordOptions options = QueryRecordOption::Default);
 
     tristate resultExists(const KDbEscapedString &sql, QueryRecordOptions options
                           = QueryRecordOption::Default);
@@ -389,7 +392,8 @@ public:
 
     bool queryStringListInternal(const KDbEscapedString *sql, QStringList* list,
                                  KDbQuerySchema* query, const QList<QVariant>* params,
-                                 int column, bool (*filterFunction)(const QString&));
+                                 int column, bool (*filterFunction)(const QString&),
+                                 QueryRecordOptions options);
 
     KDbCursor* executeQueryInternal(const KDbEscapedString& sql, KDbQuerySchema* query,
                                     const QList<QVariant>* params);
@@ -27,8 +27,12 @@
 #include "KDbParser.h"
 #include "KDbProperties.h"
 #include "KDbQuerySchema_p.h"
+#include "KDbQueryResultCache_p.h"
+#include "KDbRecordData.h"
 #include "KDbVersionInfo.h"
 
+#include <QCache>
+
 //! Interface for accessing connection's internal result, for use by drivers.
 class KDB_EXPORT KDbConnectionInternal
 {
@@ -39,6 +43,31 @@ private:
     Q_DISABLE_COPY(KDbConnectionInternal)
 };
 
+//! @internal Prepared statement cached by KDbConnectionPrivate::recordStatement()
+class KDbRecordStatement
+{
+public:
+    KDbRecordStatement() {}
+    KDbFieldList fields; //!< fields of the SET section of UPDATE, not owned
+    KDbField::List keyFields{false}; //!< fields of the WHERE section, not owned
+    KDbPreparedStatement statement;
+private:
+    Q_DISABLE_COPY(KDbRecordStatement)
+};
+
+//! @internal Definition of a table read by KDbConnectionPrivate::preloadTableSchemas()
+class KDbPreloadedTableSchema
+{
+public:
+    KDbPreloadedTableSchema() {}
+    ~KDbPreloadedTableSchema() { qDeleteAll(fields); }
+    QScopedPointer<KDbRecordData> object; //!< record of kexi__objects
+    QList<KDbRecordData*> fields; //!< records of kexi__fields ordered by f_order, owned
+    QString extendedSchema; //!< "extended_schema" data block, empty if there is no such block
+private:
+    Q_DISABLE_COPY(KDbPreloadedTableSchema)
+};
+
 class KDbConnectionPrivate
 {
     Q_DECLARE_TR_FUNCTIONS(KDbConnectionPrivate)
@@ -117,12 +146,46 @@ public:
      On failure deletes @a table and returns @c nullptr. */
     Q_REQUIRED_RESULT KDbTableSchema *setupTableSchema(KDbTableSchema *table);
 
+    /*! Reads definitions of all tables of the current database using three queries:
+     for kexi__objects, kexi__fields and kexi__objectdata. Used by useDatabase() when
+     KDbConnectionOptions::tableSchemaPreloading() is not None. For the Eager mode
+     all table schemas are created immediately.
+     @return true on success */
+    bool preloadTableSchemas(bool eager);
+
+    //! @return identifier of table @a name preloaded by preloadTableSchemas()
+    //! or -1 if there is no such table
+    inline int preloadedTableId(const QString &name) const {
+        return m_preloadedTableIds.value(name, -1);
+    }
+
+    /*! @return a full table schema for table @a id created from definition read by
+     preloadTableSchemas(). The definition is removed, so it is used only once.
+     Connection keeps ownership of the returned object.
+     @c nullptr is returned on failure or if there is no definition for the table. */
+    KDbTableSchema *setupPreloadedTableSchema(int id);
+
+    //! Removes definitions read by preloadTableSchemas()
+    void clearPreloadedTableSchemas();
+
     /*! @return a full query schema for a query using 'kexi__*' system tables.
      Connection keeps ownership of the returned object.
      Used internally by querySchema() methods.
      On failure deletes @a query and returns @c nullptr. */
     Q_REQUIRED_RESULT KDbQuerySchema *setupQuerySchema(KDbQuerySchema *query);
 
+    /*! @return query schema parsed earlier from SQL statement @a sql by setupQuerySchema()
+     or @c nullptr if there is no such query in the cache.
+     The returned object is a template owned by the cache and should be copied before use. */
+    const KDbQuerySchema* parsedQuery(const QString &sql) const;
+
+    //! Inserts copy of @a query parsed from SQL statement @a sql to the cache of parsed queries
+    void insertParsedQuery(const QString &sql, const KDbQuerySchema &query);
+
+    /*! Removes all parsed queries from the cache. Called on any change of table schemas
+     because the parsed queries point to fields of these tables. */
+    void clearParsedQueries();
+
     //! @return cached fields expanded information for @a query
     KDbQuerySchemaFieldsExpanded *fieldsExpanded(const KDbQuerySchema *query);
 
@@ -132,6 +195,37 @@ public:
     //! Removes cached fields expanded information for @a query
     void removeFieldsExpanded(const KDbQuerySchema *query);
 
+    /*! @return prepared statement of type @a type (UpdateStatement or DeleteStatement)
+     for records of @a table identified by values of @a keyFields. For UPDATE @a fields
+     are fields of the SET section. Statements are created on first use and reused
+     for the same table and fields. @c nullptr is returned if the driver does not
+     support prepared statements. */
+    KDbPreparedStatement* recordStatement(KDbPreparedStatement::Type type, KDbTableSchema *table,
+                                          const KDbFieldList &fields,
+                                          const KDbField::List &keyFields);
+
+    //! Removes prepared statements created by recordStatement() for @a table
+    void removeRecordStatements(const KDbTableSchema *table);
+
+    //! Removes all prepared statements created by recordStatement()
+    void clearRecordStatements();
+
+    /*! Computes native statement @a statement used as a key of the query result cache
+     for raw statement @a sql or for @a query with @a params if @a sql is empty.
+     For @a query, a cursor that is not opened yet is returned in @a cursor. It keeps
+     the generated statement so it is not generated again by executeQuery().
+     Maximum size of the cache is synchronized with KDbConnectionOptions::queryResultCacheSize().
+     @return false if the cache is disabled or the statement could not be generated. */
+    bool queryResultCacheStatement(KDbEscapedString *statement, KDbCursor **cursor,
+                                   const KDbEscapedString &sql, KDbQuerySchema *query,
+                                   const QList<QVariant> *params);
+
+    /*! Opens @a cursor returned by queryResultCacheStatement() or executes raw statement @a sql
+     or @a query with @a params if @a cursor is @c nullptr.
+     @return opened cursor or @c nullptr on failure. */
+    KDbCursor* executeQuery(KDbCursor *cursor, const KDbEscapedString &sql,
+                            KDbQuerySchema *query, const QList<QVariant> *params);
+
     KDbConnection* const conn; //!< The @a KDbConnection instance this @a KDbConnectionPrivate belongs to.
     KDbConnectionData connData; //!< the @a KDbConnectionData used within that connection.
 
@@ -170,6 +264,9 @@ public:
     //! Database properties
     KDbProperties dbProperties;
 
+    //! Results of queries, see KDbConnectionOptions::queryResultCacheSize()
+    KDbQueryResultCache queryResultCache;
+
     QString availableDatabaseName; //!< used by anyAvailableDatabaseName()
     QString usedDatabase; //!< database name that is opened now (the currentDatabase() name)
 
@@ -207,6 +304,14 @@ private:
     QHash<int, KDbQuerySchema*> m_queries;
     QHash<QString, KDbQuerySchema*> m_queriesByName;
     KDbUtils::AutodeletedHash<const KDbQuerySchema*, KDbQuerySchemaFieldsExpanded*> m_fieldsExpandedCache;
+    //! Prepared statements of recordStatement(), by table and type with field names
+    QHash<const KDbTableSchema*, QHash<QString, KDbRecordStatement*>> m_recordStatements;
+    //! Definitions of tables read by preloadTableSchemas(), by identifier
+    QHash<int, KDbPreloadedTableSchema*> m_preloadedTables;
+    //! Identifiers of tables read by preloadTableSchemas(), by name
+    QHash<QString, int> m_preloadedTableIds;
+    //! Queries parsed by setupQuerySchema(), by SQL statement
+    QCache<QString, KDbQuerySchema> m_parsedQueries;
     Q_DISABLE_COPY(KDbConnectionPrivate)
 };
 
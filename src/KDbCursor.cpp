@@ -25,6 +25,7 @@
 #include "KDb.h"
 #include "KDbNativeStatementBuilder.h"
 #include "KDbQuerySchema.h"
+#include "KDbRecordBatch.h"
 #include "KDbRecordData.h"
 #include "KDbRecordEditBuffer.h"
 #include "kdb_debug.h"
@@ -49,6 +50,7 @@ public:
     //! @todo IMPORTANT: use something like QPointer<KDbConnection> conn;
     KDbConnection *conn;
     KDbEscapedString rawSql;
+    KDbEscapedString preparedSql; //!< statement generated by prepareStatement(), used by next open()
     bool opened;
     bool atLast;
     bool readAhead;
@@ -199,6 +201,107 @@ bool KDbCursor::storeCurrentRecord(KDbRecordData* data) const
     return drv_storeCurrentRecord(data);
 }
 
+KDbRecordBatch* KDbCursor::createRecordBatch(int capacity) const
+{
+    QVector<KDbRecordBatch::ColumnType> columnTypes;
+    if (m_visibleFieldsExpanded) {
+        const int count = qMin(m_fieldsToStoreInRecord, m_visibleFieldsExpanded->count());
+        columnTypes.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            columnTypes.append(KDbRecordBatch::columnType(*m_visibleFieldsExpanded->at(i)->field()));
+        }
+    } else {
+        columnTypes.fill(KDbRecordBatch::ColumnType::Variant, m_fieldsToStoreInRecord);
+    }
+    KDbRecordBatch *batch = new KDbRecordBatch(columnTypes, capacity);
+    if (!batch->isValid()) {
+        delete batch;
+        return nullptr;
+    }
+    return batch;
+}
+
+bool KDbCursor::storeCurrentRecord(KDbRecordBatch* batch) const
+{
+    if (!batch) {
+        return false;
+    }
+    const int row = batch->appendRecord();
+    if (row < 0) {
+        return false;
+    }
+    return drv_storeCurrentRecordInBatch(batch, row);
+}
+
+bool KDbCursor::drv_storeCurrentRecordInBatch(KDbRecordBatch* batch, int row) const
+{
+    KDbRecordData data(m_fieldsToStoreInRecord);
+    if (!drv_storeCurrentRecord(&data)) {
+        return false;
+    }
+    const int count = qMin(batch->columnCount(), data.count());
+    for (int i = 0; i < count; ++i) {
+        batch->setValue(row, i, data.at(i));
+    }
+    return true;
+}
+
+int KDbCursor::fetchBatch(KDbRecordBatch* batch, int maxRows)
+{
+    if (!d->opened || !batch) {
+        return -1;
+    }
+    const int available = batch->capacity() - batch->count();
+    if (maxRows < 0 || maxRows > available) {
+        maxRows = available;
+    }
+    if (m_afterLast || maxRows == 0) {
+        return 0;
+    }
+    clearResult();
+    const int count = drv_fetchBatch(batch, maxRows);
+    if (count < 0 || m_fetchResult == FetchResult::Error) {
+        return -1;
+    }
+    return count;
+}
+
+int KDbCursor::drv_fetchBatch(KDbRecordBatch* batch, int maxRows)
+{
+    int count = 0;
+    while (count < maxRows && getNextRecord()) {
+        if (!storeCurrentRecord(batch)) {
+            return -1;
+        }
+        ++count;
+    }
+    return count;
+}
+
+void KDbCursor::batchFetched(int count)
+{
+    if (count > 0) {
+        m_at += count;
+        d->readAhead = false;
+        d->validRecord = true;
+        // the driver points to the last fetched record
+        d->atBuffer = isBuffered() && m_at <= m_records_in_buf;
+    }
+    if (m_fetchResult != FetchResult::Ok) { // there are no more records
+        if (isBuffered()) {
+            m_buffering_completed = true;
+        }
+        d->validRecord = false;
+        d->atBuffer = false;
+        m_afterLast = true;
+        m_at = -1; //position is invalid now and will not be used
+        if (m_fetchResult == FetchResult::Error && !m_result.isError()) { // keep driver's error
+            m_result = KDbResult(ERR_CURSOR_RECORD_FETCHING,
+                                 tr("Could not fetch next record."));
+        }
+    }
+}
+
 bool KDbCursor::open()
 {
     if (d->opened) {
@@ -215,18 +318,11 @@ bool KDbCursor::open()
                                  tr("No query statement or schema defined."));
             return false;
         }
-        KDbSelectStatementOptions options;
-        options.setAlsoRetrieveRecordId(d->containsRecordIdInfo); /*get record Id if needed*/
-        KDbNativeStatementBuilder builder(d->conn, KDb::DriverEscaping);
         KDbEscapedString sql;
-        if (!builder.generateSelectStatement(&sql, m_query, options, d->queryParameters)
-            || sql.isEmpty())
-        {
-            kdbDebug() << "no statement generated!";
-            m_result = KDbResult(ERR_SQL_EXECUTION_ERROR,
-                                 tr("Could not generate query statement."));
+        if (!prepareStatement(&sql)) {
             return false;
         }
+        d->preparedSql.clear(); // generate again for reopen(), the query could be modified
         m_result.setSql(sql);
 #ifdef KDB_DEBUG_GUI
         KDb::debugGUI(QString::fromLatin1("SQL for query \"%1\": ")
@@ -274,6 +370,29 @@ bool KDbCursor::close()
     return ret;
 }
 
+bool KDbCursor::prepareStatement(KDbEscapedString *sql)
+{
+    Q_ASSERT(sql);
+    Q_ASSERT(m_query);
+    if (!d->preparedSql.isEmpty()) {
+        *sql = d->preparedSql;
+        return true;
+    }
+    KDbSelectStatementOptions options;
+    options.setAlsoRetrieveRecordId(d->containsRecordIdInfo); /*get record Id if needed*/
+    KDbNativeStatementBuilder builder(d->conn, KDb::DriverEscaping);
+    if (!builder.generateSelectStatement(sql, m_query, options, d->queryParameters)
+        || sql->isEmpty())
+    {
+        kdbDebug() << "no statement generated!";
+        m_result = KDbResult(ERR_SQL_EXECUTION_ERROR,
+                             tr("Could not generate query statement."));
+        return false;
+    }
+    d->preparedSql = *sql;
+    return true;
+}
+
 bool KDbCursor::reopen()
 {
     if (!d->opened) {
@@ -428,6 +547,7 @@ bool KDbCursor::getNextRecord()
     if (m_options & KDbCursor::Option::Buffered) {//this cursor is buffered:
 //  kdbDebug() << "m_at < m_records_in_buf :: " << (long)m_at << " < " << m_records_in_buf;
         if (m_at < m_records_in_buf) {//we have next record already buffered:
+            d->readAhead = false; //the record read ahead (if any) is in the buffer too
             if (d->atBuffer) {//we already have got a pointer to buffer
                 drv_bufferMovePointerNext(); //just move to next record in the buffer
             } else {//we have no pointer
@@ -612,6 +732,7 @@ QList<QVariant> KDbCursor::queryParameters() const
 void KDbCursor::setQueryParameters(const QList<QVariant>& params)
 {
     d->queryParameters = params;
+    d->preparedSql.clear();
 }
 
 //! @todo extraMessages
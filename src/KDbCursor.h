@@ -29,6 +29,7 @@
 class KDbConnection;
 class KDbRecordData;
 class KDbQuerySchema;
+class KDbRecordBatch;
 class KDbRecordEditBuffer;
 
 //! Provides database cursor functionality.
@@ -72,7 +73,13 @@ public:
     //! Options that describe behavior of database cursor
     enum class Option {
         None = 0,
-        Buffered = 1
+        Buffered = 1,
+        //! Records are retrieved from the server one by one while moving forward so memory
+        //! usage does not depend on size of the result. Implies forward-only access, i.e.
+        //! the cursor is not buffered. Drivers that do not support streaming ignore this option.
+        //! Until all records are fetched or the cursor is closed the connection may be unable
+        //! to execute other statements. @since 3.2
+        Streaming = 2
     };
     Q_DECLARE_FLAGS(Options, Option)
 
@@ -225,6 +232,39 @@ public:
      @c false is returned if @a data is @c nullptr. */
     bool storeCurrentRecord(KDbRecordData* data) const;
 
+    /*! Allocates a new record batch able to store up to @a capacity records of this cursor.
+     Types of the batch columns are based on fields of the cursor's query. For cursors
+     defined by raw SQL statements columns of KDbRecordBatch::ColumnType::Variant type are
+     created, as many as fields in the current record.
+     @return the new batch or @c nullptr if memory for it could not be allocated
+     @see storeCurrentRecord(KDbRecordBatch*)
+     @since 3.2 */
+    Q_REQUIRED_RESULT KDbRecordBatch *createRecordBatch(int capacity) const;
+
+    /*! Appends current record's data to @a batch without allocating objects for particular
+     values. If the cursor is not at valid record, the result is undefined.
+     If the batch has less columns than the record, remaining values are skipped.
+     @return true on success.
+     @c false is returned if @a batch is @c nullptr or full.
+     @since 3.2 */
+    bool storeCurrentRecord(KDbRecordBatch* batch) const;
+
+    /*! Fetches up to @a maxRows records that follow the current record and appends them
+     to @a batch. This is equivalent of calling moveNext() and storeCurrentRecord(KDbRecordBatch*)
+     in a loop but drivers retrieve the values of all records in a single pass, without
+     intermediate QVariant objects.
+     If @a maxRows is negative or larger than the free space in @a batch, the batch is filled
+     up to its capacity.
+     After fetching, the last record appended to the batch is the current record. If there
+     were less records available than requested, the cursor is moved after the last record
+     and eof() returns true.
+     @return number of records appended to @a batch, 0 if there are no more records
+     or -1 on error. In the latter case the batch may contain records fetched before
+     the error occurred.
+     @see createRecordBatch()
+     @since 3.2 */
+    int fetchBatch(KDbRecordBatch* batch, int maxRows = -1);
+
     bool updateRecord(KDbRecordData* data, KDbRecordEditBuffer* buf, bool useRecordId = false);
 
     bool insertRecord(KDbRecordData* data, KDbRecordEditBuffer* buf, bool getRecrordId = false);
@@ -295,6 +335,32 @@ protected:
      to simple public KDbRecordData representation. */
     virtual bool drv_storeCurrentRecord(KDbRecordData* data) const = 0;
 
+    /*! Puts current record's data into record @a row of @a batch.
+     This method has unspecified behavior if the cursor is not at valid record.
+     @return true on success.
+     Note: For reimplementation in driver's code to convert values from internal representation
+     directly to typed columns of the batch. Default implementation uses
+     drv_storeCurrentRecord(KDbRecordData*) and converts the values.
+     @since 3.2 */
+    virtual bool drv_storeCurrentRecordInBatch(KDbRecordBatch* batch, int row) const;
+
+    /*! Appends up to @a maxRows records following the current one to @a batch;
+     @a maxRows is positive and never exceeds free space in the batch.
+     If readAhead() is true, the record that has been read ahead is the first one to append.
+     Reimplement this to retrieve the records natively. The reimplementation should set
+     m_fetchResult to FetchResult::End if there are no more records (FetchResult::Error on error),
+     leave the driver's current record at the last record appended and finally call
+     batchFetched() to update position of the cursor.
+     Default implementation uses getNextRecord() and storeCurrentRecord(KDbRecordBatch*).
+     @return number of records appended or -1 on error. */
+    virtual int drv_fetchBatch(KDbRecordBatch* batch, int maxRows);
+
+    /*! Updates position of the cursor after @a count records have been appended
+     by reimplementation of drv_fetchBatch(). If m_fetchResult is not FetchResult::Ok,
+     the cursor is moved after the last record. On FetchResult::Error a generic error
+     is set unless the driver has already set a more specific one in m_result. */
+    void batchFetched(int count);
+
     KDbQuerySchema *m_query;
     bool m_afterLast;
     qint64 m_at;
@@ -326,8 +392,14 @@ protected:
 private:
     bool readAhead() const;
 
+    /*! Generates statement for the query schema of this cursor and keeps it for the next open()
+     so it is not generated twice. Used by the query result cache of the connection.
+     @return false on failure and sets the error. */
+    bool prepareStatement(KDbEscapedString *sql);
+
     Q_DISABLE_COPY(KDbCursor)
     friend class CursorDeleter;
+    friend class KDbConnectionPrivate;
     class Private;
     Private * const d;
 };
@@ -64,7 +64,11 @@ KDbDriver::KDbDriver(QObject *parent, const QVariantList &args)
 KDbDriver::~KDbDriver()
 {
     // make a copy because d->connections will be touched by ~KDbConnection
-    QSet<KDbConnection*> connections(d->connections);
+    QSet<KDbConnection*> connections;
+    {
+        QMutexLocker locker(&d->connectionsMutex);
+        connections = d->connections;
+    }
     qDeleteAll(connections);
     d->connections.clear();
     delete d;
@@ -97,6 +101,7 @@ bool KDbDriver::isValid()
 
 const QSet<KDbConnection*> KDbDriver::connections() const
 {
+    QMutexLocker locker(&d->connectionsMutex);
     return d->connections;
 }
 
@@ -146,6 +151,7 @@ KDbConnection *KDbDriver::createConnection(const KDbConnectionData& connData,
     KDbConnection *conn = drv_createConnection(connData, options);
 
 //! @todo needed? connData->setDriverId(id());
+    QMutexLocker locker(&d->connectionsMutex);
     d->connections.insert(conn);
     return conn;
 }
@@ -158,6 +164,7 @@ KDbConnection *KDbDriver::createConnection(const KDbConnectionData& connData)
 KDbConnection* KDbDriver::removeConnection(KDbConnection *conn)
 {
     clearResult();
+    QMutexLocker locker(&d->connectionsMutex);
     if (d->connections.remove(conn))
         return conn;
     return nullptr;
@@ -20,6 +20,7 @@
 #ifndef KDB_DRIVER_P_H
 #define KDB_DRIVER_P_H
 
+#include <QMutex>
 #include <QSet>
 
 #include "KDbUtils.h"
@@ -49,6 +50,9 @@ public:
 
     QSet<KDbConnection*> connections;
 
+    //! Guards @a connections so connections can be created and deleted in multiple threads
+    mutable QMutex connectionsMutex;
+
     /*! Driver's metadata. */
     const KDbDriverMetaData *metaData;
 
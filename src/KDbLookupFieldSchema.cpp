@@ -22,6 +22,8 @@
 #include "kdb_debug.h"
 
 #include <QDomElement>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 #include <QVariant>
 #include <QStringList>
 #include <QHash>
@@ -558,6 +560,180 @@ void KDbLookupFieldSchema::saveToDom(QDomDocument *doc, QDomElement *parentEl)
     }
 }
 
+//! @internal Loads value of the first child element of the current element of @a reader
+//! and skips the rest of the current element. Used by KDbLookupFieldSchema::loadFromXml().
+static QVariant loadFirstChildValueFromXml(QXmlStreamReader *reader, bool *ok)
+{
+    QVariant val;
+    *ok = false;
+    if (reader->readNextStartElement()) {
+        val = KDb::loadPropertyValueFromXml(reader, ok);
+        reader->skipCurrentElement();
+    }
+    return val;
+}
+
+//! @internal Loads values of all child elements of the current element of @a reader.
+//! Used by KDbLookupFieldSchema::loadFromXml().
+static QVariantList loadChildValuesFromXml(QXmlStreamReader *reader, bool *ok)
+{
+    QVariantList list;
+    *ok = true;
+    while (reader->readNextStartElement()) {
+        bool valueOk;
+        const QVariant val = KDb::loadPropertyValueFromXml(reader, &valueOk);
+        if (!valueOk) {
+            *ok = false;
+        }
+        list.append(val);
+    }
+    return list;
+}
+
+/* static */
+KDbLookupFieldSchema *KDbLookupFieldSchema::loadFromXml(QXmlStreamReader *reader)
+{
+    // see loadFromDom() for description of the format;
+    // elements are always read completely, also on errors
+    QScopedPointer<KDbLookupFieldSchema> lookupFieldSchema(new KDbLookupFieldSchema);
+    KDbLookupFieldSchemaRecordSource recordSource;
+    bool ok = true;
+    while (reader->readNextStartElement()) {
+        const QByteArray name(reader->name().toLatin1());
+        if (name == "row-source") {
+            while (reader->readNextStartElement()) {
+                const QByteArray childName(reader->name().toLatin1());
+                if (childName == "type") {
+                    recordSource.setTypeByName(reader->readElementText(QXmlStreamReader::IncludeChildElements));
+                } else if (childName == "name") {
+                    recordSource.setName(reader->readElementText(QXmlStreamReader::IncludeChildElements));
+                } else {
+                    reader->skipCurrentElement();
+                }
+            }
+        } else if (name == "bound-column") {
+            bool valueOk;
+            const QVariant val = loadFirstChildValueFromXml(reader, &valueOk);
+            if (!valueOk || !::setBoundColumn(lookupFieldSchema.data(), val)) {
+                ok = false;
+            }
+        } else if (name == "visible-column") {
+            bool valueOk;
+            const QVariantList list = loadChildValuesFromXml(reader, &valueOk);
+            if (!valueOk || !::setVisibleColumns(lookupFieldSchema.data(), list)) {
+                ok = false;
+            }
+        } else if (name == "column-widths") {
+            bool valueOk;
+            const QVariantList columnWidths = loadChildValuesFromXml(reader, &valueOk);
+            if (!valueOk || !::setColumnWidths(lookupFieldSchema.data(), columnWidths)) {
+                ok = false;
+            }
+        } else if (name == "show-column-headers" || name == "list-rows" || name == "limit-to-list") {
+            bool valueOk;
+            const QVariant val = loadFirstChildValueFromXml(reader, &valueOk);
+            if (!valueOk) {
+                ok = false;
+            } else if (name == "show-column-headers") {
+                if (val.type() == QVariant::Bool)
+                    lookupFieldSchema->setColumnHeadersVisible(val.toBool());
+            } else if (name == "list-rows") {
+                if (val.type() == QVariant::Int)
+                    lookupFieldSchema->setMaxVisibleRecords(val.toInt());
+            } else {
+                if (val.type() == QVariant::Bool)
+                    lookupFieldSchema->setLimitToList(val.toBool());
+            }
+        } else if (name == "display-widget") {
+            const QByteArray displayWidgetName(
+                reader->readElementText(QXmlStreamReader::IncludeChildElements).toLatin1());
+            if (displayWidgetName == "combobox") {
+                lookupFieldSchema->setDisplayWidget(KDbLookupFieldSchema::DisplayWidget::ComboBox);
+            }
+            else if (displayWidgetName == "listbox") {
+                lookupFieldSchema->setDisplayWidget(KDbLookupFieldSchema::DisplayWidget::ListBox);
+            }
+        } else {
+            reader->skipCurrentElement();
+        }
+    }
+    if (!ok || reader->hasError()) {
+        return nullptr;
+    }
+    lookupFieldSchema->setRecordSource(recordSource);
+    return lookupFieldSchema.take();
+}
+
+void KDbLookupFieldSchema::saveToXml(QXmlStreamWriter *writer) const
+{
+    // as in saveToDom(), nothing is saved if there is no record source
+    if (!writer || recordSource().name().isEmpty()) {
+        return;
+    }
+    writer->writeStartElement(QLatin1String("lookup-column"));
+
+    writer->writeStartElement(QLatin1String("row-source"));
+    writer->writeTextElement(QLatin1String("type"), recordSource().typeName()); //can be empty
+    writer->writeTextElement(QLatin1String("name"), recordSource().name());
+    const QStringList values(recordSource().values());
+    if (!values.isEmpty()) {
+        writer->writeStartElement(QLatin1String("values"));
+        for (const QString &value : values) {
+            writer->writeTextElement(QLatin1String("value"), value);
+        }
+        writer->writeEndElement(); // values
+    }
+    writer->writeEndElement(); // row-source
+
+    if (boundColumn() >= 0) {
+        writer->writeStartElement(QLatin1String("bound-column"));
+        writer->writeTextElement(QLatin1String("number"), QString::number(boundColumn()));
+        writer->writeEndElement();
+    }
+
+    const QList<int> visibleColumns(this->visibleColumns());
+    if (!visibleColumns.isEmpty()) {
+        writer->writeStartElement(QLatin1String("visible-column"));
+        for (int visibleColumn : visibleColumns) {
+            writer->writeTextElement(QLatin1String("number"), QString::number(visibleColumn));
+        }
+        writer->writeEndElement();
+    }
+
+    const QList<int> columnWidths(this->columnWidths());
+    if (!columnWidths.isEmpty()) {
+        writer->writeStartElement(QLatin1String("column-widths"));
+        for (int columnWidth : columnWidths) {
+            writer->writeTextElement(QLatin1String("number"), QString::number(columnWidth));
+        }
+        writer->writeEndElement();
+    }
+
+    if (columnHeadersVisible() != KDB_LOOKUP_FIELD_DEFAULT_HEADERS_VISIBLE) {
+        writer->writeStartElement(QLatin1String("show-column-headers"));
+        writer->writeTextElement(QLatin1String("bool"),
+                                 columnHeadersVisible() ? QLatin1String("true") : QLatin1String("false"));
+        writer->writeEndElement();
+    }
+    if (maxVisibleRecords() != KDB_LOOKUP_FIELD_DEFAULT_MAX_VISIBLE_RECORDS) {
+        writer->writeStartElement(QLatin1String("list-rows"));
+        writer->writeTextElement(QLatin1String("number"), QString::number(maxVisibleRecords()));
+        writer->writeEndElement();
+    }
+    if (limitToList() != KDB_LOOKUP_FIELD_DEFAULT_LIMIT_TO_LIST) {
+        writer->writeStartElement(QLatin1String("limit-to-list"));
+        writer->writeTextElement(QLatin1String("bool"),
+                                 limitToList() ? QLatin1String("true") : QLatin1String("false"));
+        writer->writeEndElement();
+    }
+
+    if (displayWidget() != KDB_LOOKUP_FIELD_DEFAULT_DISPLAY_WIDGET) {
+        writer->writeTextElement(QLatin1String("display-widget"),
+            QLatin1String((displayWidget() == DisplayWidget::ListBox) ? "listbox" : "combobox"));
+    }
+    writer->writeEndElement(); // lookup-column
+}
+
 void KDbLookupFieldSchema::getProperties(QMap<QByteArray, QVariant> *values) const
 {
     values->clear();
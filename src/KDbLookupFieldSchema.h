@@ -28,6 +28,8 @@ class QStringList;
 class QDomElement;
 class QDomDocument;
 class QVariant;
+class QXmlStreamReader;
+class QXmlStreamWriter;
 
 //! default value for KDbLookupFieldSchema::columnHeadersVisible()
 #define KDB_LOOKUP_FIELD_DEFAULT_HEADERS_VISIBLE false
@@ -211,6 +213,18 @@ public:
      Does nothing if @a doc or @a parentEl is @c nullptr. */
     void saveToDom(QDomDocument *doc, QDomElement *parentEl);
 
+    /*! Loads data of lookup column schema from the current "lookup-column" element of @a reader.
+     Like loadFromDom() but the element is read using a stream reader. The element is read
+     completely, so @a reader is then positioned at its end element.
+     @return a new KDbLookupFieldSchema object or @c nullptr for invalid contents.
+     @since 3.2 */
+    static KDbLookupFieldSchema* loadFromXml(QXmlStreamReader *reader);
+
+    /*! Saves data of lookup column schema as a "lookup-column" element using @a writer.
+     The output is the same as for saveToDom(). Does nothing if @a writer is @c nullptr.
+     @since 3.2 */
+    void saveToXml(QXmlStreamWriter *writer) const;
+
     /*! Gets property values for the lookup schema.
      @a values is cleared before filling.
      This function is used e.g. for altering table design. */
@@ -18,6 +18,7 @@
 */
 
 #include "KDbPreparedStatement.h"
+#include "KDbConnection.h"
 #include "KDbPreparedStatementInterface.h"
 #include "KDbSqlResult.h"
 #include "KDbTableSchema.h"
@@ -32,7 +33,8 @@ KDbPreparedStatement::Data::Data(Type _type, KDbPreparedStatementInterface* _ifa
                                  KDbFieldList* _fields,
      const QStringList& _whereFieldNames)
     : type(_type), fields(_fields), whereFieldNames(_whereFieldNames)
-    , fieldsForParameters(nullptr), whereFields(nullptr), dirty(true), iface(_iface)
+    , fieldsForParameters(nullptr), whereFields(nullptr), parameterFields(nullptr)
+    , dirty(true), iface(_iface)
     , lastInsertRecordId(std::numeric_limits<quint64>::max())
 {
 }
@@ -41,6 +43,7 @@ KDbPreparedStatement::Data::~Data()
 {
     delete iface;
     delete whereFields;
+    delete parameterFields;
 }
 
 KDbPreparedStatement::KDbPreparedStatement()
@@ -78,6 +81,12 @@ bool KDbPreparedStatement::execute(const KDbPreparedStatementParameters& paramet
         }
         d->dirty = false;
     }
+    if (d->type != SelectStatement) {
+        KDbTableSchema *table = d->fields->isEmpty() ? nullptr : d->fields->field(0)->table();
+        if (table && table->connection()) {
+            table->connection()->invalidateQueryResultCache(table->name());
+        }
+    }
     QSharedPointer<KDbSqlResult> result
         = d->iface->execute(d->type, *d->fieldsForParameters, d->fields, parameters);
     if (!result) {
@@ -95,6 +104,10 @@ bool KDbPreparedStatement::generateStatementString(KDbEscapedString * s)
         return generateSelectStatementString(s);
     case InsertStatement:
         return generateInsertStatementString(s);
+    case UpdateStatement:
+        return generateUpdateStatementString(s);
+    case DeleteStatement:
+        return generateDeleteStatementString(s);
     default:;
     }
     kdbCritical() << "Unsupported type" << d->type;
@@ -116,7 +129,7 @@ bool KDbPreparedStatement::generateSelectStatementString(KDbEscapedString * s)
     // create WHERE
     first = true;
     delete d->whereFields;
-    d->whereFields = new KDbField::List();
+    d->whereFields = new KDbField::List(false); // fields are owned by d->fields
     foreach(const QString& whereItem, d->whereFieldNames) {
         if (first) {
             s->append(" WHERE ");
@@ -170,6 +183,75 @@ bool KDbPreparedStatement::generateInsertStatementString(KDbEscapedString * s)
     return true;
 }
 
+//! @internal @return @a name escaped using @a table's connection
+static QString escapeIdentifier(const KDbTableSchema &table, const QString &name)
+{
+    return table.connection() ? table.connection()->escapeIdentifier(name) : name;
+}
+
+bool KDbPreparedStatement::generateUpdateStatementString(KDbEscapedString * s)
+{
+    KDbTableSchema *table = d->fields->isEmpty() ? nullptr : d->fields->field(0)->table();
+    if (!table || d->whereFieldNames.isEmpty()) {
+        return false;
+    }
+    delete d->parameterFields;
+    d->parameterFields = new KDbField::List(false); // fields are owned by the table
+    *s = KDbEscapedString("UPDATE ") + escapeIdentifier(*table, table->name()) + " SET ";
+    bool first = true;
+    foreach(KDbField *f, *d->fields->fields()) {
+        if (f->table() != table) {
+            kdbWarning() << "field" << f->name() << "does not belong to table"
+                         << table->name() << ", aborting";
+            s->clear();
+            return false;
+        }
+        if (first) {
+            first = false;
+        } else {
+            s->append(",");
+        }
+        s->append(escapeIdentifier(*table, f->name()) + QLatin1String("=?"));
+        d->parameterFields->append(f);
+    }
+    return appendWhereSection(s, table);
+}
+
+bool KDbPreparedStatement::generateDeleteStatementString(KDbEscapedString * s)
+{
+    KDbTableSchema *table = d->fields->isEmpty() ? nullptr : d->fields->field(0)->table();
+    if (!table || d->whereFieldNames.isEmpty()) { // do not allow to delete all records
+        return false;
+    }
+    delete d->parameterFields;
+    d->parameterFields = new KDbField::List(false); // fields are owned by the table
+    *s = KDbEscapedString("DELETE FROM ") + escapeIdentifier(*table, table->name());
+    return appendWhereSection(s, table);
+}
+
+bool KDbPreparedStatement::appendWhereSection(KDbEscapedString *s, KDbTableSchema *table)
+{
+    bool first = true;
+    foreach(const QString& whereItem, d->whereFieldNames) {
+        if (first) {
+            s->append(" WHERE ");
+            first = false;
+        } else {
+            s->append(" AND ");
+        }
+        KDbField *f = table->field(whereItem);
+        if (!f) {
+            kdbWarning() << "field" << whereItem << "not found, aborting";
+            s->clear();
+            return false;
+        }
+        d->parameterFields->append(f);
+        s->append(escapeIdentifier(*table, whereItem) + QLatin1String("=?"));
+    }
+    d->fieldsForParameters = d->parameterFields;
+    return true;
+}
+
 bool KDbPreparedStatement::isValid() const
 {
     return d->type != InvalidStatement;
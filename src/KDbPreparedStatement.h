@@ -28,6 +28,7 @@
 #include "KDbResult.h"
 
 class KDbFieldList;
+class KDbTableSchema;
 class KDbPreparedStatementInterface;
 
 //! Prepared statement paraneters used in KDbPreparedStatement::execute()
@@ -35,7 +36,7 @@ typedef QList<QVariant> KDbPreparedStatementParameters;
 
 /*! @short Prepared database command for optimizing sequences of multiple database actions
 
-  Currently INSERT and SELECT statements are supported.
+  Currently INSERT, SELECT, UPDATE and DELETE statements are supported.
   For example when using KDbPreparedStatement for INSERTs,
   you can gain about 30% speedup compared to using multiple
   connection.insertRecord(*tabelSchema, dbRecordBuffer).
@@ -68,6 +69,17 @@ typedef QList<QVariant> KDbPreparedStatementParameters;
   If you do not call clearParameters() after every insert, you can insert
   the same value multiple times using execute() what increases efficiency even more.
 
+  For UPDATE statements fields of the SET section are specified by the field list
+  and fields of the WHERE section by field names. Parameters for execute() are values
+  of the SET section followed by values of the WHERE section. For DELETE statements
+  only the WHERE section is used, so parameters are values for fields named by
+  whereFieldNames(). The field list only specifies the table, for example:
+  @code
+    KDbPreparedStatement statement = conn->prepareStatement(
+      KDbPreparedStatement::DeleteStatement, tableSchema, QStringList() << "id");
+    statement.execute(KDbPreparedStatementParameters() << 12);
+  @endcode
+
   Another use case is inserting large objects (BLOBs or CLOBs).
   Depending on database backend, you can avoid escaping BLOBs.
   See KexiFormView::storeData() for example use.
@@ -80,7 +92,9 @@ public:
     enum Type {
         InvalidStatement, //!< Used only in invalid statements
         SelectStatement,  //!< SELECT statement will be prepared end executed
-        InsertStatement   //!< INSERT statement will be prepared end executed
+        InsertStatement,  //!< INSERT statement will be prepared end executed
+        UpdateStatement,  //!< UPDATE statement will be prepared end executed
+        DeleteStatement   //!< DELETE statement will be prepared end executed
     };
 
     //! @internal
@@ -95,6 +109,9 @@ public:
         QStringList whereFieldNames;
         const KDbField::List* fieldsForParameters; //!< fields where we'll put the inserted parameters
         KDbField::List* whereFields; //!< temporary, used for select statements, based on whereFieldNames
+        KDbField::List* parameterFields; //!< temporary, used for update and delete statements,
+                                         //!< fields of the SET section followed by fields
+                                         //!< of the WHERE section
         bool dirty; //!< true if the statement has to be internally
                     //!< prepared (possible again) before calling executeInternal()
         KDbPreparedStatementInterface *iface;
@@ -148,6 +165,12 @@ private:
     bool generateStatementString(KDbEscapedString* s);
     bool generateSelectStatementString(KDbEscapedString * s);
     bool generateInsertStatementString(KDbEscapedString * s);
+    bool generateUpdateStatementString(KDbEscapedString * s);
+    bool generateDeleteStatementString(KDbEscapedString * s);
+
+    //! Appends " WHERE name1=? AND name2=?..." to @a s and appends the WHERE fields
+    //! found in @a table to d->parameterFields.
+    bool appendWhereSection(KDbEscapedString *s, KDbTableSchema *table);
 
     QSharedDataPointer<Data> d;
 };
@@ -0,0 +1,279 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbQueryResultCache_p.h"
+
+#include <climits>
+
+//! Approximate fixed memory used by a single entry, its key and index items
+static const int entryOverhead = 128;
+
+//! @return approximate memory used by @a value
+static int valueSize(const QVariant &value)
+{
+    switch (value.type()) {
+    case QVariant::String:
+        return int(sizeof(QVariant)) + 2 * value.toString().size();
+    case QVariant::ByteArray:
+        return int(sizeof(QVariant)) + value.toByteArray().size();
+    default:
+        return int(sizeof(QVariant));
+    }
+}
+
+//! @return approximate memory used by @a entry with key @a key
+static int entrySize(const QByteArray &key, const KDbQueryResultCache::Entry &entry)
+{
+    int size = entryOverhead + key.size();
+    for (const QVariant &value : entry.values) {
+        size += valueSize(value);
+    }
+    for (const QString &string : entry.strings) {
+        size += int(sizeof(QString)) + 2 * string.size();
+    }
+    return size;
+}
+
+static bool isIdentifierCharacter(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+           || c == '_' || (c & 0x80); // non-ASCII UTF-8 bytes
+}
+
+/*! @return lower-case identifiers found in @a sql, quoted identifiers are unquoted.
+ Contents of string literals and numbers are skipped. */
+static QSet<QString> identifiers(const KDbEscapedString &sql)
+{
+    QSet<QString> result;
+    const char *data = sql.constData();
+    const int length = sql.length();
+    for (int i = 0; i < length;) {
+        const char c = data[i];
+        if (c == '\'') { // string literal, '' is an escaped quote
+            for (++i; i < length; ++i) {
+                if (data[i] == '\'') {
+                    if (i + 1 < length && data[i + 1] == '\'') {
+                        ++i;
+                    } else {
+                        break;
+                    }
+                }
+            }
+            ++i;
+        } else if (c == '"' || c == '`' || c == '[') { // quoted identifier
+            const char end = c == '[' ? ']' : c;
+            const int start = i + 1;
+            for (++i; i < length && data[i] != end; ++i) {
+            }
+            result.insert(QString::fromUtf8(data + start, i - start).toLower());
+            ++i;
+        } else if (isIdentifierCharacter(c)) {
+            const int start = i;
+            for (++i; i < length && isIdentifierCharacter(data[i]); ++i) {
+            }
+            if (!(c >= '0' && c <= '9')) {
+                result.insert(QString::fromUtf8(data + start, i - start).toLower());
+            }
+        } else {
+            ++i;
+        }
+    }
+    return result;
+}
+
+//! @return first word of @a sql in upper case
+static QByteArray firstWord(const KDbEscapedString &sql)
+{
+    const char *data = sql.constData();
+    const int length = sql.length();
+    int start = 0;
+    while (start < length && !isIdentifierCharacter(data[start])) {
+        ++start;
+    }
+    int end = start;
+    while (end < length && isIdentifierCharacter(data[end])) {
+        ++end;
+    }
+    return QByteArray(data + start, end - start).toUpper();
+}
+
+KDbQueryResultCache::KDbQueryResultCache()
+    : m_entries(0)
+{
+}
+
+KDbQueryResultCache::~KDbQueryResultCache()
+{
+}
+
+void KDbQueryResultCache::setMaximumSize(qint64 bytes)
+{
+    const int maxCost = int(qBound(qint64(0), bytes, qint64(INT_MAX)));
+    if (maxCost == m_entries.maxCost()) {
+        return;
+    }
+    m_entries.setMaxCost(maxCost);
+    if (maxCost == 0) { // numbers of records are kept
+        m_keysByName.clear();
+        m_indexedKeyCount = 0;
+    }
+}
+
+qint64 KDbQueryResultCache::maximumSize() const
+{
+    return m_entries.maxCost();
+}
+
+bool KDbQueryResultCache::isEnabled() const
+{
+    return m_entries.maxCost() > 0;
+}
+
+QByteArray KDbQueryResultCache::key(Kind kind, const KDbEscapedString &sql, int column)
+{
+    QByteArray result;
+    result.reserve(sql.length() + 8);
+    result.append(static_cast<char>(kind));
+    result.append(QByteArray::number(column));
+    result.append(':');
+    result.append(sql.toByteArray());
+    return result;
+}
+
+const KDbQueryResultCache::Entry* KDbQueryResultCache::find(const QByteArray &key)
+{
+    const Entry *entry = m_entries.object(key);
+    if (entry) {
+        ++m_hits;
+    } else {
+        ++m_misses;
+    }
+    return entry;
+}
+
+void KDbQueryResultCache::insert(const QByteArray &key, const KDbEscapedString &sql, Entry *entry)
+{
+    if (!m_entries.insert(key, entry, entrySize(key, *entry))) { // too large, deleted by QCache
+        return;
+    }
+    for (const QString &name : identifiers(sql)) {
+        m_keysByName[name].insert(key);
+        ++m_indexedKeyCount;
+    }
+    if (m_indexedKeyCount > 16 * (m_entries.count() + 16)) {
+        squeezeIndex();
+    }
+}
+
+void KDbQueryResultCache::squeezeIndex()
+{
+    m_indexedKeyCount = 0;
+    for (auto it = m_keysByName.begin(); it != m_keysByName.end();) {
+        QSet<QByteArray> &keys = it.value();
+        for (auto keyIt = keys.begin(); keyIt != keys.end();) {
+            if (m_entries.contains(*keyIt)) {
+                ++keyIt;
+            } else {
+                keyIt = keys.erase(keyIt);
+            }
+        }
+        if (keys.isEmpty()) {
+            it = m_keysByName.erase(it);
+        } else {
+            m_indexedKeyCount += keys.count();
+            ++it;
+        }
+    }
+}
+
+qint64 KDbQueryResultCache::recordCount(const QString &tableName) const
+{
+    return m_recordCounts.value(tableName.toLower(), -1);
+}
+
+void KDbQueryResultCache::setRecordCount(const QString &tableName, qint64 count)
+{
+    m_recordCounts.insert(tableName.toLower(), count);
+}
+
+void KDbQueryResultCache::invalidate(const QString &tableName)
+{
+    if (m_keysByName.isEmpty() && m_recordCounts.isEmpty()) {
+        return;
+    }
+    m_recordCounts.remove(tableName.toLower());
+    const QSet<QByteArray> keys = m_keysByName.take(tableName.toLower());
+    m_indexedKeyCount -= keys.count();
+    for (const QByteArray &key : keys) {
+        if (m_entries.remove(key)) {
+            ++m_invalidations;
+        }
+    }
+}
+
+void KDbQueryResultCache::invalidateForStatement(const KDbEscapedString &sql)
+{
+    if (m_entries.isEmpty() && m_recordCounts.isEmpty()) {
+        return;
+    }
+    const QByteArray word = firstWord(sql);
+    if (word == "SELECT" || word == "EXPLAIN" || word == "SHOW" || word == "PRAGMA"
+        || word == "SET" || word == "BEGIN" || word == "START" || word == "COMMIT"
+        || word == "END" || word == "SAVEPOINT" || word == "RELEASE" || word == "ANALYZE"
+        || word == "VACUUM")
+    {
+        return; // data is not modified
+    }
+    if (word == "INSERT" || word == "UPDATE" || word == "DELETE" || word == "REPLACE"
+        || word == "MERGE" || word == "UPSERT" || word == "WITH")
+    {
+        for (const QString &name : identifiers(sql)) {
+            invalidate(name);
+        }
+        return;
+    }
+    // schema changes, rollbacks and unknown statements
+    invalidateAll();
+}
+
+void KDbQueryResultCache::invalidateAll()
+{
+    m_invalidations += m_entries.count();
+    clear();
+}
+
+void KDbQueryResultCache::clear()
+{
+    m_entries.clear();
+    m_keysByName.clear();
+    m_recordCounts.clear();
+    m_indexedKeyCount = 0;
+}
+
+KDbConnection::QueryResultCacheStatistics KDbQueryResultCache::statistics() const
+{
+    KDbConnection::QueryResultCacheStatistics statistics;
+    statistics.hits = m_hits;
+    statistics.misses = m_misses;
+    statistics.invalidations = m_invalidations;
+    statistics.entryCount = m_entries.count();
+    statistics.memoryUsage = m_entries.totalCost();
+    statistics.maximumSize = m_entries.maxCost();
+    return statistics;
+}
@@ -0,0 +1,124 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_QUERYRESULTCACHE_P_H
+#define KDB_QUERYRESULTCACHE_P_H
+
+#include "KDbConnection.h"
+
+#include <QCache>
+#include <QHash>
+#include <QSet>
+
+/*! @internal Memory-bounded cache of results of single-record, single-value and
+ string list queries, see KDbConnectionOptions::queryResultCacheSize()
+
+ The cache also keeps exact numbers of records of tables, see
+ KDbConnection::cachedRecordCount(). These are not limited by the option and are
+ invalidated together with the query results.
+
+ Entries are keyed on the native SQL statement, which already includes values of
+ query parameters. Every identifier found in the statement is recorded, so all
+ entries that may depend on a table can be removed when the table is modified.
+ This is conservative: an entry can also be removed when a column or alias
+ of the same name is modified. */
+class KDbQueryResultCache
+{
+public:
+    //! Kind of cached result, part of the key
+    enum class Kind : char {
+        Record = 'r',
+        String = 's',
+        StringList = 'l'
+    };
+
+    //! Cached result of a query
+    class Entry
+    {
+    public:
+        tristate result = true; //!< true or cancelled if there was no record
+        QList<QVariant> values; //!< Values of the record or the single value
+        QStringList strings;    //!< Values of the string list
+    };
+
+    KDbQueryResultCache();
+
+    ~KDbQueryResultCache();
+
+    /*! Sets maximum memory used by the entries to @a bytes. 0 disables the cache.
+     Least recently used entries are removed if needed. */
+    void setMaximumSize(qint64 bytes);
+
+    //! @return maximum memory used by the entries, 0 if the cache is disabled
+    qint64 maximumSize() const;
+
+    //! @return true if maximumSize() is not 0
+    bool isEnabled() const;
+
+    //! @return key for result of @a kind of @a sql for column @a column
+    static QByteArray key(Kind kind, const KDbEscapedString &sql, int column = 0);
+
+    //! @return entry for @a key or @c nullptr if there is no such entry; updates statistics
+    const Entry* find(const QByteArray &key);
+
+    /*! Inserts @a entry for @a key computed for @a sql. Ownership of @a entry is transferred.
+     The entry is not inserted if it is larger than maximumSize(). */
+    void insert(const QByteArray &key, const KDbEscapedString &sql, Entry *entry);
+
+    //! @return cached number of records of table @a tableName or -1 if it is not known
+    qint64 recordCount(const QString &tableName) const;
+
+    //! Sets cached number of records of table @a tableName to @a count
+    void setRecordCount(const QString &tableName, qint64 count);
+
+    //! Removes entries and number of records that depend on table @a tableName
+    void invalidate(const QString &tableName);
+
+    /*! Removes entries that may be out of date after executing @a sql.
+     Entries that depend on tables modified by data manipulation statements are removed.
+     Statements that do not modify data such as SELECT or COMMIT do not remove anything.
+     Other statements such as ROLLBACK or schema changes remove all entries. */
+    void invalidateForStatement(const KDbEscapedString &sql);
+
+    //! Removes all entries because any table could have been modified
+    void invalidateAll();
+
+    //! Removes all entries
+    void clear();
+
+    //! @return statistics of the cache
+    KDbConnection::QueryResultCacheStatistics statistics() const;
+
+private:
+    //! Removes keys of entries that are no longer cached from m_keysByName
+    void squeezeIndex();
+
+    QCache<QByteArray, Entry> m_entries;
+    //! Keys of entries by lower-case identifiers found in their statements
+    QHash<QString, QSet<QByteArray>> m_keysByName;
+    //! Numbers of records by lower-case table names
+    QHash<QString, qint64> m_recordCounts;
+    int m_indexedKeyCount = 0;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+    quint64 m_invalidations = 0;
+    Q_DISABLE_COPY(KDbQueryResultCache)
+};
+
+#endif
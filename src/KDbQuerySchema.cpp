@@ -81,10 +81,11 @@ KDbQuerySchema::KDbQuerySchema(const KDbQuerySchema& querySchema, KDbConnection
         , KDbObject(querySchema)
         , d(new KDbQuerySchemaPrivate(this, querySchema.d))
 {
-    //only deep copy query asterisks
+    //only deep copy query asterisks and expression fields owned by the query
     for (KDbField* f :  qAsConst(*querySchema.fields())) {
         KDbField *copiedField;
-        if (dynamic_cast<KDbQueryAsterisk*>(f)) {
+        const bool ownedExpression = querySchema.d->ownedExpressionFields.contains(f);
+        if (ownedExpression || dynamic_cast<KDbQueryAsterisk*>(f)) {
             copiedField = f->copy();
             if (static_cast<const KDbFieldList *>(f->parent()) == &querySchema) {
                 copiedField->setParent(this);
@@ -93,6 +94,9 @@ KDbQuerySchema::KDbQuerySchema(const KDbQuerySchema& querySchema, KDbConnection
         else {
             copiedField = f;
         }
+        if (ownedExpression) {
+            d->ownedExpressionFields.append(copiedField);
+        }
         addField(copiedField);
     }
     // this deep copy must be after the 'd' initialization because fieldsExpanded() is used there
@@ -261,10 +265,11 @@ bool KDbQuerySchema::addExpressionInternal(const KDbExpression& expr, bool visib
     } else {
         ok = addInvisibleField(field);
     }
-    if (!ok) {
+    if (ok) {
+        d->ownedExpressionFields.append(field);
+    } else {
         delete field;
     }
-    d->ownedExpressionFields.append(field);
     return ok;
 }
 
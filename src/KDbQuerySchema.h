@@ -65,7 +65,8 @@ public:
     explicit KDbQuerySchema(KDbTableSchema *tableSchema);
 
     /*! Copy constructor. Creates deep copy of @a querySchema.
-     KDbQueryAsterisk objects are deeply copied while only pointers to KDbField objects are copied. */
+     KDbQueryAsterisk objects and fields of expression columns are deeply copied while only
+     pointers to other KDbField objects (owned by tables) are copied. */
     KDbQuerySchema(const KDbQuerySchema& querySchema, KDbConnection *conn);
 
     ~KDbQuerySchema() override;
@@ -41,6 +41,9 @@ KDbQuerySchemaPrivate::KDbQuerySchemaPrivate(KDbQuerySchema* q, KDbQuerySchemaPr
     if (copy) {
         // deep copy
         *this = *copy;
+        query = q; // overwritten above
+        // fields expanded of the copy are not cached yet
+        recentConnection = nullptr;
         // <clear, so computeFieldsExpanded() will re-create it>
         orderByColumnList = nullptr;
         autoincFields = nullptr;
@@ -57,6 +60,10 @@ KDbQuerySchemaPrivate::KDbQuerySchemaPrivate(KDbQuerySchema* q, KDbQuerySchemaPr
         asterisks.setAutoDelete(false);
         asterisks.clear();
         asterisks.setAutoDelete(true);
+        // the same for expression fields
+        ownedExpressionFields.setAutoDelete(false);
+        ownedExpressionFields.clear();
+        ownedExpressionFields.setAutoDelete(true);
     }
     else {
         orderByColumnList = new KDbOrderByColumnList;
@@ -0,0 +1,216 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbRecordBatch.h"
+#include "KDbRecordData.h"
+#include "KDbUtils.h"
+#include "kdb_debug.h"
+
+KDbRecordBatch::KDbRecordBatch(const QVector<ColumnType> &columnTypes, int capacity)
+    : m_columnTypes(columnTypes)
+    , m_capacity(qMax(0, capacity))
+    , m_bitmapSize((m_capacity + 7) / 8)
+{
+    const size_t cellsSize = size_t(m_columnTypes.count()) * m_capacity * sizeof(Cell);
+    const size_t nullsSize = size_t(m_columnTypes.count()) * m_bitmapSize;
+    m_arena = cellsSize + nullsSize > 0 ? static_cast<char*>(malloc(cellsSize + nullsSize))
+                                        : nullptr;
+    if (!m_arena && cellsSize + nullsSize > 0) {
+        kdbWarning() << "Could not allocate" << cellsSize + nullsSize << "bytes for"
+                     << m_capacity << "records";
+        m_valid = false;
+        m_capacity = 0; // nothing can be appended
+        m_bitmapSize = 0;
+        m_cells = nullptr;
+        m_nulls = nullptr;
+        return;
+    }
+    m_cells = reinterpret_cast<Cell*>(m_arena);
+    m_nulls = reinterpret_cast<quint8*>(m_arena + cellsSize);
+    clear();
+}
+
+KDbRecordBatch::~KDbRecordBatch()
+{
+    free(m_arena);
+}
+
+//static
+KDbRecordBatch::ColumnType KDbRecordBatch::columnType(KDbField::Type type)
+{
+    if (KDbField::isIntegerType(type)) {
+        return ColumnType::Integer;
+    } else if (KDbField::isFPNumericType(type)) {
+        return ColumnType::Double;
+    } else if (type == KDbField::Boolean) {
+        return ColumnType::Boolean;
+    } else if (KDbField::isTextType(type)) {
+        return ColumnType::Text;
+    } else if (type == KDbField::BLOB) {
+        return ColumnType::Binary;
+    }
+    return ColumnType::Variant;
+}
+
+KDbRecordBatch::ColumnType KDbRecordBatch::columnType(const KDbField &field)
+{
+    const KDbField::Type type = field.type(); // evaluating type of expressions can be expensive
+    if (type == KDbField::BigInteger && field.isUnsigned()) {
+        return ColumnType::Variant;
+    }
+    return columnType(type);
+}
+
+void KDbRecordBatch::clear()
+{
+    m_count = 0;
+    if (m_arena) {
+        memset(m_nulls, 0xff, size_t(m_columnTypes.count()) * m_bitmapSize); // all nulls
+    }
+    m_pool.resize(0);
+    m_variants.clear();
+}
+
+QString KDbRecordBatch::textValue(int row, int col) const
+{
+    const Cell &c = cell(row, col);
+    return QString::fromUtf8(m_pool.constData() + c.string.offset, c.string.length);
+}
+
+QByteArray KDbRecordBatch::binaryValue(int row, int col) const
+{
+    const Cell &c = cell(row, col);
+    return QByteArray(m_pool.constData() + c.string.offset, c.string.length);
+}
+
+QVariant KDbRecordBatch::at(int row, int col) const
+{
+    if (isNull(row, col)) {
+        return QVariant();
+    }
+    switch (m_columnTypes.at(col)) {
+    case ColumnType::Integer:
+        return QVariant(integerValue(row, col));
+    case ColumnType::Double:
+        return QVariant(doubleValue(row, col));
+    case ColumnType::Boolean:
+        return QVariant(booleanValue(row, col));
+    case ColumnType::Text:
+        return QVariant(textValue(row, col));
+    case ColumnType::Binary:
+        return QVariant(binaryValue(row, col));
+    case ColumnType::Variant:
+        return m_variants.at(static_cast<int>(cell(row, col).integer));
+    }
+    return QVariant();
+}
+
+void KDbRecordBatch::setString(int row, int col, const char *data, int length)
+{
+    Cell &c = cell(row, col);
+    c.string.offset = m_pool.size();
+    c.string.length = length;
+    m_pool.append(data, length);
+    setNotNull(row, col);
+}
+
+void KDbRecordBatch::setText(int row, int col, const QString &text)
+{
+    const QByteArray utf8(text.toUtf8());
+    setString(row, col, utf8.constData(), utf8.length());
+}
+
+void KDbRecordBatch::setVariant(int row, int col, const QVariant &value)
+{
+    cell(row, col).integer = m_variants.count();
+    m_variants.append(value);
+    setNotNull(row, col);
+}
+
+void KDbRecordBatch::setValue(int row, int col, const QVariant &value)
+{
+    if (value.isNull()) {
+        setNull(row, col);
+        return;
+    }
+    bool ok = true;
+    switch (m_columnTypes.at(col)) {
+    case ColumnType::Integer: {
+        const qint64 integer = value.toLongLong(&ok);
+        if (ok) {
+            setInteger(row, col, integer);
+        }
+        break;
+    }
+    case ColumnType::Double: {
+        const double real = value.toDouble(&ok);
+        if (ok) {
+            setDouble(row, col, real);
+        }
+        break;
+    }
+    case ColumnType::Boolean:
+        setBoolean(row, col, value.toBool());
+        break;
+    case ColumnType::Text:
+        setText(row, col, value.toString());
+        break;
+    case ColumnType::Binary: {
+        const QByteArray binary(value.toByteArray());
+        setString(row, col, binary.constData(), binary.length());
+        break;
+    }
+    case ColumnType::Variant:
+        setVariant(row, col, value);
+        break;
+    }
+    if (!ok) {
+        setNull(row, col);
+    }
+}
+
+void KDbRecordBatch::toRecordData(int row, KDbRecordData *data) const
+{
+    Q_ASSERT(data);
+    data->resize(columnCount());
+    for (int col = 0; col < columnCount(); ++col) {
+        (*data)[col] = at(row, col);
+    }
+}
+
+QDebug operator<<(QDebug dbg, const KDbRecordBatch& batch)
+{
+    dbg.nospace() << "RECORD BATCH (" << batch.count() << "/" << batch.capacity()
+                  << " RECORDS, " << batch.columnCount() << " COLUMNS)";
+    for (int row = 0; row < batch.count(); ++row) {
+        dbg.nospace() << "\n" << row << ":";
+        for (int col = 0; col < batch.columnCount(); ++col) {
+            dbg.nospace() << " " << KDbUtils::squeezedValue(batch.at(row, col));
+        }
+    }
+    return dbg.space();
+}
+
+KDbRecordBatchProducer::~KDbRecordBatchProducer()
+{
+}
+
+KDbRecordBatchConsumer::~KDbRecordBatchConsumer()
+{
+}
@@ -0,0 +1,243 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_RECORDBATCH_H
+#define KDB_RECORDBATCH_H
+
+#include <QVariant>
+#include <QVector>
+
+#include "KDbField.h"
+#include "KDbSqlString.h"
+
+class KDbRecordData;
+
+//! @short Columnar storage for a block of records with type information
+/*! KDbRecordBatch is an alternative to a list of KDbRecordData objects for bulk result sets.
+ Values are not stored as separate QVariant objects. Instead each column is a typed vector
+ and all the vectors of the batch live in a single memory block allocated once, when the batch
+ is created. Text and binary values are copied to a string pool owned by the batch and are
+ referenced by offset and length. Null values are stored in a bitmap, one per column.
+
+ The batch has fixed capacity. Use appendRecord() to add a new record with all values set
+ to null and then the set*() methods to fill it. clear() removes all the records but keeps
+ the memory allocated so the batch can be reused for the next block of records.
+
+ Columns of types that have no typed representation (ColumnType::Variant), such as date
+ and time values, are stored as QVariant objects.
+
+ KDbCursor can fill the batch directly, see KDbCursor::storeCurrentRecord(KDbRecordBatch*).
+ @since 3.2
+*/
+class KDB_EXPORT KDbRecordBatch
+{
+public:
+    //! Type of storage used for a single column
+    enum class ColumnType {
+        Integer, //!< 64-bit integer value
+        Double,  //!< double value
+        Boolean, //!< boolean value
+        Text,    //!< UTF-8 encoded text stored in the string pool
+        Binary,  //!< binary data stored in the string pool
+        Variant  //!< QVariant value, used for types without typed storage
+    };
+
+    /*! Creates a new batch with columns of types @a columnTypes that can store
+     up to @a capacity records. Check isValid() for large capacities. */
+    KDbRecordBatch(const QVector<ColumnType> &columnTypes, int capacity);
+
+    ~KDbRecordBatch();
+
+    //! @return type of storage used for values of type @a type
+    static ColumnType columnType(KDbField::Type type);
+
+    //! @return type of storage used for values of @a field
+    //! Unsigned big integers are stored as variants because values above LLONG_MAX
+    //! do not fit the 64-bit integer storage.
+    static ColumnType columnType(const KDbField &field);
+
+    //! @return number of columns
+    inline int columnCount() const { return m_columnTypes.count(); }
+
+    //! @return type of column @a col
+    inline ColumnType columnType(int col) const { return m_columnTypes.at(col); }
+
+    //! @return false if memory for the requested capacity could not be allocated;
+    //! capacity() is 0 then.
+    inline bool isValid() const { return m_valid; }
+
+    //! @return maximum number of records that can be stored in the batch
+    inline int capacity() const { return m_capacity; }
+
+    //! @return number of records stored in the batch
+    inline int count() const { return m_count; }
+
+    //! @return true if there are no records in the batch
+    inline bool isEmpty() const { return m_count == 0; }
+
+    //! @return true if no more records can be appended
+    inline bool isFull() const { return m_count == m_capacity; }
+
+    /*! Removes all records. Allocated memory is kept for reuse. */
+    void clear();
+
+    /*! Appends new record with all values set to null.
+     @return index of the new record or -1 if the batch is full. */
+    inline int appendRecord() {
+        return m_count < m_capacity ? m_count++ : -1;
+    }
+
+    /*! @return true if value at @a row and @a col is null.
+     @a row and @a col must be valid indices. */
+    inline bool isNull(int row, int col) const {
+        return m_nulls[col * m_bitmapSize + (row >> 3)] & (1 << (row & 7));
+    }
+
+    //! @return integer value at @a row and @a col; column should be of Integer type
+    inline qint64 integerValue(int row, int col) const { return cell(row, col).integer; }
+
+    //! @return double value at @a row and @a col; column should be of Double type
+    inline double doubleValue(int row, int col) const { return cell(row, col).real; }
+
+    //! @return boolean value at @a row and @a col; column should be of Boolean type
+    inline bool booleanValue(int row, int col) const { return cell(row, col).integer != 0; }
+
+    /*! @return text or binary value at @a row and @a col without copying it.
+     The column should be of Text or Binary type.
+     @note The returned object points to the string pool of the batch; it is valid until
+     the batch is modified or destroyed. */
+    inline KDbSqlString stringView(int row, int col) const {
+        const Cell &c = cell(row, col);
+        return KDbSqlString(m_pool.constData() + c.string.offset, c.string.length);
+    }
+
+    //! @return text value at @a row and @a col converted to QString; column should be of Text type
+    QString textValue(int row, int col) const;
+
+    //! @return deep copy of binary value at @a row and @a col; column should be of Binary type
+    QByteArray binaryValue(int row, int col) const;
+
+    /*! @return value at @a row and @a col converted to QVariant.
+     Values of Integer columns are returned as qint64.
+     Null QVariant is returned for null values. */
+    QVariant at(int row, int col) const;
+
+    //! Sets value at @a row and @a col to null
+    inline void setNull(int row, int col) {
+        m_nulls[col * m_bitmapSize + (row >> 3)] |= (1 << (row & 7));
+    }
+
+    //! Sets integer value at @a row and @a col; column should be of Integer type
+    inline void setInteger(int row, int col, qint64 value) {
+        cell(row, col).integer = value;
+        setNotNull(row, col);
+    }
+
+    //! Sets double value at @a row and @a col; column should be of Double type
+    inline void setDouble(int row, int col, double value) {
+        cell(row, col).real = value;
+        setNotNull(row, col);
+    }
+
+    //! Sets boolean value at @a row and @a col; column should be of Boolean type
+    inline void setBoolean(int row, int col, bool value) {
+        cell(row, col).integer = value ? 1 : 0;
+        setNotNull(row, col);
+    }
+
+    /*! Copies @a length bytes of @a data to the string pool and sets it as value
+     at @a row and @a col. The column should be of Text (then @a data should be UTF-8 encoded)
+     or Binary type. */
+    void setString(int row, int col, const char *data, int length);
+
+    //! Sets text value at @a row and @a col; column should be of Text type
+    void setText(int row, int col, const QString &text);
+
+    //! Sets value at @a row and @a col; column should be of Variant type
+    void setVariant(int row, int col, const QVariant &value);
+
+    /*! Sets value at @a row and @a col to @a value converted to column's type.
+     Null @a value sets null. */
+    void setValue(int row, int col, const QVariant &value);
+
+    /*! Copies values of record @a row to @a data.
+     @a data is resized to columnCount(). Values are converted as in at(). */
+    void toRecordData(int row, KDbRecordData *data) const;
+
+private:
+    //! Storage of a single value
+    union Cell {
+        qint64 integer;
+        double real;
+        struct {
+            quint32 offset;
+            quint32 length;
+        } string;
+    };
+
+    inline const Cell& cell(int row, int col) const { return m_cells[col * m_capacity + row]; }
+    inline Cell& cell(int row, int col) { return m_cells[col * m_capacity + row]; }
+
+    inline void setNotNull(int row, int col) {
+        m_nulls[col * m_bitmapSize + (row >> 3)] &= ~(1 << (row & 7));
+    }
+
+    const QVector<ColumnType> m_columnTypes;
+    int m_capacity;
+    int m_bitmapSize; //!< number of bytes of null bitmap for a single column
+    bool m_valid = true;
+    int m_count = 0;
+    char *m_arena;       //!< memory block for cells and null bitmaps of all columns
+    Cell *m_cells;       //!< cells stored column by column, points to m_arena
+    quint8 *m_nulls;     //!< null bitmaps stored column by column, points to m_arena
+    QByteArray m_pool;   //!< string pool for Text and Binary values
+    QVector<QVariant> m_variants; //!< values of Variant columns, indexed by Cell::integer
+    Q_DISABLE_COPY(KDbRecordBatch)
+};
+
+//! Sends information about record batch @a batch to debug output @a dbg.
+KDB_EXPORT QDebug operator<<(QDebug dbg, const KDbRecordBatch& batch);
+
+//! @short An interface for providing records for KDbConnection::importRecords()
+/*! @since 3.2 */
+class KDB_EXPORT KDbRecordBatchProducer
+{
+public:
+    virtual ~KDbRecordBatchProducer();
+
+    /*! Appends next records to @a batch, up to its capacity. @a batch is empty when this method
+     is called. Importing finishes when no records are appended.
+     @return false on error; then importing is cancelled. */
+    virtual bool produceRecords(KDbRecordBatch *batch) = 0;
+};
+
+//! @short An interface for receiving records from KDbConnection::exportRecords()
+/*! @since 3.2 */
+class KDB_EXPORT KDbRecordBatchConsumer
+{
+public:
+    virtual ~KDbRecordBatchConsumer();
+
+    /*! Receives next records in @a batch. The batch is cleared and reused after this method
+     returns so the values should be copied if they are needed later.
+     @return false to cancel exporting. */
+    virtual bool consumeRecords(const KDbRecordBatch &batch) = 0;
+};
+
+#endif
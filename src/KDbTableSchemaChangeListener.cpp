@@ -538,6 +538,8 @@ tristate KDbTableSchemaChangeListener::closeListeners(KDbConnection *conn,
         kdbWarning() << "Missing table";
         return false;
     }
+    // the table is about to change, so queries parsed using it are no longer valid
+    conn->d->clearParsedQueries();
     QSet<KDbTableSchemaChangeListener*> toClose(listeners(conn, table).toSet().subtract(except.toSet()));
     tristate result = true;
     for (KDbTableSchemaChangeListener *listener : qAsConst(toClose)) {
@@ -61,6 +61,16 @@ bool MysqlConnection::drv_connect()
     if (res == false) // sanity
         return false;
     d->lowerCaseTableNames = intLowerCaseTableNames > 0;
+
+    // Statements longer than max_allowed_packet are rejected by the server.
+    // The value is read once because insertions are limited by it.
+    if (true != querySingleNumber(KDbEscapedString("SELECT @@max_allowed_packet"),
+                                  &d->maxAllowedPacket, 0 /*col*/,
+                                  QueryRecordOption::Default | QueryRecordOption::NoResultCache))
+    {
+        d->maxAllowedPacket = 1024 * 1024; // default for MySQL 5.5
+        clearResult(); // not fatal
+    }
     return true;
 }
 
@@ -109,6 +119,9 @@ bool MysqlConnection::drv_getDatabasesList(QStringList* list)
 {
     mysqlDebug();
     list->clear();
+    if (!checkNotBusy()) {
+        return false;
+    }
     MYSQL_RES *res = mysql_list_dbs(d->mysql, nullptr);
     if (res != nullptr) {
         MYSQL_ROW row;
@@ -153,6 +166,9 @@ bool MysqlConnection::drv_useDatabase(const QString &dbName, bool *cancelled, KD
     Q_UNUSED(msgHandler);
 //! @todo is here escaping needed?
     const QString storedDbName(d->lowerCaseTableNames ? dbName.toLower() : dbName);
+    if (!checkNotBusy()) {
+        return false;
+    }
     if (!d->useDatabase(storedDbName)) {
         storeResult();
         return false;
@@ -185,6 +201,9 @@ KDbSqlResult* MysqlConnection::drv_prepareSql(const KDbEscapedString& sql)
 
 bool MysqlConnection::drv_executeSql(const KDbEscapedString& sql)
 {
+    if (!checkNotBusy()) {
+        return false;
+    }
     if (!d->executeSql(sql)) {
         storeResult();
         return false;
@@ -192,6 +211,29 @@ bool MysqlConnection::drv_executeSql(const KDbEscapedString& sql)
     return true;
 }
 
+bool MysqlConnection::drv_insertRecords(const QString &tableName, KDbFieldList *fields,
+                                        const QList<QList<QVariant>> &records)
+{
+    if (!checkNotBusy()) {
+        return false;
+    }
+    // Larger statements do not make insertion faster, so limit the length to 16 MiB.
+    const int maxStatementLength = qBound(1024, d->maxAllowedPacket - 1024, 16 * 1024 * 1024);
+    return insertRecordsUsingMultipleValues(tableName, fields, records, maxStatementLength);
+}
+
+bool MysqlConnection::checkNotBusy()
+{
+    if (d->streamingCursor) {
+        m_result = KDbResult(ERR_SQL_EXECUTION_ERROR,
+                             tr("Could not execute statement because records of another query "
+                                "are being retrieved. Retrieve all the records or close the "
+                                "query first."));
+        return false;
+    }
+    return true;
+}
+
 QString MysqlConnection::serverResultName() const
 {
     return MysqlConnectionInternal::serverResultName(d->mysql);
@@ -203,6 +245,29 @@ tristate MysqlConnection::drv_containsTable(const QString& tableName)
                         .arg(escapeString(tableName)));
 }
 
+tristate MysqlConnection::drv_estimatedRecordCount(const KDbTableSchema &tableSchema,
+                                                  qint64 *count)
+{
+    // Exact for MyISAM, estimated for InnoDB; NULL for views
+    QString number;
+    // Statistics change without modifications of the table so they are not cached
+    const tristate result = querySingleString(
+        KDbEscapedString("SELECT TABLE_ROWS FROM information_schema.TABLES "
+                         "WHERE TABLE_SCHEMA=DATABASE() AND TABLE_NAME=%1")
+            .arg(escapeString(tableSchema.name())), &number, 0,
+        QueryRecordOption::Default | QueryRecordOption::NoResultCache);
+    if (result != true) {
+        return result;
+    }
+    bool ok;
+    const qint64 estimate = number.toLongLong(&ok);
+    if (!ok || estimate < 0) {
+        return cancelled;
+    }
+    *count = estimate;
+    return true;
+}
+
 KDbPreparedStatementInterface* MysqlConnection::prepareStatementInternal()
 {
     return new MysqlPreparedStatement(d);
@@ -29,6 +29,11 @@
 class MysqlConnectionInternal;
 
 /*! @short Provides database connection, allowing queries and data modification.
+
+ Cursors opened with KDbCursor::Option::Streaming retrieve records using mysql_use_result().
+ While such a cursor is retrieving records, MySQL does not allow to execute other statements
+ using the same connection, so they fail with an error until all records are retrieved
+ or the cursor is closed.
 */
 class MysqlConnection : public KDbConnection
 {
@@ -64,18 +69,33 @@ protected:
     Q_REQUIRED_RESULT KDbSqlResult *drv_prepareSql(const KDbEscapedString &sql) override;
     bool drv_executeSql(const KDbEscapedString& sql) override;
 
+    //! Inserts records using INSERT statements with multiple VALUES lists,
+    //! each not longer than the server's max_allowed_packet
+    bool drv_insertRecords(const QString &tableName, KDbFieldList *fields,
+                           const QList<QList<QVariant>> &records) override;
+
     //! Implemented for KDbResultable
     QString serverResultName() const override;
 
 //! @todo move this somewhere to low level class (MIGRATION?)
     tristate drv_containsTable(const QString &tableName) override;
 
+    //! Estimates number of records using information_schema.TABLES.TABLE_ROWS
+    tristate drv_estimatedRecordCount(const KDbTableSchema &tableSchema,
+                                      qint64 *count) override;
+
     void storeResult();
 
+    //! @return true if no streaming cursor is using the connection;
+    //! otherwise sets error in result() and returns false
+    bool checkNotBusy();
+
     MysqlConnectionInternal* const d;
 
     friend class MysqlDriver;
+    friend class MysqlCursor;
     friend class MysqlCursorData;
+    friend class MysqlPreparedStatement;
     friend class MysqlSqlResult;
 private:
     Q_DISABLE_COPY(MysqlConnection)
@@ -39,6 +39,7 @@ MysqlConnectionInternal::MysqlConnectionInternal(KDbConnection* connection)
         , res(0)
         , lowerCaseTableNames(false)
         , serverVersion(0)
+        , maxAllowedPacket(1024 * 1024)
 {
 }
 
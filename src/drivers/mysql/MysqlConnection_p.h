@@ -31,8 +31,11 @@ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
 
 #include <mysql.h>
 
+#include <cstdlib>
+
 class KDbConnectionData;
 class KDbEscapedString;
+class MysqlCursor;
 
 //! Internal MySQL connection data.
 /*! Provides a low-level API for accessing MySQL databases, that can
@@ -79,6 +82,13 @@ public:
     //! See https://dev.mysql.com/doc/refman/5.7/en/mysql-get-server-version.html
     //! @todo store in Connection base class as a property or as public server info
     unsigned long serverVersion;
+    //! Value of the max_allowed_packet variable read after connecting, i.e. the maximum
+    //! length of statements accepted by the server.
+    int maxAllowedPacket;
+    //! Streaming cursor that retrieves records using mysql_use_result(), if any.
+    //! Until all its records are retrieved or it is closed, no other statements can be executed
+    //! using the connection.
+    MysqlCursor *streamingCursor = nullptr;
 private:
     Q_DISABLE_COPY(MysqlConnectionInternal)
 };
@@ -136,6 +146,31 @@ public:
     inline QByteArray toByteArray(int index) override {
         return QByteArray(record[index], lengths[index]);
     }
+    inline bool isNull(int index) override {
+        return !record[index];
+    }
+    inline qint64 int64Value(int index) override {
+        // values of MYSQL_ROW are null-terminated
+        return record[index] ? std::strtoll(record[index], nullptr, 10) : 0;
+    }
+    inline double doubleValue(int index) override {
+        // not std::strtod() as it depends on locale's decimal point
+        return record[index] ? QByteArray::fromRawData(record[index], lengths[index]).toDouble()
+                             : 0.0;
+    }
+    inline bool boolValue(int index) override {
+        const char *value = record[index];
+        if (!value || lengths[index] == 0) {
+            return false;
+        }
+        if (value[0] == 't' || value[0] == 'T') {
+            return true;
+        }
+        return doubleValue(index) != 0.0;
+    }
+    inline KDbSqlString blobView(int index) override {
+        return KDbSqlString(record[index], lengths[index]);
+    }
 
 private:
     MYSQL_ROW record;
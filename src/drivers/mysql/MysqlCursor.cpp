@@ -23,21 +23,33 @@
 #include "MysqlConnection_p.h"
 #include "KDbError.h"
 #include "KDb.h"
+#include "KDbRecordBatch.h"
 #include "KDbRecordData.h"
 
 #include <limits.h>
 
 #define BOOL bool
 
+//! Streaming cursors are unbuffered, other cursors are always buffered
+static inline KDbCursor::Options cursorOptions(KDbCursor::Options options)
+{
+    if (options & KDbCursor::Option::Streaming) {
+        options &= ~KDbCursor::Options(KDbCursor::Option::Buffered);
+    } else {
+        options |= KDbCursor::Option::Buffered;
+    }
+    return options;
+}
+
 MysqlCursor::MysqlCursor(KDbConnection* conn, const KDbEscapedString& sql,
                          KDbCursor::Options options)
-        : KDbCursor(conn, sql, options | KDbCursor::Option::Buffered)
+        : KDbCursor(conn, sql, cursorOptions(options))
         , d(new MysqlCursorData(conn))
 {
 }
 
 MysqlCursor::MysqlCursor(KDbConnection* conn, KDbQuerySchema* query, KDbCursor::Options options)
-        : KDbCursor(conn, query, options | KDbCursor::Option::Buffered)
+        : KDbCursor(conn, query, cursorOptions(options))
         , d(new MysqlCursorData(conn))
 {
 }
@@ -48,8 +60,22 @@ MysqlCursor::~MysqlCursor()
     delete d;
 }
 
+MysqlConnectionInternal* MysqlCursor::connectionInternal()
+{
+    return static_cast<MysqlConnection*>(connection())->d;
+}
+
 bool MysqlCursor::drv_open(const KDbEscapedString& sql)
 {
+    if (connectionInternal()->streamingCursor) {
+        m_result = KDbResult(ERR_SQL_EXECUTION_ERROR,
+                             tr("Could not open query because records of another query "
+                                "are being retrieved."));
+        return false;
+    }
+    if (options() & KDbCursor::Option::Streaming) {
+        return openStreaming(sql);
+    }
     if (mysql_real_query(d->mysql, sql.constData(), sql.length()) == 0) {
         if (mysql_errno(d->mysql) == 0) {
             //! @todo Add option somewhere so we can use more optimal mysql_num_rows().
@@ -69,9 +95,44 @@ bool MysqlCursor::drv_open(const KDbEscapedString& sql)
     return false;
 }
 
+bool MysqlCursor::openStreaming(const KDbEscapedString& sql)
+{
+    if (mysql_real_query(d->mysql, sql.constData(), sql.length()) == 0) {
+        // records are retrieved from the server by mysql_fetch_row()
+        d->mysqlres = mysql_use_result(d->mysql);
+        if (d->mysqlres) {
+            m_fieldCount = mysql_num_fields(d->mysqlres);
+            m_fieldsToStoreInRecord = m_fieldCount;
+            d->numRows = -1; // unknown until all records are retrieved
+            connectionInternal()->streamingCursor = this;
+            return true;
+        }
+    }
+    storeResult();
+    return false;
+}
+
+void MysqlCursor::streamingFinished()
+{
+    if (connectionInternal()->streamingCursor == this) {
+        connectionInternal()->streamingCursor = nullptr;
+    }
+    d->mysqlrow = nullptr;
+    if (mysql_errno(d->mysql) == 0) {
+        m_fetchResult = FetchResult::End;
+    } else {
+        storeResult();
+        m_fetchResult = FetchResult::Error;
+    }
+}
+
 bool MysqlCursor::drv_close()
 {
+    // for streaming cursors this also reads and discards records not retrieved so far
     mysql_free_result(d->mysqlres);
+    if (connectionInternal()->streamingCursor == this) {
+        connectionInternal()->streamingCursor = nullptr;
+    }
     d->mysqlres = nullptr;
     d->mysqlrow = nullptr;
     d->lengths = nullptr;
@@ -81,7 +142,16 @@ bool MysqlCursor::drv_close()
 
 void MysqlCursor::drv_getNextRecord()
 {
-    if (at() >= d->numRows) {
+    if (options() & KDbCursor::Option::Streaming) {
+        d->mysqlrow = mysql_fetch_row(d->mysqlres);
+        if (d->mysqlrow) {
+            d->lengths = mysql_fetch_lengths(d->mysqlres);
+            m_fetchResult = FetchResult::Ok;
+        } else {
+            streamingFinished();
+        }
+    }
+    else if (at() >= d->numRows) {
         m_fetchResult = FetchResult::End;
     }
     else if (at() < 0) {
@@ -164,6 +234,94 @@ void MysqlCursor::drv_bufferMovePointerTo(qint64 to)
     d->lengths = mysql_fetch_lengths(d->mysqlres);
 }
 
+int MysqlCursor::drv_fetchBatch(KDbRecordBatch* batch, int maxRows)
+{
+    const int columns = qMin(batch->columnCount(), m_fieldCount);
+    // cache: evaluating type of expressions can be expensive
+    QVector<KDbField::Type> types(columns, KDbField::Text);
+    if (m_visibleFieldsExpanded) {
+        for (int i = 0; i < columns; ++i) {
+            const KDbField *f = m_visibleFieldsExpanded->at(i)->field();
+            if (f) {
+                types[i] = f->type();
+            }
+        }
+    }
+    const bool streaming = options() & KDbCursor::Option::Streaming;
+    if (m_at == 0 && !streaming) { // nothing has been fetched from the result yet
+        mysql_data_seek(d->mysqlres, 0);
+    }
+    int count = 0;
+    m_fetchResult = FetchResult::Ok;
+    while (count < maxRows) {
+        MYSQL_ROW row = mysql_fetch_row(d->mysqlres);
+        if (!row) {
+            if (streaming) {
+                streamingFinished();
+            } else {
+                m_fetchResult = FetchResult::End;
+            }
+            break;
+        }
+        d->mysqlrow = row;
+        d->lengths = mysql_fetch_lengths(d->mysqlres);
+        const int r = batch->appendRecord();
+        for (int i = 0; i < columns; ++i) {
+            const char *data = row[i];
+            if (!data) {
+                continue; // the value is null already
+            }
+            const int length = d->lengths[i];
+            bool ok = true;
+            switch (batch->columnType(i)) {
+            case KDbRecordBatch::ColumnType::Integer: {
+                const qint64 value = QByteArray::fromRawData(data, length).toLongLong(&ok);
+                if (ok) {
+                    batch->setInteger(r, i, value);
+                }
+                break;
+            }
+            case KDbRecordBatch::ColumnType::Double: {
+                const double value = QByteArray::fromRawData(data, length).toDouble(&ok);
+                if (ok) {
+                    batch->setDouble(r, i, value);
+                }
+                break;
+            }
+            case KDbRecordBatch::ColumnType::Text:
+            case KDbRecordBatch::ColumnType::Binary:
+                // text is UTF-8 encoded, no conversion needed
+                batch->setString(r, i, data, length);
+                break;
+            case KDbRecordBatch::ColumnType::Boolean:
+            case KDbRecordBatch::ColumnType::Variant: {
+                QVariant value(KDb::cstringToVariant(data, types[i], &ok, length));
+                if (!ok && types[i] == KDbField::BigInteger) { // unsigned, above LLONG_MAX
+                    value = QByteArray::fromRawData(data, length).toULongLong(&ok);
+                }
+                if (ok) {
+                    batch->setValue(r, i, value);
+                }
+                break;
+            }
+            }
+            if (!ok) {
+                m_result = KDbResult(ERR_CURSOR_RECORD_FETCHING,
+                    MysqlConnection::tr("Could not convert value \"%1\" of column %2.")
+                        .arg(QString::fromUtf8(data, length)).arg(i + 1));
+                m_fetchResult = FetchResult::Error;
+                break;
+            }
+        }
+        ++count;
+        if (m_fetchResult == FetchResult::Error) {
+            break;
+        }
+    }
+    batchFetched(count);
+    return count;
+}
+
 const char** MysqlCursor::recordData() const
 {
     //! @todo
@@ -24,6 +24,7 @@
 #include "KDbCursor.h"
 
 class KDbConnection;
+class MysqlConnectionInternal;
 class MysqlCursorData;
 
 class MysqlCursor: public KDbCursor
@@ -45,11 +46,21 @@ public:
     void drv_bufferMovePointerNext() override;
     void drv_bufferMovePointerPrev() override;
     void drv_bufferMovePointerTo(qint64 to) override;
+    int drv_fetchBatch(KDbRecordBatch* batch, int maxRows) override;
 
     //! Implemented for KDbResultable
     QString serverResultName() const override;
 
 private:
+    //! Opens the cursor in streaming mode using mysql_use_result()
+    bool openStreaming(const KDbEscapedString& sql);
+
+    //! Called when all records have been retrieved in streaming mode; sets m_fetchResult
+    void streamingFinished();
+
+    //! @return internal data of the cursor's connection
+    MysqlConnectionInternal* connectionInternal();
+
     void storeResult();
     MysqlCursorData * const d;
     Q_DISABLE_COPY(MysqlCursor)
@@ -18,7 +18,8 @@
 */
 
 #include "MysqlPreparedStatement.h"
-#include "KDbConnection.h"
+#include "MysqlConnection.h"
+#include "KDbDriver.h"
 
 //#include <mysql/errmsg.h>
 // For example prepared MySQL statement code see:
@@ -87,10 +88,48 @@ void MysqlPreparedStatement::done()
 
 bool MysqlPreparedStatement::prepare(const KDbEscapedString& sql)
 {
+#ifndef KDB_USE_MYSQL_STMT
+    m_tempStatementString = sql;
+#else
     Q_UNUSED(sql);
+#endif
     return true;
 }
 
+#ifndef KDB_USE_MYSQL_STMT
+KDbEscapedString MysqlPreparedStatement::statementWithValues(
+    const KDbField::List &fieldList, const KDbPreparedStatementParameters &parameters) const
+{
+    // replace ? placeholders with values, skipping quoted strings and identifiers
+    KDbEscapedString sql;
+    sql.reserve(m_tempStatementString.length() + 16 * fieldList.count());
+    KDbField::ListIterator itFields(fieldList.constBegin());
+    QList<QVariant>::ConstIterator it(parameters.constBegin());
+    char quote = 0;
+    for (const char *s = m_tempStatementString.constData(), *end = s + m_tempStatementString.length();
+         s < end; ++s)
+    {
+        if (quote) {
+            if (*s == quote) {
+                quote = 0;
+            }
+        } else if (*s == '\'' || *s == '"' || *s == '`') {
+            quote = *s;
+        } else if (*s == '?' && itFields != fieldList.constEnd()) {
+            sql.append(connection->driver()->valueToSql(
+                           *itFields, it == parameters.constEnd() ? QVariant() : *it));
+            ++itFields;
+            if (it != parameters.constEnd()) {
+                ++it;
+            }
+            continue;
+        }
+        sql.append(s, 1);
+    }
+    return sql;
+}
+#endif
+
 #ifdef KDB_USE_MYSQL_STMT
 #define BIND_NULL { \
         m_mysqlBind[arg].buffer_type = MYSQL_TYPE_NULL; \
@@ -237,8 +276,13 @@ QSharedPointer<KDbSqlResult> MysqlPreparedStatement::execute(KDbPreparedStatemen
                                 KDbFieldList *insertFieldList,
                                 const KDbPreparedStatementParameters &parameters)
 {
-    Q_UNUSED(selectFieldList);
     QSharedPointer<KDbSqlResult> result;
+    // the connection cannot execute statements while a streaming cursor retrieves records
+    MysqlConnection *mysqlConnection = static_cast<MysqlConnection*>(connection);
+    if (!mysqlConnection->checkNotBusy()) {
+        m_result = mysqlConnection->result();
+        return result;
+    }
 #ifdef KDB_USE_MYSQL_STMT
     if (!m_statement || m_realParamCount <= 0)
         return false;
@@ -306,6 +350,10 @@ QSharedPointer<KDbSqlResult> MysqlPreparedStatement::execute(KDbPreparedStatemen
             }
         }
         result = connection->insertRecord(insertFieldList, myParameters);
+    } else if (type == KDbPreparedStatement::UpdateStatement
+               || type == KDbPreparedStatement::DeleteStatement)
+    {
+        result = connection->prepareSql(statementWithValues(selectFieldList, parameters));
     }
 //! @todo support select
 #endif // !KDB_USE_MYSQL_STMT
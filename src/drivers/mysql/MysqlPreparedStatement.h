@@ -44,6 +44,13 @@ private:
     bool init();
     void done();
 
+#ifndef KDB_USE_MYSQL_STMT
+    //! @return the prepared statement with ? placeholders replaced by @a parameters
+    //! converted to SQL literals according to types of fields from @a fieldList
+    KDbEscapedString statementWithValues(const KDbField::List &fieldList,
+                                         const KDbPreparedStatementParameters &parameters) const;
+#endif
+
 #ifdef KDB_USE_MYSQL_STMT
     bool bindValue(KDbField *field, const QVariant& value, int arg);
     int m_realParamCount;
@@ -26,11 +26,16 @@
 #include "KDbConnectionData.h"
 #include "KDbError.h"
 #include "KDbGlobal.h"
+#include "KDbRecordBatch.h"
 #include "KDbVersionInfo.h"
 
 #include <QFileInfo>
+#include <QVector>
 #include <QHostAddress>
 
+//! Size of data chunks sent for "COPY ... FROM STDIN"
+static const int copyDataChunkSize = 0x10000;
+
 #define MIN_SERVER_VERSION_MAJOR 7
 #define MIN_SERVER_VERSION_MINOR 1
 
@@ -55,6 +60,12 @@ PostgresqlConnection::PostgresqlConnection(KDbDriver *driver, const KDbConnectio
         : KDbConnection(driver, connData, options)
         , d(new PostgresqlConnectionInternal(this))
 {
+    const QByteArray propertyName = "postgresqlBinaryResults";
+    if (this->options()->property(propertyName).isNull()) {
+        this->options()->insert(propertyName, false);
+    }
+    this->options()->setCaption(propertyName,
+                                PostgresqlConnection::tr("Retrieve query results in binary format"));
 }
 
 PostgresqlConnection::~PostgresqlConnection()
@@ -227,6 +238,9 @@ bool PostgresqlConnection::drv_dropDatabase(const QString &dbName)
 
 KDbSqlResult* PostgresqlConnection::drv_prepareSql(const KDbEscapedString& sql)
 {
+    if (!checkNotBusy()) {
+        return nullptr;
+    }
     PGresult* result = d->executeSql(sql);
     const ExecStatusType status = PQresultStatus(result);
     if (status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK) {
@@ -238,12 +252,179 @@ KDbSqlResult* PostgresqlConnection::drv_prepareSql(const KDbEscapedString& sql)
 
 bool PostgresqlConnection::drv_executeSql(const KDbEscapedString& sql)
 {
+    if (!checkNotBusy()) {
+        return false;
+    }
     PGresult* result = d->executeSql(sql);
     const ExecStatusType status = PQresultStatus(result);
     d->storeResultAndClear(&m_result, &result, status);
     return status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK;
 }
 
+//! @return KDb types of fields of @a fields
+static QVector<KDbField::Type> fieldTypes(const KDbFieldList &fields)
+{
+    QVector<KDbField::Type> types;
+    types.reserve(fields.fieldCount());
+    for (const KDbField *f : *fields.fields()) {
+        types.append(f->type());
+    }
+    return types;
+}
+
+//! @return result for value of @a field that cannot be converted for the COPY statement
+static KDbResult copyValueConversionResult(const KDbField &field, const KDbEscapedString &sql)
+{
+    KDbResult result(ERR_OTHER,
+                     PostgresqlConnection::tr("Could not convert value of field \"%1\" to type %2.")
+                         .arg(field.name()).arg(KDbField::typeName(field.type())));
+    result.setSql(sql);
+    return result;
+}
+
+bool PostgresqlConnection::drv_insertRecords(const QString &tableName, KDbFieldList *fields,
+                                             const QList<QList<QVariant>> &records)
+{
+    const KDbEscapedString sql(KDbEscapedString("COPY ") + escapeIdentifier(tableName)
+                               + " (" + fields->sqlFieldsList(this) + ") FROM STDIN");
+    if (!checkNotBusy() || !d->beginCopyIn(sql, &m_result)) {
+        return false;
+    }
+    m_result.setSql(sql);
+    const QVector<KDbField::Type> types(fieldTypes(*fields));
+    QByteArray data;
+    data.reserve(copyDataChunkSize + 0x1000);
+    bool ok = true;
+    for (QList<QList<QVariant>>::ConstIterator it = records.constBegin();
+         ok && it != records.constEnd(); ++it)
+    {
+        for (int i = 0; ok && i < types.count(); ++i) {
+            if (i > 0) {
+                data.append('\t');
+            }
+            if (!PostgresqlConnectionInternal::appendCopyValue(
+                    &data, types.at(i), i < it->count() ? it->at(i) : QVariant()))
+            {
+                m_result = copyValueConversionResult(*fields->field(i), sql);
+                // the server discards all records when the COPY is ended with an error
+                d->endCopyIn(&m_result, "Invalid value");
+                return false;
+            }
+        }
+        data.append('\n');
+        if (data.size() >= copyDataChunkSize) {
+            ok = d->putCopyData(data, &m_result);
+            data.resize(0);
+        }
+    }
+    if (ok && !data.isEmpty()) {
+        ok = d->putCopyData(data, &m_result);
+    }
+    return d->endCopyIn(&m_result, ok ? nullptr : "Sending data failed") && ok;
+}
+
+bool PostgresqlConnection::drv_importRecords(KDbTableSchema *table,
+                                             KDbRecordBatchProducer *producer,
+                                             KDbRecordBatch *batch)
+{
+    const KDbEscapedString sql(KDbEscapedString("COPY ") + escapeIdentifier(table->name())
+                               + " (" + table->sqlFieldsList(this) + ") FROM STDIN");
+    if (!checkNotBusy() || !d->beginCopyIn(sql, &m_result)) {
+        return false;
+    }
+    m_result.setSql(sql);
+    const QVector<KDbField::Type> types(fieldTypes(*table));
+    QByteArray data;
+    data.reserve(copyDataChunkSize + 0x1000);
+    bool ok = true;
+    bool cancelled = false;
+    while (ok) {
+        batch->clear();
+        if (!producer->produceRecords(batch)) {
+            cancelled = true;
+            break;
+        }
+        if (batch->isEmpty()) {
+            break;
+        }
+        // data is sent in chunks so memory use does not depend on the number of records
+        for (int row = 0; ok && row < batch->count(); ++row) {
+            const int invalidColumn
+                = PostgresqlConnectionInternal::appendCopyRecord(&data, *batch, row, types);
+            if (invalidColumn >= 0) {
+                m_result = copyValueConversionResult(*table->field(invalidColumn), sql);
+                // the server discards all records when the COPY is ended with an error
+                d->endCopyIn(&m_result, "Invalid value");
+                return false;
+            }
+            if (data.size() >= copyDataChunkSize) {
+                ok = d->putCopyData(data, &m_result);
+                data.resize(0);
+            }
+        }
+    }
+    if (ok && !cancelled && !data.isEmpty()) {
+        ok = d->putCopyData(data, &m_result);
+    }
+    ok = d->endCopyIn(&m_result, (ok && !cancelled) ? nullptr : "Importing cancelled") && ok;
+    return ok && !cancelled;
+}
+
+bool PostgresqlConnection::drv_exportRecords(KDbTableSchema *table,
+                                             KDbRecordBatchConsumer *consumer,
+                                             KDbRecordBatch *batch)
+{
+    const KDbEscapedString sql(KDbEscapedString("COPY ") + escapeIdentifier(table->name())
+                               + " (" + table->sqlFieldsList(this) + ") TO STDOUT");
+    if (!checkNotBusy() || !d->beginCopyOut(sql, &m_result)) {
+        return false;
+    }
+    m_result.setSql(sql);
+    const QVector<KDbField::Type> types(fieldTypes(*table));
+    QByteArray buffer;
+    bool ok = true;
+    bool cancelled = false;
+    Q_FOREVER {
+        char *line = nullptr;
+        const int length = PQgetCopyData(d->conn, &line, 0 /* wait */);
+        if (length == -1) { // all data received
+            break;
+        }
+        if (length < 0) {
+            if (ok) {
+                m_result.setCode(ERR_SQL_EXECUTION_ERROR);
+                d->storeResult(&m_result);
+                ok = false;
+            }
+            break;
+        }
+        if (ok) { // after cancelling, remaining lines are only discarded
+            PostgresqlConnectionInternal::parseCopyRecord(line, length, batch, batch->appendRecord(),
+                                                          types, &buffer);
+            if (batch->isFull()) {
+                ok = consumer->consumeRecords(*batch);
+                batch->clear();
+                if (!ok) {
+                    cancelled = true;
+                    d->cancelQuery();
+                }
+            }
+        }
+        PQfreemem(line);
+    }
+    if (ok && !batch->isEmpty()) {
+        ok = consumer->consumeRecords(*batch);
+        cancelled = !ok;
+    }
+    if (!d->endCopyOut(&m_result) && !cancelled) {
+        ok = false;
+    }
+    if (cancelled) {
+        m_result = KDbResult(ERR_OTHER, tr("Exporting records has been cancelled."));
+    }
+    return ok;
+}
+
 bool PostgresqlConnection::drv_isDatabaseUsed() const
 {
     return d->conn;
@@ -255,6 +436,47 @@ tristate PostgresqlConnection::drv_containsTable(const QString &tableName)
                         .arg(escapeString(tableName)));
 }
 
+tristate PostgresqlConnection::drv_estimatedRecordCount(const KDbTableSchema &tableSchema,
+                                                       qint64 *count)
+{
+    // Density of records computed by the last VACUUM or ANALYZE is applied to the current
+    // size of the table, as the query planner does. -1 means the table has not been analyzed.
+    QString number;
+    // Statistics change without modifications of the table so they are not cached
+    const tristate result = querySingleString(
+        KDbEscapedString("SELECT CASE WHEN c.reltuples > 0 AND c.relpages > 0 "
+                         "THEN (c.reltuples / c.relpages * (pg_relation_size(c.oid) "
+                         "/ current_setting('block_size')::integer))::bigint "
+                         "ELSE -1 END "
+                         "FROM pg_class c JOIN pg_namespace n ON n.oid = c.relnamespace "
+                         "WHERE c.relkind='r' AND lower(c.relname)=lower(%1) "
+                         "AND n.nspname = ANY (current_schemas(false))")
+            .arg(escapeString(tableSchema.name())), &number, 0,
+        QueryRecordOption::Default | QueryRecordOption::NoResultCache);
+    if (result != true) {
+        return result;
+    }
+    bool ok;
+    const qint64 estimate = number.toLongLong(&ok);
+    if (!ok || estimate < 0) {
+        return cancelled;
+    }
+    *count = estimate;
+    return true;
+}
+
+bool PostgresqlConnection::checkNotBusy()
+{
+    if (d->streamingCursor) {
+        m_result = KDbResult(ERR_SQL_EXECUTION_ERROR,
+                             tr("Could not execute statement because records of another query "
+                                "are being retrieved. Retrieve all the records or close the "
+                                "query first."));
+        return false;
+    }
+    return true;
+}
+
 QString PostgresqlConnection::serverResultName() const
 {
     if (m_result.code() >= 0 && m_result.code() <= PGRES_SINGLE_TUPLE) {
@@ -38,6 +38,16 @@ private:
     Q_DISABLE_COPY(PostgresqlTransactionData)
 };
 
+/*! @brief PostgreSQL-specific connection
+    Following connection options are supported (see KDbConnectionOptions):
+    - postgresqlBinaryResults (read/write, bool): if true, cursors retrieve results in binary
+                              format and decode values directly instead of parsing their
+                              text representation. Affects cursors opened after the change.
+                              Only used for SELECT statements. If the result contains columns
+                              of types without a binary decoder, the statement is executed
+                              again and the result is retrieved in text format. NUMERIC
+                              values are decoded to exact decimal strings. Default is false.
+*/
 class PostgresqlConnection : public KDbConnection
 {
     Q_DECLARE_TR_FUNCTIONS(PostgresqlConnection)
@@ -88,18 +98,40 @@ private:
     Q_REQUIRED_RESULT KDbSqlResult *drv_prepareSql(const KDbEscapedString &sql) override;
     bool drv_executeSql(const KDbEscapedString& sql) override;
 
+    //! Inserts records using "COPY ... FROM STDIN" statement
+    bool drv_insertRecords(const QString &tableName, KDbFieldList *fields,
+                           const QList<QList<QVariant>> &records) override;
+
+    //! Imports records using "COPY ... FROM STDIN" statement
+    bool drv_importRecords(KDbTableSchema *table, KDbRecordBatchProducer *producer,
+                           KDbRecordBatch *batch) override;
+
+    //! Exports records using "COPY ... TO STDOUT" statement
+    bool drv_exportRecords(KDbTableSchema *table, KDbRecordBatchConsumer *consumer,
+                           KDbRecordBatch *batch) override;
+
     //! Implemented for KDbResultable
     QString serverResultName() const override;
 
 //! @todo move this somewhere to low level class (MIGRATION?)
     tristate drv_containsTable(const QString &tableName) override;
 
+    //! Estimates number of records using pg_class.reltuples like the query planner
+    tristate drv_estimatedRecordCount(const KDbTableSchema &tableSchema,
+                                      qint64 *count) override;
+
     void storeResult(PGresult *pgResult, ExecStatusType execStatus);
 
+    //! @return true if no streaming cursor is using the connection;
+    //! otherwise sets error in result() and returns false
+    bool checkNotBusy();
+
     PostgresqlConnectionInternal * const d;
 
     friend class PostgresqlDriver;
+    friend class PostgresqlCursor;
     friend class PostgresqlCursorData;
+    friend class PostgresqlPreparedStatement;
     friend class PostgresqlTransactionData;
     friend class PostgresqlSqlResult;
     Q_DISABLE_COPY(PostgresqlConnection)
@@ -19,6 +19,15 @@
 */
 
 #include "PostgresqlConnection_p.h"
+#include "PostgresqlDriver.h"
+#include "postgresql_debug.h"
+
+#include "KDbRecordBatch.h"
+#include "KDbUtils.h"
+
+#include <QDateTime>
+
+#include <cctype>
 
 PostgresqlConnectionInternal::PostgresqlConnectionInternal(KDbConnection *_conn)
         : KDbConnectionInternal(_conn)
@@ -62,10 +71,331 @@ void PostgresqlConnectionInternal::storeResult(KDbResult *result)
     result->setServerMessage(QString::fromLatin1(msg));
 }
 
-PGresult* PostgresqlConnectionInternal::executeSql(const KDbEscapedString& sql)
+PGresult* PostgresqlConnectionInternal::executeSql(const KDbEscapedString& sql, bool binaryResults)
+{
+    const QByteArray sqlData(sql.toByteArray());
+    if (binaryResults && isBinaryResultsStatement(sqlData)) {
+        PGresult *res = PQexecParams(conn, sqlData.constData(), 0, nullptr, nullptr, nullptr,
+                                     nullptr, 1);
+        if (PQresultStatus(res) != PGRES_TUPLES_OK || hasBinaryDecoders(res)) {
+            return res;
+        }
+        PQclear(res); // the text representation can always be returned
+    }
+    return PQexec(conn, sqlData.constData());
+}
+
+//static
+bool PostgresqlConnectionInternal::isBinaryResultsStatement(const QByteArray &sql)
+{
+    int i = 0;
+    while (i < sql.length() && (sql[i] == '(' || isspace(static_cast<unsigned char>(sql[i])))) {
+        ++i;
+    }
+    return qstrnicmp(sql.constData() + i, "SELECT", 6) == 0;
+}
+
+//static
+bool PostgresqlConnectionInternal::hasBinaryDecoders(const PGresult *res)
+{
+    for (int i = 0; i < PQnfields(res); ++i) {
+        if (!PostgresqlDriver::hasBinaryDecoder(PQftype(res, i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//static
+bool PostgresqlConnectionInternal::appendCopyValue(QByteArray *line, KDbField::Type type,
+                                                   const QVariant &value)
+{
+    if (value.isNull()) {
+        line->append("\\N");
+        return true;
+    }
+    bool ok = true;
+    switch (type) {
+    case KDbField::Byte:
+    case KDbField::ShortInteger:
+    case KDbField::Integer:
+    case KDbField::BigInteger: {
+        const qlonglong integer = value.toLongLong(&ok);
+        if (ok) {
+            line->append(QByteArray::number(integer));
+        }
+        return ok;
+    }
+    case KDbField::Float:
+    case KDbField::Double: {
+        const double real = value.toDouble(&ok);
+        if (ok) {
+            line->append(QByteArray::number(real, 'g', 17));
+        }
+        return ok;
+    }
+    case KDbField::Boolean:
+        line->append(value.toBool() ? 't' : 'f');
+        return true;
+    case KDbField::Date: {
+        const QDate date(value.toDate());
+        if (!date.isValid()) {
+            return false;
+        }
+        line->append(date.toString(Qt::ISODate).toLatin1());
+        return true;
+    }
+    case KDbField::Time: {
+        const QTime time(value.toTime());
+        if (!time.isValid()) {
+            return false;
+        }
+        line->append(KDbUtils::toISODateStringWithMs(time).toLatin1());
+        return true;
+    }
+    case KDbField::DateTime: {
+        const QDateTime dateTime(value.toDateTime());
+        if (!dateTime.isValid()) {
+            return false;
+        }
+        line->append(KDbUtils::toISODateStringWithMs(dateTime).toLatin1());
+        return true;
+    }
+    case KDbField::BLOB:
+        // hex format of bytea; the backslash itself has to be escaped for COPY
+        line->append("\\\\x");
+        line->append(value.toByteArray().toHex());
+        return true;
+    default:
+        break;
+    }
+    if (!value.canConvert<QString>()) {
+        return false;
+    }
+    const QByteArray text(value.toString().toUtf8());
+    appendCopyText(line, text.constData(), text.length());
+    return true;
+}
+
+//static
+void PostgresqlConnectionInternal::appendCopyText(QByteArray *line, const char *data, int length)
+{
+    const char *end = data + length;
+    for (const char *c = data; c < end; ++c) {
+        switch (*c) {
+        case '\\': line->append("\\\\"); break;
+        case '\n': line->append("\\n"); break;
+        case '\r': line->append("\\r"); break;
+        case '\t': line->append("\\t"); break;
+        default: line->append(*c);
+        }
+    }
+}
+
+//static
+int PostgresqlConnectionInternal::appendCopyRecord(QByteArray *line, const KDbRecordBatch &batch,
+                                                   int row, const QVector<KDbField::Type> &types)
+{
+    for (int col = 0; col < batch.columnCount(); ++col) {
+        if (col > 0) {
+            line->append('\t');
+        }
+        if (batch.isNull(row, col)) {
+            line->append("\\N");
+            continue;
+        }
+        switch (batch.columnType(col)) {
+        case KDbRecordBatch::ColumnType::Integer:
+            line->append(QByteArray::number(batch.integerValue(row, col)));
+            break;
+        case KDbRecordBatch::ColumnType::Double:
+            line->append(QByteArray::number(batch.doubleValue(row, col), 'g', 17));
+            break;
+        case KDbRecordBatch::ColumnType::Boolean:
+            line->append(batch.booleanValue(row, col) ? 't' : 'f');
+            break;
+        case KDbRecordBatch::ColumnType::Text: {
+            const KDbSqlString text(batch.stringView(row, col));
+            appendCopyText(line, text.string, int(text.length));
+            break;
+        }
+        case KDbRecordBatch::ColumnType::Binary: {
+            const KDbSqlString binary(batch.stringView(row, col));
+            line->append("\\\\x");
+            line->append(QByteArray::fromRawData(binary.string, int(binary.length)).toHex());
+            break;
+        }
+        case KDbRecordBatch::ColumnType::Variant:
+            if (!appendCopyValue(line, types.at(col), batch.at(row, col))) {
+                return col;
+            }
+            break;
+        }
+    }
+    line->append('\n');
+    return -1;
+}
+
+//static
+void PostgresqlConnectionInternal::parseCopyRecord(const char *data, int length,
+                                                   KDbRecordBatch *batch, int row,
+                                                   const QVector<KDbField::Type> &types,
+                                                   QByteArray *buffer)
+{
+    const char *end = data + length;
+    if (end > data && end[-1] == '\n') {
+        --end;
+    }
+    const char *c = data;
+    for (int col = 0; col < batch->columnCount() && c <= end; ++col) {
+        buffer->resize(0);
+        bool isNull = false;
+        if (c + 1 < end && c[0] == '\\' && c[1] == 'N' && (c + 2 == end || c[2] == '\t')) {
+            isNull = true;
+            c += 2;
+        } else {
+            for (; c < end && *c != '\t'; ++c) {
+                if (*c != '\\' || c + 1 == end) {
+                    buffer->append(*c);
+                    continue;
+                }
+                ++c;
+                switch (*c) {
+                case 'n': buffer->append('\n'); break;
+                case 'r': buffer->append('\r'); break;
+                case 't': buffer->append('\t'); break;
+                case 'b': buffer->append('\b'); break;
+                case 'f': buffer->append('\f'); break;
+                case 'v': buffer->append('\v'); break;
+                default: buffer->append(*c); // e.g. backslash
+                }
+            }
+        }
+        ++c; // skip the delimiter
+        if (isNull) {
+            continue; // the value is null already
+        }
+        bool ok = true;
+        switch (batch->columnType(col)) {
+        case KDbRecordBatch::ColumnType::Integer: {
+            const qint64 integer = buffer->toLongLong(&ok);
+            if (ok) {
+                batch->setInteger(row, col, integer);
+            }
+            break;
+        }
+        case KDbRecordBatch::ColumnType::Double: {
+            const double real = buffer->toDouble(&ok);
+            if (ok) {
+                batch->setDouble(row, col, real);
+            }
+            break;
+        }
+        case KDbRecordBatch::ColumnType::Boolean:
+            batch->setBoolean(row, col, buffer->startsWith('t'));
+            break;
+        case KDbRecordBatch::ColumnType::Text:
+            batch->setString(row, col, buffer->constData(), buffer->length());
+            break;
+        case KDbRecordBatch::ColumnType::Binary:
+        case KDbRecordBatch::ColumnType::Variant:
+            batch->setValue(row, col, PostgresqlDriver::textToVariant(
+                                types.at(col), buffer->constData(), buffer->length()));
+            break;
+        }
+    }
+}
+
+bool PostgresqlConnectionInternal::beginCopyIn(const KDbEscapedString &sql, KDbResult *result)
+{
+    PGresult *pgResult = PQexec(conn, sql.toByteArray().constData());
+    const ExecStatusType status = PQresultStatus(pgResult);
+    if (status != PGRES_COPY_IN) {
+        result->setSql(sql);
+        storeResultAndClear(result, &pgResult, status);
+        return false;
+    }
+    PQclear(pgResult);
+    return true;
+}
+
+bool PostgresqlConnectionInternal::beginCopyOut(const KDbEscapedString &sql, KDbResult *result)
+{
+    PGresult *pgResult = PQexec(conn, sql.toByteArray().constData());
+    const ExecStatusType status = PQresultStatus(pgResult);
+    if (status != PGRES_COPY_OUT) {
+        result->setSql(sql);
+        storeResultAndClear(result, &pgResult, status);
+        return false;
+    }
+    PQclear(pgResult);
+    return true;
+}
+
+bool PostgresqlConnectionInternal::putCopyData(const QByteArray &data, KDbResult *result)
+{
+    if (PQputCopyData(conn, data.constData(), data.size()) != 1) {
+        result->setCode(ERR_SQL_EXECUTION_ERROR);
+        storeResult(result);
+        return false;
+    }
+    return true;
+}
+
+bool PostgresqlConnectionInternal::endCopyIn(KDbResult *result, const char *errorMessage)
+{
+    bool ok = true;
+    if (PQputCopyEnd(conn, errorMessage) != 1) {
+        result->setCode(ERR_SQL_EXECUTION_ERROR);
+        storeResult(result);
+        ok = false;
+    }
+    // Collect the final status; there can be more results when the operation fails.
+    while (PGresult *pgResult = PQgetResult(conn)) {
+        const ExecStatusType status = PQresultStatus(pgResult);
+        if (status == PGRES_COMMAND_OK) {
+            PQclear(pgResult);
+        } else {
+            if (ok && !errorMessage) {
+                storeResultAndClear(result, &pgResult, status);
+            } else {
+                PQclear(pgResult);
+            }
+            ok = false;
+        }
+    }
+    return ok && !errorMessage;
+}
+
+bool PostgresqlConnectionInternal::endCopyOut(KDbResult *result)
 {
-//! @todo consider using binary mode with PQexecParams()
-    return PQexec(conn, sql.toByteArray().constData());
+    bool ok = true;
+    while (PGresult *pgResult = PQgetResult(conn)) {
+        const ExecStatusType status = PQresultStatus(pgResult);
+        if (status == PGRES_COMMAND_OK) {
+            PQclear(pgResult);
+        } else {
+            if (ok) {
+                storeResultAndClear(result, &pgResult, status);
+            } else {
+                PQclear(pgResult);
+            }
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void PostgresqlConnectionInternal::cancelQuery()
+{
+    PGcancel *cancel = PQgetCancel(conn);
+    if (cancel) {
+        char errorBuffer[256];
+        if (!PQcancel(cancel, errorBuffer, sizeof(errorBuffer))) {
+            postgresqlWarning() << "Could not cancel query:" << errorBuffer;
+        }
+        PQfreeCancel(cancel);
+    }
 }
 
 //--------------------------------------
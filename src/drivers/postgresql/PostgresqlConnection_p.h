@@ -31,10 +31,15 @@
 #include "KDbSqlString.h"
 
 #include <QString>
+#include <QVector>
 
 #include <libpq-fe.h>
 
+#include <cstdlib>
+
 class KDbEscapedString;
+class KDbRecordBatch;
+class PostgresqlCursor;
 
 class PostgresqlConnectionInternal : public KDbConnectionInternal
 {
@@ -44,7 +49,19 @@ public:
     virtual ~PostgresqlConnectionInternal();
 
     //! Executes query for a raw SQL statement @a sql on the database
-    PGresult* executeSql(const KDbEscapedString& sql);
+    //! If @a binaryResults is true and @a sql is a single SELECT statement, values are
+    //! requested in binary format using a single request. If the result contains columns
+    //! of types without a binary decoder, the statement is executed again in text format.
+    //! Use PQfformat() to check the format of the result.
+    PGresult* executeSql(const KDbEscapedString& sql, bool binaryResults = false);
+
+    //! @return true if results of @a sql can be requested in binary format, i.e. @a sql
+    //! is a SELECT statement that can be safely executed again in text format if needed
+    static bool isBinaryResultsStatement(const QByteArray &sql);
+
+    //! @return true if values of all result columns of @a res can be decoded
+    //! by PostgresqlDriver::binaryToVariant()
+    static bool hasBinaryDecoders(const PGresult *res);
 
     static QString serverResultName(int resultCode);
 
@@ -52,6 +69,49 @@ public:
 
     void storeResult(KDbResult *result);
 
+    //! Appends @a value of type @a type to @a line using text format of the COPY statement.
+    //! Null values are written as @c \\N; backslashes and control characters are escaped.
+    //! @return false if @a value cannot be converted to @a type; @a line is then incomplete
+    static bool appendCopyValue(QByteArray *line, KDbField::Type type, const QVariant &value);
+
+    //! Appends UTF-8 text @a data of @a length bytes to @a line, escaped for the COPY statement
+    static void appendCopyText(QByteArray *line, const char *data, int length);
+
+    //! Appends record @a row of @a batch to @a line using text format of the COPY statement,
+    //! including the trailing newline. @a types are KDb types of the batch's columns.
+    //! @return -1 on success or index of the column which value cannot be converted
+    static int appendCopyRecord(QByteArray *line, const KDbRecordBatch &batch, int row,
+                                const QVector<KDbField::Type> &types);
+
+    //! Decodes line @a data of @a length bytes returned by "COPY ... TO STDOUT" in text format
+    //! and stores the values in record @a row of @a batch. @a types are KDb types of
+    //! the batch's columns; @a buffer is used for unescaping.
+    static void parseCopyRecord(const char *data, int length, KDbRecordBatch *batch, int row,
+                                const QVector<KDbField::Type> &types, QByteArray *buffer);
+
+    //! Executes "COPY ... FROM STDIN" statement @a sql
+    //! @return true if the server is ready to receive data; otherwise stores error in @a result
+    bool beginCopyIn(const KDbEscapedString &sql, KDbResult *result);
+
+    //! Sends @a data, a number of complete or partial lines, during "COPY ... FROM STDIN"
+    bool putCopyData(const QByteArray &data, KDbResult *result);
+
+    //! Finishes "COPY ... FROM STDIN". If @a errorMessage is not @c nullptr the operation
+    //! is aborted and no records are stored.
+    //! @return true if all the data has been stored successfully
+    bool endCopyIn(KDbResult *result, const char *errorMessage = nullptr);
+
+    //! Executes "COPY ... TO STDOUT" statement @a sql
+    //! @return true if the server started sending data; otherwise stores error in @a result
+    bool beginCopyOut(const KDbEscapedString &sql, KDbResult *result);
+
+    //! Collects the final status of "COPY ... TO STDOUT" after all the data has been received
+    //! @return true on success
+    bool endCopyOut(KDbResult *result);
+
+    //! Requests the server to cancel the current query; errors are only logged
+    void cancelQuery();
+
     //! @return true if status of connection is "OK".
     /*! From https://www.postgresql.org/docs/8.4/static/libpq-status.html:
         "Only two of these are seen outside of an asynchronous connection procedure:
@@ -62,6 +122,10 @@ public:
     bool unicode;
     QByteArray escapingBuffer;
     bool fuzzystrmatchExtensionCreated = false;
+    //! Streaming cursor that retrieves records in single-row mode, if any. Only set for
+    //! the connection's own internal data. Until all its records are retrieved or it is closed,
+    //! no other statements can be executed using the connection.
+    PostgresqlCursor *streamingCursor = nullptr;
 private:
     Q_DISABLE_COPY(PostgresqlConnectionInternal)
 };
@@ -127,6 +191,40 @@ public:
                 : QByteArray(PQgetvalue(result, record, index),
                              PQgetlength(result, record, index));
     }
+    inline bool isNull(int index) override {
+        return PQgetisnull(result, record, index);
+    }
+    inline qint64 int64Value(int index) override {
+        // values returned by PQgetvalue() are null-terminated, NULL is an empty string
+        return std::strtoll(PQgetvalue(result, record, index), nullptr, 10);
+    }
+    inline double doubleValue(int index) override {
+        // not std::strtod() as it depends on locale's decimal point
+        return QByteArray::fromRawData(PQgetvalue(result, record, index),
+                                       PQgetlength(result, record, index)).toDouble();
+    }
+    inline bool boolValue(int index) override {
+        // booleans are returned as "t" or "f", NULL is an empty string
+        const char *value = PQgetvalue(result, record, index);
+        switch (value[0]) {
+        case 't':
+        case 'T':
+            return true;
+        case 'f':
+        case 'F':
+        case '\0':
+            return false;
+        default:;
+        }
+        return doubleValue(index) != 0.0;
+    }
+    inline KDbSqlString blobView(int index) override {
+        // bytea values are returned escaped, as for toByteArray()
+        return PQgetisnull(result, record, index)
+                ? KDbSqlString()
+                : KDbSqlString(PQgetvalue(result, record, index),
+                               PQgetlength(result, record, index));
+    }
 
 private:
     const PGresult * const result;
@@ -26,13 +26,29 @@
 
 #include "KDbError.h"
 #include "KDbGlobal.h"
+#include "KDbRecordBatch.h"
 #include "KDbRecordData.h"
 
 // Constructor based on query statement
+//! Streaming cursors are unbuffered, other cursors are always buffered
+static inline KDbCursor::Options cursorOptions(KDbCursor::Options options)
+{
+    if (options & KDbCursor::Option::Streaming) {
+        options &= ~KDbCursor::Options(KDbCursor::Option::Buffered);
+    } else {
+        options |= KDbCursor::Option::Buffered;
+    }
+    return options;
+}
+
 PostgresqlCursor::PostgresqlCursor(KDbConnection* conn, const KDbEscapedString& sql,
                                    KDbCursor::Options options)
-        : KDbCursor(conn, sql, options | KDbCursor::Option::Buffered)
+        : KDbCursor(conn, sql, cursorOptions(options))
         , m_numRows(0)
+        , m_binaryResults(false)
+        , m_streaming(false)
+        , m_recordPending(false)
+        , m_resultsPending(false)
         , d(new PostgresqlCursorData(conn))
 {
 }
@@ -41,8 +57,12 @@ PostgresqlCursor::PostgresqlCursor(KDbConnection* conn, const KDbEscapedString&
 //Constructor base on query object
 PostgresqlCursor::PostgresqlCursor(KDbConnection* conn, KDbQuerySchema* query,
                                    KDbCursor::Options options)
-        : KDbCursor(conn, query, options | KDbCursor::Option::Buffered)
+        : KDbCursor(conn, query, cursorOptions(options))
         , m_numRows(0)
+        , m_binaryResults(false)
+        , m_streaming(false)
+        , m_recordPending(false)
+        , m_resultsPending(false)
         , d(new PostgresqlCursorData(conn))
 {
 }
@@ -57,38 +77,142 @@ PostgresqlCursor::~PostgresqlCursor()
 
 //==================================================================================
 //Create a cursor result set
+PostgresqlConnectionInternal* PostgresqlCursor::connectionInternal()
+{
+    return static_cast<PostgresqlConnection*>(connection())->d;
+}
+
 bool PostgresqlCursor::drv_open(const KDbEscapedString& sql)
 {
-    d->res = d->executeSql(sql);
+    if (connectionInternal()->streamingCursor) {
+        m_result = KDbResult(ERR_SQL_EXECUTION_ERROR,
+                             tr("Could not open query because records of another query "
+                                "are being retrieved."));
+        return false;
+    }
+    m_binaryResults = connection()->options()->property("postgresqlBinaryResults").value().toBool();
+    m_streaming = options() & KDbCursor::Option::Streaming;
+    if (m_streaming) {
+        return openStreaming(sql);
+    }
+    d->res = d->executeSql(sql, m_binaryResults);
     d->resultStatus = PQresultStatus(d->res);
     if (d->resultStatus != PGRES_TUPLES_OK && d->resultStatus != PGRES_COMMAND_OK) {
         storeResultAndClear(&d->res, d->resultStatus);
         return false;
     }
-    m_fieldsToStoreInRecord = PQnfields(d->res);
-    m_fieldCount = m_fieldsToStoreInRecord - (containsRecordIdInfo() ? 1 : 0);
     m_numRows = PQntuples(d->res);
     m_records_in_buf = m_numRows;
     m_buffering_completed = true;
+    setupFields();
+    return true;
+}
+
+//==================================================================================
+//Send the query in single-row mode; the first result also describes the fields
+bool PostgresqlCursor::openStreaming(const KDbEscapedString& sql)
+{
+    const QByteArray sqlData(sql.toByteArray());
+    const bool binaryResults = m_binaryResults
+            && PostgresqlConnectionInternal::isBinaryResultsStatement(sqlData);
+    const int sent = binaryResults
+            ? PQsendQueryParams(d->conn, sqlData.constData(), 0, nullptr, nullptr, nullptr,
+                                nullptr, 1)
+            : PQsendQuery(d->conn, sqlData.constData());
+    if (!sent) {
+        d->storeResult(&m_result);
+        return false;
+    }
+    m_resultsPending = true;
+    if (!PQsetSingleRowMode(d->conn)) {
+        d->storeResult(&m_result);
+        discardPendingResults();
+        return false;
+    }
+    m_numRows = 0;
+    d->res = PQgetResult(d->conn);
+    d->resultStatus = PQresultStatus(d->res);
+    if (binaryResults
+        && (d->resultStatus == PGRES_SINGLE_TUPLE || d->resultStatus == PGRES_TUPLES_OK)
+        && !PostgresqlConnectionInternal::hasBinaryDecoders(d->res))
+    {
+        // the text representation can always be returned, send the query again
+        PQclear(d->res);
+        d->res = nullptr;
+        if (connection()->transactions().isEmpty()) {
+            d->cancelQuery();
+        }
+        discardPendingResults();
+        m_binaryResults = false;
+        return openStreaming(sql);
+    }
+    if (d->resultStatus == PGRES_SINGLE_TUPLE) {
+        m_recordPending = true;
+    } else if (d->resultStatus == PGRES_TUPLES_OK || d->resultStatus == PGRES_COMMAND_OK) {
+        m_recordPending = false; // empty result
+        discardPendingResults();
+    } else {
+        storeResultAndClear(&d->res, d->resultStatus);
+        discardPendingResults();
+        return false;
+    }
+    if (m_resultsPending) {
+        connectionInternal()->streamingCursor = this;
+    }
+    setupFields();
+    return true;
+}
+
+//==================================================================================
+//Get real types for all fields
+void PostgresqlCursor::setupFields()
+{
+    m_fieldsToStoreInRecord = PQnfields(d->res);
+    // binary format is not used if a column has no binary decoder
+    m_binaryResults = m_fieldsToStoreInRecord > 0 && PQfformat(d->res, 0) == 1;
+    m_fieldCount = m_fieldsToStoreInRecord - (containsRecordIdInfo() ? 1 : 0);
 
-    // get real types for all fields
     PostgresqlDriver* drv = static_cast<PostgresqlDriver*>(connection()->driver());
 
     m_realTypes.resize(m_fieldsToStoreInRecord);
     m_realLengths.resize(m_fieldsToStoreInRecord);
+    m_pqTypes.resize(m_fieldsToStoreInRecord);
     for (int i = 0; i < int(m_fieldsToStoreInRecord); i++) {
         const int pqtype = PQftype(d->res, i);
         const int pqfmod = PQfmod(d->res, i);
         m_realTypes[i] = drv->pgsqlToKDbType(pqtype, pqfmod, &m_realLengths[i]);
+        m_pqTypes[i] = pqtype;
+    }
+}
+
+//==================================================================================
+//Read and drop remaining results so the connection can be used again
+void PostgresqlCursor::discardPendingResults()
+{
+    while (PGresult *result = PQgetResult(d->conn)) {
+        PQclear(result);
+    }
+    m_resultsPending = false;
+    if (connectionInternal()->streamingCursor == this) {
+        connectionInternal()->streamingCursor = nullptr;
     }
-    return true;
 }
 
 //==================================================================================
 //Delete objects
 bool PostgresqlCursor::drv_close()
 {
+    if (m_resultsPending) {
+        // Do not read all the remaining records, cancel the query instead. This is not possible
+        // within a transaction because cancelling would abort it.
+        if (connection()->transactions().isEmpty()) {
+            d->cancelQuery();
+        }
+        discardPendingResults();
+    }
+    m_recordPending = false;
     PQclear(d->res);
+    d->res = nullptr;
     return true;
 }
 
@@ -96,7 +220,10 @@ bool PostgresqlCursor::drv_close()
 //Gets the next record...does not need to do much, just return fetchend if at end of result set
 void PostgresqlCursor::drv_getNextRecord()
 {
-    if (at() >= qint64(m_numRows)) {
+    if (m_streaming) {
+        getNextStreamedRecord();
+    }
+    else if (at() >= qint64(m_numRows)) {
         m_fetchResult = FetchResult::End;
     }
     else if (at() < 0) {
@@ -109,6 +236,35 @@ void PostgresqlCursor::drv_getNextRecord()
     }
 }
 
+//==================================================================================
+//Replace the current result with the next single-record result
+void PostgresqlCursor::getNextStreamedRecord()
+{
+    if (m_recordPending) { // the first record has been retrieved by openStreaming()
+        m_recordPending = false;
+        m_fetchResult = FetchResult::Ok;
+        return;
+    }
+    PQclear(d->res);
+    d->res = nullptr;
+    if (!m_resultsPending) {
+        m_fetchResult = FetchResult::End;
+        return;
+    }
+    d->res = PQgetResult(d->conn);
+    d->resultStatus = PQresultStatus(d->res);
+    if (d->resultStatus == PGRES_SINGLE_TUPLE) {
+        m_fetchResult = FetchResult::Ok;
+    } else if (d->resultStatus == PGRES_TUPLES_OK) { // zero-row result that ends the query
+        m_fetchResult = FetchResult::End;
+        discardPendingResults();
+    } else {
+        storeResultAndClear(&d->res, d->resultStatus);
+        m_fetchResult = FetchResult::Error;
+        discardPendingResults();
+    }
+}
+
 //==================================================================================
 //Check the current position is within boundaries
 #if 0
@@ -166,47 +322,12 @@ inline QVariant pgsqlCStrToVariant(const pqxx::result::field& r)
 }
 #endif
 
-static inline bool hasTimeZone(const QString& s)
-{
-    return s.at(s.length() - 3) == QLatin1Char('+') || s.at(s.length() - 3) == QLatin1Char('-');
-}
-
 static inline QVariant convertToKDbType(bool convert, const QVariant &value, KDbField::Type kdbType)
 {
     return (convert && kdbType != KDbField::InvalidType)
             ? KDbField::convertToType(value, kdbType) : value;
 }
 
-static inline QTime timeFromData(const char *data, int len)
-{
-    if (len == 0) {
-        return QTime();
-    }
-    QString s(QString::fromLatin1(data, len));
-    if (hasTimeZone(s)) {
-        s.chop(3); // skip timezone
-    }
-    return KDbUtils::timeFromISODateStringWithMs(s);
-}
-
-static inline QDateTime dateTimeFromData(const char *data, int len)
-{
-    if (len < 10 /*ISO Date*/) {
-        return QDateTime();
-    }
-    QString s(QString::fromLatin1(data, len));
-    if (hasTimeZone(s)) {
-        s.chop(3); // skip timezone
-        if (s.isEmpty()) {
-            return QDateTime();
-        }
-    }
-    if (s.at(s.length() - 3).isPunct()) { // fix ms, should be three digits
-        s += QLatin1Char('0');
-    }
-    return KDbUtils::dateTimeFromISODateStringWithMs(s);
-}
-
 static inline QByteArray byteArrayFromData(const char *data)
 {
     size_t unescapedLen;
@@ -220,9 +341,16 @@ static inline QByteArray byteArrayFromData(const char *data)
 //==================================================================================
 //Return the value for a given column for the current record - Private const version
 QVariant PostgresqlCursor::pValue(int pos) const
+{
+    // in streaming mode the result contains only the current record
+    return pValue(m_streaming ? 0 : int(at()), pos);
+}
+
+//==================================================================================
+//Return the value for a given column for record at position row
+QVariant PostgresqlCursor::pValue(int row, int pos) const
 {
 //  postgresqlWarning() << "PostgresqlCursor::value - ERROR: requested position is greater than the number of fields";
-    const qint64 row = at();
 
     KDbField *f = (m_visibleFieldsExpanded && pos < qMin(m_visibleFieldsExpanded->count(), m_fieldCount))
                        ? m_visibleFieldsExpanded->at(pos)->field() : nullptr;
@@ -236,6 +364,12 @@ QVariant PostgresqlCursor::pValue(int pos) const
     const char *data = PQgetvalue(d->res, row, pos);
     int len = PQgetlength(d->res, row, pos);
 
+    if (m_binaryResults && type != KDbField::Text && type != KDbField::LongText) {
+        // text has the same representation in both formats
+        const QVariant value(PostgresqlDriver::binaryToVariant(m_pqTypes[pos], data, len));
+        return convertToKDbType(value.type() != KDbField::variantType(kdbType), value, kdbType);
+    }
+
     switch (type) { // from most to least frequently used types:
     case KDbField::Text:
     case KDbField::LongText: {
@@ -272,11 +406,11 @@ QVariant PostgresqlCursor::pValue(int pos) const
                                 kdbType);
     case KDbField::Time:
         return convertToKDbType(kdbType != KDbField::Time,
-                                timeFromData(data, len),
+                                PostgresqlDriver::timeFromText(data, len),
                                 kdbType);
     case KDbField::DateTime:
         return convertToKDbType(kdbType != KDbField::DateTime,
-                                dateTimeFromData(data, len),
+                                PostgresqlDriver::dateTimeFromText(data, len),
                                 kdbType);
     case KDbField::BLOB:
         return convertToKDbType(kdbType != KDbField::BLOB,
@@ -306,6 +440,117 @@ bool PostgresqlCursor::drv_storeCurrentRecord(KDbRecordData* data) const
     return true;
 }
 
+//==================================================================================
+//Append records following the current one to the batch, column by column
+int PostgresqlCursor::drv_fetchBatch(KDbRecordBatch* batch, int maxRows)
+{
+    const int columns = qMin(batch->columnCount(), m_fieldsToStoreInRecord);
+    if (m_streaming) { // one record per result
+        int count = 0;
+        while (count < maxRows) {
+            getNextStreamedRecord();
+            if (m_fetchResult != FetchResult::Ok) {
+                break;
+            }
+            const int batchRow = batch->appendRecord();
+            for (int col = 0; col < columns; ++col) {
+                fetchColumnInBatch(batch, col, 0, batchRow, 1);
+            }
+            ++count;
+        }
+        batchFetched(count);
+        return count;
+    }
+    const int firstRow = m_at; // the next record
+    const int count = qMax(0, qMin(maxRows, int(m_numRows) - firstRow));
+    m_fetchResult = count < maxRows ? FetchResult::End : FetchResult::Ok;
+    if (count > 0) {
+        const int firstBatchRow = batch->count();
+        for (int i = 0; i < count; ++i) {
+            batch->appendRecord();
+        }
+        for (int col = 0; col < columns; ++col) {
+            fetchColumnInBatch(batch, col, firstRow, firstBatchRow, count);
+        }
+    }
+    batchFetched(count);
+    return count;
+}
+
+//==================================================================================
+//Store values of column col for count records starting at firstRow in the batch
+void PostgresqlCursor::fetchColumnInBatch(KDbRecordBatch* batch, int col, int firstRow,
+                                          int firstBatchRow, int count) const
+{
+    const KDbField::Type type = m_realTypes[col];
+    KDbField *f = (m_visibleFieldsExpanded && col < qMin(m_visibleFieldsExpanded->count(), m_fieldCount))
+                       ? m_visibleFieldsExpanded->at(col)->field() : nullptr;
+    const KDbField::Type kdbType = f ? f->type() : KDbField::InvalidType; // cache: evaluating type of expressions can be expensive
+    const KDbRecordBatch::ColumnType columnType = batch->columnType(col);
+    // decide once per column if the value can be copied without conversion
+    bool native;
+    switch (columnType) {
+    case KDbRecordBatch::ColumnType::Integer: // values of other types are decoded by pValue()
+        native = !m_binaryResults && (type == KDbField::Integer || type == KDbField::BigInteger);
+        break;
+    case KDbRecordBatch::ColumnType::Double:
+        native = !m_binaryResults && type == KDbField::Double;
+        break;
+    case KDbRecordBatch::ColumnType::Boolean:
+        native = !m_binaryResults && type == KDbField::Boolean;
+        break;
+    case KDbRecordBatch::ColumnType::Text:
+        native = d->unicode && (type == KDbField::Text || type == KDbField::LongText);
+        break;
+    case KDbRecordBatch::ColumnType::Binary: // binary format differs between BLOB-like types
+        native = !m_binaryResults && type == KDbField::BLOB;
+        break;
+    default:
+        native = false;
+    }
+    const bool isNullType = kdbType == KDbField::Null;
+    const int maxLength = m_realLengths[col];
+    for (int i = 0; i < count; ++i) {
+        const int row = firstRow + i;
+        const int batchRow = firstBatchRow + i;
+        if (isNullType || PQgetisnull(d->res, row, col)) {
+            continue; // the value is null already
+        }
+        if (!native) {
+            batch->setValue(batchRow, col, pValue(row, col));
+            continue;
+        }
+        const char *data = PQgetvalue(d->res, row, col);
+        int len = PQgetlength(d->res, row, col);
+        switch (columnType) {
+        case KDbRecordBatch::ColumnType::Integer:
+            batch->setInteger(batchRow, col, QByteArray::fromRawData(data, len).toLongLong());
+            break;
+        case KDbRecordBatch::ColumnType::Double:
+            batch->setDouble(batchRow, col, QByteArray::fromRawData(data, len).toDouble());
+            break;
+        case KDbRecordBatch::ColumnType::Boolean:
+            batch->setBoolean(batchRow, col, data[0] == 't');
+            break;
+        case KDbRecordBatch::ColumnType::Text:
+            if (maxLength > 0) {
+                len = qMin(len, maxLength);
+            }
+            batch->setString(batchRow, col, data, len);
+            break;
+        case KDbRecordBatch::ColumnType::Binary: {
+            size_t unescapedLen;
+            unsigned char *unescapedData = PQunescapeBytea((const unsigned char*)data, &unescapedLen);
+            batch->setString(batchRow, col, (const char*)unescapedData, int(unescapedLen));
+            PQfreemem(unescapedData);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
 //==================================================================================
 //
 /*void PostgresqlCursor::drv_clearServerResult()
@@ -27,6 +27,7 @@
 #include <libpq-fe.h>
 
 class KDbConnection;
+class PostgresqlConnectionInternal;
 class PostgresqlCursorData;
 
 class PostgresqlCursor: public KDbCursor
@@ -48,15 +49,39 @@ public:
     void drv_bufferMovePointerNext() override;
     void drv_bufferMovePointerPrev() override;
     void drv_bufferMovePointerTo(qint64 to) override;
+    int drv_fetchBatch(KDbRecordBatch* batch, int maxRows) override;
 
     void storeResultAndClear(PGresult **pgResult, ExecStatusType execStatus);
 
 private:
+    //! Sends the query for streaming and retrieves the first record
+    bool openStreaming(const KDbEscapedString& sql);
+
+    //! Retrieves the next record from the server in streaming mode
+    void getNextStreamedRecord();
+
+    //! Discards all results of the query that are still pending in streaming mode
+    void discardPendingResults();
+
+    //! @return internal data of the cursor's connection
+    PostgresqlConnectionInternal* connectionInternal();
+
+    //! Reads information about fields from the current result
+    void setupFields();
+
     QVariant pValue(int pos)const;
+    QVariant pValue(int row, int pos) const;
+    void fetchColumnInBatch(KDbRecordBatch* batch, int col, int firstRow, int firstBatchRow,
+                            int count) const;
 
     unsigned long m_numRows;
     QVector<KDbField::Type> m_realTypes;
     QVector<int> m_realLengths;
+    QVector<int> m_pqTypes; //!< PostgreSQL types of the fields, needed for binary results
+    bool m_binaryResults; //!< true if the result is in binary format, see setupFields()
+    bool m_streaming; //!< true if records are retrieved one by one (single-row mode)
+    bool m_recordPending; //!< true if the current result contains a record not yet fetched
+    bool m_resultsPending; //!< true if the server still sends results for the query
 
     PostgresqlCursorData * const d;
     Q_DISABLE_COPY(PostgresqlCursor)
@@ -23,6 +23,8 @@
 
 #include "KDbDriver.h"
 
+#include <QDateTime>
+
 class KDbConnection;
 
 //! PostgreSQL database driver.
@@ -98,6 +100,32 @@ public:
         return typeForSize(t, pqfmod, maxTextLength);
     }
 
+    //! @return PostgreSQL type OID used for parameters of KDb type @a type
+    //! that are passed to the server in binary format.
+    //! 0 is returned for types that are passed as text; then the server infers the type.
+    static int kdbToPgsqlType(KDbField::Type type);
+
+    //! @return value of PostgreSQL type @a pqtype decoded from its binary representation
+    //! @a data of @a length bytes, as returned by PQgetvalue() for results in binary format.
+    //! Null value is returned for types that have no binary decoder.
+    static QVariant binaryToVariant(int pqtype, const char *data, int length);
+
+    //! @return true if values of PostgreSQL type @a pqtype can be decoded by binaryToVariant()
+    static bool hasBinaryDecoder(int pqtype);
+
+    //! @return time decoded from text representation @a data of @a length bytes
+    //! returned by the server. Time zone is ignored.
+    static QTime timeFromText(const char *data, int length);
+
+    //! @return date and time decoded from text representation @a data of @a length bytes
+    //! returned by the server. Time zone is ignored.
+    static QDateTime dateTimeFromText(const char *data, int length);
+
+    //! @return value of KDb type @a type decoded from text representation @a data
+    //! of @a length bytes, as returned by the server, e.g. by "COPY ... TO STDOUT".
+    //! BLOB values are expected in the hex format of bytea.
+    static QVariant textToVariant(KDbField::Type type, const char *data, int length);
+
     //! Generates native (driver-specific) HEX() function call.
     //! Uses UPPER(ENCODE(val, 'hex')).
     //! See https://www.postgresql.org/docs/9.3/static/functions-string.html#FUNCTIONS-STRING-OTHER */
@@ -0,0 +1,60 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "PostgresqlPlaceholders.h"
+
+//! @return true if @a c can be a part of an unquoted identifier or keyword
+static inline bool isIdentifierChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+        || c == '_' || c == '$' || (c & 0x80);
+}
+
+QByteArray postgresqlPlaceholders(const KDbEscapedString &sql)
+{
+    QByteArray result;
+    result.reserve(sql.length() + 16);
+    int param = 0;
+    char quote = 0;
+    bool backslashEscapes = false; // true inside E'...'
+    const char *begin = sql.constData();
+    for (const char *s = begin, *end = begin + sql.length(); s < end; ++s) {
+        if (quote) {
+            if (backslashEscapes && *s == '\\' && (s + 1) < end) {
+                result.append(*s++); // the escaped character is appended below
+            } else if (*s == quote) {
+                if ((s + 1) < end && s[1] == quote) { // doubled quote
+                    result.append(*s++);
+                } else {
+                    quote = 0;
+                }
+            }
+        } else if (*s == '\'' || *s == '"') {
+            quote = *s;
+            backslashEscapes = quote == '\'' && s > begin && (s[-1] == 'E' || s[-1] == 'e')
+                && (s - 1 == begin || !isIdentifierChar(s[-2]));
+        } else if (*s == '?') {
+            result.append('$');
+            result.append(QByteArray::number(++param));
+            continue;
+        }
+        result.append(*s);
+    }
+    return result;
+}
@@ -0,0 +1,31 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_POSTGRESQLPLACEHOLDERS_H
+#define KDB_POSTGRESQLPLACEHOLDERS_H
+
+#include "KDbEscapedString.h"
+
+/*! @return @a sql with "?" placeholders replaced by PostgreSQL's $1..$n placeholders.
+ Question marks inside string constants and quoted identifiers are kept. Quotes doubled
+ inside them are recognized, as well as backslash escapes inside E'...' string constants
+ produced by PostgresqlDriver::escapeString(). */
+QByteArray postgresqlPlaceholders(const KDbEscapedString &sql);
+
+#endif
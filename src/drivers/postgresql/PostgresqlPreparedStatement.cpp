@@ -19,42 +19,266 @@
 */
 
 #include "PostgresqlPreparedStatement.h"
-#include "KDbConnection.h"
+#include "PostgresqlConnection.h"
+#include "PostgresqlDriver.h"
+#include "PostgresqlPlaceholders.h"
+#include "postgresql_debug.h"
+#include "KDbError.h"
+#include "KDbUtils.h"
+
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QtEndian>
+
+#include <cstring>
+
+//! Epoch of PostgreSQL's binary date and time values
+static const QDate postgresqlEpoch(2000, 1, 1);
+
+template <typename T>
+static inline void setBigEndian(QByteArray *data, T value)
+{
+    data->resize(sizeof(T));
+    qToBigEndian<T>(value, reinterpret_cast<uchar*>(data->data()));
+}
 
 PostgresqlPreparedStatement::PostgresqlPreparedStatement(PostgresqlConnectionInternal* conn)
         : KDbPreparedStatementInterface()
         , PostgresqlConnectionInternal(conn->connection)
+        , m_preparedOnServer(false)
 {
+    static QAtomicInt statementCounter;
+    this->conn = conn->conn;
+    unicode = conn->unicode;
+    m_name = "kdb_statement_" + QByteArray::number(statementCounter.fetchAndAddRelaxed(1) + 1);
+    const char *integerDateTimes = PQparameterStatus(this->conn, "integer_datetimes");
+    m_integerDateTimes = integerDateTimes && qstrcmp(integerDateTimes, "on") == 0;
 }
 
-
 PostgresqlPreparedStatement::~PostgresqlPreparedStatement()
 {
+    deallocate();
 }
 
 bool PostgresqlPreparedStatement::prepare(const KDbEscapedString& sql)
 {
-    Q_UNUSED(sql);
+    deallocate();
+    m_sql = postgresqlPlaceholders(sql);
+    // the statement is prepared on the server by the first execute() when types are known
     return true;
 }
 
+bool PostgresqlPreparedStatement::prepareOnServer(const KDbField::List &fields)
+{
+    const int count = fields.count();
+    m_paramTypes.resize(count);
+    for (int i = 0; i < count; ++i) {
+        const KDbField::Type type = fields.at(i)->type();
+        Oid oid = PostgresqlDriver::kdbToPgsqlType(type);
+        if (!m_integerDateTimes && (type == KDbField::Time || type == KDbField::DateTime)) {
+            oid = 0; // floating-point timestamps are not supported, use text
+        }
+        m_paramTypes[i] = oid;
+    }
+    m_paramValues.resize(count);
+    m_paramPointers.resize(count);
+    m_paramLengths.resize(count);
+    m_paramFormats.resize(count);
+
+    PGresult *result = PQprepare(conn, m_name.constData(), m_sql.constData(), count,
+                                 m_paramTypes.constData());
+    const ExecStatusType status = PQresultStatus(result);
+    if (status != PGRES_COMMAND_OK) {
+        storeResultAndClear(&m_result, &result, status);
+        postgresqlWarning() << m_result << m_sql;
+        return false;
+    }
+    PQclear(result);
+    m_preparedOnServer = true;
+    return true;
+}
+
+void PostgresqlPreparedStatement::deallocate()
+{
+    if (!m_preparedOnServer) {
+        return;
+    }
+    m_preparedOnServer = false;
+    if (!connection->isConnected()) { // the statement is gone with the session
+        return;
+    }
+    PGresult *result = PQexec(conn, QByteArray("DEALLOCATE " + m_name).constData());
+    PQclear(result);
+}
+
+bool PostgresqlPreparedStatement::encodeValue(const KDbField *field, const QVariant &value,
+                                              bool binary, QByteArray *data) const
+{
+    Q_ASSERT(!value.isNull());
+    bool ok = true;
+    if (!binary) {
+        QString text;
+        switch (field->type()) {
+        case KDbField::Date:
+            ok = value.toDate().isValid();
+            text = value.toDate().toString(Qt::ISODate);
+            break;
+        case KDbField::Time:
+            ok = value.toTime().isValid();
+            text = KDbUtils::toISODateStringWithMs(value.toTime());
+            break;
+        case KDbField::DateTime:
+            ok = value.toDateTime().isValid();
+            text = KDbUtils::toISODateStringWithMs(value.toDateTime());
+            break;
+        default:
+            ok = value.canConvert<QString>();
+            text = value.toString();
+        }
+        *data = unicode ? text.toUtf8() : text.toLocal8Bit();
+        return ok;
+    }
+    // binary formats, see *send() functions in PostgreSQL's src/backend/utils/adt/
+    switch (field->type()) {
+    case KDbField::Byte:
+    case KDbField::ShortInteger: {
+        const int intValue = value.toInt(&ok);
+        if (ok) {
+            setBigEndian<qint16>(data, static_cast<qint16>(intValue));
+        }
+        break;
+    }
+    case KDbField::Integer: {
+        //! @todo what about unsigned > INT_MAX ?
+        const int intValue = value.toInt(&ok);
+        if (ok) {
+            setBigEndian<qint32>(data, intValue);
+        }
+        break;
+    }
+    case KDbField::BigInteger: {
+        const qint64 int64Value = value.toLongLong(&ok);
+        if (ok) {
+            setBigEndian<qint64>(data, int64Value);
+        }
+        break;
+    }
+    case KDbField::Boolean:
+        data->resize(1);
+        (*data)[0] = value.toBool() ? 1 : 0;
+        break;
+    case KDbField::Float: {
+        const float floatValue = value.toFloat(&ok);
+        if (ok) {
+            quint32 bits;
+            memcpy(&bits, &floatValue, sizeof(bits));
+            setBigEndian<quint32>(data, bits);
+        }
+        break;
+    }
+    case KDbField::Double: {
+        const double doubleValue = value.toDouble(&ok);
+        if (ok) {
+            quint64 bits;
+            memcpy(&bits, &doubleValue, sizeof(bits));
+            setBigEndian<quint64>(data, bits);
+        }
+        break;
+    }
+    case KDbField::BLOB:
+        *data = value.toByteArray();
+        break;
+    case KDbField::Date: { // days since epoch
+        const QDate date(value.toDate());
+        ok = date.isValid();
+        if (ok) {
+            setBigEndian<qint32>(data, static_cast<qint32>(postgresqlEpoch.daysTo(date)));
+        }
+        break;
+    }
+    case KDbField::Time: { // microseconds since midnight
+        const QTime time(value.toTime());
+        ok = time.isValid();
+        if (ok) {
+            setBigEndian<qint64>(data, qint64(time.msecsSinceStartOfDay()) * 1000);
+        }
+        break;
+    }
+    case KDbField::DateTime: { // microseconds since epoch
+        const QDateTime dateTime(value.toDateTime());
+        ok = dateTime.isValid();
+        if (ok) {
+            setBigEndian<qint64>(data, postgresqlEpoch.daysTo(dateTime.date()) * Q_INT64_C(86400000000)
+                                       + qint64(dateTime.time().msecsSinceStartOfDay()) * 1000);
+        }
+        break;
+    }
+    default:
+        postgresqlWarning() << "unsupported field type:" << field->type();
+        ok = false;
+    }
+    return ok;
+}
+
 QSharedPointer<KDbSqlResult> PostgresqlPreparedStatement::execute(
     KDbPreparedStatement::Type type, const KDbField::List &selectFieldList,
     KDbFieldList *insertFieldList, const KDbPreparedStatementParameters &parameters)
 {
-    Q_UNUSED(selectFieldList);
-    QSharedPointer<KDbSqlResult> result;
-    if (type == KDbPreparedStatement::InsertStatement) {
-        const int missingValues = insertFieldList->fieldCount() - parameters.count();
-        KDbPreparedStatementParameters myParameters(parameters);
-        if (missingValues > 0) {
-    //! @todo can be more efficient
-            for (int i = 0; i < missingValues; i++) {
-                myParameters.append(QVariant());
-            }
-        }
-        result = connection->insertRecord(insertFieldList, myParameters);
-    }
-//! @todo support select
-    return result;
+    Q_UNUSED(insertFieldList);
+    if (type == KDbPreparedStatement::InvalidStatement) {
+        return QSharedPointer<KDbSqlResult>();
+    }
+    // the connection cannot execute statements while a streaming cursor retrieves records
+    PostgresqlConnection *postgresqlConnection = static_cast<PostgresqlConnection*>(connection);
+    if (!postgresqlConnection->checkNotBusy()) {
+        m_result = postgresqlConnection->result();
+        return QSharedPointer<KDbSqlResult>();
+    }
+    // for INSERT selectFieldList contains inserted fields, for SELECT and DELETE fields
+    // of the WHERE section, for UPDATE fields of the SET section followed by the WHERE section
+    if (!m_preparedOnServer && !prepareOnServer(selectFieldList)) {
+        return QSharedPointer<KDbSqlResult>();
+    }
+    const int count = m_paramTypes.count();
+    KDbField::ListIterator itFields(selectFieldList.constBegin());
+    QList<QVariant>::ConstIterator it(parameters.constBegin());
+    for (int i = 0; i < count; ++i, ++itFields) {
+        const bool binary = m_paramTypes.at(i) != 0;
+        QByteArray *data = &m_paramValues[i];
+        const QVariant value(it == parameters.constEnd() ? QVariant() : *it);
+        if (value.isNull()) {
+            m_paramPointers[i] = nullptr;
+            m_paramLengths[i] = 0;
+            m_paramFormats[i] = 0;
+        } else if (encodeValue(*itFields, value, binary, data)) {
+            m_paramPointers[i] = data->constData();
+            m_paramLengths[i] = data->length();
+            m_paramFormats[i] = binary ? 1 : 0;
+        } else {
+            m_result = KDbResult(ERR_OTHER,
+                                 PostgresqlConnection::tr("Could not convert value \"%1\" of "
+                                                          "parameter %2 to type %3.")
+                                     .arg(value.toString()).arg(i + 1)
+                                     .arg(KDbField::typeName((*itFields)->type())));
+            postgresqlWarning() << m_result << m_sql;
+            return QSharedPointer<KDbSqlResult>();
+        }
+        if (it != parameters.constEnd()) {
+            ++it;
+        }
+    }
+
+    //real execution
+    PGresult *result = PQexecPrepared(conn, m_name.constData(), count, m_paramPointers.constData(),
+                                      m_paramLengths.constData(), m_paramFormats.constData(),
+                                      0 /* text results */);
+    const ExecStatusType status = PQresultStatus(result);
+    if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
+        storeResultAndClear(&m_result, &result, status);
+        postgresqlWarning() << m_result << m_sql;
+        return QSharedPointer<KDbSqlResult>();
+    }
+    m_result = KDbResult();
+    return QSharedPointer<KDbSqlResult>(
+        new PostgresqlSqlResult(static_cast<PostgresqlConnection*>(connection), result, status));
 }
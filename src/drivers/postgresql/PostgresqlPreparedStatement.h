@@ -24,6 +24,12 @@
 #include "KDbPreparedStatementInterface.h"
 #include "PostgresqlConnection_p.h"
 
+#include <QVector>
+
+/*! Implementation of prepared statements for PostgreSQL driver.
+ Named server-side statements are used (PQprepare() and PQexecPrepared()), so the statement
+ is parsed and planned by the server only once. Parameters of numeric, boolean, BLOB,
+ date and time types are sent in binary format; other values are sent as text. */
 class PostgresqlPreparedStatement : public KDbPreparedStatementInterface, public PostgresqlConnectionInternal
 {
 public:
@@ -40,6 +46,27 @@ public:
             const KDbPreparedStatementParameters &parameters) override;
 
 private:
+    //! Prepares the statement on the server using types of @a fields for parameters
+    bool prepareOnServer(const KDbField::List &fields);
+
+    //! Deallocates the statement on the server if it has been prepared
+    void deallocate();
+
+    //! Encodes non-null @a value of @a field in @a data, in binary format if @a binary is true
+    //! @return false if @a value cannot be converted to type of @a field
+    bool encodeValue(const KDbField *field, const QVariant &value, bool binary,
+                     QByteArray *data) const;
+
+    QByteArray m_name; //!< unique name of the statement within the session
+    QByteArray m_sql; //!< SQL statement with $1..$n placeholders
+    QVector<Oid> m_paramTypes; //!< OIDs of parameter types, 0 for text parameters
+    //! Buffers for parameters, reused by subsequent executions
+    QVector<QByteArray> m_paramValues;
+    QVector<const char*> m_paramPointers;
+    QVector<int> m_paramLengths;
+    QVector<int> m_paramFormats;
+    bool m_preparedOnServer;
+    bool m_integerDateTimes; //!< true if the server uses 64-bit integer timestamps
     Q_DISABLE_COPY(PostgresqlPreparedStatement)
 };
 
@@ -42,6 +42,14 @@
 #pragma warning( pop )
 #endif
 
+#include "KDbUtils.h"
+
+#include <QDateTime>
+#include <QtEndian>
+
+#include <cstring>
+#include <limits>
+
 void PostgresqlDriver::initPgsqlToKDbMap()
 {
     m_pgsqlToKDbTypes.insert(BOOLOID, KDbField::Boolean);
@@ -125,3 +133,300 @@ void PostgresqlDriver::initPgsqlToKDbMap()
     //! @todo ANYNONARRAYOID
     //! @todo ANYENUMOID
 }
+
+//static
+int PostgresqlDriver::kdbToPgsqlType(KDbField::Type type)
+{
+    switch (type) {
+    case KDbField::Byte:
+    case KDbField::ShortInteger:
+        return INT2OID;
+    case KDbField::Integer:
+        return INT4OID;
+    case KDbField::BigInteger:
+        return INT8OID;
+    case KDbField::Boolean:
+        return BOOLOID;
+    case KDbField::Float:
+        return FLOAT4OID;
+    case KDbField::Double:
+        return FLOAT8OID;
+    case KDbField::BLOB:
+        return BYTEAOID;
+    case KDbField::Date:
+        return DATEOID;
+    case KDbField::Time:
+        return TIMEOID;
+    case KDbField::DateTime:
+        return TIMESTAMPOID;
+    default:;
+    }
+    return 0;
+}
+
+template <typename T>
+static inline T fromBigEndian(const char *data)
+{
+    return qFromBigEndian<T>(reinterpret_cast<const uchar*>(data));
+}
+
+//! Decodes value of the NUMERIC type: int16 number of digits, int16 weight, uint16 sign,
+//! int16 display scale and digits in base 10000. The value is returned as a string
+//! in the same format as the text representation, so precision is not lost.
+static QVariant numericToVariant(const char *data, int length)
+{
+    if (length < 8) {
+        return QVariant();
+    }
+    const int digits = fromBigEndian<qint16>(data);
+    const int weight = fromBigEndian<qint16>(data + 2);
+    const quint16 sign = fromBigEndian<quint16>(data + 4);
+    const int scale = fromBigEndian<qint16>(data + 6);
+    switch (sign) {
+    case 0xC000:
+        return QStringLiteral("NaN");
+    case 0xD000:
+        return QStringLiteral("Infinity");
+    case 0xF000:
+        return QStringLiteral("-Infinity");
+    default:;
+    }
+    if (digits < 0 || scale < 0 || length < 8 + 2 * digits) {
+        return QVariant();
+    }
+    const auto digit = [data, digits](int i) {
+        return (i >= 0 && i < digits) ? int(fromBigEndian<qint16>(data + 8 + 2 * i)) : 0;
+    };
+    QString result;
+    if (sign == 0x4000) {
+        result += QLatin1Char('-');
+    }
+    if (weight < 0) {
+        result += QLatin1Char('0');
+    } else {
+        result += QString::number(digit(0));
+        for (int i = 1; i <= weight; ++i) {
+            result += QString::number(digit(i)).rightJustified(4, QLatin1Char('0'));
+        }
+    }
+    if (scale > 0) {
+        QString fraction;
+        for (int i = weight + 1; fraction.length() < scale; ++i) {
+            fraction += QString::number(digit(i)).rightJustified(4, QLatin1Char('0'));
+        }
+        fraction.truncate(scale);
+        result += QLatin1Char('.') + fraction;
+    }
+    return result;
+}
+
+//static
+QVariant PostgresqlDriver::binaryToVariant(int pqtype, const char *data, int length)
+{
+    // Formats are defined by *send() functions in PostgreSQL's src/backend/utils/adt/
+    static const QDate epoch(2000, 1, 1);
+    switch (pqtype) {
+    case INT2OID:
+        return length == 2 ? QVariant(int(fromBigEndian<qint16>(data))) : QVariant();
+    case INT4OID:
+        return length == 4 ? QVariant(fromBigEndian<qint32>(data)) : QVariant();
+    case INT8OID:
+        return length == 8 ? QVariant(fromBigEndian<qint64>(data)) : QVariant();
+    case OIDOID:
+    case XIDOID:
+    case CIDOID:
+    case REGPROCOID:
+        return length == 4 ? QVariant(fromBigEndian<quint32>(data)) : QVariant();
+    case CHAROID:
+        return length == 1 ? QVariant(int(data[0])) : QVariant();
+    case BOOLOID:
+        return length == 1 ? QVariant(data[0] != 0) : QVariant();
+    case FLOAT4OID: {
+        if (length != 4) {
+            return QVariant();
+        }
+        const quint32 bits = fromBigEndian<quint32>(data);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return double(value);
+    }
+    case FLOAT8OID: {
+        if (length != 8) {
+            return QVariant();
+        }
+        const quint64 bits = fromBigEndian<quint64>(data);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    case NUMERICOID:
+        return numericToVariant(data, length);
+    case DATEOID: { // days since epoch
+        if (length != 4) {
+            return QVariant();
+        }
+        const qint32 days = fromBigEndian<qint32>(data);
+        if (days == std::numeric_limits<qint32>::max() || days == std::numeric_limits<qint32>::min()) {
+            return QDate(); // infinity
+        }
+        return epoch.addDays(days);
+    }
+    case TIMEOID:
+    case TIMETZOID: { // microseconds since midnight, followed by zone for TIMETZ (skipped)
+        if (length < 8) {
+            return QVariant();
+        }
+        return QTime(0, 0).addMSecs(int(fromBigEndian<qint64>(data) / 1000));
+    }
+    case TIMESTAMPOID:
+    case TIMESTAMPTZOID: { // microseconds since epoch; TIMESTAMPTZ is in UTC
+        if (length != 8) {
+            return QVariant();
+        }
+        const qint64 usecs = fromBigEndian<qint64>(data);
+        if (usecs == std::numeric_limits<qint64>::max() || usecs == std::numeric_limits<qint64>::min()) {
+            return QDateTime(); // infinity
+        }
+        const qint64 msecsPerDay = Q_INT64_C(86400000);
+        qint64 days = usecs / 1000 / msecsPerDay;
+        qint64 msecs = usecs / 1000 % msecsPerDay;
+        if (msecs < 0) {
+            msecs += msecsPerDay;
+            --days;
+        }
+        return QDateTime(epoch.addDays(days), QTime(0, 0).addMSecs(int(msecs)),
+                         pqtype == TIMESTAMPTZOID ? Qt::UTC : Qt::LocalTime);
+    }
+    case BYTEAOID:
+    case NAMEOID:
+        return QByteArray(data, length);
+    case BITOID:
+    case VARBITOID: { // int32 number of bits followed by the bits; same as text, e.g. "0101"
+        if (length < 4) {
+            return QVariant();
+        }
+        const qint32 bits = fromBigEndian<qint32>(data);
+        if (bits < 0 || length < 4 + (bits + 7) / 8) {
+            return QVariant();
+        }
+        QByteArray result(bits, '0');
+        for (int i = 0; i < bits; ++i) {
+            if (data[4 + i / 8] & (0x80 >> (i % 8))) {
+                result[i] = '1';
+            }
+        }
+        return result;
+    }
+    case TEXTOID:
+    case VARCHAROID:
+    case BPCHAROID:
+    case XMLOID:
+        return QString::fromUtf8(data, length);
+    default:;
+    }
+    return QVariant();
+}
+
+static inline bool hasTimeZone(const QString& s)
+{
+    return s.at(s.length() - 3) == QLatin1Char('+') || s.at(s.length() - 3) == QLatin1Char('-');
+}
+
+//static
+QTime PostgresqlDriver::timeFromText(const char *data, int length)
+{
+    if (length == 0) {
+        return QTime();
+    }
+    QString s(QString::fromLatin1(data, length));
+    if (hasTimeZone(s)) {
+        s.chop(3); // skip timezone
+    }
+    return KDbUtils::timeFromISODateStringWithMs(s);
+}
+
+//static
+QDateTime PostgresqlDriver::dateTimeFromText(const char *data, int length)
+{
+    if (length < 10 /*ISO Date*/) {
+        return QDateTime();
+    }
+    QString s(QString::fromLatin1(data, length));
+    if (hasTimeZone(s)) {
+        s.chop(3); // skip timezone
+        if (s.isEmpty()) {
+            return QDateTime();
+        }
+    }
+    if (s.at(s.length() - 3).isPunct()) { // fix ms, should be three digits
+        s += QLatin1Char('0');
+    }
+    return KDbUtils::dateTimeFromISODateStringWithMs(s);
+}
+
+//static
+QVariant PostgresqlDriver::textToVariant(KDbField::Type type, const char *data, int length)
+{
+    const QByteArray text(QByteArray::fromRawData(data, length));
+    switch (type) {
+    case KDbField::Byte:
+    case KDbField::ShortInteger:
+    case KDbField::Integer:
+        return text.toInt();
+    case KDbField::BigInteger:
+        return text.toLongLong();
+    case KDbField::Boolean:
+        return bool(length > 0 && data[0] == 't');
+    case KDbField::Float:
+    case KDbField::Double:
+        return text.toDouble();
+    case KDbField::Date:
+        return QDate::fromString(QLatin1String(text), Qt::ISODate);
+    case KDbField::Time:
+        return timeFromText(data, length);
+    case KDbField::DateTime:
+        return dateTimeFromText(data, length);
+    case KDbField::BLOB:
+        if (text.startsWith("\\x")) {
+            return QByteArray::fromHex(text.mid(2));
+        }
+        return QByteArray(data, length);
+    default:;
+    }
+    return KDbField::convertToType(QString::fromUtf8(data, length), type);
+}
+
+//static
+bool PostgresqlDriver::hasBinaryDecoder(int pqtype)
+{
+    switch (pqtype) {
+    case INT2OID:
+    case INT4OID:
+    case INT8OID:
+    case OIDOID:
+    case XIDOID:
+    case CIDOID:
+    case REGPROCOID:
+    case CHAROID:
+    case BOOLOID:
+    case FLOAT4OID:
+    case FLOAT8OID:
+    case NUMERICOID:
+    case DATEOID:
+    case TIMEOID:
+    case TIMETZOID:
+    case TIMESTAMPOID:
+    case TIMESTAMPTZOID:
+    case BYTEAOID:
+    case NAMEOID:
+    case BITOID:
+    case VARBITOID:
+    case TEXTOID:
+    case VARCHAROID:
+    case BPCHAROID:
+    case XMLOID:
+        return true;
+    default:;
+    }
+    return false;
+}
@@ -48,9 +48,19 @@ bool SqliteAdminTools::vacuum(const KDbConnectionData& data, const QString& data
     }
     QFileInfo file(databaseName);
     SqliteVacuum vacuum(QDir::fromNativeSeparators(file.absoluteFilePath()));
+    const ProgressFunction progressFunction(this->progressFunction());
+    if (progressFunction) {
+        QObject::connect(&vacuum, &SqliteVacuum::progress, &vacuum,
+                         [&vacuum, &progressFunction](int percent) {
+                             if (!progressFunction(percent)) {
+                                 vacuum.cancel();
+                             }
+                         });
+    }
     tristate result = vacuum.run();
     if (false == result) {
-        m_result = KDbResult(title);
+        m_result = vacuum.result();
+        m_result.prependMessage(title);
         return false;
     } else { //success or cancelled
         return true;
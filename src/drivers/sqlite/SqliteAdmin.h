@@ -31,7 +31,7 @@ public:
     ~SqliteAdminTools() override;
 
 #ifdef KDB_SQLITE_VACUUM
-    /*! Performs vacuum (compacting) for connection @a conn. */
+    /*! Performs vacuum (compacting) for connection @a conn, see SqliteVacuum. */
     bool vacuum(const KDbConnectionData &data, const QString &databaseName) override;
 #endif
 private:
@@ -22,6 +22,7 @@
 #include "SqliteCursor.h"
 #include "SqlitePreparedStatement.h"
 #include "SqliteFunctions.h"
+#include "SqliteStatementCache.h"
 #include "sqlite_debug.h"
 
 #include <sqlite3.h>
@@ -36,10 +37,47 @@
 #include <QDir>
 #include <QRegularExpression>
 
+namespace {
+//! PRAGMAs set by a performance profile, nullptr values are not changed
+struct PerformanceProfile {
+    const char *name;
+    const char *pageSize; //!< only has effect for new databases
+    const char *journalMode;
+    const char *synchronous;
+    const char *cacheSize; //!< negative values are in KiB
+    const char *mmapSize;
+    const char *tempStore;
+    const char *secureDelete;
+};
+
+//! Profiles supported by the sqlitePerformanceProfile option, the first one is the default
+const PerformanceProfile performanceProfiles[] = {
+    // Journal mode of the database file is kept, e.g. WAL set by the user or another application
+    { "durable", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, "on" },
+    { "balanced", nullptr, "wal", "normal", "-16384", "268435456", "memory", "off" },
+    { "bulk-load", "16384", "memory", "off", "-65536", "268435456", "memory", "off" }
+};
+
+//! Options that store values of PRAGMAs in effect, and names of the PRAGMAs
+const struct {
+    const char *option;
+    const char *pragma;
+} pragmaOptions[] = {
+    { "sqlitePageSize", "page_size" },
+    { "sqliteJournalMode", "journal_mode" },
+    { "sqliteSynchronous", "synchronous" },
+    { "sqliteCacheSize", "cache_size" },
+    { "sqliteMmapSize", "mmap_size" },
+    { "sqliteTempStore", "temp_store" },
+    { "sqliteSecureDelete", "secure_delete" }
+};
+}
+
 SqliteConnection::SqliteConnection(KDbDriver *driver, const KDbConnectionData& connData,
                                    const KDbConnectionOptions &options)
         : KDbConnection(driver, connData, options)
         , d(new SqliteConnectionInternal(this))
+        , m_statementCache(new SqliteStatementCache)
 {
     QByteArray propertyName = "extraSqliteExtensionPaths";
     KDbUtils::Property extraSqliteExtensionPathsProperty = this->options()->property(propertyName);
@@ -47,11 +85,38 @@ SqliteConnection::SqliteConnection(KDbDriver *driver, const KDbConnectionData& c
         this->options()->insert(propertyName, QStringList());
     }
     this->options()->setCaption(propertyName, SqliteConnection::tr("Extra paths for SQLite plugins"));
+
+    propertyName = "sqliteStatementCacheSize";
+    if (this->options()->property(propertyName).isNull()) {
+        this->options()->insert(propertyName, SqliteStatementCache::defaultCapacity());
+    }
+    this->options()->setCaption(propertyName, SqliteConnection::tr("Size of SQLite statement cache"));
+    setReadOnlyOption("sqliteStatementCacheHits", qulonglong(0),
+                      SqliteConnection::tr("SQLite statement cache hits"));
+    setReadOnlyOption("sqliteStatementCacheMisses", qulonglong(0),
+                      SqliteConnection::tr("SQLite statement cache misses"));
+
+    propertyName = "sqlitePerformanceProfile";
+    if (this->options()->property(propertyName).isNull()) {
+        this->options()->insert(propertyName, QString::fromLatin1(performanceProfiles[0].name));
+    }
+    this->options()->setCaption(propertyName, SqliteConnection::tr("SQLite performance profile"));
+    setReadOnlyOption("sqliteJournalMode", QString(), SqliteConnection::tr("SQLite journal mode"));
+    setReadOnlyOption("sqliteSynchronous", QString(),
+                      SqliteConnection::tr("SQLite synchronous mode"));
+    setReadOnlyOption("sqliteCacheSize", QString(), SqliteConnection::tr("SQLite page cache size"));
+    setReadOnlyOption("sqliteMmapSize", QString(),
+                      SqliteConnection::tr("SQLite memory-mapped I/O size"));
+    setReadOnlyOption("sqliteTempStore", QString(),
+                      SqliteConnection::tr("SQLite temporary storage"));
+    setReadOnlyOption("sqlitePageSize", QString(), SqliteConnection::tr("SQLite page size"));
+    setReadOnlyOption("sqliteSecureDelete", QString(), SqliteConnection::tr("SQLite secure delete"));
 }
 
 SqliteConnection::~SqliteConnection()
 {
     destroy();
+    delete m_statementCache;
     delete d;
 }
 
@@ -96,6 +161,36 @@ tristate SqliteConnection::drv_containsTable(const QString &tableName)
                             .arg(escapeString(tableName)));
 }
 
+tristate SqliteConnection::drv_estimatedRecordCount(const KDbTableSchema &tableSchema,
+                                                   qint64 *count)
+{
+    const tristate statisticsExist = resultExists(KDbEscapedString(
+        "SELECT name FROM sqlite_master WHERE type='table' AND name='sqlite_stat1'"));
+    if (statisticsExist != true) {
+        return statisticsExist;
+    }
+    // The "stat" column starts with the number of records of the table, or of the index
+    // that has the same number of entries. The row without index is used first if present.
+    // sqlite_stat4 has no better information for whole tables.
+    QString stat;
+    // Statistics change without modifications of the table so they are not cached
+    const tristate result = querySingleString(
+        KDbEscapedString("SELECT stat FROM sqlite_stat1 WHERE tbl=%1 COLLATE NOCASE "
+                         "ORDER BY idx IS NOT NULL")
+            .arg(escapeString(tableSchema.name())), &stat, 0,
+        QueryRecordOption::Default | QueryRecordOption::NoResultCache);
+    if (result != true) {
+        return result;
+    }
+    bool ok;
+    const qint64 number = stat.section(QLatin1Char(' '), 0, 0).toLongLong(&ok);
+    if (!ok) {
+        return cancelled;
+    }
+    *count = number;
+    return true;
+}
+
 #if 0 // TODO
 bool SqliteConnection::drv_getTablesList(QStringList* list)
 {
@@ -166,12 +261,12 @@ bool SqliteConnection::drv_useDatabaseInternal(bool *cancelled,
     storeResult();
 
     if (!m_result.isError()) {
-        // Set the secure-delete on, so SQLite overwrites deleted content with zeros.
-        // The default setting is determined by the SQLITE_SECURE_DELETE compile-time option but we overwrite it here.
-        // Works with 3.6.23. Earlier version just ignore this pragma.
-        // See https://www.sqlite.org/pragma.html#pragma_secure_delete
-//! @todo add connection flags to the driver and global setting to control the "secure delete" pragma
-        if (!drv_executeSql(KDbEscapedString("PRAGMA secure_delete = on"))) {
+        bool ok;
+        const int statementCacheSize
+            = options()->property("sqliteStatementCacheSize").value().toInt(&ok);
+        m_statementCache->setCapacity(ok ? statementCacheSize
+                                         : SqliteStatementCache::defaultCapacity());
+        if (!applyPerformanceProfile()) {
             drv_closeDatabaseSilently();
             return false;
         }
@@ -249,6 +344,7 @@ bool SqliteConnection::drv_closeDatabase()
     if (!d->data)
         return false;
 
+    m_statementCache->clear(); // otherwise sqlite3_close() fails with SQLITE_BUSY
     const int res = sqlite3_close(d->data);
     if (SQLITE_OK == res) {
         d->data = nullptr;
@@ -276,6 +372,10 @@ bool SqliteConnection::drv_dropDatabase(const QString &dbName)
                    .arg(QDir::fromNativeSeparators(filename)));
         return false;
     }
+    // Remove files left by the WAL journal mode so they are not used by a new database
+    for (const char *suffix : { "-wal", "-shm" }) {
+        QFile::remove(filename + QLatin1String(suffix));
+    }
     return true;
 }
 
@@ -296,13 +396,7 @@ KDbSqlResult* SqliteConnection::drv_prepareSql(const KDbEscapedString& sql)
 #endif
 
     sqlite3_stmt *prepared_st = nullptr;
-    const int res = sqlite3_prepare(
-                 d->data,            /* Database handle */
-                 sql.constData(),    /* SQL statement, UTF-8 encoded */
-                 sql.length(),       /* Length of zSql in bytes. */
-                 &prepared_st,       /* OUT: Statement handle */
-                 nullptr/*const char **pzTail*/     /* OUT: Pointer to unused portion of zSql */
-             );
+    const int res = acquireStatement(sql, &prepared_st);
     if (res != SQLITE_OK) {
         m_result.setServerErrorCode(res);
         storeResult();
@@ -318,6 +412,53 @@ KDbSqlResult* SqliteConnection::drv_prepareSql(const KDbEscapedString& sql)
     return new SqliteSqlResult(this, prepared_st);
 }
 
+bool SqliteConnection::applyPerformanceProfile()
+{
+    const QString profileName = options()->property("sqlitePerformanceProfile").value().toString();
+    const PerformanceProfile *profile = nullptr;
+    for (const PerformanceProfile &p : performanceProfiles) {
+        if (profileName == QLatin1String(p.name)) {
+            profile = &p;
+            break;
+        }
+    }
+    if (!profile) {
+        clearResult();
+        m_result = KDbResult(ERR_OBJECT_NOT_FOUND,
+                             SqliteConnection::tr("Unknown SQLite performance profile \"%1\".")
+                                 .arg(profileName));
+        return false;
+    }
+    const bool readOnly = options()->isReadOnly();
+    // The order matters: page size cannot be changed after switching to WAL
+    const struct {
+        const char *pragma;
+        const char *value;
+    } pragmas[] = {
+        { "page_size", readOnly ? nullptr : profile->pageSize },
+        { "journal_mode", readOnly ? nullptr : profile->journalMode },
+        { "synchronous", profile->synchronous },
+        { "cache_size", profile->cacheSize },
+        { "mmap_size", profile->mmapSize },
+        { "temp_store", profile->tempStore },
+        // Works with 3.6.23. Earlier version just ignore this pragma.
+        // See https://www.sqlite.org/pragma.html#pragma_secure_delete
+        { "secure_delete", profile->secureDelete }
+    };
+    for (const auto &pragma : pragmas) {
+        if (pragma.value
+            && !drv_executeSql(KDbEscapedString("PRAGMA ") + pragma.pragma + " = " + pragma.value))
+        {
+            return false;
+        }
+    }
+    for (const auto &pragmaOption : pragmaOptions) {
+        const QVariant value = SqliteConnectionInternal::pragmaValue(d->data, pragmaOption.pragma);
+        setReadOnlyOption(pragmaOption.option, value.toString());
+    }
+    return true;
+}
+
 bool SqliteConnection::drv_executeSql(const KDbEscapedString& sql)
 {
 #ifdef KDB_DEBUG_GUI
@@ -342,12 +483,78 @@ bool SqliteConnection::drv_executeSql(const KDbEscapedString& sql)
         storeResult();
     }
 
+    if (res == SQLITE_OK && SqliteStatementCache::isSchemaChangingStatement(sql)) {
+        // compiled statements would be recompiled by SQLite anyway
+        m_statementCache->clear();
+    }
+
 #ifdef KDB_DEBUG_GUI
     KDb::debugGUI(QLatin1String( res == SQLITE_OK ? "  Success" : "  Failure"));
 #endif
     return res == SQLITE_OK;
 }
 
+bool SqliteConnection::drv_insertRecords(const QString &tableName, KDbFieldList *fields,
+                                         const QList<QList<QVariant>> &records)
+{
+    const KDbField::List *flist = fields->fields();
+    KDbEscapedString sql(KDbEscapedString("INSERT INTO ") + escapeIdentifier(tableName)
+                         + " (" + fields->sqlFieldsList(this) + ") VALUES (");
+    for (int i = 0; i < flist->count(); ++i) {
+        sql += (i == 0 ? "?" : ",?");
+    }
+    sql += ')';
+    m_result.setSql(sql);
+
+    sqlite3_stmt *statement = nullptr;
+    int res = acquireStatement(sql, &statement);
+    for (QList<QList<QVariant>>::ConstIterator it = records.constBegin();
+         res == SQLITE_OK && it != records.constEnd(); ++it)
+    {
+        int par = 1; // par.index counted from 1
+        for (KDbField *f : *flist) {
+            res = SqliteConnectionInternal::bindValue(
+                      statement, f, par <= it->count() ? it->at(par - 1) : QVariant(), par);
+            if (res != SQLITE_OK) {
+                break;
+            }
+            ++par;
+        }
+        if (res == SQLITE_OK) {
+            res = sqlite3_step(statement);
+            if (res == SQLITE_DONE) {
+                res = sqlite3_reset(statement);
+            }
+        }
+    }
+    if (res != SQLITE_OK) {
+        m_result.setServerErrorCode(res);
+        storeResult();
+    }
+    (void)releaseStatement(statement);
+    return res == SQLITE_OK;
+}
+
+int SqliteConnection::acquireStatement(const KDbEscapedString &sql, sqlite3_stmt **statement)
+{
+    const int res = m_statementCache->acquire(d->data, sql, statement);
+    updateStatementCacheStatistics();
+    return res;
+}
+
+int SqliteConnection::releaseStatement(sqlite3_stmt *statement)
+{
+    return m_statementCache->release(statement);
+}
+
+void SqliteConnection::updateStatementCacheStatistics()
+{
+    // captions are set in the constructor, empty ones are not overwriting them
+    setReadOnlyOption("sqliteStatementCacheHits", qulonglong(m_statementCache->hits()), QString());
+    setReadOnlyOption("sqliteStatementCacheMisses", qulonglong(m_statementCache->misses()),
+                      QString());
+}
+
 QString SqliteConnection::serverResultName() const
 {
     return SqliteConnectionInternal::serverResultName(m_result.serverErrorCode());
@@ -25,13 +25,49 @@
 #include "KDbConnection.h"
 
 class SqliteConnectionInternal;
+class SqliteStatementCache;
 class KDbDriver;
+struct sqlite3_stmt;
 
 /*! @brief SQLite-specific connection
     Following connection options are supported (see KDbConnectionOptions):
     - extraSqliteExtensionPaths (read/write, QStringList): adds extra seach paths for SQLite
                                 extensions. Set them before KDbConnection::useDatabase()
                                 is called. Absolute paths are recommended.
+    - sqliteStatementCacheSize (read/write, int): maximum number of compiled statements kept
+                               for reuse by this connection, see SqliteStatementCache.
+                               0 disables the cache. Set it before KDbConnection::useDatabase()
+                               is called. Default is 100.
+    - sqliteStatementCacheHits (read only, qulonglong): number of statements reused from the cache.
+                               Updated each time a statement is requested from the cache.
+    - sqliteStatementCacheMisses (read only, qulonglong): number of statements that had to be
+                                 compiled because they were not found in the cache. Updated
+                                 each time a statement is requested from the cache.
+    - sqlitePerformanceProfile (read/write, QString): storage settings applied when the database
+                               is opened. Set it before KDbConnection::useDatabase() is called.
+                               Supported profiles:
+                               - "durable" (default): SQLite defaults and secure_delete on,
+                                 so deleted content is overwritten with zeros. The journal
+                                 mode is not changed: new databases use rollback journal
+                                 (DELETE mode) and databases in the persistent WAL mode,
+                                 e.g. set by the "balanced" profile, are kept in WAL mode.
+                               - "balanced": WAL journal, synchronous NORMAL, 16 MiB page cache,
+                                 256 MiB memory-mapped I/O, temporary data in memory,
+                                 secure_delete off. Committed transactions can be lost but
+                                 the database is not corrupted on power failure. WAL mode
+                                 is stored in the database file so it is kept when the
+                                 database is opened later with the "durable" profile.
+                               - "bulk-load": journal in memory, synchronous OFF, 64 MiB page
+                                 cache, 256 MiB memory-mapped I/O, temporary data in memory,
+                                 16 KiB pages for new files, secure_delete off. The database
+                                 can be corrupted on crash or power failure; use it only for
+                                 data that can be recreated.
+    - sqliteJournalMode, sqliteSynchronous, sqliteCacheSize, sqliteMmapSize, sqliteTempStore,
+      sqlitePageSize, sqliteSecureDelete (read only): values of the respective PRAGMAs
+                               in effect after the database has been opened. They may differ
+                               from the profile, e.g. journal mode is not changed by read-only
+                               connections. The options cannot be changed by the user,
+                               see KDbConnectionOptions::isReadOnlyOption().
 */
 class SqliteConnection : public KDbConnection
 {
@@ -66,6 +102,10 @@ protected:
 //! @todo move this somewhere to low level class (MIGRATION?)
     tristate drv_containsTable(const QString &tableName) override;
 
+    //! Estimates number of records using the sqlite_stat1 table created by ANALYZE
+    tristate drv_estimatedRecordCount(const KDbTableSchema &tableSchema,
+                                      qint64 *count) override;
+
     /*! Creates new database using connection. Note: Do not pass @a dbName
       arg because for file-based engine (that has one database per connection)
       it is defined during connection. */
@@ -89,6 +129,10 @@ protected:
 
     bool drv_executeSql(const KDbEscapedString& sql) override;
 
+    //! Inserts records using a single prepared INSERT statement with bound parameters
+    bool drv_insertRecords(const QString &tableName, KDbFieldList *fields,
+                           const QList<QList<QVariant>> &records) override;
+
     //! Implemented for KDbResultable
     QString serverResultName() const override;
 
@@ -105,6 +149,11 @@ protected:
 private:
     bool drv_useDatabaseInternal(bool *cancelled, KDbMessageHandler* msgHandler, bool createIfMissing);
 
+    //! Applies PRAGMAs of the profile set in the sqlitePerformanceProfile option
+    //! and stores their effective values in connection's options.
+    //! @return true on success
+    bool applyPerformanceProfile();
+
     //! Closes database without altering stored result number and message
     void drv_closeDatabaseSilently();
 
@@ -117,6 +166,21 @@ private:
     //! @return true on success
     bool loadExtension(const QString& path);
 
+    //! Provides compiled statement for @a sql using the statement cache.
+    //! @return SQLite result code, SQLITE_OK on success.
+    //! @see SqliteStatementCache::acquire()
+    int acquireStatement(const KDbEscapedString &sql, sqlite3_stmt **statement);
+
+    //! Passes @a statement obtained using acquireStatement() back to the statement cache.
+    //! @see SqliteStatementCache::release()
+    int releaseStatement(sqlite3_stmt *statement);
+
+    //! Copies hit/miss counters of the statement cache to connection's read-only options.
+    //! Called by acquireStatement() so the options are always up to date.
+    void updateStatementCacheStatistics();
+
+    SqliteStatementCache * const m_statementCache;
+
     friend class SqliteDriver;
     friend class SqliteCursor;
     friend class SqliteSqlResult;
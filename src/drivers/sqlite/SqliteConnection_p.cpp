@@ -18,6 +18,9 @@
 */
 
 #include "SqliteConnection_p.h"
+#include "sqlite_debug.h"
+
+#include "KDbUtils.h"
 
 SqliteConnectionInternal::SqliteConnectionInternal(KDbConnection *connection)
         : KDbConnectionInternal(connection)
@@ -97,6 +100,91 @@ void SqliteConnectionInternal::setExtensionsLoadingEnabled(bool set)
     m_extensionsLoadingEnabled = set;
 }
 
+//static
+QVariant SqliteConnectionInternal::pragmaValue(sqlite3 *db, const char *name)
+{
+    QVariant value;
+    sqlite3_stmt *statement = nullptr;
+    if (SQLITE_OK == sqlite3_prepare_v2(db, (QByteArray("PRAGMA ") + name).constData(), -1,
+                                        &statement, nullptr)
+        && SQLITE_ROW == sqlite3_step(statement))
+    {
+        if (sqlite3_column_type(statement, 0) == SQLITE_INTEGER) {
+            value = qint64(sqlite3_column_int64(statement, 0));
+        } else {
+            value = QString::fromUtf8((const char*)sqlite3_column_text(statement, 0));
+        }
+    }
+    sqlite3_finalize(statement);
+    return value;
+}
+
+//static
+int SqliteConnectionInternal::bindValue(sqlite3_stmt *statement, KDbField *field,
+                                        const QVariant& value, int par)
+{
+    if (value.isNull()) {
+        //no value to bind or the value is null: bind NULL
+        return sqlite3_bind_null(statement, par);
+    }
+    if (field->isTextType()) {
+        //! @todo optimize: make a static copy so SQLITE_STATIC can be used
+        const QByteArray utf8String(value.toString().toUtf8());
+        return sqlite3_bind_text(statement, par,
+                                 utf8String.constData(), utf8String.length(), SQLITE_TRANSIENT /*??*/);
+    }
+
+    switch (field->type()) {
+    case KDbField::Byte:
+    case KDbField::ShortInteger:
+    case KDbField::Integer: {
+        //! @todo what about unsigned > INT_MAX ?
+        bool ok;
+        const int intValue = value.toInt(&ok);
+        if (ok) {
+            return sqlite3_bind_int(statement, par, intValue);
+        }
+        return sqlite3_bind_null(statement, par);
+    }
+    case KDbField::Float:
+    case KDbField::Double:
+        return sqlite3_bind_double(statement, par, value.toDouble());
+    case KDbField::BigInteger: {
+        //! @todo what about unsigned > LLONG_MAX ?
+        bool ok;
+        const qint64 int64Value = value.toLongLong(&ok);
+        if (ok) {
+            return sqlite3_bind_int64(statement, par, int64Value);
+        }
+        return sqlite3_bind_null(statement, par);
+    }
+    case KDbField::Boolean:
+        return sqlite3_bind_text(statement, par, value.toBool() ? "1" : "0",
+                                 1, SQLITE_TRANSIENT /*??*/);
+    case KDbField::Time:
+        return sqlite3_bind_text(statement, par,
+                                 qPrintable(KDbUtils::toISODateStringWithMs(value.toTime())),
+                                 QLatin1String("HH:MM:SS").size(), SQLITE_TRANSIENT /*??*/);
+    case KDbField::Date:
+        return sqlite3_bind_text(statement, par,
+                                 qPrintable(value.toDate().toString(Qt::ISODate)),
+                                 QLatin1String("YYYY-MM-DD").size(), SQLITE_TRANSIENT /*??*/);
+    case KDbField::DateTime:
+        return sqlite3_bind_text(statement, par,
+                                 qPrintable(KDbUtils::toISODateStringWithMs(value.toDateTime())),
+                                 QLatin1String("YYYY-MM-DDTHH:MM:SS").size(), SQLITE_TRANSIENT /*??*/);
+    case KDbField::BLOB: {
+        const QByteArray byteArray(value.toByteArray());
+        return sqlite3_bind_blob(statement, par,
+                                 byteArray.constData(), byteArray.size(), SQLITE_TRANSIENT /*??*/);
+    }
+    default:
+        sqliteWarning() << "unsupported field type:"
+                << field->type() << "- NULL value bound to column #" << par;
+        return sqlite3_bind_null(statement, par);
+    }
+}
+
 //static
 KDbField::Type SqliteSqlResult::type(int sqliteType)
 {
@@ -191,15 +279,13 @@ bool SqliteSqlResult::cacheFieldInfo(const QString &tableName)
             break;
         }
         info->defaultValue = record->stringValue(columnIndex[TableInfoDefault]);
-        info->isNotNull
-            = record->cstringValue(columnIndex[TableInfoNotNull]).rawDataToByteArray() == "1";
+        info->isNotNull = record->int64Value(columnIndex[TableInfoNotNull]) == 1;
         //! @todo Support composite primary keys:
         //! The "pk" column in the result set is zero for columns that are not part of
         //! the primary key, and is the index of the column in the primary key for columns
         //! that are part of the primary key.
         //! https://www.sqlite.org/pragma.html#pragma_table_info
-        info->isPrimaryKey
-            = record->cstringValue(columnIndex[TableInfoPK]).rawDataToByteArray() != "0";
+        info->isPrimaryKey = record->int64Value(columnIndex[TableInfoPK]) != 0;
         cachedFieldInfos.insert(name, info.take());
     }
     if (!ok) {
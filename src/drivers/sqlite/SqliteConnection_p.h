@@ -46,6 +46,14 @@ public:
 
     void storeResult(KDbResult *result);
 
+    //! Binds @a value of @a field to parameter @a par (counted from 1) of @a statement
+    //! @return result of the sqlite3_bind_*() call
+    static int bindValue(sqlite3_stmt *statement, KDbField *field, const QVariant& value, int par);
+
+    //! @return value of PRAGMA @a name for database @a db, null value on failure
+    //! Integer values are returned as qint64, other values as strings.
+    static QVariant pragmaValue(sqlite3 *db, const char *name);
+
     sqlite3 *data;
     bool data_owned; //!< true if data pointer should be freed on destruction
 
@@ -102,6 +110,25 @@ public:
         return QByteArray((const char*)sqlite3_column_blob(prepared_st, index),
                           sqlite3_column_bytes(prepared_st, index));
     }
+    inline bool isNull(int index) override {
+        return sqlite3_column_type(prepared_st, index) == SQLITE_NULL;
+    }
+    inline qint64 int64Value(int index) override {
+        return sqlite3_column_int64(prepared_st, index);
+    }
+    inline double doubleValue(int index) override {
+        return sqlite3_column_double(prepared_st, index);
+    }
+    inline bool boolValue(int index) override {
+        if (sqlite3_column_type(prepared_st, index) == SQLITE_TEXT) {
+            return KDbSqlRecord::boolValue(index);
+        }
+        return sqlite3_column_double(prepared_st, index) != 0.0;
+    }
+    inline KDbSqlString blobView(int index) override {
+        return KDbSqlString((const char*)sqlite3_column_blob(prepared_st, index),
+                            sqlite3_column_bytes(prepared_st, index));
+    }
 
 private:
     sqlite3_stmt * const prepared_st;
@@ -127,7 +154,7 @@ public:
 
     inline ~SqliteSqlResult() override {
         // don't check result here, done elsewhere already
-        (void)sqlite3_finalize(prepared_st);
+        (void)conn->releaseStatement(prepared_st);
     }
 
     inline KDbConnection *connection() const override {
@@ -21,14 +21,15 @@
 
 #include "SqliteConnection.h"
 #include "SqliteConnection_p.h"
+#include "SqliteRecordBuffer.h"
 #include "sqlite_debug.h"
 
 #include "KDbDriver.h"
 #include "KDbError.h"
+#include "KDbRecordBatch.h"
 #include "KDbRecordData.h"
 #include "KDbUtils.h"
 
-#include <QVector>
 #include <QDateTime>
 #include <QByteArray>
 
@@ -47,44 +48,61 @@ public:
     explicit SqliteCursorData(SqliteConnection* conn)
             : SqliteConnectionInternal(conn)
             , prepared_st_handle(nullptr)
-            , utail(nullptr)
-            , curr_coldata(nullptr)
-            , curr_colname(nullptr)
-            , cols_pointers_mem_size(0)
+            , currentRecord(nullptr)
+            , currentIndex(-1)
     {
         data_owned = false;
     }
 
-    /*
-        void fetchRowDataIfNeeded()
-        {
-          if (!rowDataReadyToFetch)
-            return true;
-          rowDataReadyToFetch = false;
-          m_fieldCount = sqlite3_data_count(data);
-          for (int i=0; i<m_fieldCount; i++) {
+    sqlite3_stmt *prepared_st_handle;
+
+    SqliteRecordBuffer buffer; //!< buffer data
+    QVector<QByteArray> recordTexts; //!< values of the current record for recordData()
+    QVector<const char*> recordTextPointers; //!< pointers to recordTexts, nullptr for nulls
+    //! current record of the buffer or nullptr if values are read from the statement
+    const SqliteCell *currentRecord;
+    qint64 currentIndex; //!< index of currentRecord in the buffer
+
+    inline void setCurrentRecord(qint64 index) {
+        currentIndex = index;
+        currentRecord = buffer.record(index);
+    }
 
-          }
+    //! @return value of column @a i of the current record
+    inline SqliteCell cell(int i) const {
+        if (currentRecord) {
+            return currentRecord[i];
         }
-    */
+        SqliteCell c;
+        c.read(prepared_st_handle, i);
+        return c;
+    }
 
-    sqlite3_stmt *prepared_st_handle;
+    //! @return text representation of @a c, as SQLite would convert it
+    static QString cellText(const SqliteCell &c) {
+        switch (c.type) {
+        case SQLITE_TEXT:
+        case SQLITE_BLOB:
+//! @todo support for UTF-16
+            return QString::fromUtf8(c.data, c.length);
+        case SQLITE_INTEGER:
+            return QString::number(c.integer);
+        case SQLITE_FLOAT:
+            return QString::number(c.real, 'g', 15);
+        default:
+            return QString();
+        }
+    }
 
-    char *utail;
-    const char **curr_coldata;
-    const char **curr_colname;
-    int cols_pointers_mem_size; //!< size of record's array of pointers to values
-    QVector<const char**> records; //!< buffer data
+    inline QVariant getValue(KDbField *f, int i) const {
+        return cellToVariant(f, cell(i));
+    }
 
-    inline QVariant getValue(KDbField *f, int i) {
-        int type = sqlite3_column_type(prepared_st_handle, i);
-        if (type == SQLITE_NULL) {
+    static QVariant cellToVariant(KDbField *f, const SqliteCell &c) {
+        if (c.type == SQLITE_NULL) {
             return QVariant();
-        } else if (!f || type == SQLITE_TEXT) {
-//! @todo support for UTF-16
-            QString text(QString::fromUtf8(
-                (const char*)sqlite3_column_text(prepared_st_handle, i),
-                 sqlite3_column_bytes(prepared_st_handle, i)));
+        } else if (!f || c.type == SQLITE_TEXT) {
+            QString text(cellText(c));
             if (!f) {
                 return text;
             }
@@ -106,37 +124,34 @@ public:
             } else {
                 return QVariant(); //!< @todo
             }
-        } else if (type == SQLITE_INTEGER) {
+        } else if (c.type == SQLITE_INTEGER) {
             const KDbField::Type t = f->type();  // cache: evaluating type of expressions can be expensive
             if (t == KDbField::BigInteger) {
-                return QVariant(qint64(sqlite3_column_int64(prepared_st_handle, i)));
+                return QVariant(c.integer);
             } else if (KDbField::isIntegerType(t)) {
-                const int intVal = sqlite3_column_int(prepared_st_handle, i);
+                const int intVal = static_cast<int>(c.integer);
                 return f->isUnsigned() ? QVariant(static_cast<uint>(intVal)) : QVariant(intVal);
             } else if (t == KDbField::Boolean) {
-                return sqlite3_column_int(prepared_st_handle, i) != 0;
+                return c.integer != 0;
             } else if (KDbField::isFPNumericType(t)) { //WEIRD, YEAH?
-                return QVariant(double(sqlite3_column_int(prepared_st_handle, i)));
+                return QVariant(double(c.integer));
             } else {
                 return QVariant(); //!< @todo
             }
-        } else if (type == SQLITE_FLOAT) {
+        } else if (c.type == SQLITE_FLOAT) {
             const KDbField::Type t = f->type(); // cache: evaluating type of expressions can be expensive
             if (KDbField::isFPNumericType(t)) {
-                return QVariant(sqlite3_column_double(prepared_st_handle, i));
+                return QVariant(c.real);
             } else if (t == KDbField::BigInteger) {
-                return QVariant(qint64(sqlite3_column_int64(prepared_st_handle, i)));
+                return QVariant(qint64(c.real));
             } else if (KDbField::isIntegerType(t)) {
-                const double doubleVal = sqlite3_column_double(prepared_st_handle, i);
-                return f->isUnsigned() ? QVariant(static_cast<uint>(doubleVal)) : QVariant(static_cast<int>(doubleVal));
+                return f->isUnsigned() ? QVariant(static_cast<uint>(c.real)) : QVariant(static_cast<int>(c.real));
             } else {
                 return QVariant(); //!< @todo
             }
-        } else if (type == SQLITE_BLOB) {
-            if (f && f->type() == KDbField::BLOB) {
-//! @todo efficient enough?
-                return QByteArray((const char*)sqlite3_column_blob(prepared_st_handle, i),
-                                  sqlite3_column_bytes(prepared_st_handle, i));
+        } else if (c.type == SQLITE_BLOB) {
+            if (f->type() == KDbField::BLOB) {
+                return QByteArray(c.data, c.length);
             } else
                 return QVariant(); //!< @todo
         }
@@ -177,29 +192,20 @@ bool SqliteCursor::drv_open(const KDbEscapedString& sql)
         return false;
     }
 
-    int res = sqlite3_prepare(
-                 d->data,            /* Database handle */
-                 sql.constData(),       /* SQL statement, UTF-8 encoded */
-                 sql.length(),             /* Length of zSql in bytes. */
-                 &d->prepared_st_handle,  /* OUT: Statement handle */
-                 nullptr/*const char **pzTail*/     /* OUT: Pointer to unused portion of zSql */
-             );
+    int res = static_cast<SqliteConnection*>(connection())->acquireStatement(
+                  sql, &d->prepared_st_handle);
     if (res != SQLITE_OK) {
         m_result.setServerErrorCode(res);
         storeResult();
         return false;
     }
-    if (isBuffered()) {
-//! @todo manage size dynamically
-        d->records.resize(128);
-    }
-
     return true;
 }
 
 bool SqliteCursor::drv_close()
 {
-    int res = sqlite3_finalize(d->prepared_st_handle);
+    int res = static_cast<SqliteConnection*>(connection())->releaseStatement(d->prepared_st_handle);
+    d->prepared_st_handle = nullptr;
     if (res != SQLITE_OK) {
         m_result.setServerErrorCode(res);
         storeResult();
@@ -226,70 +232,36 @@ void SqliteCursor::drv_getNextRecord()
             m_fetchResult = FetchResult::Error;
         }
     }
-
-    //debug
-    /*
-      if ((int)m_result == (int)FetchResult::Ok && d->curr_coldata) {
-        for (int i=0;i<m_fieldCount;i++) {
-          sqliteDebug()<<"col."<< i<<": "<< d->curr_colname[i]<<" "<< d->curr_colname[m_fieldCount+i]
-          << " = " << (d->curr_coldata[i] ? QString::fromLocal8Bit(d->curr_coldata[i]) : "(NULL)");
-        }
-    //  sqliteDebug() << m_fieldCount << "col(s) fetched";
-      }*/
 }
 
 void SqliteCursor::drv_appendCurrentRecordToBuffer()
 {
-// sqliteDebug();
-    if (!d->curr_coldata)
-        return;
-    if (!d->cols_pointers_mem_size)
-        d->cols_pointers_mem_size = m_fieldCount * sizeof(char*);
-    const char **record = (const char**)malloc(d->cols_pointers_mem_size);
-    const char **src_col = d->curr_coldata;
-    const char **dest_col = record;
-    for (int i = 0; i < m_fieldCount; i++, src_col++, dest_col++) {
-//  sqliteDebug() << i <<": '" << *src_col << "'";
-//  sqliteDebug() << "src_col: " << src_col;
-        *dest_col = *src_col ? strdup(*src_col) : nullptr;
-    }
-    d->records[m_records_in_buf] = record;
-// sqliteDebug() << "ok.";
+    d->buffer.append(d->prepared_st_handle, m_fieldCount);
+    // the appended record is the current one
+    d->setCurrentRecord(d->buffer.count() - 1);
 }
 
 void SqliteCursor::drv_bufferMovePointerNext()
 {
-    d->curr_coldata++; //move to next record in the buffer
+    d->setCurrentRecord(d->currentIndex + 1); //move to next record in the buffer
 }
 
 void SqliteCursor::drv_bufferMovePointerPrev()
 {
-    d->curr_coldata--; //move to prev record in the buffer
+    d->setCurrentRecord(d->currentIndex - 1); //move to prev record in the buffer
 }
 
-//compute a place in the buffer that contain next record's data
-//and move internal buffer pointer to that place
 void SqliteCursor::drv_bufferMovePointerTo(qint64 at)
 {
-    d->curr_coldata = d->records.at(at);
+    d->setCurrentRecord(at);
 }
 
 void SqliteCursor::drv_clearBuffer()
 {
-    if (d->cols_pointers_mem_size > 0) {
-        const int records_in_buf = m_records_in_buf;
-        const char ***r_ptr = d->records.data();
-        for (int i = 0; i < records_in_buf; i++, r_ptr++) {
-            const char **field_data = *r_ptr;
-            for (int col = 0; col < m_fieldCount; col++, field_data++) {
-                free((void*)*field_data); //free field memory
-            }
-            free(*r_ptr); //free pointers to fields array
-        }
-    }
+    d->buffer.clear();
+    d->currentRecord = nullptr;
+    d->currentIndex = -1;
     m_records_in_buf = 0;
-    d->cols_pointers_mem_size = 0;
-    d->records.clear();
 }
 
 //! @todo
@@ -303,16 +275,40 @@ const char *** SqliteCursor::bufferData()
 
 const char ** SqliteCursor::recordData() const
 {
-    return d->curr_coldata;
+    if (eof() || bof() || m_fieldCount <= 0) {
+        return nullptr;
+    }
+    // values are stored as typed cells so text representation is created on demand
+    d->recordTexts.resize(m_fieldCount);
+    d->recordTextPointers.resize(m_fieldCount);
+    for (int i = 0; i < m_fieldCount; ++i) {
+        const SqliteCell c(d->cell(i));
+        switch (c.type) {
+        case SQLITE_TEXT:
+        case SQLITE_BLOB:
+            d->recordTexts[i] = QByteArray(c.data, c.length);
+            break;
+        case SQLITE_INTEGER:
+            d->recordTexts[i] = QByteArray::number(c.integer);
+            break;
+        case SQLITE_FLOAT:
+            d->recordTexts[i] = QByteArray::number(c.real, 'g', 15);
+            break;
+        default:
+            d->recordTexts[i].clear();
+            d->recordTextPointers[i] = nullptr;
+            continue;
+        }
+        d->recordTextPointers[i] = d->recordTexts[i].constData();
+    }
+    return d->recordTextPointers.data();
 }
 
 bool SqliteCursor::drv_storeCurrentRecord(KDbRecordData* data) const
 {
     if (!m_visibleFieldsExpanded) {//simple version: without types
         for (int i = 0; i < m_fieldCount; i++) {
-            (*data)[i] = QString::fromUtf8(
-                            (const char*)sqlite3_column_text(d->prepared_st_handle, i),
-                            sqlite3_column_bytes(d->prepared_st_handle, i));
+            (*data)[i] = SqliteCursorData::cellText(d->cell(i));
         }
         return true;
     }
@@ -324,6 +320,95 @@ bool SqliteCursor::drv_storeCurrentRecord(KDbRecordData* data) const
     return true;
 }
 
+bool SqliteCursor::drv_storeCurrentRecordInBatch(KDbRecordBatch* batch, int row) const
+{
+    const int count = qMin(batch->columnCount(), m_fieldCount);
+    for (int i = 0; i < count; ++i) {
+        const SqliteCell c(d->cell(i));
+        if (c.type == SQLITE_NULL) {
+            continue; // the value is null already
+        }
+        switch (batch->columnType(i)) {
+        case KDbRecordBatch::ColumnType::Integer:
+            if (c.type == SQLITE_INTEGER) {
+                batch->setInteger(row, i, c.integer);
+            } else if (c.type == SQLITE_FLOAT) {
+                batch->setInteger(row, i, qint64(c.real));
+            }
+            break;
+        case KDbRecordBatch::ColumnType::Double:
+            if (c.type == SQLITE_INTEGER) {
+                batch->setDouble(row, i, double(c.integer));
+            } else if (c.type == SQLITE_FLOAT) {
+                batch->setDouble(row, i, c.real);
+            }
+            break;
+        case KDbRecordBatch::ColumnType::Boolean:
+            if (c.type == SQLITE_INTEGER) {
+                batch->setBoolean(row, i, c.integer != 0);
+            } else if (c.type == SQLITE_FLOAT) {
+                batch->setBoolean(row, i, int(c.real) != 0);
+            } else {
+                batch->setBoolean(row, i, sqliteStringToBool(SqliteCursorData::cellText(c)));
+            }
+            break;
+        case KDbRecordBatch::ColumnType::Text:
+            if (c.type == SQLITE_TEXT || c.type == SQLITE_BLOB) {
+                // UTF-8 text is copied directly to the batch's string pool, no conversion needed
+                batch->setString(row, i, c.data, c.length);
+            } else {
+                batch->setText(row, i, SqliteCursorData::cellText(c));
+            }
+            break;
+        case KDbRecordBatch::ColumnType::Binary:
+            if (c.type == SQLITE_BLOB) {
+                batch->setString(row, i, c.data, c.length);
+            }
+            break;
+        case KDbRecordBatch::ColumnType::Variant: {
+            KDbField *f = (m_visibleFieldsExpanded && i < m_visibleFieldsExpanded->count())
+                          ? m_visibleFieldsExpanded->at(i)->field() : nullptr;
+            batch->setValue(row, i, SqliteCursorData::cellToVariant(f, c));
+            break;
+        }
+        }
+    }
+    return true;
+}
+
+int SqliteCursor::drv_fetchBatch(KDbRecordBatch* batch, int maxRows)
+{
+    if (isBuffered()) { // each record has to be appended to the buffer
+        return KDbCursor::drv_fetchBatch(batch, maxRows);
+    }
+    int count = 0;
+    m_fetchResult = FetchResult::Ok;
+    if (readAhead()) { // the first record is already available
+        SqliteCursor::drv_storeCurrentRecordInBatch(batch, batch->appendRecord());
+        ++count;
+    }
+    while (count < maxRows) {
+        const int res = sqlite3_step(d->prepared_st_handle);
+        if (res != SQLITE_ROW) {
+            if (res == SQLITE_DONE) {
+                m_fetchResult = FetchResult::End;
+            } else {
+                m_result.setServerErrorCode(res);
+                m_fetchResult = FetchResult::Error;
+            }
+            break;
+        }
+        if (count == 0) {
+            m_fieldCount = sqlite3_data_count(d->prepared_st_handle);
+            m_fieldsToStoreInRecord = m_fieldCount;
+        }
+        SqliteCursor::drv_storeCurrentRecordInBatch(batch, batch->appendRecord());
+        ++count;
+    }
+    batchFetched(count);
+    return count;
+}
+
 QVariant SqliteCursor::value(int i)
 {
     if (i < 0 || i > (m_fieldCount - 1)) //range checking
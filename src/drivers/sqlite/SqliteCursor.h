@@ -38,11 +38,19 @@ public:
 
     /*! [PROTOTYPE] @return internal buffer data. */
 //! @todo virtual const char *** bufferData()
-    /*! [PROTOTYPE] @return current record data or @c nullptr if there is no current records. */
+    /*! [PROTOTYPE] @return current record data or @c nullptr if there is no current records.
+     Values are stored as typed cells so their null-terminated UTF-8 text representation
+     is created on each call; it is valid until the next call or until the cursor is moved.
+     Null values are returned as @c nullptr, BLOB values containing zero bytes are truncated. */
     const char ** recordData() const override;
 
     bool drv_storeCurrentRecord(KDbRecordData* data) const override;
 
+    bool drv_storeCurrentRecordInBatch(KDbRecordBatch* batch, int row) const override;
+
+    //! Fetches records using sqlite3_step() loop for unbuffered cursors
+    int drv_fetchBatch(KDbRecordBatch* batch, int maxRows) override;
+
     //! Implemented for KDbResultable
     QString serverResultName() const override;
 
@@ -42,149 +42,12 @@ bool SqlitePreparedStatement::prepare(const KDbEscapedString& sql)
 
 bool SqlitePreparedStatement::bindValue(KDbField *field, const QVariant& value, int par)
 {
-    if (value.isNull()) {
-        //no value to bind or the value is null: bind NULL
-        int res = sqlite3_bind_null(sqlResult()->prepared_st, par);
-        if (res != SQLITE_OK) {
-            m_result.setServerErrorCode(res);
-            storeResult(&m_result);
-            return false;
-        }
-        return true;
-    }
-    if (field->isTextType()) {
-        //! @todo optimize: make a static copy so SQLITE_STATIC can be used
-        const QByteArray utf8String(value.toString().toUtf8());
-        int res = sqlite3_bind_text(sqlResult()->prepared_st, par,
-                                    utf8String.constData(), utf8String.length(), SQLITE_TRANSIENT /*??*/);
-        if (res != SQLITE_OK) {
-            m_result.setServerErrorCode(res);
-            storeResult(&m_result);
-            return false;
-        }
-        return true;
-    }
-
-    switch (field->type()) {
-    case KDbField::Byte:
-    case KDbField::ShortInteger:
-    case KDbField::Integer: {
-        //! @todo what about unsigned > INT_MAX ?
-        bool ok;
-        const int intValue = value.toInt(&ok);
-        if (ok) {
-            int res = sqlite3_bind_int(sqlResult()->prepared_st, par, intValue);
-            if (res != SQLITE_OK) {
-                m_result.setServerErrorCode(res);
-                storeResult(&m_result);
-                return false;
-            }
-        } else {
-            int res = sqlite3_bind_null(sqlResult()->prepared_st, par);
-            if (res != SQLITE_OK) {
-                m_result.setServerErrorCode(res);
-                storeResult(&m_result);
-                return false;
-            }
-        }
-        break;
-    }
-    case KDbField::Float:
-    case KDbField::Double: {
-        int res = sqlite3_bind_double(sqlResult()->prepared_st, par, value.toDouble());
-        if (res != SQLITE_OK) {
-            m_result.setServerErrorCode(res);
-            storeResult(&m_result);
-            return false;
-        }
-        break;
-    }
-    case KDbField::BigInteger: {
-        //! @todo what about unsigned > LLONG_MAX ?
-        bool ok;
-        const qint64 int64Value = value.toLongLong(&ok);
-        if (ok) {
-            int res = sqlite3_bind_int64(sqlResult()->prepared_st, par, int64Value);
-            if (res != SQLITE_OK) {
-                m_result.setServerErrorCode(res);
-                storeResult(&m_result);
-                return false;
-            }
-        } else {
-            int res = sqlite3_bind_null(sqlResult()->prepared_st, par);
-            if (res != SQLITE_OK) {
-                m_result.setServerErrorCode(res);
-                storeResult(&m_result);
-                return false;
-            }
-        }
-        break;
-    }
-    case KDbField::Boolean: {
-        int res = sqlite3_bind_text(sqlResult()->prepared_st, par, value.toBool() ? "1" : "0",
-                                    1, SQLITE_TRANSIENT /*??*/);
-        if (res != SQLITE_OK) {
-            m_result.setServerErrorCode(res);
-            storeResult(&m_result);
-            return false;
-        }
-        break;
-    }
-    case KDbField::Time: {
-        int res = sqlite3_bind_text(sqlResult()->prepared_st, par,
-                                    qPrintable(KDbUtils::toISODateStringWithMs(value.toTime())),
-                                    QLatin1String("HH:MM:SS").size(), SQLITE_TRANSIENT /*??*/);
-        if (res != SQLITE_OK) {
-            m_result.setServerErrorCode(res);
-            storeResult(&m_result);
-            return false;
-        }
-        break;
-    }
-    case KDbField::Date: {
-        int res = sqlite3_bind_text(sqlResult()->prepared_st, par,
-                                    qPrintable(value.toDate().toString(Qt::ISODate)),
-                                    QLatin1String("YYYY-MM-DD").size(), SQLITE_TRANSIENT /*??*/);
-        if (res != SQLITE_OK) {
-            m_result.setServerErrorCode(res);
-            storeResult(&m_result);
-            return false;
-        }
-        break;
-    }
-    case KDbField::DateTime: {
-        int res = sqlite3_bind_text(sqlResult()->prepared_st, par,
-                                qPrintable(KDbUtils::toISODateStringWithMs(value.toDateTime())),
-                                QLatin1String("YYYY-MM-DDTHH:MM:SS").size(), SQLITE_TRANSIENT /*??*/);
-        if (res != SQLITE_OK) {
-            m_result.setServerErrorCode(res);
-            storeResult(&m_result);
-            return false;
-        }
-        break;
-    }
-    case KDbField::BLOB: {
-        const QByteArray byteArray(value.toByteArray());
-        int res = sqlite3_bind_blob(sqlResult()->prepared_st, par,
-                                    byteArray.constData(), byteArray.size(), SQLITE_TRANSIENT /*??*/);
-        if (res != SQLITE_OK) {
-            m_result.setServerErrorCode(res);
-            storeResult(&m_result);
-            return false;
-        }
-        break;
-    }
-    default: {
-        sqliteWarning() << "unsupported field type:"
-                << field->type() << "- NULL value bound to column #" << par;
-        int res = sqlite3_bind_null(sqlResult()->prepared_st, par);
-        if (res != SQLITE_OK) {
-            m_result.setServerErrorCode(res);
-            storeResult(&m_result);
-            return false;
-        }
+    const int res = SqliteConnectionInternal::bindValue(sqlResult()->prepared_st, field, value, par);
+    if (res != SQLITE_OK) {
+        m_result.setServerErrorCode(res);
+        storeResult(&m_result);
+        return false;
     }
-    } //switch
     return true;
 }
 
@@ -211,7 +74,10 @@ QSharedPointer<KDbSqlResult> SqlitePreparedStatement::execute(
 
     //real execution
     const int res = sqlite3_step(sqlResult()->prepared_st);
-    if (type == KDbPreparedStatement::InsertStatement) {
+    if (type == KDbPreparedStatement::InsertStatement
+        || type == KDbPreparedStatement::UpdateStatement
+        || type == KDbPreparedStatement::DeleteStatement)
+    {
         const bool ok = res == SQLITE_DONE;
         if (ok) {
             m_result = KDbResult();
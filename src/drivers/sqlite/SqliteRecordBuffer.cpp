@@ -0,0 +1,91 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "SqliteRecordBuffer.h"
+
+#include <cstring>
+
+SqliteRecordBuffer::SqliteRecordBuffer()
+{
+}
+
+SqliteRecordBuffer::~SqliteRecordBuffer()
+{
+    clear();
+}
+
+const SqliteCell* SqliteRecordBuffer::append(sqlite3_stmt *statement, int fieldCount)
+{
+    if (m_count == 0) {
+        m_fieldCount = fieldCount;
+    }
+    Q_ASSERT(fieldCount == m_fieldCount);
+    const int indexInChunk = int(m_count % recordsPerChunk);
+    if (indexInChunk == 0) {
+        m_chunks.append(new SqliteCell[size_t(recordsPerChunk) * m_fieldCount]);
+    }
+    SqliteCell *record = m_chunks.last() + indexInChunk * m_fieldCount;
+    for (int i = 0; i < m_fieldCount; ++i) {
+        SqliteCell *cell = record + i;
+        cell->read(statement, i);
+        if (cell->type == SQLITE_TEXT || cell->type == SQLITE_BLOB) {
+            cell->data = copyData(cell->data, cell->length);
+        }
+    }
+    ++m_count;
+    return record;
+}
+
+const char* SqliteRecordBuffer::copyData(const char *data, int length)
+{
+    if (length <= 0) {
+        return "";
+    }
+    char *copy;
+    if (length > blockSize / 4) { // large value: own block, keep filling the current one
+        copy = new char[length];
+        m_blocks.append(copy);
+    } else {
+        if (!m_block || m_blockUsed + length > blockSize) {
+            m_block = new char[blockSize];
+            m_blocks.append(m_block);
+            m_blockUsed = 0;
+        }
+        copy = m_block + m_blockUsed;
+        m_blockUsed += length;
+    }
+    memcpy(copy, data, length);
+    return copy;
+}
+
+void SqliteRecordBuffer::clear()
+{
+    for (SqliteCell *chunk : m_chunks) {
+        delete [] chunk;
+    }
+    for (char *block : m_blocks) {
+        delete [] block;
+    }
+    m_chunks.clear();
+    m_blocks.clear();
+    m_block = nullptr;
+    m_blockUsed = 0;
+    m_fieldCount = 0;
+    m_count = 0;
+}
@@ -0,0 +1,109 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_SQLITERECORDBUFFER_H
+#define KDB_SQLITERECORDBUFFER_H
+
+#include <QVector>
+
+#include <sqlite3.h>
+
+//! @internal Single value of a record with SQLite storage class
+struct SqliteCell
+{
+    int type;   //!< SQLITE_INTEGER, SQLITE_FLOAT, SQLITE_TEXT, SQLITE_BLOB or SQLITE_NULL
+    int length; //!< number of bytes of text or BLOB value
+    union {
+        qint64 integer;
+        double real;
+        const char *data; //!< UTF-8 text or BLOB value, not null-terminated
+    };
+
+    //! Reads value of column @a col of the current record of @a statement.
+    //! Text and BLOB values are not copied so they are valid only until the next step.
+    inline void read(sqlite3_stmt *statement, int col) {
+        type = sqlite3_column_type(statement, col);
+        switch (type) {
+        case SQLITE_INTEGER:
+            integer = sqlite3_column_int64(statement, col);
+            break;
+        case SQLITE_FLOAT:
+            real = sqlite3_column_double(statement, col);
+            break;
+        case SQLITE_TEXT:
+            data = reinterpret_cast<const char*>(sqlite3_column_text(statement, col));
+            length = sqlite3_column_bytes(statement, col);
+            break;
+        case SQLITE_BLOB:
+            data = static_cast<const char*>(sqlite3_column_blob(statement, col));
+            length = sqlite3_column_bytes(statement, col);
+            break;
+        default:
+            type = SQLITE_NULL;
+        }
+    }
+};
+
+//! @internal Growable storage of records for buffered SQLite cursors
+/*! Records are stored as arrays of typed cells. The arrays are allocated in chunks
+ of fixed number of records so accessing a record by index is constant-time and
+ appending never moves records that are already stored. Text and BLOB values are copied
+ to large memory blocks instead of being allocated one by one; values larger than
+ a quarter of a block get a block of their own. */
+class SqliteRecordBuffer
+{
+public:
+    SqliteRecordBuffer();
+
+    ~SqliteRecordBuffer();
+
+    //! Appends a copy of the current record of @a statement that has @a fieldCount columns.
+    //! @return pointer to the first cell of the new record
+    const SqliteCell* append(sqlite3_stmt *statement, int fieldCount);
+
+    //! @return pointer to the first cell of record @a index; @a index must be valid
+    inline const SqliteCell* record(qint64 index) const {
+        return m_chunks.at(int(index / recordsPerChunk))
+            + (index % recordsPerChunk) * m_fieldCount;
+    }
+
+    //! @return number of records in the buffer
+    inline qint64 count() const { return m_count; }
+
+    //! Removes all records and frees memory
+    void clear();
+
+private:
+    //! Copies @a length bytes of @a data to the memory blocks
+    //! @return pointer to the copy
+    const char* copyData(const char *data, int length);
+
+    static const int recordsPerChunk = 256;
+    static const int blockSize = 64 * 1024;
+
+    QVector<SqliteCell*> m_chunks; //!< arrays of recordsPerChunk * m_fieldCount cells
+    QVector<char*> m_blocks; //!< memory blocks for text and BLOB values
+    char *m_block = nullptr; //!< block that is currently being filled
+    int m_blockUsed = 0; //!< number of bytes used in m_block
+    int m_fieldCount = 0;
+    qint64 m_count = 0;
+    Q_DISABLE_COPY(SqliteRecordBuffer)
+};
+
+#endif
@@ -0,0 +1,153 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "SqliteStatementCache.h"
+
+#include "KDbEscapedString.h"
+
+SqliteStatementCache::SqliteStatementCache(int capacity)
+    : m_capacity(qMax(0, capacity))
+{
+}
+
+SqliteStatementCache::~SqliteStatementCache()
+{
+    clear();
+}
+
+//static
+int SqliteStatementCache::defaultCapacity()
+{
+    return 100;
+}
+
+int SqliteStatementCache::capacity() const
+{
+    return m_capacity;
+}
+
+void SqliteStatementCache::setCapacity(int capacity)
+{
+    m_capacity = qMax(0, capacity);
+    while (m_idle.count() > m_capacity) {
+        evictLeastRecentlyUsed();
+    }
+}
+
+int SqliteStatementCache::acquire(sqlite3 *db, const KDbEscapedString &sql,
+                                  sqlite3_stmt **statement)
+{
+    Q_ASSERT(statement);
+    const QByteArray key(sql.toByteArray());
+    QHash<QByteArray, Entry>::Iterator it = m_idle.find(key);
+    if (it != m_idle.end()) {
+        *statement = it.value().statement;
+        m_idle.erase(it);
+        m_acquired.insert(*statement, key);
+        ++m_hits;
+        return SQLITE_OK;
+    }
+    ++m_misses;
+    *statement = nullptr;
+    const int res = sqlite3_prepare_v2(
+                 db,                 /* Database handle */
+                 sql.constData(),    /* SQL statement, UTF-8 encoded */
+                 sql.length(),       /* Length of zSql in bytes. */
+                 statement,          /* OUT: Statement handle */
+                 nullptr/*const char **pzTail*/     /* OUT: Pointer to unused portion of zSql */
+             );
+    if (res == SQLITE_OK && *statement && m_capacity > 0) {
+        m_acquired.insert(*statement, key);
+    }
+    return res;
+}
+
+int SqliteStatementCache::release(sqlite3_stmt *statement)
+{
+    if (!statement) {
+        return SQLITE_OK;
+    }
+    QHash<sqlite3_stmt*, QByteArray>::Iterator acquiredIt = m_acquired.find(statement);
+    if (acquiredIt == m_acquired.end()) { // not ours or handed out before clear()
+        return sqlite3_finalize(statement);
+    }
+    const QByteArray key(acquiredIt.value());
+    m_acquired.erase(acquiredIt);
+    // The result of reset repeats the error of the most recent sqlite3_step(), if any;
+    // the statement itself stays usable.
+    const int res = sqlite3_reset(statement);
+    (void)sqlite3_clear_bindings(statement);
+    if (m_capacity == 0 || m_idle.contains(key)) { // no room or the same statement
+                                                   // has been released already
+        (void)sqlite3_finalize(statement);
+        return res;
+    }
+    if (m_idle.count() >= m_capacity) {
+        evictLeastRecentlyUsed();
+    }
+    m_idle.insert(key, Entry{statement, ++m_useCounter});
+    return res;
+}
+
+void SqliteStatementCache::clear()
+{
+    for (const Entry &entry : m_idle) {
+        (void)sqlite3_finalize(entry.statement);
+    }
+    m_idle.clear();
+    m_acquired.clear();
+}
+
+void SqliteStatementCache::evictLeastRecentlyUsed()
+{
+    if (m_idle.isEmpty()) {
+        return;
+    }
+    // Linear search is fine: this only happens when a new statement has just been
+    // compiled, which is far more expensive than scanning the bounded cache.
+    QHash<QByteArray, Entry>::Iterator oldest = m_idle.begin();
+    for (QHash<QByteArray, Entry>::Iterator it = m_idle.begin(); it != m_idle.end(); ++it) {
+        if (it.value().lastUse < oldest.value().lastUse) {
+            oldest = it;
+        }
+    }
+    (void)sqlite3_finalize(oldest.value().statement);
+    m_idle.erase(oldest);
+}
+
+quint64 SqliteStatementCache::hits() const
+{
+    return m_hits;
+}
+
+quint64 SqliteStatementCache::misses() const
+{
+    return m_misses;
+}
+
+//static
+bool SqliteStatementCache::isSchemaChangingStatement(const KDbEscapedString &sql)
+{
+    const char *s = sql.constData();
+    while (*s == ' ' || *s == '\t' || *s == '\n' || *s == '\r') {
+        ++s;
+    }
+    return qstrnicmp(s, "CREATE", 6) == 0 || qstrnicmp(s, "DROP", 4) == 0
+        || qstrnicmp(s, "ALTER", 5) == 0;
+}
@@ -0,0 +1,101 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_SQLITESTATEMENTCACHE_H
+#define KDB_SQLITESTATEMENTCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+
+#include <sqlite3.h>
+
+class KDbEscapedString;
+
+//! @internal Bounded per-connection cache of prepared SQLite statements
+/*! Statements are keyed by their SQL text. acquire() returns an idle statement compiled
+ earlier for the same text or prepares a new one. A statement handed out by acquire() is
+ exclusively owned by the caller until it is passed back to release(); then it is reset,
+ its bindings are cleared and it becomes available again. When the cache is full the least
+ recently used idle statement is finalized.
+
+ Statements are prepared using sqlite3_prepare_v2() so SQLite recompiles them transparently
+ if the schema changes. Idle statements are nevertheless dropped by clear() after executing
+ statements that alter the schema and before the database is closed.
+
+ Capacity of 0 disables caching: release() then simply finalizes the statement. */
+class SqliteStatementCache
+{
+public:
+    explicit SqliteStatementCache(int capacity = defaultCapacity());
+
+    ~SqliteStatementCache();
+
+    //! @return default capacity of the cache
+    static int defaultCapacity();
+
+    //! @return maximum number of idle statements kept in the cache
+    int capacity() const;
+
+    //! Sets maximum number of idle statements kept in the cache to @a capacity.
+    //! Least recently used statements are finalized if needed.
+    void setCapacity(int capacity);
+
+    //! Provides a statement for @a sql within database @a db and assigns it to @a statement.
+    //! @return SQLITE_OK on success or SQLite error code returned by sqlite3_prepare_v2().
+    int acquire(sqlite3 *db, const KDbEscapedString &sql, sqlite3_stmt **statement);
+
+    //! Puts @a statement back to the cache or finalizes it if it was not handed out
+    //! by acquire() since the most recent clear().
+    //! @return result of sqlite3_reset() for statements kept in the cache or
+    //! result of sqlite3_finalize() otherwise.
+    int release(sqlite3_stmt *statement);
+
+    //! Finalizes all idle statements. Statements currently handed out will be finalized
+    //! when they are released.
+    void clear();
+
+    //! @return number of acquire() calls satisfied from the cache
+    quint64 hits() const;
+
+    //! @return number of acquire() calls that required preparing a new statement
+    quint64 misses() const;
+
+    //! @return true if @a sql is a statement that alters the database schema
+    //! so cached statements should be dropped after executing it.
+    static bool isSchemaChangingStatement(const KDbEscapedString &sql);
+
+private:
+    //! Finalizes least recently used idle statement
+    void evictLeastRecentlyUsed();
+
+    struct Entry {
+        sqlite3_stmt *statement;
+        quint64 lastUse;
+    };
+
+    int m_capacity;
+    quint64 m_useCounter = 0;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+    QHash<QByteArray, Entry> m_idle; //!< idle statements by SQL
+    QHash<sqlite3_stmt*, QByteArray> m_acquired; //!< statements handed out, with their SQL
+    Q_DISABLE_COPY(SqliteStatementCache)
+};
+
+#endif
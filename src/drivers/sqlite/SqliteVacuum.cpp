@@ -18,96 +18,79 @@
 */
 
 #include "SqliteVacuum.h"
+#include "SqliteConnection_p.h"
 #include "sqlite_debug.h"
 
-#include "KDb.h"
+#include <sqlite3.h>
 
-#include <QMessageBox>
-#include <QProgressDialog>
-#include <QFileInfo>
-#include <QFile>
 #include <QDir>
-#include <QApplication>
-#include <QProcess>
-#include <QCursor>
-#include <QLocale>
+#include <QFile>
+#include <QFileInfo>
 #include <QTemporaryFile>
 
+//! Number of pages copied by a single step of the online backup
+static const int pagesPerBackupStep = 256;
+
+//! Time after which copying of pages is abandoned if the database is locked, in milliseconds
+static const int backupBusyTimeout = 10000;
+
+//! Minimum interval between updates of progress of executed statements, in milliseconds
+static const int progressInterval = 100;
+
 namespace {
-#ifdef Q_OS_WIN
-#include <Windows.h>
-void usleep(unsigned int usec)
+//! Owns SQLite database handle
+class DatabaseHandle
 {
-    Sleep(usec/1000);
-}
+public:
+    DatabaseHandle() : db(nullptr) {}
+    ~DatabaseHandle() {
+        sqlite3_close(db);
+    }
+    sqlite3 *db;
+private:
+    Q_DISABLE_COPY(DatabaseHandle)
+};
 
-//! @todo Use when it's in kdewin
-#define CONV(x) ((wchar_t*)x.utf16())
-int atomic_rename(const QString &in, const QString &out)
+//! Opens SQLite database file @a filePath using @a flags, @return SQLite result code
+int openDatabase(const QString &filePath, int flags, DatabaseHandle *handle)
 {
-    // better than :waccess/_wunlink/_wrename
-# ifndef _WIN32_WCE
-    bool ok = (MoveFileExW(CONV(in), CONV(out),
-                           MOVEFILE_REPLACE_EXISTING | MOVEFILE_COPY_ALLOWED) != 0);
-# else
-    bool ok = (MoveFileW(CONV(in), CONV(out)) != 0);
-# endif
-    return ok ? 0 : -1;
+    return sqlite3_open_v2(QDir::toNativeSeparators(filePath).toUtf8().constData(),
+                           &handle->db, flags, nullptr);
 }
-#else
-#include <unistd.h>
-int atomic_rename(const QString &in, const QString &out)
+
+//! @return value of integer PRAGMA @a name for database @a db, -1 on failure
+qint64 integerPragmaValue(sqlite3 *db, const char *name)
 {
-    return ::rename(QFile::encodeName(in).constData(), QFile::encodeName(out).constData());
+    bool ok;
+    const qint64 value = SqliteConnectionInternal::pragmaValue(db, name).toLongLong(&ok);
+    return ok ? value : -1;
 }
-#endif
 } // namespace
 
 SqliteVacuum::SqliteVacuum(const QString& filePath)
         : m_filePath(filePath)
+        , m_percent(-1)
+        , m_originalSize(0)
+        , m_compactedSize(0)
+        , m_expectedSize(0)
+        , m_firstPercent(0)
+        , m_lastPercent(0)
 {
-    m_dumpProcess = nullptr;
-    m_sqliteProcess = nullptr;
-    m_percent = 0;
-    m_dlg = nullptr;
-    m_canceled = false;
 }
 
 SqliteVacuum::~SqliteVacuum()
 {
-    if (m_dumpProcess) {
-        m_dumpProcess->waitForFinished();
-        delete m_dumpProcess;
+    if (!m_tmpFilePath.isEmpty()) {
+        QFile::remove(m_tmpFilePath);
     }
-    if (m_sqliteProcess) {
-        m_sqliteProcess->waitForFinished();
-        delete m_sqliteProcess;
-    }
-    if (m_dlg)
-        m_dlg->reset();
-    delete m_dlg;
-    QFile::remove(m_tmpFilePath);
 }
 
 tristate SqliteVacuum::run()
 {
-    const QString dump_app = QString::fromLatin1(KDB_SQLITE_DUMP_TOOL);
-    //sqliteDebug() << dump_app;
-    if (dump_app.isEmpty()) {
-        m_result = KDbResult(ERR_OBJECT_NOT_FOUND, tr("Could not find tool \"%1\".")
-                             .arg(dump_app));
-        sqliteWarning() << m_result;
-        return false;
-    }
-    const QString sqlite_app(KDb::sqlite3ProgramPath());
-    //sqliteDebug() << sqlite_app;
-    if (sqlite_app.isEmpty()) {
-        m_result = KDbResult(ERR_OBJECT_NOT_FOUND, tr("Could not find application \"%1\".")
-                             .arg(sqlite_app));
-        sqliteWarning() << m_result;
-        return false;
-    }
-
+    clearResult();
+    m_canceled.store(0);
+    m_percent = -1;
+    m_compactedSize = 0;
     QFileInfo fi(m_filePath);
     if (!fi.isReadable()) {
         m_result = KDbResult(ERR_OBJECT_NOT_FOUND, tr("Could not read file \"%1\".")
@@ -115,163 +98,198 @@ tristate SqliteVacuum::run()
         sqliteWarning() << m_result;
         return false;
     }
-
-    //sqliteDebug() << fi.absoluteFilePath() << fi.absoluteDir().path();
-
-    delete m_dumpProcess;
-    m_dumpProcess = new QProcess(this);
-    m_dumpProcess->setWorkingDirectory(fi.absoluteDir().path());
-    m_dumpProcess->setReadChannel(QProcess::StandardError);
-    connect(m_dumpProcess, SIGNAL(readyReadStandardError()), this, SLOT(readFromStdErr()));
-    connect(m_dumpProcess, SIGNAL(finished(int,QProcess::ExitStatus)),
-            this, SLOT(dumpProcessFinished(int,QProcess::ExitStatus)));
-
-    delete m_sqliteProcess;
-    m_sqliteProcess = new QProcess(this);
-    m_sqliteProcess->setWorkingDirectory(fi.absoluteDir().path());
-    connect(m_sqliteProcess, SIGNAL(finished(int,QProcess::ExitStatus)),
-            this, SLOT(sqliteProcessFinished(int,QProcess::ExitStatus)));
-
-    m_dumpProcess->setStandardOutputProcess(m_sqliteProcess);
-    m_dumpProcess->start(dump_app, QStringList() << fi.absoluteFilePath());
-    if (!m_dumpProcess->waitForStarted()) {
-        delete m_dumpProcess;
-        m_dumpProcess = nullptr;
-        m_result.setCode(ERR_OTHER);
-        return false;
-    }
-
+    m_originalSize = fi.size();
     {
         QTemporaryFile tempFile(fi.absoluteFilePath());
         if (!tempFile.open()) {
-            delete m_dumpProcess;
-            m_dumpProcess = nullptr;
-            m_result.setCode(ERR_OTHER);
+            m_result = KDbResult(ERR_ACCESS_RIGHTS, tr("Could not create temporary file in \"%1\".")
+                                 .arg(QDir::fromNativeSeparators(fi.absolutePath())));
+            sqliteWarning() << m_result;
             return false;
         }
         m_tmpFilePath = tempFile.fileName();
+    } // the file is removed here because VACUUM INTO needs a nonexisting file
+    setProgress(0);
+
+    tristate result;
+    {
+        DatabaseHandle original;
+        int res = openDatabase(m_filePath, SQLITE_OPEN_READWRITE, &original);
+        if (res != SQLITE_OK) {
+            setSqliteResult(original.db, res, tr("Could not open database \"%1\".").arg(m_filePath));
+            return false;
+        }
+        sqlite3_busy_timeout(original.db, 1000);
+        // data_version changes when another connection commits changes to the database
+        const qint64 dataVersion = integerPragmaValue(original.db, "data_version");
+        result = compactToTemporaryFile(original.db);
+        if (result == true) {
+            DatabaseHandle compacted;
+            res = openDatabase(m_tmpFilePath, SQLITE_OPEN_READONLY, &compacted);
+            if (res != SQLITE_OK) {
+                setSqliteResult(compacted.db, res,
+                                tr("Could not open database \"%1\".").arg(m_tmpFilePath));
+                result = false;
+            } else {
+                result = backup(original.db, compacted.db, 90, 100, dataVersion);
+            }
+        }
+        if (result == true) {
+            // The file itself can be larger until checkpoint if WAL is used
+            m_compactedSize = integerPragmaValue(original.db, "page_count")
+                              * integerPragmaValue(original.db, "page_size");
+        }
     }
-    //sqliteDebug() << m_tmpFilePath;
-    m_sqliteProcess->start(sqlite_app, QStringList() << m_tmpFilePath);
-    if (!m_sqliteProcess->waitForStarted()) {
-        delete m_dumpProcess;
-        m_dumpProcess = nullptr;
-        delete m_sqliteProcess;
-        m_sqliteProcess = nullptr;
-        m_result.setCode(ERR_OTHER);
-        return false;
+    QFile::remove(m_tmpFilePath);
+    m_tmpFilePath.clear();
+    if (result == true) {
+        setProgress(100);
     }
+    return result;
+}
 
-    delete m_dlg;
-    m_dlg = new QProgressDialog(nullptr); // krazy:exclude=qclasses
-    m_dlg->setWindowModality(Qt::WindowModal);
-    m_dlg->setWindowTitle(tr("Compacting database"));
-    m_dlg->setLabelText(
-        QLatin1String("<qt>") + tr("Compacting database \"%1\"...")
-            .arg(QLatin1String("<nobr>")
-                 + QDir::fromNativeSeparators(fi.fileName())
-                 + QLatin1String("</nobr>"))
-    );
-    m_dlg->adjustSize();
-    m_dlg->resize(300, m_dlg->height());
-    m_dlg->setMinimumDuration(1000);
-    m_dlg->setAutoClose(true);
-    m_dlg->setRange(0, 100);
-    m_dlg->exec();
-    if (m_dlg->wasCanceled()) {
-        cancelClicked();
+tristate SqliteVacuum::compactToTemporaryFile(sqlite3 *db)
+{
+    const qint64 expectedSize = integerPragmaValue(db, "page_size")
+        * (integerPragmaValue(db, "page_count") - integerPragmaValue(db, "freelist_count"));
+    if (sqlite3_libversion_number() >= 3027000) {
+        QByteArray path = QDir::toNativeSeparators(m_tmpFilePath).toUtf8();
+        path.replace('\'', "''");
+        return executeWithProgress(db, "VACUUM INTO '" + path + '\'', expectedSize, 0, 90);
     }
-    delete m_dlg;
-    m_dlg = nullptr;
-    while (m_dumpProcess->state() == QProcess::Running
-           && m_sqliteProcess->state()  == QProcess::Running)
-    {
-        readFromStdErr();
-        qApp->processEvents(QEventLoop::AllEvents, 50000);
+    // VACUUM INTO is not available: copy the database, then compact the copy
+    DatabaseHandle copy;
+    const int res = openDatabase(m_tmpFilePath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, &copy);
+    if (res != SQLITE_OK) {
+        setSqliteResult(copy.db, res, tr("Could not open database \"%1\".").arg(m_tmpFilePath));
+        return false;
     }
-
-    readFromStdErr();
-    return !m_result.isError();
+    const tristate result = backup(copy.db, db, 0, 45);
+    if (result != true) {
+        return result;
+    }
+    // progress cannot be estimated because VACUUM uses its own temporary file
+    return executeWithProgress(copy.db, "VACUUM", 0, 45, 90);
 }
 
-void SqliteVacuum::readFromStdErr()
+tristate SqliteVacuum::backup(sqlite3 *destination, sqlite3 *source, int firstPercent,
+                              int lastPercent, qint64 destinationDataVersion)
 {
-    while (true) {
-        QByteArray s(m_dumpProcess->readLine(1000));
-        if (s.isEmpty())
-            break;
-        //sqliteDebug() << s;
-        if (s.startsWith("DUMP: ")) {
-            //set previously known progress
-            if (m_dlg) {
-                m_dlg->setValue(m_percent);
-            }
-            //update progress info
-            if (s.mid(6, 4) == "100%") {
-                m_percent = 100;
-//! @todo IMPORTANT: m_dlg->setAllowCancel(false);
-                if (m_dlg) {
-                    m_dlg->setCursor(QCursor(Qt::WaitCursor));
-                }
-            } else if (s.mid(7, 1) == "%") {
-                m_percent = s.mid(6, 1).toInt();
-            } else if (s.mid(8, 1) == "%") {
-                m_percent = s.mid(6, 2).toInt();
+    sqlite3_backup *backup = sqlite3_backup_init(destination, "main", source, "main");
+    if (!backup) {
+        setSqliteResult(destination, sqlite3_errcode(destination),
+                        tr("Could not copy database \"%1\".").arg(m_filePath));
+        return false;
+    }
+    // If the destination has to be verified, the first step copies no pages. It only starts
+    // the write transaction that is kept by the destination until the last step.
+    bool verify = destinationDataVersion >= 0;
+    QElapsedTimer busyTimer;
+    busyTimer.start();
+    int res;
+    do {
+        res = sqlite3_backup_step(backup, verify ? 0 : pagesPerBackupStep);
+        const int pageCount = sqlite3_backup_pagecount(backup);
+        if (pageCount > 0) {
+            setProgress(firstPercent + (lastPercent - firstPercent)
+                        * (pageCount - sqlite3_backup_remaining(backup)) / pageCount);
+        }
+        if (m_canceled.load()) {
+            sqlite3_backup_finish(backup); // changes of the destination are rolled back
+            return cancelled;
+        }
+        if (res == SQLITE_BUSY || res == SQLITE_LOCKED) {
+            if (busyTimer.elapsed() >= backupBusyTimeout) {
+                break;
             }
-            if (m_dlg) {
-                m_dlg->setValue(m_percent);
+            sqlite3_sleep(50); // locked by another connection, try again
+            continue;
+        }
+        busyTimer.restart();
+        if (verify && res == SQLITE_OK) {
+            verify = false;
+            // Nothing can be committed to the destination by other connections from now on
+            if (integerPragmaValue(destination, "data_version") != destinationDataVersion) {
+                sqlite3_backup_finish(backup); // the transaction is rolled back
+                m_result = KDbResult(ERR_OTHER,
+                                     tr("Database \"%1\" has been modified by another application "
+                                        "while it was being compacted.").arg(m_filePath));
+                sqliteWarning() << m_result;
+                return false;
             }
         }
+    } while (res == SQLITE_OK || res == SQLITE_BUSY || res == SQLITE_LOCKED);
+    const int finishRes = sqlite3_backup_finish(backup);
+    if (res != SQLITE_DONE || finishRes != SQLITE_OK) {
+        setSqliteResult(destination, res != SQLITE_DONE ? res : finishRes,
+                        tr("Could not copy database \"%1\".").arg(m_filePath));
+        return false;
     }
+    return true;
 }
 
-void SqliteVacuum::dumpProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+tristate SqliteVacuum::executeWithProgress(sqlite3 *db, const QByteArray &sql,
+                                           qint64 expectedSize, int firstPercent, int lastPercent)
 {
-    //sqliteDebug() << exitCode << exitStatus;
-    if (exitCode != 0 || exitStatus != QProcess::NormalExit) {
-        cancelClicked();
-        m_result.setCode(ERR_OTHER);
+    m_expectedSize = expectedSize;
+    m_firstPercent = firstPercent;
+    m_lastPercent = lastPercent;
+    m_progressTimer.start();
+    sqlite3_progress_handler(db, 1000, progressHandler, this);
+    const int res = sqlite3_exec(db, sql.constData(), nullptr, nullptr, nullptr);
+    sqlite3_progress_handler(db, 0, nullptr, nullptr);
+    if (res == SQLITE_INTERRUPT && m_canceled.load()) {
+        return cancelled;
     }
+    if (res != SQLITE_OK) {
+        setSqliteResult(db, res, tr("Could not compact database \"%1\".").arg(m_filePath));
+        return false;
+    }
+    setProgress(lastPercent);
+    return true;
 }
 
-void SqliteVacuum::sqliteProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+int SqliteVacuum::progressHandler(void *vacuum)
 {
-    //sqliteDebug() << exitCode << exitStatus;
-    if (exitCode != 0 || exitStatus != QProcess::NormalExit) {
-        m_result.setCode(ERR_OTHER);
+    SqliteVacuum *v = static_cast<SqliteVacuum*>(vacuum);
+    if (v->m_expectedSize > 0 && v->m_progressTimer.elapsed() >= progressInterval) {
+        v->m_progressTimer.restart();
+        const qint64 size = qMin(QFileInfo(v->m_tmpFilePath).size(), v->m_expectedSize);
+        v->setProgress(v->m_firstPercent
+                       + int((v->m_lastPercent - v->m_firstPercent) * size / v->m_expectedSize));
     }
+    return v->m_canceled.load() ? 1 : 0; // nonzero interrupts the statement
+}
 
-    if (m_dlg) {
-        m_dlg->reset();
+void SqliteVacuum::setProgress(int percent)
+{
+    if (percent != m_percent) {
+        m_percent = percent;
+        emit progress(percent);
     }
+}
 
-    if (m_result.isError() || m_canceled) {
-        return;
+void SqliteVacuum::setSqliteResult(sqlite3 *db, int res, const QString &message)
+{
+    m_result = KDbResult(ERR_OTHER, message);
+    m_result.setServerErrorCode(res);
+    if (db) {
+        m_result.setServerMessage(QString::fromUtf8(sqlite3_errmsg(db)));
     }
+    sqliteWarning() << m_result;
+}
 
-    // dump process and sqlite process finished by now so we can rename the result to the original name
-    QFileInfo fi(m_filePath);
-    const qint64 origSize = fi.size();
-
-    const QString newName(fi.absoluteFilePath());
-    if (0 != atomic_rename(m_tmpFilePath, newName)) {
-        m_result= KDbResult(ERR_ACCESS_RIGHTS,
-                        tr("Could not rename file \"%1\" to \"%2\".").arg(m_tmpFilePath, newName));
-        sqliteWarning() << m_result;
-    }
+qint64 SqliteVacuum::originalSize() const
+{
+    return m_originalSize;
+}
 
-    if (!m_result.isError()) {
-        const qint64 newSize = QFileInfo(m_filePath).size();
-        const qint64 decrease = 100 - 100 * newSize / origSize;
-        QMessageBox::information(nullptr, QString(), // krazy:exclude=qclasses
-            tr("The database has been compacted. Current size decreased by %1% to %2 MB.")
-               .arg(decrease).arg(QLocale().toString(double(newSize)/1000000.0, 'f', 2)));
-    }
+qint64 SqliteVacuum::compactedSize() const
+{
+    return m_compactedSize;
 }
 
-void SqliteVacuum::cancelClicked()
+void SqliteVacuum::cancel()
 {
-    m_sqliteProcess->terminate();
-    m_canceled = true;
-    QFile::remove(m_tmpFilePath);
+    m_canceled.store(1);
 }
@@ -20,27 +20,36 @@
 #ifndef KDB_SQLITEVACUUM_H
 #define KDB_SQLITEVACUUM_H
 
+#include <QAtomicInt>
+#include <QElapsedTimer>
 #include <QObject>
 #include <QString>
-#include <QProcess>
 
 #include "KDbTristate.h"
 #include "KDbResult.h"
 
-class QProgressDialog;
+struct sqlite3;
 
-//! @short Helper class performing interactive compacting (VACUUM) of the SQLite database
-/*! Proved SQLite database filename in the constructor.
- Then execute run() should be executed.
+//! @short Helper class performing compacting (VACUUM) of the SQLite database
+/*! Provide SQLite database filename in the constructor, then execute run().
 
- QProgressDialog will be displayed. Its progress bar will be updated whenever another
- table's data compacting is performed. User can click "Cancel" button in any time
- (except the final committing) to cancel the operation. In this case,
- it's guaranteed that the original file remains unchanged.
+ Compacting is performed in-process in two phases, without blocking the database
+ for long periods:
+ 1. A compacted copy of the database is written to a temporary file using
+    "VACUUM INTO", which only needs a read transaction on the original database.
+    For SQLite older than 3.27 the database is copied page by page using the online
+    backup API first and then the copy is vacuumed.
+ 2. The compacted copy is written back to the original file using the online backup API
+    within a single write transaction, so other connections see the result consistently.
+    Other connections can read the database during this phase but their attempts to write
+    fail with SQLITE_BUSY until the transaction is complete.
 
- This is possible because we rely on SQLite's VACUUM SQL command, which itself temporarily
- creates a copy of the original database file, and replaces the orginal with the new only
- on success.
+ progress() is emitted during the operation. cancel() can be called at any time,
+ e.g. from a slot connected to progress(). If the operation is cancelled or fails,
+ the transaction of phase 2 is rolled back and the original database remains unchanged.
+ If the original database has been modified by another connection before phase 2 obtains
+ its write lock, run() fails without changing the database. run() also fails if the write
+ lock cannot be obtained within 10 seconds because other connections keep the database busy.
 */
 class SqliteVacuum : public QObject, public KDbResultable
 {
@@ -50,24 +59,59 @@ public:
     ~SqliteVacuum() override;
 
     /*! Performs compacting procedure.
-     @return true on success, false on failure and cancelled if user
-     clicked "Cancel" button in the progress dialog. */
+     @return true on success, false on failure and cancelled if cancel() has been called. */
     tristate run();
 
+    //! @return size of the database file before the last run(), in bytes
+    qint64 originalSize() const;
+
+    //! @return size of the database file after the last successful run(), in bytes
+    qint64 compactedSize() const;
+
 public Q_SLOTS:
-    void readFromStdErr();
-    void dumpProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
-    void sqliteProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
-    void cancelClicked();
+    //! Cancels the operation. Can be called from any thread.
+    void cancel();
+
+Q_SIGNALS:
+    //! Emitted when progress of the operation changes, @a percent is between 0 and 100
+    void progress(int percent);
 
 private:
+    //! Writes compacted copy of @a db to m_tmpFilePath
+    tristate compactToTemporaryFile(sqlite3 *db);
+
+    /*! Copies contents of @a source to @a destination using the backup API, several pages
+     at a time. Progress is reported between @a firstPercent and @a lastPercent.
+     If @a destinationDataVersion is not negative, copying fails without changes when
+     "PRAGMA data_version" of the destination differs from it once the destination is locked. */
+    tristate backup(sqlite3 *destination, sqlite3 *source, int firstPercent, int lastPercent,
+                    qint64 destinationDataVersion = -1);
+
+    /*! Executes @a sql on @a db. Progress is estimated using size of m_tmpFilePath compared
+     to @a expectedSize and reported between @a firstPercent and @a lastPercent. */
+    tristate executeWithProgress(sqlite3 *db, const QByteArray &sql, qint64 expectedSize,
+                                 int firstPercent, int lastPercent);
+
+    //! Called periodically by SQLite while a statement is executed
+    static int progressHandler(void *vacuum);
+
+    //! Emits progress() if @a percent changed
+    void setProgress(int percent);
+
+    //! Sets result for SQLite error @a res of @a db with message @a message
+    void setSqliteResult(sqlite3 *db, int res, const QString &message);
+
     QString m_filePath;
     QString m_tmpFilePath;
-    QProcess *m_dumpProcess;
-    QProcess *m_sqliteProcess;
-    QProgressDialog* m_dlg; // krazy:exclude=qclasses
+    QAtomicInt m_canceled;
     int m_percent;
-    bool m_canceled;
+    qint64 m_originalSize;
+    qint64 m_compactedSize;
+    //! State of executeWithProgress()
+    QElapsedTimer m_progressTimer;
+    qint64 m_expectedSize;
+    int m_firstPercent;
+    int m_lastPercent;
     Q_DISABLE_COPY(SqliteVacuum)
 };
 
@@ -44,7 +44,9 @@ protected:
 
     //! For implementation, executes the prepared statement
     //! Type of statement is specified by the @a type parameter.
-    //! @a selectFieldList specifies fields for SELECT statement.
+    //! @a selectFieldList specifies fields for parameters of the statement: fields
+    //! of the WHERE section for SELECT and DELETE, inserted fields for INSERT,
+    //! fields of the SET section followed by fields of the WHERE section for UPDATE.
     //! @a insertFieldList is set to list of fields in INSERT statement.
     //! Parameters @a parameters are passed to the statement, usually using binding.
     virtual QSharedPointer<KDbSqlResult> execute(
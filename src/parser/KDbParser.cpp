@@ -27,8 +27,6 @@
 
 #include <vector>
 
-bool parseData();
-
 //! Cache
 class ParserStatic
 {
@@ -122,13 +120,7 @@ bool KDbParser::parse(const KDbEscapedString &sql, KDbQuerySchema *query)
     d->sql = sql;
     d->query = query;
 
-    KDbParser *oldParser = globalParser;
-    KDbField *oldField = globalField;
-    globalParser = this;
-    globalField = nullptr;
-    bool res = parseData();
-    globalParser = oldParser;
-    globalField = oldField;
+    bool res = parseData(this);
     if (query) { // if existing query was supplied to parse() nullptr should be returned by query()
         d->query = nullptr;
     }
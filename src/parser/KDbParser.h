@@ -97,6 +97,10 @@ class KDbParserPrivate; //!< @internal
  * KDbSQL dialect. Schema objects such as KDbQuerySchema that are created after successful parsing
  * can be then used for running the queries on actual data or used for further modification.
  *
+ * State of parsing is kept in the parser object and in a scanner created for each parse() call,
+ * so different parser objects can be used in different threads at the same time. A single parser
+ * object should not be used by more than one thread at once.
+ *
  * @todo Add examples
  * @todo Support more types than the SELECT
  */
@@ -30,18 +30,13 @@
 
 #include <QMutableListIterator>
 
-KDbParser *globalParser = nullptr;
-KDbField *globalField = nullptr;
-QList<KDbField*> fieldList;
-int globalCurrentPos = 0;
-QByteArray globalToken;
-
-extern int yylex_destroy(void);
+extern int yylex_init_extra(KDbParser *parser, yyscan_t *scanner);
+extern int yylex_destroy(yyscan_t scanner);
 
 //-------------------------------------
 
 KDbParserPrivate::KDbParserPrivate()
-    : table(nullptr), query(nullptr), connection(nullptr), initialized(false)
+    : table(nullptr), query(nullptr), connection(nullptr), initialized(false), currentPos(0)
 {
     reset();
 }
@@ -60,6 +55,8 @@ void KDbParserPrivate::reset()
     table = nullptr;
     delete query;
     query = nullptr;
+    currentPos = 0;
+    token.clear();
 }
 
 void KDbParserPrivate::setStatementType(KDbParser::StatementType type)
@@ -173,23 +170,23 @@ void KDbParseInfoInternal::appendPositionForTableOrAliasName(const QString &tabl
 
 //-------------------------------------
 
-extern int yyparse();
-extern void tokenize(const char *data);
+extern void tokenize(const char *data, yyscan_t scanner);
 
-void yyerror(const char *str)
+void yyerror(KDbParser *parser, const char *str)
 {
+    KDbParserPrivate *d = KDbParserPrivate::get(parser);
     kdbDebug() << "error: " << str;
-    kdbDebug() << "at character " << globalCurrentPos << " near tooken " << globalToken;
-    KDbParserPrivate::get(globalParser)->setStatementType(KDbParser::NoType);
+    kdbDebug() << "at character " << d->currentPos << " near tooken " << d->token;
+    d->setStatementType(KDbParser::NoType);
 
     const bool otherError = (qstrnicmp(str, "other error", 11) == 0);
     const bool syntaxError = qstrnicmp(str, "syntax error", 12) == 0;
-    if ((globalParser->error().type().isEmpty()
+    if ((parser->error().type().isEmpty()
          && (str == nullptr || strlen(str) == 0 || syntaxError))
         || otherError)
     {
-        kdbDebug() << globalParser->statement();
-        QString ptrline(globalCurrentPos, QLatin1Char(' '));
+        kdbDebug() << parser->statement();
+        QString ptrline(d->currentPos, QLatin1Char(' '));
 
         ptrline += QLatin1String("^");
 
@@ -197,7 +194,7 @@ void yyerror(const char *str)
 
 #if 0
         //lexer may add error messages
-        QString lexerErr = globalParser->error().message();
+        QString lexerErr = parser->error().message();
 
         QString errtypestr = QLatin1String(str);
         if (lexerErr.isEmpty()) {
@@ -209,75 +206,84 @@ void yyerror(const char *str)
 
         //! @todo exact invalid expression can be selected in the editor, based on KDbParseInfo data
         if (!otherError) {
-            const bool isKDbSqlKeyword = KDb::isKDbSqlKeyword(globalToken);
+            const bool isKDbSqlKeyword = KDb::isKDbSqlKeyword(d->token);
             if (isKDbSqlKeyword || syntaxError) {
                 if (isKDbSqlKeyword) {
-                    KDbParserPrivate::get(globalParser)->setError(KDbParserError(KDbParser::tr("Syntax Error"),
-                                                          KDbParser::tr("\"%1\" is a reserved keyword.").arg(QLatin1String(globalToken)),
-                                                          globalToken, globalCurrentPos));
+                    d->setError(KDbParserError(KDbParser::tr("Syntax Error"),
+                                               KDbParser::tr("\"%1\" is a reserved keyword.").arg(QLatin1String(d->token)),
+                                               d->token, d->currentPos));
                 } else {
-                    KDbParserPrivate::get(globalParser)->setError(KDbParserError(KDbParser::tr("Syntax Error"),
-                                                          KDbParser::tr("Syntax error."),
-                                                          globalToken, globalCurrentPos));
+                    d->setError(KDbParserError(KDbParser::tr("Syntax Error"),
+                                               KDbParser::tr("Syntax error."),
+                                               d->token, d->currentPos));
                 }
             } else {
-                KDbParserPrivate::get(globalParser)->setError(KDbParserError(KDbParser::tr("Error"),
-                                                      KDbParser::tr("Error near \"%1\".").arg(QLatin1String(globalToken)),
-                                                      globalToken, globalCurrentPos));
+                d->setError(KDbParserError(KDbParser::tr("Error"),
+                                           KDbParser::tr("Error near \"%1\".").arg(QLatin1String(d->token)),
+                                           d->token, d->currentPos));
             }
         }
     }
 }
 
-void setError(const QString& errName, const QString& errDesc)
+void setError(KDbParser *parser, const QString& errName, const QString& errDesc)
 {
-    KDbParserPrivate::get(globalParser)->setError(KDbParserError(errName, errDesc, globalToken, globalCurrentPos));
-    yyerror(qPrintable(errName));
+    KDbParserPrivate *d = KDbParserPrivate::get(parser);
+    d->setError(KDbParserError(errName, errDesc, d->token, d->currentPos));
+    yyerror(parser, qPrintable(errName));
 }
 
-void setError(const QString& errDesc)
+void setError(KDbParser *parser, const QString& errDesc)
 {
-    setError(KDbParser::tr("Other error"), errDesc);
+    setError(parser, KDbParser::tr("Other error"), errDesc);
 }
 
 /* this is better than assert() */
-#define IMPL_ERROR(errmsg) setError(KDbParser::tr("Implementation error"), QLatin1String(errmsg))
+#define IMPL_ERROR(errmsg) setError(parser, KDbParser::tr("Implementation error"), QLatin1String(errmsg))
 
-//! @internal Parses @a data for parser @a p
-//! @todo Make it REENTRANT
-bool parseData()
+//! @internal Parses statement of @a parser
+//! Each call uses a scanner of its own so statements can be parsed in parallel
+//! by parsers used in different threads.
+bool parseData(KDbParser *parser)
 {
-    fieldList.clear();
-
-    const KDbEscapedString sql(globalParser->statement());
+    KDbParserPrivate *d = KDbParserPrivate::get(parser);
+    const KDbEscapedString sql(parser->statement());
     if (sql.isEmpty()) {
         KDbParserError err(KDbParser::tr("Error"),
                            KDbParser::tr("No query statement specified."),
-                           globalToken, globalCurrentPos);
-        KDbParserPrivate::get(globalParser)->setError(err);
-        yyerror("");
+                           d->token, d->currentPos);
+        d->setError(err);
+        yyerror(parser, "");
         return false;
     }
 
+    yyscan_t scanner;
+    if (yylex_init_extra(parser, &scanner) != 0) {
+        d->setError(KDbParserError(KDbParser::tr("Error"),
+                                   KDbParser::tr("Could not initialize the SQL scanner."),
+                                   d->token, d->currentPos));
+        return false;
+    }
     const char *data = sql.constData();
-    tokenize(data);
-    if (!globalParser->error().type().isEmpty()) {
+    tokenize(data, scanner);
+    if (!parser->error().type().isEmpty()) {
+        yylex_destroy(scanner);
         return false;
     }
 
-    bool ok = yyparse() == 0;
-    if (ok && globalCurrentPos < sql.length()) {
+    bool ok = yyparse(parser, scanner) == 0;
+    if (ok && d->currentPos < sql.length()) {
         kdbDebug() << "Parse error: tokens left"
-                   << "globalCurrentPos:" << globalCurrentPos << "sql.length():" << sql.length()
-                   << "globalToken:" << QString::fromUtf8(globalToken);
+                   << "currentPos:" << d->currentPos << "sql.length():" << sql.length()
+                   << "token:" << QString::fromUtf8(d->token);
         KDbParserError err(KDbParser::tr("Error"),
                            KDbParser::tr("Unexpected character."),
-                           globalToken, globalCurrentPos);
-        KDbParserPrivate::get(globalParser)->setError(err);
-        yyerror("");
+                           d->token, d->currentPos);
+        d->setError(err);
+        yyerror(parser, "");
         ok = false;
     }
-    if (ok && globalParser->statementType() == KDbParser::Select) {
+    if (ok && parser->statementType() == KDbParser::Select) {
         kdbDebug() << "parseData(): ok";
 //   kdbDebug() << "parseData(): " << tableDict.count() << " loaded tables";
         /*   KDbTableSchema *ts;
@@ -288,19 +294,19 @@ bool parseData()
     } else {
         ok = false;
     }
-    yylex_destroy();
+    yylex_destroy(scanner);
     return ok;
 }
 
 
 /*! Adds @a columnExpr to @a parseInfo
  The column can be in a form table.field, tableAlias.field or field.
- @return true on success. On error message in globalParser object is updated.
+ @return true on success. On error message in @a parser object is updated.
 */
-bool addColumn(KDbParseInfo *parseInfo, const KDbExpression &columnExpr)
+bool addColumn(KDbParser *parser, KDbParseInfo *parseInfo, const KDbExpression &columnExpr)
 {
     if (!KDbExpression(columnExpr).validate(parseInfo)) { // (KDbExpression(columnExpr) used to avoid constness problem)
-        setError(parseInfo->errorMessage(), parseInfo->errorDescription());
+        setError(parser, parseInfo->errorMessage(), parseInfo->errorDescription());
         return false;
     }
 
@@ -309,25 +315,25 @@ bool addColumn(KDbParseInfo *parseInfo, const KDbExpression &columnExpr)
         //it's a variable:
         if (v_e.name() == QLatin1String("*")) {//all tables asterisk
             if (parseInfo->querySchema()->tables()->isEmpty()) {
-                setError(KDbParser::tr("\"*\" could not be used if no tables are specified."));
+                setError(parser, KDbParser::tr("\"*\" could not be used if no tables are specified."));
                 return false;
             }
             KDbQueryAsterisk *a = new KDbQueryAsterisk(parseInfo->querySchema());
             if (!parseInfo->querySchema()->addAsterisk(a)) {
                 delete a;
-                setError(KDbParser::tr("\"*\" could not be added."));
+                setError(parser, KDbParser::tr("\"*\" could not be added."));
                 return false;
             }
         } else if (v_e.tableForQueryAsterisk()) {//one-table asterisk
             KDbQueryAsterisk *a = new KDbQueryAsterisk(parseInfo->querySchema(), *v_e.tableForQueryAsterisk());
             if (!parseInfo->querySchema()->addAsterisk(a)) {
                 delete a;
-                setError(KDbParser::tr("\"<table>.*\" could not be added."));
+                setError(parser, KDbParser::tr("\"<table>.*\" could not be added."));
                 return false;
             }
         } else if (v_e.field()) {//"table.field" or "field" (bound to a table or not)
             if (!parseInfo->querySchema()->addField(v_e.field(), v_e.tablePositionForField())) {
-                setError(KDbParser::tr("Could not add binding to a field."));
+                setError(parser, KDbParser::tr("Could not add binding to a field."));
                 return false;
             }
         } else {
@@ -342,7 +348,7 @@ bool addColumn(KDbParseInfo *parseInfo, const KDbExpression &columnExpr)
 }
 
 KDbQuerySchema* buildSelectQuery(
-    KDbQuerySchema* querySchema, KDbNArgExpression* _colViews,
+    KDbParser *parser, KDbQuerySchema* querySchema, KDbNArgExpression* _colViews,
     KDbNArgExpression* _tablesList, SelectOptionsInternal* options)
 {
     KDbParseInfoInternal parseInfo(querySchema);
@@ -384,9 +390,9 @@ KDbQuerySchema* buildSelectQuery(
             }
             Q_ASSERT(t_e.isVariable());
             QString tname = t_e.name();
-            KDbTableSchema *s = globalParser->connection()->tableSchema(tname);
+            KDbTableSchema *s = parser->connection()->tableSchema(tname);
             if (!s) {
-                setError(KDbParser::tr("Table \"%1\" does not exist.").arg(tname));
+                setError(parser, KDbParser::tr("Table \"%1\" does not exist.").arg(tname));
                 return nullptr;
             }
             QString tableOrAliasName = KDb::iifNotEmpty(aliasString, tname);
@@ -395,8 +401,8 @@ KDbQuerySchema* buildSelectQuery(
                 const int tablePosition = querySchema->tablePositionForAlias(aliasString);
                 if (tablePosition != -1 && tablePosition != i) {
                     KDbTableSchema* tableForAlias = querySchema->tables()->at(tablePosition);
-                    setError(KDbParser::tr("Could not set alias \"%1\" for table \"%2\". "
-                                           "This alias is already set for table \"%3\".")
+                    setError(parser, KDbParser::tr("Could not set alias \"%1\" for table \"%2\". "
+                                                   "This alias is already set for table \"%3\".")
                              .arg(aliasString, tname, tableForAlias->name()));
                     break;
                 }
@@ -427,8 +433,8 @@ KDbQuerySchema* buildSelectQuery(
                 columnExpr = e.toBinary().left();
                 aliasVariable = e.toBinary().right().toVariable();
                 if (aliasVariable.isNull()) {
-                    setError(KDbParser::tr("Invalid alias definition for column \"%1\".")
-                                           .arg(columnExpr.toString(nullptr).toString())); //ok?
+                    setError(parser, KDbParser::tr("Invalid alias definition for column \"%1\".")
+                                                   .arg(columnExpr.toString(nullptr).toString())); //ok?
                     break;
                 }
             }
@@ -447,7 +453,7 @@ KDbQuerySchema* buildSelectQuery(
             if (c == KDb::VariableExpression) {
                 if (columnExpr.toVariable().name() == QLatin1String("*")) {
                     if (containsAsteriskColumn) {
-                        setError(KDbParser::tr("More than one asterisk \"*\" is not allowed."));
+                        setError(parser, KDbParser::tr("More than one asterisk \"*\" is not allowed."));
                         return nullptr;
                     }
                     else {
@@ -461,8 +467,8 @@ KDbQuerySchema* buildSelectQuery(
 //  kdbDebug() << colViews->list.count() << " " << it.current()->debugString();
 //! @todo IMPORTANT: it.remove();
             } else if (aliasVariable.isNull()) {
-                setError(KDbParser::tr("Invalid \"%1\" column definition.")
-                                       .arg(e.toString(nullptr).toString())); //ok?
+                setError(parser, KDbParser::tr("Invalid \"%1\" column definition.")
+                                               .arg(e.toString(nullptr).toString())); //ok?
                 break;
             }
             else {
@@ -470,7 +476,7 @@ KDbQuerySchema* buildSelectQuery(
                 e.toBinary().setLeft(KDbExpression());
             }
 
-            if (!addColumn(&parseInfo, columnExpr)) {
+            if (!addColumn(parser, &parseInfo, columnExpr)) {
                 break;
             }
 
@@ -479,18 +485,18 @@ KDbQuerySchema* buildSelectQuery(
 //     << columnNum;
                 const int currentColumn = querySchema->columnPositionForAlias(aliasVariable.name());
                 if (currentColumn != -1) {
-                    setError(KDbParser::tr("Could not set alias \"%1\" for column #%2. This alias is already set for column #%3.")
+                    setError(parser, KDbParser::tr("Could not set alias \"%1\" for column #%2. This alias is already set for column #%3.")
                              .arg(aliasVariable.name()).arg(columnNum + 1).arg(currentColumn + 1));
                     break;
                 }
                 if (!querySchema->setColumnAlias(columnNum, aliasVariable.name())) {
-                    setError(KDbParser::tr("Could not set alias \"%1\" for column #%2.")
+                    setError(parser, KDbParser::tr("Could not set alias \"%1\" for column #%2.")
                              .arg(aliasVariable.name()).arg(columnNum + 1));
                     break;
                 }
             }
         } // for
-        if (!globalParser->error().message().isEmpty()) { // we could not return earlier (inside the loop)
+        if (!parser->error().message().isEmpty()) { // we could not return earlier (inside the loop)
                                                           // because we want run CLEANUP what could crash QMutableListIterator.
             return nullptr;
         }
@@ -500,7 +506,7 @@ KDbQuerySchema* buildSelectQuery(
         //----- WHERE expr.
         if (!options->whereExpr.isNull()) {
             if (!options->whereExpr.validate(&parseInfo)) {
-                setError(parseInfo.errorMessage(), parseInfo.errorDescription());
+                setError(parser, parseInfo.errorMessage(), parseInfo.errorDescription());
                 return nullptr;
             }
             KDbQuerySchemaPrivate::setWhereExpressionInternal(querySchema, options->whereExpr);
@@ -516,28 +522,28 @@ KDbQuerySchema* buildSelectQuery(
             {
                 // first, try to find a column name or alias (outside of asterisks)
                 KDbQueryColumnInfo *columnInfo = querySchema->columnInfo(
-                    globalParser->connection(), (*it).aliasOrName,
+                    parser->connection(), (*it).aliasOrName,
                     KDbQuerySchema::ExpandMode::Unexpanded /*outside of asterisks*/);
                 if (columnInfo) {
                     orderByColumnList->appendColumn(columnInfo, (*it).order);
                 } else {
                     //failed, try to find a field name within all the tables
                     if ((*it).columnNumber != -1) {
-                        if (!orderByColumnList->appendColumn(globalParser->connection(),
+                        if (!orderByColumnList->appendColumn(parser->connection(),
                                                              querySchema, (*it).order,
                                                              (*it).columnNumber - 1))
                         {
-                            setError(KDbParser::tr("Could not define sorting. Column at "
-                                                   "position %1 does not exist.")
-                                                   .arg((*it).columnNumber));
+                            setError(parser, KDbParser::tr("Could not define sorting. Column at "
+                                                           "position %1 does not exist.")
+                                                           .arg((*it).columnNumber));
                             return nullptr;
                         }
                     } else {
                         KDbField * f = querySchema->findTableField((*it).aliasOrName);
                         if (!f) {
-                            setError(KDbParser::tr("Could not define sorting. "
-                                                   "Column name or alias \"%1\" does not exist.")
-                                                   .arg((*it).aliasOrName));
+                            setError(parser, KDbParser::tr("Could not define sorting. "
+                                                           "Column name or alias \"%1\" does not exist.")
+                                                           .arg((*it).aliasOrName));
                             return nullptr;
                         }
                         orderByColumnList->appendField(f, (*it).order);
@@ -73,6 +73,10 @@ public:
      */
     Q_REQUIRED_RESULT KDbQuerySchema *createQuery();
 
+    //! State of the current KDbParser::parse() call, updated by the scanner
+    int currentPos; //!< position of the character after the current token
+    QByteArray token; //!< text of the current token
+
     friend class KDbParser;
 
 private:
@@ -162,19 +166,22 @@ private:
 
 KDB_TESTING_EXPORT const char* g_tokenName(unsigned int offset);
 
-void yyerror(const char *str);
+//! Functions below are used by the parser's low level code.
+//! All of them operate on state of @a parser so parsers can be used in parallel.
+
+void yyerror(KDbParser *parser, const char *str);
 
-void setError(const QString& errName, const QString& errDesc);
+void setError(KDbParser *parser, const QString& errName, const QString& errDesc);
 
-void setError(const QString& errDesc);
+void setError(KDbParser *parser, const QString& errDesc);
 
-bool addColumn(KDbParseInfo* parseInfo, KDbExpression* columnExpr);
+bool addColumn(KDbParser *parser, KDbParseInfo* parseInfo, const KDbExpression &columnExpr);
 
 KDbQuerySchema* buildSelectQuery(
-    KDbQuerySchema* querySchema, KDbNArgExpression* colViews,
+    KDbParser *parser, KDbQuerySchema* querySchema, KDbNArgExpression* colViews,
     KDbNArgExpression* tablesList = nullptr, SelectOptionsInternal * options = nullptr);
 
-extern KDbParser *globalParser;
-extern KDbField *globalField;
+//! Parses statement of @a parser
+bool parseData(KDbParser *parser);
 
 #endif
@@ -486,7 +486,19 @@ QDebug operator<<(QDebug dbg, const KDbExpressionPtr& expr)
     return dbg.space();
 }
 
-int yylex();
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+int yylex(union YYSTYPE *lvalp, yyscan_t scanner);
+
+//! Errors are reported by the parser object, the scanner is not needed
+static void yyerror(KDbParser *parser, yyscan_t scanner, const char *str)
+{
+    Q_UNUSED(scanner);
+    yyerror(parser, str);
+}
 
 #define YY_NO_UNPUT
 #define YYSTACK_USE_ALLOCA 1
@@ -502,6 +514,10 @@ int yylex();
 
 %}
 
+%define api.pure full
+%parse-param {KDbParser *parser} {yyscan_t scanner}
+%lex-param {yyscan_t scanner}
+
 %union {
     QString* stringValue;
     QByteArray* binaryValue;
@@ -565,8 +581,8 @@ StatementList
 {
 //todo: multiple statements
 //todo: not only "select" statements
-    KDbParserPrivate::get(globalParser)->setStatementType(KDbParser::Select);
-    KDbParserPrivate::get(globalParser)->setQuerySchema($1);
+    KDbParserPrivate::get(parser)->setStatementType(KDbParser::Select);
+    KDbParserPrivate::get(parser)->setQuerySchema($1);
 }
 ;
 
@@ -600,8 +616,8 @@ SelectStatement
 /*CreateTableStatement :
 CREATE TABLE IDENTIFIER
 {
-    globalParser->setStatementType(KDbParser::CreateTable);
-    globalParser->createTable($3->toLatin1());
+    parser->setStatementType(KDbParser::CreateTable);
+    parser->createTable($3->toLatin1());
     delete $3;
 }
 '(' ColDefs ')'
@@ -618,7 +634,7 @@ IDENTIFIER ColType
 {
     sqlParserDebug() << "adding field " << *$1;
     globalField->setName(*$1);
-    globalParser->table()->addField(globalField);
+    parser->table()->addField(globalField);
     globalField = nullptr;
     delete $1;
 }
@@ -627,10 +643,10 @@ IDENTIFIER ColType
     sqlParserDebug() << "adding field " << *$1;
     globalField->setName(*$1);
     delete $1;
-    globalParser->table()->addField(globalField);
+    parser->table()->addField(globalField);
 
 //    if(globalField->isPrimaryKey())
-//        globalParser->table()->addPrimaryKey(globalField->name());
+//        parser->table()->addPrimaryKey(globalField->name());
 
 //    delete globalField;
 //    globalField = nullptr;
@@ -693,43 +709,43 @@ SelectStatement:
 Select
 {
     sqlParserDebug() << "Select";
-    if (!($$ = buildSelectQuery( $1, nullptr )))
+    if (!($$ = buildSelectQuery(parser, $1, nullptr )))
         YYABORT;
 }
 | Select ColViews
 {
     sqlParserDebug() << "Select ColViews=" << *$2;
 
-    if (!($$ = buildSelectQuery( $1, $2 )))
+    if (!($$ = buildSelectQuery(parser, $1, $2 )))
         YYABORT;
 }
 | Select ColViews Tables
 {
-    if (!($$ = buildSelectQuery( $1, $2, $3 )))
+    if (!($$ = buildSelectQuery(parser, $1, $2, $3 )))
         YYABORT;
 }
 | Select Tables
 {
     sqlParserDebug() << "Select ColViews Tables";
-    if (!($$ = buildSelectQuery( $1, nullptr, $2 )))
+    if (!($$ = buildSelectQuery(parser, $1, nullptr, $2 )))
         YYABORT;
 }
 | Select ColViews SelectOptions
 {
     sqlParserDebug() << "Select ColViews Conditions";
-    if (!($$ = buildSelectQuery( $1, $2, nullptr, $3 )))
+    if (!($$ = buildSelectQuery(parser, $1, $2, nullptr, $3 )))
         YYABORT;
 }
 | Select Tables SelectOptions
 {
     sqlParserDebug() << "Select Tables SelectOptions";
-    if (!($$ = buildSelectQuery( $1, nullptr, $2, $3 )))
+    if (!($$ = buildSelectQuery(parser, $1, nullptr, $2, $3 )))
         YYABORT;
 }
 | Select ColViews Tables SelectOptions
 {
     sqlParserDebug() << "Select ColViews Tables SelectOptions";
-    if (!($$ = buildSelectQuery( $1, $2, $3, $4 )))
+    if (!($$ = buildSelectQuery(parser, $1, $2, $3, $4 )))
         YYABORT;
 }
 ;
@@ -738,7 +754,7 @@ Select:
 SELECT
 {
     sqlParserDebug() << "SELECT";
-    $$ = KDbParserPrivate::get(globalParser)->createQuery();
+    $$ = KDbParserPrivate::get(parser)->createQuery();
 }
 ;
 
@@ -1413,7 +1429,7 @@ IDENTIFIER
 
     //! @todo this isn't ok for more tables:
     /*
-    KDbField::ListIterator it = globalParser->query()->fieldsIterator();
+    KDbField::ListIterator it = parser->query()->fieldsIterator();
     for(KDbField *item; (item = it.current()); ++it)
     {
         if(item->table() == dummy)
@@ -1427,8 +1443,8 @@ IDENTIFIER
             if(!f)
             {
                 KDbParserError err(KDbParser::tr("Field List Error"), KDbParser::tr("Unknown column '%1' in table '%2'",item->name(),schema->name()), ctoken, current);
-                globalParser->setError(err);
-                yyerror("fieldlisterror");
+                parser->setError(err);
+                yyerror(parser, "fieldlisterror");
             }
         }
     }*/
@@ -1481,7 +1497,7 @@ ColExpression
 //    $$ = new KDbField();
 //    dummy->addField($$);
 //    $$->setExpression( $1 );
-//    globalParser->query()->addField($$);
+//    parser->query()->addField($$);
     $$ = $1;
     sqlParserDebug() << " added column expr:" << *$1;
 }
@@ -1530,7 +1546,7 @@ aExpr
 //    $$ = new AggregationExpression( SUM,  );
 //    $$->setName("SUM(" + $3->name() + ")");
 //wait    $$->containsGroupingAggregate(true);
-//wait    globalParser->query()->grouped(true);
+//wait    parser->query()->grouped(true);
 }*/
 //! @todo
 /*
@@ -1539,7 +1555,7 @@ aExpr
     $$ = $3;
 //    $$->setName("MIN(" + $3->name() + ")");
 //wait    $$->containsGroupingAggregate(true);
-//wait    globalParser->query()->grouped(true);
+//wait    parser->query()->grouped(true);
 }*/
 //! @todo
 /*
@@ -1548,7 +1564,7 @@ aExpr
     $$ = $3;
 //    $$->setName("MAX(" + $3->name() + ")");
 //wait    $$->containsGroupingAggregate(true);
-//wait    globalParser->query()->grouped(true);
+//wait    parser->query()->grouped(true);
 }*/
 //! @todo
 /*
@@ -1557,7 +1573,7 @@ aExpr
     $$ = $3;
 //    $$->setName("AVG(" + $3->name() + ")");
 //wait    $$->containsGroupingAggregate(true);
-//wait    globalParser->query()->grouped(true);
+//wait    parser->query()->grouped(true);
 }*/
 | DISTINCT '(' ColExpression ')'
 {
@@ -1573,8 +1589,8 @@ ColWildCard:
     $$ = new KDbVariableExpression(QLatin1String("*"));
     sqlParserDebug() << "all columns";
 
-//    KDbQueryAsterisk *ast = new KDbQueryAsterisk(globalParser->query(), dummy);
-//    globalParser->query()->addAsterisk(ast);
+//    KDbQueryAsterisk *ast = new KDbQueryAsterisk(parser->query(), dummy);
+//    parser->query()->addAsterisk(ast);
 //    requiresTable = true;
 }
 | IDENTIFIER '.' '*'
@@ -1589,7 +1605,7 @@ ColWildCard:
 {
     $$ = new KDbVariableExpression($1);
     sqlParserDebug() << "  Invalid identifier! " << $1;
-    setError(KDbParser::tr("Invalid identifier \"%1\"",$1));
+    setError(parser, KDbParser::tr("Invalid identifier \"%1\"",$1));
 }*/
 ;
 
@@ -27,6 +27,14 @@ BISON_MIN_NUM=30004  # keep updated for best results
 FLEX_MIN=2.5.37      # keep updated for best results
 FLEX_MIN_NUM=20537   # keep updated for best results
 
+# Check if the tools are available, otherwise the generated files would be left incomplete
+for tool in bison flex ; do
+    if ! which $tool > /dev/null 2>&1 ; then
+        echo "$tool not found, it is needed to generate the parser and lexer code."
+        exit 1
+    fi
+done
+
 # Check minimum version of bison
 bisonv=`bison --version | head -n 1| cut -f4 -d" "`
 bisonv1=`echo $bisonv | cut -f1 -d.`
@@ -55,10 +63,15 @@ builddir=$PWD
 srcdir=`dirname $0`
 cd $srcdir
 
-flex -ogenerated/sqlscanner.cpp KDbSqlScanner.l
+flex -ogenerated/sqlscanner.cpp KDbSqlScanner.l || exit 1
 # Correct a few yy_size_t vs size_t vs int differences that some bisons cause
 sed --in-place 's/int yyleng/yy_size_t yyleng/g;s/int yyget_leng/yy_size_t yyget_leng/g;s/yyleng = (int)/yyleng = (size_t)/g;' generated/sqlscanner.cpp
-bison -d KDbSqlParser.y -Wall -fall -rall --report-file=$builddir/KDbSqlParser.output
+bison -d KDbSqlParser.y -Wall -fall -rall --report-file=$builddir/KDbSqlParser.output || exit 1
+# -fall includes -fsyntax-only since bison 3.7 so nothing is generated
+if [ ! -f KDbSqlParser.tab.c -o ! -f KDbSqlParser.tab.h ] ; then
+    echo "bison $bisonv has not generated the parser code, use version 3.0.x."
+    exit 1
+fi
 
 # postprocess
 cat << EOF > generated/sqlparser.h
@@ -74,9 +87,15 @@ cat << EOF > generated/sqlparser.h
 #include "KDbField.h"
 #include "KDbOrderByColumn.h"
 
+class KDbParser;
 struct OrderByColumnInternal;
 struct SelectOptionsInternal;
 
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
 EOF
 
 # Fine-tune the code: extra functions and remove trailing white space
@@ -50,7 +50,7 @@
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -117,7 +117,19 @@ QDebug operator<<(QDebug dbg, const KDbExpressionPtr& expr)
     return dbg.space();
 }
 
-int yylex();
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+int yylex(union YYSTYPE *lvalp, yyscan_t scanner);
+
+//! Errors are reported by the parser object, the scanner is not needed
+static void yyerror(KDbParser *parser, yyscan_t scanner, const char *str)
+{
+    Q_UNUSED(scanner);
+    yyerror(parser, str);
+}
 
 #define YY_NO_UNPUT
 #define YYSTACK_USE_ALLOCA 1
@@ -132,7 +144,7 @@ int yylex();
     }
 
 
-#line 136 "sqlparser.cpp" /* yacc.c:339  */
+#line 148 "sqlparser.cpp" /* yacc.c:339  */
 
 # ifndef YY_NULLPTR
 #  if defined __cplusplus && 201103L <= __cplusplus
@@ -242,7 +254,7 @@ extern int yydebug;
 
 union YYSTYPE
 {
-#line 505 "KDbSqlParser.y" /* yacc.c:355  */
+#line 521 "KDbSqlParser.y" /* yacc.c:355  */
 
     QString* stringValue;
     QByteArray* binaryValue;
@@ -264,7 +276,7 @@ union YYSTYPE
     QList<OrderByColumnInternal> *orderByColumns;
     QVariant *variantValue;
 
-#line 268 "sqlparser.cpp" /* yacc.c:355  */
+#line 280 "sqlparser.cpp" /* yacc.c:355  */
 };
 
 typedef union YYSTYPE YYSTYPE;
@@ -273,15 +285,14 @@ typedef union YYSTYPE YYSTYPE;
 #endif
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
+int yyparse (KDbParser *parser, yyscan_t scanner);
 
 #endif /* !YY_YY_KDBSQLPARSER_TAB_H_INCLUDED  */
 
 /* Copy the second part of user declarations.  */
 
-#line 285 "sqlparser.cpp" /* yacc.c:358  */
+#line 296 "sqlparser.cpp" /* yacc.c:358  */
 
 #ifdef short
 # undef short
@@ -876,7 +887,7 @@ do                                                              \
     }                                                           \
   else                                                          \
     {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
+      yyerror (parser, scanner, YY_("syntax error: cannot back up")); \
       YYERROR;                                                  \
     }                                                           \
 while (0)
@@ -913,7 +924,7 @@ do {                                                                      \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Type, Value, parser, scanner); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -924,10 +935,12 @@ do {                                                                      \
 `----------------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, KDbParser *parser, yyscan_t scanner)
 {
   FILE *yyo = yyoutput;
   YYUSE (yyo);
+  YYUSE (parser);
+  YYUSE (scanner);
   if (!yyvaluep)
     return;
 # ifdef YYPRINT
@@ -943,12 +956,12 @@ yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvalue
 `--------------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, KDbParser *parser, yyscan_t scanner)
 {
   YYFPRINTF (yyoutput, "%s %s (",
              yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
+  yy_symbol_value_print (yyoutput, yytype, yyvaluep, parser, scanner);
   YYFPRINTF (yyoutput, ")");
 }
 
@@ -981,7 +994,7 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule, KDbParser *parser, yyscan_t scanner)
 {
   unsigned long int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -995,7 +1008,7 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
       yy_symbol_print (stderr,
                        yystos[yyssp[yyi + 1 - yynrhs]],
                        &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
+                                              , parser, scanner);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1003,7 +1016,7 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, parser, scanner); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
@@ -1261,9 +1274,11 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, KDbParser *parser, yyscan_t scanner)
 {
   YYUSE (yyvaluep);
+  YYUSE (parser);
+  YYUSE (scanner);
   if (!yymsg)
     yymsg = "Deleting";
   YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
@@ -1276,22 +1291,26 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
 
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
-
-
 /*----------.
 | yyparse.  |
 `----------*/
 
 int
-yyparse (void)
+yyparse (KDbParser *parser, yyscan_t scanner)
 {
+/* The lookahead symbol.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs;
+
     int yystate;
     /* Number of tokens to shift before error messages enabled.  */
     int yyerrstatus;
@@ -1446,7 +1465,7 @@ yybackup:
   if (yychar == YYEMPTY)
     {
       YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
@@ -1525,142 +1544,142 @@ yyreduce:
   switch (yyn)
     {
         case 2:
-#line 565 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 581 "KDbSqlParser.y" /* yacc.c:1646  */
     {
 //todo: multiple statements
 //todo: not only "select" statements
-    KDbParserPrivate::get(globalParser)->setStatementType(KDbParser::Select);
-    KDbParserPrivate::get(globalParser)->setQuerySchema((yyvsp[0].querySchema));
+    KDbParserPrivate::get(parser)->setStatementType(KDbParser::Select);
+    KDbParserPrivate::get(parser)->setQuerySchema((yyvsp[0].querySchema));
 }
-#line 1536 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1555 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 3:
-#line 575 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 591 "KDbSqlParser.y" /* yacc.c:1646  */
     {
 //todo: multiple statements
 }
-#line 1544 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1563 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 5:
-#line 580 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 596 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.querySchema) = (yyvsp[-1].querySchema);
 }
-#line 1552 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1571 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 6:
-#line 595 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 611 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.querySchema) = (yyvsp[0].querySchema);
 }
-#line 1560 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1579 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 7:
-#line 694 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 710 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "Select";
-    if (!((yyval.querySchema) = buildSelectQuery( (yyvsp[0].querySchema), nullptr )))
+    if (!((yyval.querySchema) = buildSelectQuery(parser, (yyvsp[0].querySchema), nullptr )))
         YYABORT;
 }
-#line 1570 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1589 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 8:
-#line 700 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 716 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "Select ColViews=" << *(yyvsp[0].exprList);
 
-    if (!((yyval.querySchema) = buildSelectQuery( (yyvsp[-1].querySchema), (yyvsp[0].exprList) )))
+    if (!((yyval.querySchema) = buildSelectQuery(parser, (yyvsp[-1].querySchema), (yyvsp[0].exprList) )))
         YYABORT;
 }
-#line 1581 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1600 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 9:
-#line 707 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 723 "KDbSqlParser.y" /* yacc.c:1646  */
     {
-    if (!((yyval.querySchema) = buildSelectQuery( (yyvsp[-2].querySchema), (yyvsp[-1].exprList), (yyvsp[0].exprList) )))
+    if (!((yyval.querySchema) = buildSelectQuery(parser, (yyvsp[-2].querySchema), (yyvsp[-1].exprList), (yyvsp[0].exprList) )))
         YYABORT;
 }
-#line 1590 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1609 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 10:
-#line 712 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 728 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "Select ColViews Tables";
-    if (!((yyval.querySchema) = buildSelectQuery( (yyvsp[-1].querySchema), nullptr, (yyvsp[0].exprList) )))
+    if (!((yyval.querySchema) = buildSelectQuery(parser, (yyvsp[-1].querySchema), nullptr, (yyvsp[0].exprList) )))
         YYABORT;
 }
-#line 1600 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1619 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 11:
-#line 718 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 734 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "Select ColViews Conditions";
-    if (!((yyval.querySchema) = buildSelectQuery( (yyvsp[-2].querySchema), (yyvsp[-1].exprList), nullptr, (yyvsp[0].selectOptions) )))
+    if (!((yyval.querySchema) = buildSelectQuery(parser, (yyvsp[-2].querySchema), (yyvsp[-1].exprList), nullptr, (yyvsp[0].selectOptions) )))
         YYABORT;
 }
-#line 1610 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1629 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 12:
-#line 724 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 740 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "Select Tables SelectOptions";
-    if (!((yyval.querySchema) = buildSelectQuery( (yyvsp[-2].querySchema), nullptr, (yyvsp[-1].exprList), (yyvsp[0].selectOptions) )))
+    if (!((yyval.querySchema) = buildSelectQuery(parser, (yyvsp[-2].querySchema), nullptr, (yyvsp[-1].exprList), (yyvsp[0].selectOptions) )))
         YYABORT;
 }
-#line 1620 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1639 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 13:
-#line 730 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 746 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "Select ColViews Tables SelectOptions";
-    if (!((yyval.querySchema) = buildSelectQuery( (yyvsp[-3].querySchema), (yyvsp[-2].exprList), (yyvsp[-1].exprList), (yyvsp[0].selectOptions) )))
+    if (!((yyval.querySchema) = buildSelectQuery(parser, (yyvsp[-3].querySchema), (yyvsp[-2].exprList), (yyvsp[-1].exprList), (yyvsp[0].selectOptions) )))
         YYABORT;
 }
-#line 1630 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1649 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 14:
-#line 739 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 755 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "SELECT";
-    (yyval.querySchema) = KDbParserPrivate::get(globalParser)->createQuery();
+    (yyval.querySchema) = KDbParserPrivate::get(parser)->createQuery();
 }
-#line 1639 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1658 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 15:
-#line 747 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 763 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "WhereClause";
     (yyval.selectOptions) = new SelectOptionsInternal;
     (yyval.selectOptions)->whereExpr = *(yyvsp[0].expr);
     delete (yyvsp[0].expr);
 }
-#line 1650 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1669 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 16:
-#line 754 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 770 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "OrderByClause";
     (yyval.selectOptions) = new SelectOptionsInternal;
     (yyval.selectOptions)->orderByColumns = (yyvsp[0].orderByColumns);
 }
-#line 1660 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1679 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 17:
-#line 760 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 776 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "WhereClause ORDER BY OrderByClause";
     (yyval.selectOptions) = new SelectOptionsInternal;
@@ -1668,11 +1687,11 @@ yyreduce:
     delete (yyvsp[-3].expr);
     (yyval.selectOptions)->orderByColumns = (yyvsp[0].orderByColumns);
 }
-#line 1672 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1691 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 18:
-#line 768 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 784 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "OrderByClause WhereClause";
     (yyval.selectOptions) = new SelectOptionsInternal;
@@ -1680,19 +1699,19 @@ yyreduce:
     delete (yyvsp[0].expr);
     (yyval.selectOptions)->orderByColumns = (yyvsp[-1].orderByColumns);
 }
-#line 1684 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1703 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 19:
-#line 779 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 795 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = (yyvsp[0].expr);
 }
-#line 1692 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1711 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 20:
-#line 788 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 804 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "ORDER BY IDENTIFIER";
     (yyval.orderByColumns) = new QList<OrderByColumnInternal>;
@@ -1701,11 +1720,11 @@ yyreduce:
     (yyval.orderByColumns)->append( orderByColumn );
     delete (yyvsp[0].variantValue);
 }
-#line 1705 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1724 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 21:
-#line 797 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 813 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "ORDER BY IDENTIFIER OrderByOption";
     (yyval.orderByColumns) = new QList<OrderByColumnInternal>;
@@ -1715,11 +1734,11 @@ yyreduce:
     (yyval.orderByColumns)->append( orderByColumn );
     delete (yyvsp[-1].variantValue);
 }
-#line 1719 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1738 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 22:
-#line 807 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 823 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.orderByColumns) = (yyvsp[0].orderByColumns);
     OrderByColumnInternal orderByColumn;
@@ -1727,11 +1746,11 @@ yyreduce:
     (yyval.orderByColumns)->append( orderByColumn );
     delete (yyvsp[-2].variantValue);
 }
-#line 1731 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1750 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 23:
-#line 815 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 831 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.orderByColumns) = (yyvsp[0].orderByColumns);
     OrderByColumnInternal orderByColumn;
@@ -1740,208 +1759,208 @@ yyreduce:
     (yyval.orderByColumns)->append( orderByColumn );
     delete (yyvsp[-3].variantValue);
 }
-#line 1744 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1763 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 24:
-#line 827 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 843 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.variantValue) = new QVariant( *(yyvsp[0].stringValue) );
     sqlParserDebug() << "OrderByColumnId: " << *(yyval.variantValue);
     delete (yyvsp[0].stringValue);
 }
-#line 1754 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1773 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 25:
-#line 833 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 849 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.variantValue) = new QVariant( *(yyvsp[-2].stringValue) + QLatin1Char('.') + *(yyvsp[0].stringValue) );
     sqlParserDebug() << "OrderByColumnId: " << *(yyval.variantValue);
     delete (yyvsp[-2].stringValue);
     delete (yyvsp[0].stringValue);
 }
-#line 1765 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1784 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 26:
-#line 840 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 856 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.variantValue) = new QVariant((yyvsp[0].integerValue));
     sqlParserDebug() << "OrderByColumnId: " << *(yyval.variantValue);
 }
-#line 1774 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1793 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 27:
-#line 847 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 863 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.sortOrderValue) = KDbOrderByColumn::SortOrder::Ascending;
 }
-#line 1782 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1801 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 28:
-#line 851 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 867 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.sortOrderValue) = KDbOrderByColumn::SortOrder::Descending;
 }
-#line 1790 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1809 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 30:
-#line 863 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 879 "KDbSqlParser.y" /* yacc.c:1646  */
     {
 //    sqlParserDebug() << "AND " << $3.debugString();
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::AND, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1801 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1820 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 31:
-#line 870 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 886 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::OR, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1811 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1830 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 32:
-#line 876 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 892 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::XOR, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1821 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1840 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 34:
-#line 888 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 904 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), '>', *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1831 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1850 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 35:
-#line 894 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 910 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::GREATER_OR_EQUAL, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1841 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1860 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 36:
-#line 900 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 916 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), '<', *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1851 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1870 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 37:
-#line 906 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 922 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::LESS_OR_EQUAL, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1861 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1880 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 38:
-#line 912 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 928 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), '=', *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1871 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1890 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 40:
-#line 924 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 940 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::NOT_EQUAL, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1881 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1900 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 41:
-#line 930 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 946 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::NOT_EQUAL2, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1891 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1910 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 42:
-#line 936 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 952 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::LIKE, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1901 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1920 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 43:
-#line 942 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 958 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::NOT_LIKE, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1911 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1930 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 44:
-#line 948 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 964 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::SQL_IN, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1921 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1940 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 45:
-#line 954 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 970 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::SIMILAR_TO, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1931 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1950 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 46:
-#line 960 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 976 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::NOT_SIMILAR_TO, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1941 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1960 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 47:
-#line 966 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 982 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbNArgExpression(KDb::RelationalExpression, KDbToken::BETWEEN_AND);
     (yyval.expr)->toNArg().append( *(yyvsp[-4].expr) );
@@ -1951,11 +1970,11 @@ yyreduce:
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1955 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1974 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 48:
-#line 976 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 992 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbNArgExpression(KDb::RelationalExpression, KDbToken::NOT_BETWEEN_AND);
     (yyval.expr)->toNArg().append( *(yyvsp[-4].expr) );
@@ -1965,165 +1984,165 @@ yyreduce:
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1969 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1988 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 50:
-#line 992 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1008 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbUnaryExpression( KDbToken::SQL_IS_NULL, *(yyvsp[-1].expr) );
     delete (yyvsp[-1].expr);
 }
-#line 1978 "sqlparser.cpp" /* yacc.c:1646  */
+#line 1997 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 51:
-#line 997 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1013 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbUnaryExpression( KDbToken::SQL_IS_NOT_NULL, *(yyvsp[-1].expr) );
     delete (yyvsp[-1].expr);
 }
-#line 1987 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2006 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 53:
-#line 1008 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1024 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::BITWISE_SHIFT_LEFT, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 1997 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2016 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 54:
-#line 1014 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1030 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::BITWISE_SHIFT_RIGHT, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 2007 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2026 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 56:
-#line 1026 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1042 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), '+', *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 2017 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2036 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 57:
-#line 1032 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1048 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), KDbToken::CONCATENATION, *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 2027 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2046 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 58:
-#line 1038 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1054 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), '-', *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 2037 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2056 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 59:
-#line 1044 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1060 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), '&', *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 2047 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2066 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 60:
-#line 1050 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1066 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), '|', *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 2057 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2076 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 62:
-#line 1062 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1078 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), '/', *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 2067 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2086 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 63:
-#line 1068 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1084 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), '*', *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 2077 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2096 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 64:
-#line 1074 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1090 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(*(yyvsp[-2].expr), '%', *(yyvsp[0].expr));
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].expr);
 }
-#line 2087 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2106 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 66:
-#line 1087 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1103 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbUnaryExpression( '-', *(yyvsp[0].expr) );
     delete (yyvsp[0].expr);
 }
-#line 2096 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2115 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 67:
-#line 1092 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1108 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbUnaryExpression( '+', *(yyvsp[0].expr) );
     delete (yyvsp[0].expr);
 }
-#line 2105 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2124 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 68:
-#line 1097 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1113 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbUnaryExpression( '~', *(yyvsp[0].expr) );
     delete (yyvsp[0].expr);
 }
-#line 2114 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2133 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 69:
-#line 1102 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1118 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbUnaryExpression( KDbToken::NOT, *(yyvsp[0].expr) );
     delete (yyvsp[0].expr);
 }
-#line 2123 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2142 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 70:
-#line 1107 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1123 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbVariableExpression( *(yyvsp[0].stringValue) );
 
@@ -2131,80 +2150,80 @@ yyreduce:
     sqlParserDebug() << "  + identifier: " << *(yyvsp[0].stringValue);
     delete (yyvsp[0].stringValue);
 }
-#line 2135 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2154 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 71:
-#line 1115 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1131 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbQueryParameterExpression( *(yyvsp[0].stringValue) );
     sqlParserDebug() << "  + query parameter:" << *(yyval.expr);
     delete (yyvsp[0].stringValue);
 }
-#line 2145 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2164 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 72:
-#line 1121 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1137 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "  + function:" << *(yyvsp[-1].stringValue) << "(" << *(yyvsp[0].exprList) << ")";
     (yyval.expr) = new KDbFunctionExpression(*(yyvsp[-1].stringValue), *(yyvsp[0].exprList));
     delete (yyvsp[-1].stringValue);
     delete (yyvsp[0].exprList);
 }
-#line 2156 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2175 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 73:
-#line 1129 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1145 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbVariableExpression( *(yyvsp[-2].stringValue) + QLatin1Char('.') + *(yyvsp[0].stringValue) );
     sqlParserDebug() << "  + identifier.identifier:" << *(yyvsp[-2].stringValue) << "." << *(yyvsp[0].stringValue);
     delete (yyvsp[-2].stringValue);
     delete (yyvsp[0].stringValue);
 }
-#line 2167 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2186 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 74:
-#line 1136 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1152 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbConstExpression( KDbToken::SQL_NULL, QVariant() );
     sqlParserDebug() << "  + NULL";
 //    $$ = new KDbField();
     //$$->setName(QString::null);
 }
-#line 2178 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2197 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 75:
-#line 1143 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1159 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbConstExpression( KDbToken::SQL_TRUE, true );
 }
-#line 2186 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2205 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 76:
-#line 1147 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1163 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbConstExpression( KDbToken::SQL_FALSE, false );
 }
-#line 2194 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2213 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 77:
-#line 1151 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1167 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbConstExpression( KDbToken::CHARACTER_STRING_LITERAL, *(yyvsp[0].stringValue) );
     sqlParserDebug() << "  + constant " << (yyvsp[0].stringValue);
     delete (yyvsp[0].stringValue);
 }
-#line 2204 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2223 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 78:
-#line 1157 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1173 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     QVariant val;
     if ((yyvsp[0].integerValue) <= INT_MAX && (yyvsp[0].integerValue) >= INT_MIN)
@@ -2221,60 +2240,60 @@ yyreduce:
     (yyval.expr) = new KDbConstExpression( KDbToken::INTEGER_CONST, val );
     sqlParserDebug() << "  + int constant: " << val.toString();
 }
-#line 2225 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2244 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 79:
-#line 1174 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1190 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbConstExpression( KDbToken::REAL_CONST, *(yyvsp[0].binaryValue) );
     sqlParserDebug() << "  + real constant: " << *(yyvsp[0].binaryValue);
     delete (yyvsp[0].binaryValue);
 }
-#line 2235 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2254 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 80:
-#line 1180 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1196 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbConstExpression(KDbToken::DATE_CONST, QVariant::fromValue(*(yyvsp[0].dateValue)));
     sqlParserDebug() << "  + date constant:" << *(yyvsp[0].dateValue);
     delete (yyvsp[0].dateValue);
 }
-#line 2245 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2264 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 81:
-#line 1186 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1202 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbConstExpression(KDbToken::TIME_CONST, QVariant::fromValue(*(yyvsp[0].timeValue)));
     sqlParserDebug() << "  + time constant:" << *(yyvsp[0].timeValue);
     delete (yyvsp[0].timeValue);
 }
-#line 2255 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2274 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 82:
-#line 1192 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1208 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbConstExpression(KDbToken::DATETIME_CONST, QVariant::fromValue(*(yyvsp[0].dateTimeValue)));
     sqlParserDebug() << "  + datetime constant:" << *(yyvsp[0].dateTimeValue);
     delete (yyvsp[0].dateTimeValue);
 }
-#line 2265 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2284 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 84:
-#line 1203 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1219 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.dateValue) = (yyvsp[-1].dateValue);
     sqlParserDebug() << "DateConst:" << *(yyval.dateValue);
 }
-#line 2274 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2293 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 85:
-#line 1211 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1227 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.dateValue) = new KDbDate(*(yyvsp[-4].yearValue), *(yyvsp[-2].binaryValue), *(yyvsp[0].binaryValue));
     sqlParserDebug() << "DateValue:" << *(yyval.dateValue);
@@ -2282,11 +2301,11 @@ yyreduce:
     delete (yyvsp[-2].binaryValue);
     delete (yyvsp[0].binaryValue);
 }
-#line 2286 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2305 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 86:
-#line 1219 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1235 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.dateValue) = new KDbDate(*(yyvsp[0].yearValue), *(yyvsp[-4].binaryValue), *(yyvsp[-2].binaryValue));
     sqlParserDebug() << "DateValue:" << *(yyval.dateValue);
@@ -2294,50 +2313,50 @@ yyreduce:
     delete (yyvsp[-2].binaryValue);
     delete (yyvsp[0].yearValue);
 }
-#line 2298 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2317 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 87:
-#line 1230 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1246 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.yearValue) = new KDbYear(KDbYear::Sign::None, *(yyvsp[0].binaryValue));
     sqlParserDebug() << "YearConst:" << *(yyval.yearValue);
     delete (yyvsp[0].binaryValue);
 }
-#line 2308 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2327 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 88:
-#line 1236 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1252 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.yearValue) = new KDbYear(KDbYear::Sign::Plus, *(yyvsp[0].binaryValue));
     sqlParserDebug() << "YearConst:" << *(yyval.yearValue);
     delete (yyvsp[0].binaryValue);
 }
-#line 2318 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2337 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 89:
-#line 1242 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1258 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.yearValue) = new KDbYear(KDbYear::Sign::Minus, *(yyvsp[0].binaryValue));
     sqlParserDebug() << "YearConst:" << *(yyval.yearValue);
     delete (yyvsp[0].binaryValue);
 }
-#line 2328 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2347 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 90:
-#line 1251 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1267 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.timeValue) = (yyvsp[-1].timeValue);
     sqlParserDebug() << "TimeConst:" << *(yyval.timeValue);
 }
-#line 2337 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2356 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 91:
-#line 1259 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1275 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.timeValue) = new KDbTime(*(yyvsp[-4].binaryValue), *(yyvsp[-2].binaryValue), {}, *(yyvsp[-1].binaryValue), (yyvsp[0].timePeriodValue));
     sqlParserDebug() << "TimeValue:" << *(yyval.timeValue);
@@ -2345,11 +2364,11 @@ yyreduce:
     delete (yyvsp[-2].binaryValue);
     delete (yyvsp[-1].binaryValue);
 }
-#line 2349 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2368 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 92:
-#line 1267 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1283 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.timeValue) = new KDbTime(*(yyvsp[-6].binaryValue), *(yyvsp[-4].binaryValue), *(yyvsp[-2].binaryValue), *(yyvsp[-1].binaryValue), (yyvsp[0].timePeriodValue));
     sqlParserDebug() << "TimeValue:" << *(yyval.timeValue);
@@ -2358,143 +2377,143 @@ yyreduce:
     delete (yyvsp[-2].binaryValue);
     delete (yyvsp[-1].binaryValue);
 }
-#line 2362 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2381 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 93:
-#line 1279 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1295 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.binaryValue) = (yyvsp[0].binaryValue);
 }
-#line 2370 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2389 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 94:
-#line 1283 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1299 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.binaryValue) = new QByteArray;
 }
-#line 2378 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2397 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 95:
-#line 1290 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1306 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.timePeriodValue) = KDbTime::Period::Am;
 }
-#line 2386 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2405 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 96:
-#line 1294 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1310 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.timePeriodValue) = KDbTime::Period::Pm;
 }
-#line 2394 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2413 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 97:
-#line 1298 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1314 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.timePeriodValue) = KDbTime::Period::None;
 }
-#line 2402 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2421 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 98:
-#line 1305 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1321 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.dateTimeValue) = new KDbDateTime(*(yyvsp[-3].dateValue), *(yyvsp[-1].timeValue));
     sqlParserDebug() << "DateTimeConst:" << *(yyval.dateTimeValue);
     delete (yyvsp[-3].dateValue);
     delete (yyvsp[-1].timeValue);
 }
-#line 2413 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2432 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 99:
-#line 1315 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1331 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "(expr)";
     (yyval.expr) = new KDbUnaryExpression('(', *(yyvsp[-1].expr));
     delete (yyvsp[-1].expr);
 }
-#line 2423 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2442 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 100:
-#line 1324 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1340 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.exprList) = (yyvsp[-1].exprList);
 }
-#line 2431 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2450 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 101:
-#line 1328 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1344 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.exprList) = new KDbNArgExpression(KDb::ArgumentListExpression, ',');
 }
-#line 2439 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2458 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 102:
-#line 1335 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1351 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.exprList) = (yyvsp[0].exprList);
     (yyval.exprList)->prepend( *(yyvsp[-2].expr) );
     delete (yyvsp[-2].expr);
 }
-#line 2449 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2468 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 103:
-#line 1341 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1357 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.exprList) = new KDbNArgExpression(KDb::ArgumentListExpression, ',');
     (yyval.exprList)->append( *(yyvsp[0].expr) );
     delete (yyvsp[0].expr);
 }
-#line 2459 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2478 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 104:
-#line 1350 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1366 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.exprList) = (yyvsp[0].exprList);
 }
-#line 2467 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2486 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 105:
-#line 1395 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1411 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.exprList) = (yyvsp[-2].exprList);
     (yyval.exprList)->append(*(yyvsp[0].expr));
     delete (yyvsp[0].expr);
 }
-#line 2477 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2496 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 106:
-#line 1401 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1417 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.exprList) = new KDbNArgExpression(KDb::TableListExpression, KDbToken::IDENTIFIER); //ok?
     (yyval.exprList)->append(*(yyvsp[0].expr));
     delete (yyvsp[0].expr);
 }
-#line 2487 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2506 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 107:
-#line 1410 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1426 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     sqlParserDebug() << "FROM: '" << *(yyvsp[0].stringValue) << "'";
     (yyval.expr) = new KDbVariableExpression(*(yyvsp[0].stringValue));
 
     //! @todo this isn't ok for more tables:
     /*
-    KDbField::ListIterator it = globalParser->query()->fieldsIterator();
+    KDbField::ListIterator it = parser->query()->fieldsIterator();
     for(KDbField *item; (item = it.current()); ++it)
     {
         if(item->table() == dummy)
@@ -2508,18 +2527,18 @@ yyreduce:
             if(!f)
             {
                 KDbParserError err(KDbParser::tr("Field List Error"), KDbParser::tr("Unknown column '%1' in table '%2'",item->name(),schema->name()), ctoken, current);
-                globalParser->setError(err);
-                yyerror("fieldlisterror");
+                parser->setError(err);
+                yyerror(parser, "fieldlisterror");
             }
         }
     }*/
     delete (yyvsp[0].stringValue);
 }
-#line 2519 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2538 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 108:
-#line 1438 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1454 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     //table + alias
     (yyval.expr) = new KDbBinaryExpression(
@@ -2529,11 +2548,11 @@ yyreduce:
     delete (yyvsp[-1].stringValue);
     delete (yyvsp[0].stringValue);
 }
-#line 2533 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2552 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 109:
-#line 1448 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1464 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     //table + alias
     (yyval.expr) = new KDbBinaryExpression(
@@ -2543,55 +2562,55 @@ yyreduce:
     delete (yyvsp[-2].stringValue);
     delete (yyvsp[0].stringValue);
 }
-#line 2547 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2566 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 110:
-#line 1463 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1479 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.exprList) = (yyvsp[-2].exprList);
     (yyval.exprList)->append(*(yyvsp[0].expr));
     delete (yyvsp[0].expr);
     sqlParserDebug() << "ColViews: ColViews , ColItem";
 }
-#line 2558 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2577 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 111:
-#line 1470 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1486 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.exprList) = new KDbNArgExpression(KDb::FieldListExpression, KDbToken());
     (yyval.exprList)->append(*(yyvsp[0].expr));
     delete (yyvsp[0].expr);
     sqlParserDebug() << "ColViews: ColItem";
 }
-#line 2569 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2588 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 112:
-#line 1480 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1496 "KDbSqlParser.y" /* yacc.c:1646  */
     {
 //    $$ = new KDbField();
 //    dummy->addField($$);
 //    $$->setExpression( $1 );
-//    globalParser->query()->addField($$);
+//    parser->query()->addField($$);
     (yyval.expr) = (yyvsp[0].expr);
     sqlParserDebug() << " added column expr:" << *(yyvsp[0].expr);
 }
-#line 2582 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2601 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 113:
-#line 1489 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1505 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = (yyvsp[0].expr);
     sqlParserDebug() << " added column wildcard:" << *(yyvsp[0].expr);
 }
-#line 2591 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2610 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 114:
-#line 1494 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1510 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(
         *(yyvsp[-2].expr), KDbToken::AS,
@@ -2601,11 +2620,11 @@ yyreduce:
     delete (yyvsp[-2].expr);
     delete (yyvsp[0].stringValue);
 }
-#line 2605 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2624 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 115:
-#line 1504 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1520 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbBinaryExpression(
         *(yyvsp[-1].expr), KDbToken::AS_EMPTY,
@@ -2615,42 +2634,42 @@ yyreduce:
     delete (yyvsp[-1].expr);
     delete (yyvsp[0].stringValue);
 }
-#line 2619 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2638 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 116:
-#line 1517 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1533 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = (yyvsp[0].expr);
 }
-#line 2627 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2646 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 117:
-#line 1563 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1579 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = (yyvsp[-1].expr);
 //! @todo DISTINCT '(' ColExpression ')'
 //    $$->setName("DISTINCT(" + $3->name() + ")");
 }
-#line 2637 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2656 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 118:
-#line 1572 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1588 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     (yyval.expr) = new KDbVariableExpression(QLatin1String("*"));
     sqlParserDebug() << "all columns";
 
-//    KDbQueryAsterisk *ast = new KDbQueryAsterisk(globalParser->query(), dummy);
-//    globalParser->query()->addAsterisk(ast);
+//    KDbQueryAsterisk *ast = new KDbQueryAsterisk(parser->query(), dummy);
+//    parser->query()->addAsterisk(ast);
 //    requiresTable = true;
 }
-#line 2650 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2669 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
   case 119:
-#line 1581 "KDbSqlParser.y" /* yacc.c:1646  */
+#line 1597 "KDbSqlParser.y" /* yacc.c:1646  */
     {
     QString s( *(yyvsp[-2].stringValue) );
     s += QLatin1String(".*");
@@ -2658,11 +2677,11 @@ yyreduce:
     sqlParserDebug() << "  + all columns from " << s;
     delete (yyvsp[-2].stringValue);
 }
-#line 2662 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2681 "sqlparser.cpp" /* yacc.c:1646  */
     break;
 
 
-#line 2666 "sqlparser.cpp" /* yacc.c:1646  */
+#line 2685 "sqlparser.cpp" /* yacc.c:1646  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2712,7 +2731,7 @@ yyerrlab:
     {
       ++yynerrs;
 #if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
+      yyerror (parser, scanner, YY_("syntax error"));
 #else
 # define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
                                         yyssp, yytoken)
@@ -2739,7 +2758,7 @@ yyerrlab:
                 yymsgp = yymsg;
               }
           }
-        yyerror (yymsgp);
+        yyerror (parser, scanner, yymsgp);
         if (yysyntax_error_status == 2)
           goto yyexhaustedlab;
       }
@@ -2763,7 +2782,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, parser, scanner);
           yychar = YYEMPTY;
         }
     }
@@ -2819,7 +2838,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  yystos[yystate], yyvsp, parser, scanner);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2856,7 +2875,7 @@ yyabortlab:
 | yyexhaustedlab -- memory exhaustion comes here.  |
 `-------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (parser, scanner, YY_("memory exhausted"));
   yyresult = 2;
   /* Fall through.  */
 #endif
@@ -2868,7 +2887,7 @@ yyreturn:
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, parser, scanner);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2877,7 +2896,7 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
+                  yystos[*yyssp], yyvsp, parser, scanner);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
@@ -2890,7 +2909,7 @@ yyreturn:
 #endif
   return yyresult;
 }
-#line 1596 "KDbSqlParser.y" /* yacc.c:1906  */
+#line 1612 "KDbSqlParser.y" /* yacc.c:1906  */
 
 
 KDB_TESTING_EXPORT const char* g_tokenName(unsigned int offset) {
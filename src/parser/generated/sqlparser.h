@@ -10,9 +10,15 @@
 #include "KDbField.h"
 #include "KDbOrderByColumn.h"
 
+class KDbParser;
 struct OrderByColumnInternal;
 struct SelectOptionsInternal;
 
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
 /* A Bison parser, made by GNU Bison 3.0.4.  */
 
 /* Bison interface for Yacc-like parsers in C
@@ -135,7 +141,7 @@ extern int yydebug;
 
 union YYSTYPE
 {
-#line 505 "KDbSqlParser.y" /* yacc.c:1909  */
+#line 517 "KDbSqlParser.y" /* yacc.c:1909  */
 
     QString* stringValue;
     QByteArray* binaryValue;
@@ -166,9 +172,8 @@ typedef union YYSTYPE YYSTYPE;
 #endif
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
+int yyparse (KDbParser *parser, yyscan_t scanner);
 
 #endif /* !YY_YY_KDBSQLPARSER_TAB_H_INCLUDED  */
 #endif
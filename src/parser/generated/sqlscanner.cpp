@@ -119,24 +119,41 @@ typedef unsigned int flex_uint32_t;
  */
 #define YY_SC_TO_UI(c) ((unsigned int) (unsigned char) c)
 
+/* An opaque pointer. */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+/* For convenience, these vars (plus the bison vars far below)
+   are macros in the reentrant scanner. */
+#define yyin yyg->yyin_r
+#define yyout yyg->yyout_r
+#define yyextra yyg->yyextra_r
+#define yyleng yyg->yyleng_r
+#define yytext yyg->yytext_r
+#define yylineno (YY_CURRENT_BUFFER_LVALUE->yy_bs_lineno)
+#define yycolumn (YY_CURRENT_BUFFER_LVALUE->yy_bs_column)
+#define yy_flex_debug yyg->yy_flex_debug_r
+
 /* Enter a start condition.  This macro really ought to take a parameter,
  * but we do it the disgusting crufty way forced on us by the ()-less
  * definition of BEGIN.
  */
-#define BEGIN (yy_start) = 1 + 2 *
+#define BEGIN yyg->yy_start = 1 + 2 *
 
 /* Translate the current start state into a value that can be later handed
  * to BEGIN to return to the state.  The YYSTATE alias is for lex
  * compatibility.
  */
-#define YY_START (((yy_start) - 1) / 2)
+#define YY_START ((yyg->yy_start - 1) / 2)
 #define YYSTATE YY_START
 
 /* Action number for EOF rule of a given start state. */
 #define YY_STATE_EOF(state) (YY_END_OF_BUFFER + state + 1)
 
 /* Special action meaning "start processing a new file". */
-#define YY_NEW_FILE yyrestart(yyin  )
+#define YY_NEW_FILE yyrestart(yyin ,yyscanner )
 
 #define YY_END_OF_BUFFER_CHAR 0
 
@@ -159,10 +176,6 @@ typedef struct yy_buffer_state *YY_BUFFER_STATE;
 typedef size_t yy_size_t;
 #endif
 
-extern yy_size_t yyleng;
-
-extern FILE *yyin, *yyout;
-
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
 #define EOB_ACT_LAST_MATCH 2
@@ -176,14 +189,14 @@ extern FILE *yyin, *yyout;
         /* Undo effects of setting up yytext. */ \
         int yyless_macro_arg = (n); \
         YY_LESS_LINENO(yyless_macro_arg);\
-        *yy_cp = (yy_hold_char); \
+        *yy_cp = yyg->yy_hold_char; \
         YY_RESTORE_YY_MORE_OFFSET \
-        (yy_c_buf_p) = yy_cp = yy_bp + yyless_macro_arg - YY_MORE_ADJ; \
+        yyg->yy_c_buf_p = yy_cp = yy_bp + yyless_macro_arg - YY_MORE_ADJ; \
         YY_DO_BEFORE_ACTION; /* set up yytext again */ \
         } \
     while ( 0 )
 
-#define unput(c) yyunput( c, (yytext_ptr)  )
+#define unput(c) yyunput( c, yyg->yytext_ptr , yyscanner )
 
 #ifndef YY_STRUCT_YY_BUFFER_STATE
 #define YY_STRUCT_YY_BUFFER_STATE
@@ -250,71 +263,51 @@ struct yy_buffer_state
     };
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
-/* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
-
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
  * "scanner state".
  *
  * Returns the top of the stack, or NULL.
  */
-#define YY_CURRENT_BUFFER ( (yy_buffer_stack) \
-                          ? (yy_buffer_stack)[(yy_buffer_stack_top)] \
+#define YY_CURRENT_BUFFER ( yyg->yy_buffer_stack \
+                          ? yyg->yy_buffer_stack[yyg->yy_buffer_stack_top] \
                           : NULL)
 
 /* Same as previous macro, but useful when we know that the buffer stack is not
  * NULL or when we need an lvalue. For internal use only.
  */
-#define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
+#define YY_CURRENT_BUFFER_LVALUE yyg->yy_buffer_stack[yyg->yy_buffer_stack_top]
 
-/* yy_hold_char holds the character lost when yytext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-yy_size_t yyleng;
+void yyrestart (FILE *input_file ,yyscan_t yyscanner );
+void yy_switch_to_buffer (YY_BUFFER_STATE new_buffer ,yyscan_t yyscanner );
+YY_BUFFER_STATE yy_create_buffer (FILE *file,int size ,yyscan_t yyscanner );
+void yy_delete_buffer (YY_BUFFER_STATE b ,yyscan_t yyscanner );
+void yy_flush_buffer (YY_BUFFER_STATE b ,yyscan_t yyscanner );
+void yypush_buffer_state (YY_BUFFER_STATE new_buffer ,yyscan_t yyscanner );
+void yypop_buffer_state (yyscan_t yyscanner );
 
-/* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static void yyensure_buffer_stack (yyscan_t yyscanner );
+static void yy_load_buffer_state (yyscan_t yyscanner );
+static void yy_init_buffer (YY_BUFFER_STATE b,FILE *file ,yyscan_t yyscanner );
 
-/* Flag which is used to allow yywrap()'s to do buffer switches
- * instead of setting up a fresh yyin.  A bit of a hack ...
- */
-static int yy_did_buffer_switch_on_eof;
+#define YY_FLUSH_BUFFER yy_flush_buffer(YY_CURRENT_BUFFER ,yyscanner)
 
-void yyrestart (FILE *input_file  );
-void yy_switch_to_buffer (YY_BUFFER_STATE new_buffer  );
-YY_BUFFER_STATE yy_create_buffer (FILE *file,int size  );
-void yy_delete_buffer (YY_BUFFER_STATE b  );
-void yy_flush_buffer (YY_BUFFER_STATE b  );
-void yypush_buffer_state (YY_BUFFER_STATE new_buffer  );
-void yypop_buffer_state (void );
+YY_BUFFER_STATE yy_scan_buffer (char *base,yy_size_t size ,yyscan_t yyscanner );
+YY_BUFFER_STATE yy_scan_string (yyconst char *yy_str ,yyscan_t yyscanner );
+YY_BUFFER_STATE yy_scan_bytes (yyconst char *bytes,yy_size_t len ,yyscan_t yyscanner );
 
-static void yyensure_buffer_stack (void );
-static void yy_load_buffer_state (void );
-static void yy_init_buffer (YY_BUFFER_STATE b,FILE *file  );
-
-#define YY_FLUSH_BUFFER yy_flush_buffer(YY_CURRENT_BUFFER )
-
-YY_BUFFER_STATE yy_scan_buffer (char *base,yy_size_t size  );
-YY_BUFFER_STATE yy_scan_string (yyconst char *yy_str  );
-YY_BUFFER_STATE yy_scan_bytes (yyconst char *bytes,yy_size_t len  );
-
-void *yyalloc (yy_size_t  );
-void *yyrealloc (void *,yy_size_t  );
-void yyfree (void *  );
+void *yyalloc (yy_size_t ,yyscan_t yyscanner );
+void *yyrealloc (void *,yy_size_t ,yyscan_t yyscanner );
+void yyfree (void * ,yyscan_t yyscanner );
 
 #define yy_new_buffer yy_create_buffer
 
 #define yy_set_interactive(is_interactive) \
     { \
     if ( ! YY_CURRENT_BUFFER ){ \
-        yyensure_buffer_stack (); \
+        yyensure_buffer_stack (yyscanner); \
         YY_CURRENT_BUFFER_LVALUE =    \
-            yy_create_buffer(yyin,YY_BUF_SIZE ); \
+            yy_create_buffer(yyin,YY_BUF_SIZE ,yyscanner); \
     } \
     YY_CURRENT_BUFFER_LVALUE->yy_is_interactive = is_interactive; \
     }
@@ -322,9 +315,9 @@ void yyfree (void *  );
 #define yy_set_bol(at_bol) \
     { \
     if ( ! YY_CURRENT_BUFFER ){\
-        yyensure_buffer_stack (); \
+        yyensure_buffer_stack (yyscanner); \
         YY_CURRENT_BUFFER_LVALUE =    \
-            yy_create_buffer(yyin,YY_BUF_SIZE ); \
+            yy_create_buffer(yyin,YY_BUF_SIZE ,yyscanner); \
     } \
     YY_CURRENT_BUFFER_LVALUE->yy_at_bol = at_bol; \
     }
@@ -333,36 +326,29 @@ void yyfree (void *  );
 
 /* Begin user sect3 */
 
-#define yywrap() 1
+#define yywrap(yyscanner) 1
 #define YY_SKIP_YYWRAP
 
 typedef unsigned char YY_CHAR;
 
-FILE *yyin = (FILE *) 0, *yyout = (FILE *) 0;
-
 typedef int yy_state_type;
 
-extern int yylineno;
-
-int yylineno = 1;
-
-extern char *yytext;
-#define yytext_ptr yytext
+#define yytext_ptr yytext_r
 
-static yy_state_type yy_get_previous_state (void );
-static yy_state_type yy_try_NUL_trans (yy_state_type current_state  );
-static int yy_get_next_buffer (void );
-static void yy_fatal_error (yyconst char msg[]  );
+static yy_state_type yy_get_previous_state (yyscan_t yyscanner );
+static yy_state_type yy_try_NUL_trans (yy_state_type current_state  ,yyscan_t yyscanner);
+static int yy_get_next_buffer (yyscan_t yyscanner );
+static void yy_fatal_error (yyconst char msg[] ,yyscan_t yyscanner );
 
 /* Done after the current pattern has been matched and before the
  * corresponding action - sets up yytext.
  */
 #define YY_DO_BEFORE_ACTION \
-    (yytext_ptr) = yy_bp; \
+    yyg->yytext_ptr = yy_bp; \
     yyleng = (size_t) (yy_cp - yy_bp); \
-    (yy_hold_char) = *yy_cp; \
+    yyg->yy_hold_char = *yy_cp; \
     *yy_cp = '\0'; \
-    (yy_c_buf_p) = yy_cp;
+    yyg->yy_c_buf_p = yy_cp;
 
 #define YY_NUM_RULES 57
 #define YY_END_OF_BUFFER 58
@@ -630,12 +616,6 @@ static yyconst flex_int16_t yy_chk[583] =
       194,  194
     } ;
 
-static yy_state_type yy_last_accepting_state;
-static char *yy_last_accepting_cpos;
-
-extern int yy_flex_debug;
-int yy_flex_debug = 0;
-
 /* The intent behind this definition is that it'll catch
  * any uses of REJECT which flex missed.
  */
@@ -643,7 +623,6 @@ int yy_flex_debug = 0;
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *yytext;
 #line 1 "KDbSqlScanner.l"
 /* This file is part of the KDE project
    Copyright (C) 2004 Lucijan Busch <lucijan@kde.org>
@@ -669,23 +648,20 @@ char *yytext;
 #include "KDb.h"
 #include "KDbExpression.h"
 #include "KDbParser.h"
+#include "KDbParser_p.h"
 #include "KDbSqlTypes.h"
 #include "kdb_debug.h"
 
-extern int globalCurrentPos;
-extern QByteArray globalToken;
-
 #define YY_NO_UNPUT
-#define ECOUNT globalCurrentPos += yyleng; globalToken = yytext
-
-extern void setError(const QString& errDesc);
-extern void setError(const QString& errName, const QString& errDesc);
+#define ECOUNT \
+    KDbParserPrivate::get(parser)->currentPos += yyleng; \
+    KDbParserPrivate::get(parser)->token = yytext
 
 /* Only quotes the input if it does not start with a quote character, otherwise
  it would be too hard to read with some fonts. */
 static QString maybeQuote(const QString& string)
 {
-    QString first(string.at(0));
+    QString first(string.left(1));
     if (first == QLatin1Char('\'') || first == QLatin1Char('"') || first == QLatin1Char('`')) {
         return string;
     }
@@ -695,7 +671,7 @@ static QString maybeQuote(const QString& string)
 
 /*identifier       [a-zA-Z_][a-zA-Z_0-9]* */
 /* quoted_identifier (\"[a-zA-Z_0-9]+\") */
-#line 699 "generated/sqlscanner.cpp"
+#line 675 "generated/sqlscanner.cpp"
 
 #define INITIAL 0
 #define DATE_OR_TIME 1
@@ -708,40 +684,90 @@ static QString maybeQuote(const QString& string)
 #include <unistd.h>
 #endif
 
-#ifndef YY_EXTRA_TYPE
-#define YY_EXTRA_TYPE void *
-#endif
+#define YY_EXTRA_TYPE KDbParser *
+
+/* Holds the entire state of the reentrant scanner. */
+struct yyguts_t
+    {
+
+    /* User-defined. Not touched by flex. */
+    YY_EXTRA_TYPE yyextra_r;
+
+    /* The rest are the same as the globals declared in the non-reentrant scanner. */
+    FILE *yyin_r, *yyout_r;
+    size_t yy_buffer_stack_top; /**< index of top of stack. */
+    size_t yy_buffer_stack_max; /**< capacity of stack. */
+    YY_BUFFER_STATE * yy_buffer_stack; /**< Stack as an array. */
+    char yy_hold_char;
+    int yy_n_chars;
+    yy_size_t yyleng_r;
+    char *yy_c_buf_p;
+    int yy_init;
+    int yy_start;
+    int yy_did_buffer_switch_on_eof;
+    int yy_start_stack_ptr;
+    int yy_start_stack_depth;
+    int *yy_start_stack;
+    yy_state_type yy_last_accepting_state;
+    char* yy_last_accepting_cpos;
+
+    int yylineno_r;
+    int yy_flex_debug_r;
+
+    char *yytext_r;
+    int yy_more_flag;
+    int yy_more_len;
+
+    YYSTYPE * yylval_r;
 
-static int yy_init_globals (void );
+    }; /* end struct yyguts_t */
+
+static int yy_init_globals (yyscan_t yyscanner );
+
+    /* This must go here because YYSTYPE and YYLTYPE are included
+     * from bison output in section 1.*/
+    #    define yylval yyg->yylval_r
+
+int yylex_init (yyscan_t* scanner);
+
+int yylex_init_extra (YY_EXTRA_TYPE user_defined,yyscan_t* scanner);
 
 /* Accessor methods to globals.
    These are made visible to non-reentrant scanners for convenience. */
 
-int yylex_destroy (void );
+int yylex_destroy (yyscan_t yyscanner );
+
+int yyget_debug (yyscan_t yyscanner );
+
+void yyset_debug (int debug_flag ,yyscan_t yyscanner );
+
+YY_EXTRA_TYPE yyget_extra (yyscan_t yyscanner );
 
-int yyget_debug (void );
+void yyset_extra (YY_EXTRA_TYPE user_defined ,yyscan_t yyscanner );
 
-void yyset_debug (int debug_flag  );
+FILE *yyget_in (yyscan_t yyscanner );
 
-YY_EXTRA_TYPE yyget_extra (void );
+void yyset_in  (FILE * in_str ,yyscan_t yyscanner );
 
-void yyset_extra (YY_EXTRA_TYPE user_defined  );
+FILE *yyget_out (yyscan_t yyscanner );
 
-FILE *yyget_in (void );
+void yyset_out  (FILE * out_str ,yyscan_t yyscanner );
 
-void yyset_in  (FILE * in_str  );
+yy_size_t yyget_leng (yyscan_t yyscanner );
 
-FILE *yyget_out (void );
+char *yyget_text (yyscan_t yyscanner );
 
-void yyset_out  (FILE * out_str  );
+int yyget_lineno (yyscan_t yyscanner );
 
-yy_size_t yyget_leng (void );
+void yyset_lineno (int line_number ,yyscan_t yyscanner );
 
-char *yyget_text (void );
+int yyget_column  (yyscan_t yyscanner );
 
-int yyget_lineno (void );
+void yyset_column (int column_no ,yyscan_t yyscanner );
 
-void yyset_lineno (int line_number  );
+YYSTYPE * yyget_lval (yyscan_t yyscanner );
+
+void yyset_lval (YYSTYPE * yylval_param ,yyscan_t yyscanner );
 
 /* Macros after this point can all be overridden by user definitions in
  * section 1.
@@ -749,28 +775,28 @@ void yyset_lineno (int line_number  );
 
 #ifndef YY_SKIP_YYWRAP
 #ifdef __cplusplus
-extern "C" int yywrap (void );
+extern "C" int yywrap (yyscan_t yyscanner );
 #else
-extern int yywrap (void );
+extern int yywrap (yyscan_t yyscanner );
 #endif
 #endif
 
-    static void yyunput (int c,char *buf_ptr  );
+    static void yyunput (int c,char *buf_ptr  ,yyscan_t yyscanner);
 
 #ifndef yytext_ptr
-static void yy_flex_strncpy (char *,yyconst char *,int );
+static void yy_flex_strncpy (char *,yyconst char *,int ,yyscan_t yyscanner);
 #endif
 
 #ifdef YY_NEED_STRLEN
-static int yy_flex_strlen (yyconst char * );
+static int yy_flex_strlen (yyconst char * ,yyscan_t yyscanner);
 #endif
 
 #ifndef YY_NO_INPUT
 
 #ifdef __cplusplus
-static int yyinput (void );
+static int yyinput (yyscan_t yyscanner );
 #else
-static int input (void );
+static int input (yyscan_t yyscanner );
 #endif
 
 #endif
@@ -839,7 +865,7 @@ static int input (void );
 
 /* Report a fatal error. */
 #ifndef YY_FATAL_ERROR
-#define YY_FATAL_ERROR(msg) yy_fatal_error( msg )
+#define YY_FATAL_ERROR(msg) yy_fatal_error( msg , yyscanner)
 #endif
 
 /* end tables serialization structures and prototypes */
@@ -850,9 +876,11 @@ static int input (void );
 #ifndef YY_DECL
 #define YY_DECL_IS_OURS 1
 
-extern int yylex (void);
+extern int yylex \
+               (YYSTYPE * yylval_param ,yyscan_t yyscanner);
 
-#define YY_DECL int yylex (void)
+#define YY_DECL int yylex \
+               (YYSTYPE * yylval_param , yyscan_t yyscanner)
 #endif /* !YY_DECL */
 
 /* Code executed at the beginning of each rule, after yytext and yyleng
@@ -877,24 +905,28 @@ YY_DECL
     yy_state_type yy_current_state;
     char *yy_cp, *yy_bp;
     int yy_act;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
 #line 73 "KDbSqlScanner.l"
 
 
+    KDbParser * const parser = yyextra;
     int DATE_OR_TIME_caller = 0;
 
-#line 887 "generated/sqlscanner.cpp"
+#line 917 "generated/sqlscanner.cpp"
+
+    yylval = yylval_param;
 
-    if ( !(yy_init) )
+    if ( !yyg->yy_init )
         {
-        (yy_init) = 1;
+        yyg->yy_init = 1;
 
 #ifdef YY_USER_INIT
         YY_USER_INIT;
 #endif
 
-        if ( ! (yy_start) )
-            (yy_start) = 1;	/* first start state */
+        if ( ! yyg->yy_start )
+            yyg->yy_start = 1;	/* first start state */
 
         if ( ! yyin )
             yyin = stdin;
@@ -903,35 +935,35 @@ YY_DECL
             yyout = stdout;
 
         if ( ! YY_CURRENT_BUFFER ) {
-            yyensure_buffer_stack ();
+            yyensure_buffer_stack (yyscanner);
             YY_CURRENT_BUFFER_LVALUE =
-                yy_create_buffer(yyin,YY_BUF_SIZE );
+                yy_create_buffer(yyin,YY_BUF_SIZE ,yyscanner);
         }
 
-        yy_load_buffer_state( );
+        yy_load_buffer_state(yyscanner );
         }
 
     while ( 1 )		/* loops until end-of-file is reached */
         {
-        yy_cp = (yy_c_buf_p);
+        yy_cp = yyg->yy_c_buf_p;
 
         /* Support of yytext. */
-        *yy_cp = (yy_hold_char);
+        *yy_cp = yyg->yy_hold_char;
 
         /* yy_bp points to the position in yy_ch_buf of the start of
          * the current run.
          */
         yy_bp = yy_cp;
 
-        yy_current_state = (yy_start);
+        yy_current_state = yyg->yy_start;
 yy_match:
         do
             {
             YY_CHAR yy_c = yy_ec[YY_SC_TO_UI(*yy_cp)];
             if ( yy_accept[yy_current_state] )
                 {
-                (yy_last_accepting_state) = yy_current_state;
-                (yy_last_accepting_cpos) = yy_cp;
+                yyg->yy_last_accepting_state = yy_current_state;
+                yyg->yy_last_accepting_cpos = yy_cp;
                 }
             while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
                 {
@@ -943,8 +975,8 @@ yy_match:
             ++yy_cp;
             }
         while ( yy_current_state != 194 );
-        yy_cp = (yy_last_accepting_cpos);
-        yy_current_state = (yy_last_accepting_state);
+        yy_cp = yyg->yy_last_accepting_cpos;
+        yy_current_state = yyg->yy_last_accepting_state;
 
 yy_find_action:
         yy_act = yy_accept[yy_current_state];
@@ -957,14 +989,14 @@ do_action:	/* This label is used only to access EOF actions. */
     { /* beginning of action switch */
             case 0: /* must back up */
             /* undo the effects of YY_DO_BEFORE_ACTION */
-            *yy_cp = (yy_hold_char);
-            yy_cp = (yy_last_accepting_cpos);
-            yy_current_state = (yy_last_accepting_state);
+            *yy_cp = yyg->yy_hold_char;
+            yy_cp = yyg->yy_last_accepting_cpos;
+            yy_current_state = yyg->yy_last_accepting_state;
             goto yy_find_action;
 
 case 1:
 YY_RULE_SETUP
-#line 77 "KDbSqlScanner.l"
+#line 78 "KDbSqlScanner.l"
 {
     ECOUNT;
     return NOT_EQUAL;
@@ -972,7 +1004,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 82 "KDbSqlScanner.l"
+#line 83 "KDbSqlScanner.l"
 {
     ECOUNT;
     return NOT_EQUAL2;
@@ -980,7 +1012,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 87 "KDbSqlScanner.l"
+#line 88 "KDbSqlScanner.l"
 {
     ECOUNT;
     return '=';
@@ -988,7 +1020,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 92 "KDbSqlScanner.l"
+#line 93 "KDbSqlScanner.l"
 {
     ECOUNT;
     return LESS_OR_EQUAL;
@@ -996,7 +1028,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 97 "KDbSqlScanner.l"
+#line 98 "KDbSqlScanner.l"
 {
     ECOUNT;
     return GREATER_OR_EQUAL;
@@ -1004,7 +1036,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 102 "KDbSqlScanner.l"
+#line 103 "KDbSqlScanner.l"
 {
     ECOUNT;
     return SQL_IN;
@@ -1012,15 +1044,15 @@ YY_RULE_SETUP
     YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 107 "KDbSqlScanner.l"
+#line 108 "KDbSqlScanner.l"
 {
 //! @todo what about hex or octal values?
     //we're using QString:toLongLong() here because atoll() is not so portable:
     ECOUNT;
     bool ok;
-    yylval.integerValue = QByteArray(yytext).toLongLong(&ok);
+    yylval->integerValue = QByteArray(yytext).toLongLong(&ok);
     if (!ok) {
-        setError(KDbParser::tr("Invalid integer number"), KDbParser::tr("This integer number may be too large."));
+        setError(parser, KDbParser::tr("Invalid integer number"), KDbParser::tr("This integer number may be too large."));
         return SCAN_ERROR;
     }
     return INTEGER_CONST;
@@ -1028,17 +1060,17 @@ YY_RULE_SETUP
     YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 120 "KDbSqlScanner.l"
+#line 121 "KDbSqlScanner.l"
 {
     ECOUNT;
-    yylval.binaryValue = new QByteArray(yytext, yyleng);
+    yylval->binaryValue = new QByteArray(yytext, yyleng);
     return REAL_CONST;
 }
     YY_BREAK
 /* --- DATE_OR_TIME --- */
 case 9:
 YY_RULE_SETUP
-#line 127 "KDbSqlScanner.l"
+#line 128 "KDbSqlScanner.l"
 {
     ECOUNT;
     sqlParserDebug() << "### begin DATE_OR_TIME" << yytext << "(" << yyleng << ")";
@@ -1050,7 +1082,7 @@ YY_RULE_SETUP
 
 case 10:
 YY_RULE_SETUP
-#line 137 "KDbSqlScanner.l"
+#line 138 "KDbSqlScanner.l"
 { // year prefix or / or - or : separator
     ECOUNT;
     return yytext[0];
@@ -1058,16 +1090,16 @@ YY_RULE_SETUP
     YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 142 "KDbSqlScanner.l"
+#line 143 "KDbSqlScanner.l"
 { // year, month, day, hour, minute or second
     ECOUNT;
-    yylval.binaryValue = new QByteArray(yytext, yyleng);
+    yylval->binaryValue = new QByteArray(yytext, yyleng);
     return DATE_TIME_INTEGER;
 }
     YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 148 "KDbSqlScanner.l"
+#line 149 "KDbSqlScanner.l"
 {
     ECOUNT;
     return TABS_OR_SPACES;
@@ -1075,7 +1107,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 153 "KDbSqlScanner.l"
+#line 154 "KDbSqlScanner.l"
 {
     ECOUNT;
     return TIME_AM;
@@ -1083,7 +1115,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 158 "KDbSqlScanner.l"
+#line 159 "KDbSqlScanner.l"
 {
     ECOUNT;
     return TIME_PM;
@@ -1091,7 +1123,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 163 "KDbSqlScanner.l"
+#line 164 "KDbSqlScanner.l"
 {
     ECOUNT;
     sqlParserDebug() << "### end DATE_OR_TIME" << yytext << "(" << yyleng << ")";
@@ -1101,12 +1133,12 @@ YY_RULE_SETUP
     YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 171 "KDbSqlScanner.l"
+#line 172 "KDbSqlScanner.l"
 { // fallback rule to avoid flex's default action that prints the character to stdout
     // without notifying the scanner.
     ECOUNT;
     const QString string(QString::fromUtf8(yytext, yyleng));
-    setError(KDbParser::tr("Unexpected character %1 in date/time").arg(maybeQuote(string)));
+    setError(parser, KDbParser::tr("Unexpected character %1 in date/time").arg(maybeQuote(string)));
     return SCAN_ERROR;
 }
     YY_BREAK
@@ -1114,7 +1146,7 @@ YY_RULE_SETUP
 /* -- end of DATE_OR_TIME --- */
 case 17:
 YY_RULE_SETUP
-#line 182 "KDbSqlScanner.l"
+#line 183 "KDbSqlScanner.l"
 {
     ECOUNT;
     return AND;
@@ -1122,7 +1154,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 187 "KDbSqlScanner.l"
+#line 188 "KDbSqlScanner.l"
 {
     ECOUNT;
     return AS;
@@ -1130,7 +1162,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 192 "KDbSqlScanner.l"
+#line 193 "KDbSqlScanner.l"
 {
     ECOUNT;
     return CREATE;
@@ -1138,7 +1170,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 197 "KDbSqlScanner.l"
+#line 198 "KDbSqlScanner.l"
 {
     ECOUNT;
     return FROM;
@@ -1146,7 +1178,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 202 "KDbSqlScanner.l"
+#line 203 "KDbSqlScanner.l"
 {
     ECOUNT;
     return SQL_TYPE;
@@ -1154,7 +1186,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 207 "KDbSqlScanner.l"
+#line 208 "KDbSqlScanner.l"
 {
     ECOUNT;
     return JOIN;
@@ -1162,7 +1194,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 212 "KDbSqlScanner.l"
+#line 213 "KDbSqlScanner.l"
 {
     ECOUNT;
     return LEFT;
@@ -1170,7 +1202,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 217 "KDbSqlScanner.l"
+#line 218 "KDbSqlScanner.l"
 {
     ECOUNT;
     return LIKE;
@@ -1179,7 +1211,7 @@ YY_RULE_SETUP
 case 25:
 /* rule 25 can match eol */
 YY_RULE_SETUP
-#line 222 "KDbSqlScanner.l"
+#line 223 "KDbSqlScanner.l"
 {
     ECOUNT;
     return NOT_LIKE;
@@ -1187,7 +1219,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 227 "KDbSqlScanner.l"
+#line 228 "KDbSqlScanner.l"
 {
     ECOUNT;
     return BETWEEN;
@@ -1196,7 +1228,7 @@ YY_RULE_SETUP
 case 27:
 /* rule 27 can match eol */
 YY_RULE_SETUP
-#line 232 "KDbSqlScanner.l"
+#line 233 "KDbSqlScanner.l"
 {
     ECOUNT;
     return NOT_BETWEEN;
@@ -1205,7 +1237,7 @@ YY_RULE_SETUP
 case 28:
 /* rule 28 can match eol */
 YY_RULE_SETUP
-#line 237 "KDbSqlScanner.l"
+#line 238 "KDbSqlScanner.l"
 {
     ECOUNT;
     return NOT_SIMILAR_TO;
@@ -1214,7 +1246,7 @@ YY_RULE_SETUP
 case 29:
 /* rule 29 can match eol */
 YY_RULE_SETUP
-#line 242 "KDbSqlScanner.l"
+#line 243 "KDbSqlScanner.l"
 {
     ECOUNT;
     return SIMILAR_TO;
@@ -1223,7 +1255,7 @@ YY_RULE_SETUP
 case 30:
 /* rule 30 can match eol */
 YY_RULE_SETUP
-#line 247 "KDbSqlScanner.l"
+#line 248 "KDbSqlScanner.l"
 {
     ECOUNT;
     return SQL_IS_NOT_NULL;
@@ -1232,7 +1264,7 @@ YY_RULE_SETUP
 case 31:
 /* rule 31 can match eol */
 YY_RULE_SETUP
-#line 252 "KDbSqlScanner.l"
+#line 253 "KDbSqlScanner.l"
 {
     ECOUNT;
     return SQL_IS_NULL;
@@ -1240,7 +1272,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 257 "KDbSqlScanner.l"
+#line 258 "KDbSqlScanner.l"
 {
     ECOUNT;
     return NOT;
@@ -1248,7 +1280,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 262 "KDbSqlScanner.l"
+#line 263 "KDbSqlScanner.l"
 {
     ECOUNT;
     return SQL_IS;
@@ -1256,7 +1288,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 267 "KDbSqlScanner.l"
+#line 268 "KDbSqlScanner.l"
 {
     ECOUNT;
     return SQL_NULL;
@@ -1264,7 +1296,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 272 "KDbSqlScanner.l"
+#line 273 "KDbSqlScanner.l"
 {
         ECOUNT;
         return SQL_TRUE;
@@ -1272,7 +1304,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 277 "KDbSqlScanner.l"
+#line 278 "KDbSqlScanner.l"
 {
         ECOUNT;
         return SQL_FALSE;
@@ -1280,7 +1312,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 37:
 YY_RULE_SETUP
-#line 282 "KDbSqlScanner.l"
+#line 283 "KDbSqlScanner.l"
 {
     ECOUNT;
     return SQL_ON;
@@ -1288,7 +1320,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 287 "KDbSqlScanner.l"
+#line 288 "KDbSqlScanner.l"
 {
     ECOUNT;
     return OR;
@@ -1296,7 +1328,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 292 "KDbSqlScanner.l"
+#line 293 "KDbSqlScanner.l"
 { /* also means OR for numbers (mysql) */
     ECOUNT;
     return CONCATENATION;
@@ -1304,7 +1336,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 297 "KDbSqlScanner.l"
+#line 298 "KDbSqlScanner.l"
 {
     ECOUNT;
     return BITWISE_SHIFT_LEFT;
@@ -1312,7 +1344,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 302 "KDbSqlScanner.l"
+#line 303 "KDbSqlScanner.l"
 {
     ECOUNT;
     return BITWISE_SHIFT_RIGHT;
@@ -1320,7 +1352,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 307 "KDbSqlScanner.l"
+#line 308 "KDbSqlScanner.l"
 {
     ECOUNT;
     return XOR;
@@ -1328,7 +1360,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 312 "KDbSqlScanner.l"
+#line 313 "KDbSqlScanner.l"
 {
     ECOUNT;
     return RIGHT;
@@ -1336,7 +1368,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 317 "KDbSqlScanner.l"
+#line 318 "KDbSqlScanner.l"
 {
     ECOUNT;
     return SELECT;
@@ -1344,7 +1376,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 322 "KDbSqlScanner.l"
+#line 323 "KDbSqlScanner.l"
 {
     ECOUNT;
     return TABLE;
@@ -1352,7 +1384,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 327 "KDbSqlScanner.l"
+#line 328 "KDbSqlScanner.l"
 {
     ECOUNT;
     return WHERE;
@@ -1360,7 +1392,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 332 "KDbSqlScanner.l"
+#line 333 "KDbSqlScanner.l"
 {
     ECOUNT;
     return ORDER;
@@ -1368,7 +1400,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 48:
 YY_RULE_SETUP
-#line 337 "KDbSqlScanner.l"
+#line 338 "KDbSqlScanner.l"
 {
     ECOUNT;
     return BY;
@@ -1376,7 +1408,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 49:
 YY_RULE_SETUP
-#line 342 "KDbSqlScanner.l"
+#line 343 "KDbSqlScanner.l"
 {
     ECOUNT;
     return ASC;
@@ -1384,7 +1416,7 @@ YY_RULE_SETUP
     YY_BREAK
 case 50:
 YY_RULE_SETUP
-#line 347 "KDbSqlScanner.l"
+#line 348 "KDbSqlScanner.l"
 {
     ECOUNT;
     return DESC;
@@ -1393,7 +1425,7 @@ YY_RULE_SETUP
 case 51:
 /* rule 51 can match eol */
 YY_RULE_SETUP
-#line 352 "KDbSqlScanner.l"
+#line 353 "KDbSqlScanner.l"
 {
     ECOUNT;
     sqlParserDebug() << "{string} yytext: '" << yytext << "' (" << yyleng << ")";
@@ -1401,11 +1433,11 @@ YY_RULE_SETUP
     const QString unescaped(
         KDb::unescapeString(QString::fromUtf8(yytext+1, yyleng-2), yytext[0], &errorPosition));
     if (errorPosition >= 0) { // sanity check
-        setError(KDbParser::tr("Invalid string"),
+        setError(parser, KDbParser::tr("Invalid string"),
                  KDbParser::tr("Invalid character in string"));
         return SCAN_ERROR;
     }
-    yylval.stringValue = new QString(unescaped);
+    yylval->stringValue = new QString(unescaped);
     return CHARACTER_STRING_LITERAL;
 
 /* "ZZZ" sentinel for script */
@@ -1413,41 +1445,41 @@ YY_RULE_SETUP
     YY_BREAK
 case 52:
 YY_RULE_SETUP
-#line 369 "KDbSqlScanner.l"
+#line 370 "KDbSqlScanner.l"
 {
     sqlParserDebug() << "{identifier} yytext: '" << yytext << "' (" << yyleng << ")";
     ECOUNT;
     if (yytext[0]>='0' && yytext[0]<='9') {
-        setError(KDbParser::tr("Invalid identifier"),
+        setError(parser, KDbParser::tr("Invalid identifier"),
                  KDbParser::tr("Identifiers should start with a letter or '_' character"));
         return SCAN_ERROR;
     }
-    yylval.stringValue = new QString(QString::fromUtf8(yytext, yyleng));
+    yylval->stringValue = new QString(QString::fromUtf8(yytext, yyleng));
     return IDENTIFIER;
 }
     YY_BREAK
 case 53:
 /* rule 53 can match eol */
 YY_RULE_SETUP
-#line 381 "KDbSqlScanner.l"
+#line 382 "KDbSqlScanner.l"
 {
     sqlParserDebug() << "{query_parameter} yytext: '" << yytext << "' (" << yyleng << ")";
     ECOUNT;
-    yylval.stringValue = new QString(QString::fromUtf8(yytext+1, yyleng-2));
+    yylval->stringValue = new QString(QString::fromUtf8(yytext+1, yyleng-2));
     return QUERY_PARAMETER;
 }
     YY_BREAK
 case 54:
 /* rule 54 can match eol */
 YY_RULE_SETUP
-#line 388 "KDbSqlScanner.l"
+#line 389 "KDbSqlScanner.l"
 {
     ECOUNT;
 }
     YY_BREAK
 case 55:
 YY_RULE_SETUP
-#line 392 "KDbSqlScanner.l"
+#line 393 "KDbSqlScanner.l"
 {
     sqlParserDebug() << "char: '" << yytext[0] << "'";
     ECOUNT;
@@ -1456,21 +1488,21 @@ YY_RULE_SETUP
     YY_BREAK
 case 56:
 YY_RULE_SETUP
-#line 398 "KDbSqlScanner.l"
+#line 399 "KDbSqlScanner.l"
 { // fallback rule to avoid flex's default action that prints the character to stdout
     // without notifying the scanner.
     ECOUNT;
     const QString string(QString::fromUtf8(yytext, yyleng));
-    setError(KDbParser::tr("Unexpected character %1").arg(maybeQuote(string)));
+    setError(parser, KDbParser::tr("Unexpected character %1").arg(maybeQuote(string)));
     return SCAN_ERROR;
 }
     YY_BREAK
 case 57:
 YY_RULE_SETUP
-#line 406 "KDbSqlScanner.l"
+#line 407 "KDbSqlScanner.l"
 ECHO;
     YY_BREAK
-#line 1474 "generated/sqlscanner.cpp"
+#line 1506 "generated/sqlscanner.cpp"
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(DATE_OR_TIME):
     yyterminate();
@@ -1478,10 +1510,10 @@ case YY_STATE_EOF(DATE_OR_TIME):
     case YY_END_OF_BUFFER:
         {
         /* Amount of text matched not including the EOB char. */
-        int yy_amount_of_matched_text = (int) (yy_cp - (yytext_ptr)) - 1;
+        int yy_amount_of_matched_text = (int) (yy_cp - yyg->yytext_ptr) - 1;
 
         /* Undo the effects of YY_DO_BEFORE_ACTION. */
-        *yy_cp = (yy_hold_char);
+        *yy_cp = yyg->yy_hold_char;
         YY_RESTORE_YY_MORE_OFFSET
 
         if ( YY_CURRENT_BUFFER_LVALUE->yy_buffer_status == YY_BUFFER_NEW )
@@ -1495,7 +1527,7 @@ case YY_STATE_EOF(DATE_OR_TIME):
              * this is the first action (other than possibly a
              * back-up) that will match for the new input source.
              */
-            (yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
+            yyg->yy_n_chars = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
             YY_CURRENT_BUFFER_LVALUE->yy_input_file = yyin;
             YY_CURRENT_BUFFER_LVALUE->yy_buffer_status = YY_BUFFER_NORMAL;
             }
@@ -1507,13 +1539,13 @@ case YY_STATE_EOF(DATE_OR_TIME):
          * end-of-buffer state).  Contrast this with the test
          * in input().
          */
-        if ( (yy_c_buf_p) <= &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] )
+        if ( yyg->yy_c_buf_p <= &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars] )
             { /* This was really a NUL. */
             yy_state_type yy_next_state;
 
-            (yy_c_buf_p) = (yytext_ptr) + yy_amount_of_matched_text;
+            yyg->yy_c_buf_p = yyg->yytext_ptr + yy_amount_of_matched_text;
 
-            yy_current_state = yy_get_previous_state(  );
+            yy_current_state = yy_get_previous_state( yyscanner );
 
             /* Okay, we're now positioned to make the NUL
              * transition.  We couldn't have
@@ -1524,33 +1556,33 @@ case YY_STATE_EOF(DATE_OR_TIME):
              * will run more slowly).
              */
 
-            yy_next_state = yy_try_NUL_trans( yy_current_state );
+            yy_next_state = yy_try_NUL_trans( yy_current_state , yyscanner);
 
-            yy_bp = (yytext_ptr) + YY_MORE_ADJ;
+            yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
 
             if ( yy_next_state )
                 {
                 /* Consume the NUL. */
-                yy_cp = ++(yy_c_buf_p);
+                yy_cp = ++yyg->yy_c_buf_p;
                 yy_current_state = yy_next_state;
                 goto yy_match;
                 }
 
             else
                 {
-                yy_cp = (yy_last_accepting_cpos);
-                yy_current_state = (yy_last_accepting_state);
+                yy_cp = yyg->yy_last_accepting_cpos;
+                yy_current_state = yyg->yy_last_accepting_state;
                 goto yy_find_action;
                 }
             }
 
-        else switch ( yy_get_next_buffer(  ) )
+        else switch ( yy_get_next_buffer( yyscanner ) )
             {
             case EOB_ACT_END_OF_FILE:
                 {
-                (yy_did_buffer_switch_on_eof) = 0;
+                yyg->yy_did_buffer_switch_on_eof = 0;
 
-                if ( yywrap( ) )
+                if ( yywrap(yyscanner ) )
                     {
                     /* Note: because we've taken care in
                      * yy_get_next_buffer() to have set up
@@ -1561,7 +1593,7 @@ case YY_STATE_EOF(DATE_OR_TIME):
                      * YY_NULL, it'll still work - another
                      * YY_NULL will get returned.
                      */
-                    (yy_c_buf_p) = (yytext_ptr) + YY_MORE_ADJ;
+                    yyg->yy_c_buf_p = yyg->yytext_ptr + YY_MORE_ADJ;
 
                     yy_act = YY_STATE_EOF(YY_START);
                     goto do_action;
@@ -1569,30 +1601,30 @@ case YY_STATE_EOF(DATE_OR_TIME):
 
                 else
                     {
-                    if ( ! (yy_did_buffer_switch_on_eof) )
+                    if ( ! yyg->yy_did_buffer_switch_on_eof )
                         YY_NEW_FILE;
                     }
                 break;
                 }
 
             case EOB_ACT_CONTINUE_SCAN:
-                (yy_c_buf_p) =
-                    (yytext_ptr) + yy_amount_of_matched_text;
+                yyg->yy_c_buf_p =
+                    yyg->yytext_ptr + yy_amount_of_matched_text;
 
-                yy_current_state = yy_get_previous_state(  );
+                yy_current_state = yy_get_previous_state( yyscanner );
 
-                yy_cp = (yy_c_buf_p);
-                yy_bp = (yytext_ptr) + YY_MORE_ADJ;
+                yy_cp = yyg->yy_c_buf_p;
+                yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
                 goto yy_match;
 
             case EOB_ACT_LAST_MATCH:
-                (yy_c_buf_p) =
-                &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)];
+                yyg->yy_c_buf_p =
+                &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars];
 
-                yy_current_state = yy_get_previous_state(  );
+                yy_current_state = yy_get_previous_state( yyscanner );
 
-                yy_cp = (yy_c_buf_p);
-                yy_bp = (yytext_ptr) + YY_MORE_ADJ;
+                yy_cp = yyg->yy_c_buf_p;
+                yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
                 goto yy_find_action;
             }
         break;
@@ -1612,20 +1644,21 @@ case YY_STATE_EOF(DATE_OR_TIME):
  *	EOB_ACT_CONTINUE_SCAN - continue scanning from current position
  *	EOB_ACT_END_OF_FILE - end of file
  */
-static int yy_get_next_buffer (void)
+static int yy_get_next_buffer (yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
         char *dest = YY_CURRENT_BUFFER_LVALUE->yy_ch_buf;
-    char *source = (yytext_ptr);
+    char *source = yyg->yytext_ptr;
     int number_to_move, i;
     int ret_val;
 
-    if ( (yy_c_buf_p) > &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars) + 1] )
+    if ( yyg->yy_c_buf_p > &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars + 1] )
         YY_FATAL_ERROR(
         "fatal flex scanner internal error--end of buffer missed" );
 
     if ( YY_CURRENT_BUFFER_LVALUE->yy_fill_buffer == 0 )
         { /* Don't try to fill the buffer, so this is an EOF. */
-        if ( (yy_c_buf_p) - (yytext_ptr) - YY_MORE_ADJ == 1 )
+        if ( yyg->yy_c_buf_p - yyg->yytext_ptr - YY_MORE_ADJ == 1 )
             {
             /* We matched a single character, the EOB, so
              * treat this as a final EOF.
@@ -1645,7 +1678,7 @@ static int yy_get_next_buffer (void)
     /* Try to read more data. */
 
     /* First move last chars to start of buffer. */
-    number_to_move = (int) ((yy_c_buf_p) - (yytext_ptr)) - 1;
+    number_to_move = (int) (yyg->yy_c_buf_p - yyg->yytext_ptr) - 1;
 
     for ( i = 0; i < number_to_move; ++i )
         *(dest++) = *(source++);
@@ -1654,7 +1687,7 @@ static int yy_get_next_buffer (void)
         /* don't do the read, it's not guaranteed to return an EOF,
          * just force an EOF
          */
-        YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars) = 0;
+        YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars = 0;
 
     else
         {
@@ -1668,7 +1701,7 @@ static int yy_get_next_buffer (void)
             YY_BUFFER_STATE b = YY_CURRENT_BUFFER_LVALUE;
 
             int yy_c_buf_p_offset =
-                (int) ((yy_c_buf_p) - b->yy_ch_buf);
+                (int) (yyg->yy_c_buf_p - b->yy_ch_buf);
 
             if ( b->yy_is_our_buffer )
                 {
@@ -1681,7 +1714,7 @@ static int yy_get_next_buffer (void)
 
                 b->yy_ch_buf = (char *)
                     /* Include room in for 2 EOB chars. */
-                    yyrealloc((void *) b->yy_ch_buf,b->yy_buf_size + 2  );
+                    yyrealloc((void *) b->yy_ch_buf,b->yy_buf_size + 2 ,yyscanner );
                 }
             else
                 /* Can't grow it, we don't own it. */
@@ -1691,7 +1724,7 @@ static int yy_get_next_buffer (void)
                 YY_FATAL_ERROR(
                 "fatal error - scanner input buffer overflow" );
 
-            (yy_c_buf_p) = &b->yy_ch_buf[yy_c_buf_p_offset];
+            yyg->yy_c_buf_p = &b->yy_ch_buf[yy_c_buf_p_offset];
 
             num_to_read = (int) YY_CURRENT_BUFFER_LVALUE->yy_buf_size -
                         number_to_move - 1;
@@ -1703,17 +1736,17 @@ static int yy_get_next_buffer (void)
 
         /* Read in more data. */
         YY_INPUT( (&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[number_to_move]),
-            (yy_n_chars), num_to_read );
+            yyg->yy_n_chars, num_to_read );
 
-        YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
+        YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars;
         }
 
-    if ( (yy_n_chars) == 0 )
+    if ( yyg->yy_n_chars == 0 )
         {
         if ( number_to_move == YY_MORE_ADJ )
             {
             ret_val = EOB_ACT_END_OF_FILE;
-            yyrestart(yyin  );
+            yyrestart(yyin  ,yyscanner);
             }
 
         else
@@ -1727,39 +1760,40 @@ static int yy_get_next_buffer (void)
     else
         ret_val = EOB_ACT_CONTINUE_SCAN;
 
-    if ((int) ((yy_n_chars) + number_to_move) > YY_CURRENT_BUFFER_LVALUE->yy_buf_size) {
+    if ((int) (yyg->yy_n_chars + number_to_move) > YY_CURRENT_BUFFER_LVALUE->yy_buf_size) {
         /* Extend the array by 50%, plus the number we really need. */
-        int new_size = (yy_n_chars) + number_to_move + ((yy_n_chars) >> 1);
-        YY_CURRENT_BUFFER_LVALUE->yy_ch_buf = (char *) yyrealloc((void *) YY_CURRENT_BUFFER_LVALUE->yy_ch_buf,new_size  );
+        int new_size = yyg->yy_n_chars + number_to_move + (yyg->yy_n_chars >> 1);
+        YY_CURRENT_BUFFER_LVALUE->yy_ch_buf = (char *) yyrealloc((void *) YY_CURRENT_BUFFER_LVALUE->yy_ch_buf,new_size ,yyscanner );
         if ( ! YY_CURRENT_BUFFER_LVALUE->yy_ch_buf )
             YY_FATAL_ERROR( "out of dynamic memory in yy_get_next_buffer()" );
     }
 
-    (yy_n_chars) += number_to_move;
-    YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] = YY_END_OF_BUFFER_CHAR;
-    YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars) + 1] = YY_END_OF_BUFFER_CHAR;
+    yyg->yy_n_chars += number_to_move;
+    YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars] = YY_END_OF_BUFFER_CHAR;
+    YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars + 1] = YY_END_OF_BUFFER_CHAR;
 
-    (yytext_ptr) = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[0];
+    yyg->yytext_ptr = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[0];
 
     return ret_val;
 }
 
 /* yy_get_previous_state - get the state just before the EOB char was reached */
 
-    static yy_state_type yy_get_previous_state (void)
+    static yy_state_type yy_get_previous_state (yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
     yy_state_type yy_current_state;
     char *yy_cp;
 
-    yy_current_state = (yy_start);
+    yy_current_state = yyg->yy_start;
 
-    for ( yy_cp = (yytext_ptr) + YY_MORE_ADJ; yy_cp < (yy_c_buf_p); ++yy_cp )
+    for ( yy_cp = yyg->yytext_ptr + YY_MORE_ADJ; yy_cp < yyg->yy_c_buf_p; ++yy_cp )
         {
         YY_CHAR yy_c = (*yy_cp ? yy_ec[YY_SC_TO_UI(*yy_cp)] : 1);
         if ( yy_accept[yy_current_state] )
             {
-            (yy_last_accepting_state) = yy_current_state;
-            (yy_last_accepting_cpos) = yy_cp;
+            yyg->yy_last_accepting_state = yy_current_state;
+            yyg->yy_last_accepting_cpos = yy_cp;
             }
         while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
             {
@@ -1778,16 +1812,17 @@ static int yy_get_next_buffer (void)
  * synopsis
  *	next_state = yy_try_NUL_trans( current_state );
  */
-    static yy_state_type yy_try_NUL_trans  (yy_state_type yy_current_state )
+    static yy_state_type yy_try_NUL_trans  (yy_state_type yy_current_state , yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
     int yy_is_jam;
-        char *yy_cp = (yy_c_buf_p);
+        char *yy_cp = yyg->yy_c_buf_p;
 
     YY_CHAR yy_c = 1;
     if ( yy_accept[yy_current_state] )
         {
-        (yy_last_accepting_state) = yy_current_state;
-        (yy_last_accepting_cpos) = yy_cp;
+        yyg->yy_last_accepting_state = yy_current_state;
+        yyg->yy_last_accepting_cpos = yy_cp;
         }
     while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
         {
@@ -1801,19 +1836,20 @@ static int yy_get_next_buffer (void)
         return yy_is_jam ? 0 : yy_current_state;
 }
 
-    static void yyunput (int c, char * yy_bp )
+    static void yyunput (int c, char * yy_bp , yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
     char *yy_cp;
 
-    yy_cp = (yy_c_buf_p);
+    yy_cp = yyg->yy_c_buf_p;
 
     /* undo effects of setting up yytext */
-    *yy_cp = (yy_hold_char);
+    *yy_cp = yyg->yy_hold_char;
 
     if ( yy_cp < YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + 2 )
         { /* need to shift things up to make room */
         /* +2 for EOB chars. */
-        int number_to_move = (yy_n_chars) + 2;
+        int number_to_move = yyg->yy_n_chars + 2;
         char *dest = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[
                     YY_CURRENT_BUFFER_LVALUE->yy_buf_size + 2];
         char *source =
@@ -1825,7 +1861,7 @@ static int yy_get_next_buffer (void)
         yy_cp += (int) (dest - source);
         yy_bp += (int) (dest - source);
         YY_CURRENT_BUFFER_LVALUE->yy_n_chars =
-            (yy_n_chars) = (int) YY_CURRENT_BUFFER_LVALUE->yy_buf_size;
+            yyg->yy_n_chars = (int) YY_CURRENT_BUFFER_LVALUE->yy_buf_size;
 
         if ( yy_cp < YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + 2 )
             YY_FATAL_ERROR( "flex scanner push-back overflow" );
@@ -1833,39 +1869,40 @@ static int yy_get_next_buffer (void)
 
     *--yy_cp = (char) c;
 
-    (yytext_ptr) = yy_bp;
-    (yy_hold_char) = *yy_cp;
-    (yy_c_buf_p) = yy_cp;
+    yyg->yytext_ptr = yy_bp;
+    yyg->yy_hold_char = *yy_cp;
+    yyg->yy_c_buf_p = yy_cp;
 }
 
 #ifndef YY_NO_INPUT
 #ifdef __cplusplus
-    static int yyinput (void)
+    static int yyinput (yyscan_t yyscanner)
 #else
-    static int input  (void)
+    static int input  (yyscan_t yyscanner)
 #endif
 
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
     int c;
 
-    *(yy_c_buf_p) = (yy_hold_char);
+    *yyg->yy_c_buf_p = yyg->yy_hold_char;
 
-    if ( *(yy_c_buf_p) == YY_END_OF_BUFFER_CHAR )
+    if ( *yyg->yy_c_buf_p == YY_END_OF_BUFFER_CHAR )
         {
         /* yy_c_buf_p now points to the character we want to return.
          * If this occurs *before* the EOB characters, then it's a
          * valid NUL; if not, then we've hit the end of the buffer.
          */
-        if ( (yy_c_buf_p) < &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] )
+        if ( yyg->yy_c_buf_p < &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars] )
             /* This was really a NUL. */
-            *(yy_c_buf_p) = '\0';
+            *yyg->yy_c_buf_p = '\0';
 
         else
             { /* need more input */
-            yy_size_t offset = (yy_c_buf_p) - (yytext_ptr);
-            ++(yy_c_buf_p);
+            yy_size_t offset = yyg->yy_c_buf_p - yyg->yytext_ptr;
+            ++yyg->yy_c_buf_p;
 
-            switch ( yy_get_next_buffer(  ) )
+            switch ( yy_get_next_buffer( yyscanner ) )
                 {
                 case EOB_ACT_LAST_MATCH:
                     /* This happens because yy_g_n_b()
@@ -1879,34 +1916,34 @@ static int yy_get_next_buffer (void)
                      */
 
                     /* Reset buffer status. */
-                    yyrestart(yyin );
+                    yyrestart(yyin ,yyscanner);
 
                     /*FALLTHROUGH*/
 
                 case EOB_ACT_END_OF_FILE:
                     {
-                    if ( yywrap( ) )
+                    if ( yywrap(yyscanner ) )
                         return EOF;
 
-                    if ( ! (yy_did_buffer_switch_on_eof) )
+                    if ( ! yyg->yy_did_buffer_switch_on_eof )
                         YY_NEW_FILE;
 #ifdef __cplusplus
-                    return yyinput();
+                    return yyinput(yyscanner);
 #else
-                    return input();
+                    return input(yyscanner);
 #endif
                     }
 
                 case EOB_ACT_CONTINUE_SCAN:
-                    (yy_c_buf_p) = (yytext_ptr) + offset;
+                    yyg->yy_c_buf_p = yyg->yytext_ptr + offset;
                     break;
                 }
             }
         }
 
-    c = *(unsigned char *) (yy_c_buf_p);	/* cast for 8-bit char's */
-    *(yy_c_buf_p) = '\0';	/* preserve yytext */
-    (yy_hold_char) = *++(yy_c_buf_p);
+    c = *(unsigned char *) yyg->yy_c_buf_p;	/* cast for 8-bit char's */
+    *yyg->yy_c_buf_p = '\0';	/* preserve yytext */
+    yyg->yy_hold_char = *++yyg->yy_c_buf_p;
 
     return c;
 }
@@ -1917,60 +1954,63 @@ static int yy_get_next_buffer (void)
  *
  * @note This function does not reset the start condition to @c INITIAL .
  */
-    void yyrestart  (FILE * input_file )
+    void yyrestart  (FILE * input_file , yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
     if ( ! YY_CURRENT_BUFFER ){
-        yyensure_buffer_stack ();
+        yyensure_buffer_stack (yyscanner);
         YY_CURRENT_BUFFER_LVALUE =
-            yy_create_buffer(yyin,YY_BUF_SIZE );
+            yy_create_buffer(yyin,YY_BUF_SIZE ,yyscanner);
     }
 
-    yy_init_buffer(YY_CURRENT_BUFFER,input_file );
-    yy_load_buffer_state( );
+    yy_init_buffer(YY_CURRENT_BUFFER,input_file ,yyscanner);
+    yy_load_buffer_state(yyscanner );
 }
 
 /** Switch to a different input buffer.
  * @param new_buffer The new input buffer.
  *
  */
-    void yy_switch_to_buffer  (YY_BUFFER_STATE  new_buffer )
+    void yy_switch_to_buffer  (YY_BUFFER_STATE  new_buffer , yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
     /* TODO. We should be able to replace this entire function body
      * with
      *		yypop_buffer_state();
      *		yypush_buffer_state(new_buffer);
      */
-    yyensure_buffer_stack ();
+    yyensure_buffer_stack (yyscanner);
     if ( YY_CURRENT_BUFFER == new_buffer )
         return;
 
     if ( YY_CURRENT_BUFFER )
         {
         /* Flush out information for old buffer. */
-        *(yy_c_buf_p) = (yy_hold_char);
-        YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = (yy_c_buf_p);
-        YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
+        *yyg->yy_c_buf_p = yyg->yy_hold_char;
+        YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = yyg->yy_c_buf_p;
+        YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars;
         }
 
     YY_CURRENT_BUFFER_LVALUE = new_buffer;
-    yy_load_buffer_state( );
+    yy_load_buffer_state(yyscanner );
 
     /* We don't actually know whether we did this switch during
      * EOF (yywrap()) processing, but the only time this flag
      * is looked at is after yywrap() is called, so it's safe
      * to go ahead and always set it.
      */
-    (yy_did_buffer_switch_on_eof) = 1;
+    yyg->yy_did_buffer_switch_on_eof = 1;
 }
 
-static void yy_load_buffer_state  (void)
+static void yy_load_buffer_state  (yyscan_t yyscanner)
 {
-        (yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
-    (yytext_ptr) = (yy_c_buf_p) = YY_CURRENT_BUFFER_LVALUE->yy_buf_pos;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+        yyg->yy_n_chars = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
+    yyg->yytext_ptr = yyg->yy_c_buf_p = YY_CURRENT_BUFFER_LVALUE->yy_buf_pos;
     yyin = YY_CURRENT_BUFFER_LVALUE->yy_input_file;
-    (yy_hold_char) = *(yy_c_buf_p);
+    yyg->yy_hold_char = *yyg->yy_c_buf_p;
 }
 
 /** Allocate and initialize an input buffer state.
@@ -1979,11 +2019,11 @@ static void yy_load_buffer_state  (void)
  *
  * @return the allocated buffer state.
  */
-    YY_BUFFER_STATE yy_create_buffer  (FILE * file, int  size )
+    YY_BUFFER_STATE yy_create_buffer  (FILE * file, int  size , yyscan_t yyscanner)
 {
     YY_BUFFER_STATE b;
 
-    b = (YY_BUFFER_STATE) yyalloc(sizeof( struct yy_buffer_state )  );
+    b = (YY_BUFFER_STATE) yyalloc(sizeof( struct yy_buffer_state ) ,yyscanner );
     if ( ! b )
         YY_FATAL_ERROR( "out of dynamic memory in yy_create_buffer()" );
 
@@ -1992,13 +2032,13 @@ static void yy_load_buffer_state  (void)
     /* yy_ch_buf has to be 2 characters longer than the size given because
      * we need to put in 2 end-of-buffer characters.
      */
-    b->yy_ch_buf = (char *) yyalloc(b->yy_buf_size + 2  );
+    b->yy_ch_buf = (char *) yyalloc(b->yy_buf_size + 2 ,yyscanner );
     if ( ! b->yy_ch_buf )
         YY_FATAL_ERROR( "out of dynamic memory in yy_create_buffer()" );
 
     b->yy_is_our_buffer = 1;
 
-    yy_init_buffer(b,file );
+    yy_init_buffer(b,file ,yyscanner);
 
     return b;
 }
@@ -2007,8 +2047,9 @@ static void yy_load_buffer_state  (void)
  * @param b a buffer created with yy_create_buffer()
  *
  */
-    void yy_delete_buffer (YY_BUFFER_STATE  b )
+    void yy_delete_buffer (YY_BUFFER_STATE  b , yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
     if ( ! b )
         return;
@@ -2017,21 +2058,22 @@ static void yy_load_buffer_state  (void)
         YY_CURRENT_BUFFER_LVALUE = (YY_BUFFER_STATE) 0;
 
     if ( b->yy_is_our_buffer )
-        yyfree((void *) b->yy_ch_buf  );
+        yyfree((void *) b->yy_ch_buf ,yyscanner );
 
-    yyfree((void *) b  );
+    yyfree((void *) b ,yyscanner );
 }
 
 /* Initializes or reinitializes a buffer.
  * This function is sometimes called more than once on the same buffer,
  * such as during a yyrestart() or at EOF.
  */
-    static void yy_init_buffer  (YY_BUFFER_STATE  b, FILE * file )
+    static void yy_init_buffer  (YY_BUFFER_STATE  b, FILE * file , yyscan_t yyscanner)
 
 {
     int oerrno = errno;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
-    yy_flush_buffer(b );
+    yy_flush_buffer(b ,yyscanner);
 
     b->yy_input_file = file;
     b->yy_fill_buffer = 1;
@@ -2054,8 +2096,9 @@ static void yy_load_buffer_state  (void)
  * @param b the buffer state to be flushed, usually @c YY_CURRENT_BUFFER.
  *
  */
-    void yy_flush_buffer (YY_BUFFER_STATE  b )
+    void yy_flush_buffer (YY_BUFFER_STATE  b , yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
         if ( ! b )
         return;
 
@@ -2074,7 +2117,7 @@ static void yy_load_buffer_state  (void)
     b->yy_buffer_status = YY_BUFFER_NEW;
 
     if ( b == YY_CURRENT_BUFFER )
-        yy_load_buffer_state( );
+        yy_load_buffer_state(yyscanner );
 }
 
 /** Pushes the new state onto the stack. The new state becomes
@@ -2083,95 +2126,98 @@ static void yy_load_buffer_state  (void)
  *  @param new_buffer The new state.
  *
  */
-void yypush_buffer_state (YY_BUFFER_STATE new_buffer )
+void yypush_buffer_state (YY_BUFFER_STATE new_buffer , yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
         if (new_buffer == NULL)
         return;
 
-    yyensure_buffer_stack();
+    yyensure_buffer_stack(yyscanner);
 
     /* This block is copied from yy_switch_to_buffer. */
     if ( YY_CURRENT_BUFFER )
         {
         /* Flush out information for old buffer. */
-        *(yy_c_buf_p) = (yy_hold_char);
-        YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = (yy_c_buf_p);
-        YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
+        *yyg->yy_c_buf_p = yyg->yy_hold_char;
+        YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = yyg->yy_c_buf_p;
+        YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars;
         }
 
     /* Only push if top exists. Otherwise, replace top. */
     if (YY_CURRENT_BUFFER)
-        (yy_buffer_stack_top)++;
+        yyg->yy_buffer_stack_top++;
     YY_CURRENT_BUFFER_LVALUE = new_buffer;
 
     /* copied from yy_switch_to_buffer. */
-    yy_load_buffer_state( );
-    (yy_did_buffer_switch_on_eof) = 1;
+    yy_load_buffer_state(yyscanner );
+    yyg->yy_did_buffer_switch_on_eof = 1;
 }
 
 /** Removes and deletes the top of the stack, if present.
  *  The next element becomes the new top.
  *
  */
-void yypop_buffer_state (void)
+void yypop_buffer_state (yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
         if (!YY_CURRENT_BUFFER)
         return;
 
-    yy_delete_buffer(YY_CURRENT_BUFFER );
+    yy_delete_buffer(YY_CURRENT_BUFFER ,yyscanner);
     YY_CURRENT_BUFFER_LVALUE = NULL;
-    if ((yy_buffer_stack_top) > 0)
-        --(yy_buffer_stack_top);
+    if (yyg->yy_buffer_stack_top > 0)
+        --yyg->yy_buffer_stack_top;
 
     if (YY_CURRENT_BUFFER) {
-        yy_load_buffer_state( );
-        (yy_did_buffer_switch_on_eof) = 1;
+        yy_load_buffer_state(yyscanner );
+        yyg->yy_did_buffer_switch_on_eof = 1;
     }
 }
 
 /* Allocates the stack if it does not exist.
  *  Guarantees space for at least one push.
  */
-static void yyensure_buffer_stack (void)
+static void yyensure_buffer_stack (yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
     yy_size_t num_to_alloc;
 
-    if (!(yy_buffer_stack)) {
+    if (!yyg->yy_buffer_stack) {
 
         /* First allocation is just for 2 elements, since we don't know if this
          * scanner will even need a stack. We use 2 instead of 1 to avoid an
          * immediate realloc on the next call.
          */
         num_to_alloc = 1;
-        (yy_buffer_stack) = (struct yy_buffer_state**)yyalloc
+        yyg->yy_buffer_stack = (struct yy_buffer_state**)yyalloc
                                 (num_to_alloc * sizeof(struct yy_buffer_state*)
-                                );
-        if ( ! (yy_buffer_stack) )
+                                , yyscanner);
+        if ( ! yyg->yy_buffer_stack )
             YY_FATAL_ERROR( "out of dynamic memory in yyensure_buffer_stack()" );
 
-        memset((yy_buffer_stack), 0, num_to_alloc * sizeof(struct yy_buffer_state*));
+        memset(yyg->yy_buffer_stack, 0, num_to_alloc * sizeof(struct yy_buffer_state*));
 
-        (yy_buffer_stack_max) = num_to_alloc;
-        (yy_buffer_stack_top) = 0;
+        yyg->yy_buffer_stack_max = num_to_alloc;
+        yyg->yy_buffer_stack_top = 0;
         return;
     }
 
-    if ((yy_buffer_stack_top) >= ((yy_buffer_stack_max)) - 1){
+    if (yyg->yy_buffer_stack_top >= (yyg->yy_buffer_stack_max) - 1){
 
         /* Increase the buffer to prepare for a possible push. */
         int grow_size = 8 /* arbitrary grow size */;
 
-        num_to_alloc = (yy_buffer_stack_max) + grow_size;
-        (yy_buffer_stack) = (struct yy_buffer_state**)yyrealloc
-                                ((yy_buffer_stack),
+        num_to_alloc = yyg->yy_buffer_stack_max + grow_size;
+        yyg->yy_buffer_stack = (struct yy_buffer_state**)yyrealloc
+                                (yyg->yy_buffer_stack,
                                 num_to_alloc * sizeof(struct yy_buffer_state*)
-                                );
-        if ( ! (yy_buffer_stack) )
+                                , yyscanner);
+        if ( ! yyg->yy_buffer_stack )
             YY_FATAL_ERROR( "out of dynamic memory in yyensure_buffer_stack()" );
 
         /* zero only the new slots.*/
-        memset((yy_buffer_stack) + (yy_buffer_stack_max), 0, grow_size * sizeof(struct yy_buffer_state*));
-        (yy_buffer_stack_max) = num_to_alloc;
+        memset(yyg->yy_buffer_stack + yyg->yy_buffer_stack_max, 0, grow_size * sizeof(struct yy_buffer_state*));
+        yyg->yy_buffer_stack_max = num_to_alloc;
     }
 }
 
@@ -2181,7 +2227,7 @@ static void yyensure_buffer_stack (void)
  *
  * @return the newly allocated buffer state object.
  */
-YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size )
+YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size , yyscan_t yyscanner)
 {
     YY_BUFFER_STATE b;
 
@@ -2191,7 +2237,7 @@ YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size )
         /* They forgot to leave room for the EOB's. */
         return 0;
 
-    b = (YY_BUFFER_STATE) yyalloc(sizeof( struct yy_buffer_state )  );
+    b = (YY_BUFFER_STATE) yyalloc(sizeof( struct yy_buffer_state ) ,yyscanner );
     if ( ! b )
         YY_FATAL_ERROR( "out of dynamic memory in yy_scan_buffer()" );
 
@@ -2205,7 +2251,7 @@ YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size )
     b->yy_fill_buffer = 0;
     b->yy_buffer_status = YY_BUFFER_NEW;
 
-    yy_switch_to_buffer(b  );
+    yy_switch_to_buffer(b ,yyscanner );
 
     return b;
 }
@@ -2218,10 +2264,10 @@ YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size )
  * @note If you want to scan bytes that may contain NUL values, then use
  *       yy_scan_bytes() instead.
  */
-YY_BUFFER_STATE yy_scan_string (yyconst char * yystr )
+YY_BUFFER_STATE yy_scan_string (yyconst char * yystr , yyscan_t yyscanner)
 {
 
-    return yy_scan_bytes(yystr,(int) strlen(yystr) );
+    return yy_scan_bytes(yystr,(int) strlen(yystr) ,yyscanner);
 }
 
 /** Setup the input buffer state to scan the given bytes. The next call to yylex() will
@@ -2231,7 +2277,7 @@ YY_BUFFER_STATE yy_scan_string (yyconst char * yystr )
  *
  * @return the newly allocated buffer state object.
  */
-YY_BUFFER_STATE yy_scan_bytes  (yyconst char * yybytes, yy_size_t  _yybytes_len )
+YY_BUFFER_STATE yy_scan_bytes  (yyconst char * yybytes, yy_size_t  _yybytes_len , yyscan_t yyscanner)
 {
     YY_BUFFER_STATE b;
     char *buf;
@@ -2240,7 +2286,7 @@ YY_BUFFER_STATE yy_scan_bytes  (yyconst char * yybytes, yy_size_t  _yybytes_len
 
     /* Get memory for full buffer, including space for trailing EOB's. */
     n = (yy_size_t) _yybytes_len + 2;
-    buf = (char *) yyalloc(n  );
+    buf = (char *) yyalloc(n ,yyscanner );
     if ( ! buf )
         YY_FATAL_ERROR( "out of dynamic memory in yy_scan_bytes()" );
 
@@ -2249,7 +2295,7 @@ YY_BUFFER_STATE yy_scan_bytes  (yyconst char * yybytes, yy_size_t  _yybytes_len
 
     buf[_yybytes_len] = buf[_yybytes_len+1] = YY_END_OF_BUFFER_CHAR;
 
-    b = yy_scan_buffer(buf,n );
+    b = yy_scan_buffer(buf,n ,yyscanner);
     if ( ! b )
         YY_FATAL_ERROR( "bad buffer in yy_scan_bytes()" );
 
@@ -2265,7 +2311,7 @@ YY_BUFFER_STATE yy_scan_bytes  (yyconst char * yybytes, yy_size_t  _yybytes_len
 #define YY_EXIT_FAILURE 2
 #endif
 
-static void yy_fatal_error (yyconst char* msg )
+static void yy_fatal_error (yyconst char* msg , yyscan_t yyscanner)
 {
         (void) fprintf( stderr, "%s\n", msg );
     exit( YY_EXIT_FAILURE );
@@ -2280,106 +2326,253 @@ static void yy_fatal_error (yyconst char* msg )
         /* Undo effects of setting up yytext. */ \
         int yyless_macro_arg = (n); \
         YY_LESS_LINENO(yyless_macro_arg);\
-        yytext[yyleng] = (yy_hold_char); \
-        (yy_c_buf_p) = yytext + yyless_macro_arg; \
-        (yy_hold_char) = *(yy_c_buf_p); \
-        *(yy_c_buf_p) = '\0'; \
+        yytext[yyleng] = yyg->yy_hold_char; \
+        yyg->yy_c_buf_p = yytext + yyless_macro_arg; \
+        yyg->yy_hold_char = *yyg->yy_c_buf_p; \
+        *yyg->yy_c_buf_p = '\0'; \
         yyleng = yyless_macro_arg; \
         } \
     while ( 0 )
 
 /* Accessor  methods (get/set functions) to struct members. */
 
+/** Get the user-defined data for this scanner.
+ * @param yyscanner The scanner object.
+ */
+YY_EXTRA_TYPE yyget_extra  (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyextra;
+}
+
 /** Get the current line number.
- *
+ * @param yyscanner The scanner object.
  */
-int yyget_lineno  (void)
+int yyget_lineno  (yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+        if (! YY_CURRENT_BUFFER)
+            return 0;
 
     return yylineno;
 }
 
+/** Get the current column number.
+ * @param yyscanner The scanner object.
+ */
+int yyget_column  (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+        if (! YY_CURRENT_BUFFER)
+            return 0;
+
+    return yycolumn;
+}
+
 /** Get the input stream.
- *
+ * @param yyscanner The scanner object.
  */
-FILE *yyget_in  (void)
+FILE *yyget_in  (yyscan_t yyscanner)
 {
-        return yyin;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyin;
 }
 
 /** Get the output stream.
- *
+ * @param yyscanner The scanner object.
  */
-FILE *yyget_out  (void)
+FILE *yyget_out  (yyscan_t yyscanner)
 {
-        return yyout;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyout;
 }
 
 /** Get the length of the current token.
- *
+ * @param yyscanner The scanner object.
  */
-yy_size_t yyget_leng  (void)
+yy_size_t yyget_leng  (yyscan_t yyscanner)
 {
-        return yyleng;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyleng;
 }
 
 /** Get the current token.
- *
+ * @param yyscanner The scanner object.
  */
 
-char *yyget_text  (void)
+char *yyget_text  (yyscan_t yyscanner)
 {
-        return yytext;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yytext;
+}
+
+/** Set the user-defined data. This data is never touched by the scanner.
+ * @param user_defined The data to be associated with this scanner.
+ * @param yyscanner The scanner object.
+ */
+void yyset_extra (YY_EXTRA_TYPE  user_defined , yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yyextra = user_defined ;
 }
 
 /** Set the current line number.
  * @param line_number
- *
+ * @param yyscanner The scanner object.
  */
-void yyset_lineno (int  line_number )
+void yyset_lineno (int  line_number , yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+        /* lineno is only valid if an input buffer exists. */
+        if (! YY_CURRENT_BUFFER )
+           YY_FATAL_ERROR( "yyset_lineno called with no buffer" );
 
     yylineno = line_number;
 }
 
+/** Set the current column.
+ * @param line_number
+ * @param yyscanner The scanner object.
+ */
+void yyset_column (int  column_no , yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+        /* column is only valid if an input buffer exists. */
+        if (! YY_CURRENT_BUFFER )
+           YY_FATAL_ERROR( "yyset_column called with no buffer" );
+
+    yycolumn = column_no;
+}
+
 /** Set the input stream. This does not discard the current
  * input buffer.
  * @param in_str A readable stream.
- *
+ * @param yyscanner The scanner object.
  * @see yy_switch_to_buffer
  */
-void yyset_in (FILE *  in_str )
+void yyset_in (FILE *  in_str , yyscan_t yyscanner)
 {
-        yyin = in_str ;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yyin = in_str ;
 }
 
-void yyset_out (FILE *  out_str )
+void yyset_out (FILE *  out_str , yyscan_t yyscanner)
 {
-        yyout = out_str ;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yyout = out_str ;
 }
 
-int yyget_debug  (void)
+int yyget_debug  (yyscan_t yyscanner)
 {
-        return yy_flex_debug;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yy_flex_debug;
 }
 
-void yyset_debug (int  bdebug )
+void yyset_debug (int  bdebug , yyscan_t yyscanner)
 {
-        yy_flex_debug = bdebug ;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yy_flex_debug = bdebug ;
 }
 
-static int yy_init_globals (void)
+/* Accessor methods for yylval and yylloc */
+
+YYSTYPE * yyget_lval  (yyscan_t yyscanner)
 {
-        /* Initialization is the same as for the non-reentrant scanner.
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yylval;
+}
+
+void yyset_lval (YYSTYPE *  yylval_param , yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yylval = yylval_param;
+}
+
+/* User-visible API */
+
+/* yylex_init is special because it creates the scanner itself, so it is
+ * the ONLY reentrant function that doesn't take the scanner as the last argument.
+ * That's why we explicitly handle the declaration, instead of using our macros.
+ */
+
+int yylex_init(yyscan_t* ptr_yy_globals)
+
+{
+    if (ptr_yy_globals == NULL){
+        errno = EINVAL;
+        return 1;
+    }
+
+    *ptr_yy_globals = (yyscan_t) yyalloc ( sizeof( struct yyguts_t ), NULL );
+
+    if (*ptr_yy_globals == NULL){
+        errno = ENOMEM;
+        return 1;
+    }
+
+    /* By setting to 0xAA, we expose bugs in yy_init_globals. Leave at 0x00 for releases. */
+    memset(*ptr_yy_globals,0x00,sizeof(struct yyguts_t));
+
+    return yy_init_globals ( *ptr_yy_globals );
+}
+
+/* yylex_init_extra has the same functionality as yylex_init, but follows the
+ * convention of taking the scanner as the last argument. Note however, that
+ * this is a *pointer* to a scanner, as it will be allocated by this call (and
+ * is the reason, too, why this function also must handle its own declaration).
+ * The user defined value in the first argument will be available to yyalloc in
+ * the yyextra field.
+ */
+
+int yylex_init_extra(YY_EXTRA_TYPE yy_user_defined,yyscan_t* ptr_yy_globals )
+
+{
+    struct yyguts_t dummy_yyguts;
+
+    yyset_extra (yy_user_defined, &dummy_yyguts);
+
+    if (ptr_yy_globals == NULL){
+        errno = EINVAL;
+        return 1;
+    }
+
+    *ptr_yy_globals = (yyscan_t) yyalloc ( sizeof( struct yyguts_t ), &dummy_yyguts );
+
+    if (*ptr_yy_globals == NULL){
+        errno = ENOMEM;
+        return 1;
+    }
+
+    /* By setting to 0xAA, we expose bugs in
+    yy_init_globals. Leave at 0x00 for releases. */
+    memset(*ptr_yy_globals,0x00,sizeof(struct yyguts_t));
+
+    yyset_extra (yy_user_defined, *ptr_yy_globals);
+
+    return yy_init_globals ( *ptr_yy_globals );
+}
+
+static int yy_init_globals (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    /* Initialization is the same as for the non-reentrant scanner.
      * This function is called from yylex_destroy(), so don't allocate here.
      */
 
-    (yy_buffer_stack) = 0;
-    (yy_buffer_stack_top) = 0;
-    (yy_buffer_stack_max) = 0;
-    (yy_c_buf_p) = (char *) 0;
-    (yy_init) = 0;
-    (yy_start) = 0;
+    yyg->yy_buffer_stack = 0;
+    yyg->yy_buffer_stack_top = 0;
+    yyg->yy_buffer_stack_max = 0;
+    yyg->yy_c_buf_p = (char *) 0;
+    yyg->yy_init = 0;
+    yyg->yy_start = 0;
+
+    yyg->yy_start_stack_ptr = 0;
+    yyg->yy_start_stack_depth = 0;
+    yyg->yy_start_stack =  NULL;
 
 /* Defined in main.c */
 #ifdef YY_STDINIT
@@ -2397,24 +2590,32 @@ static int yy_init_globals (void)
 }
 
 /* yylex_destroy is for both reentrant and non-reentrant scanners. */
-int yylex_destroy  (void)
+int yylex_destroy  (yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
     /* Pop the buffer stack, destroying each element. */
     while(YY_CURRENT_BUFFER){
-        yy_delete_buffer(YY_CURRENT_BUFFER  );
+        yy_delete_buffer(YY_CURRENT_BUFFER ,yyscanner );
         YY_CURRENT_BUFFER_LVALUE = NULL;
-        yypop_buffer_state();
+        yypop_buffer_state(yyscanner);
     }
 
     /* Destroy the stack itself. */
-    yyfree((yy_buffer_stack) );
-    (yy_buffer_stack) = NULL;
+    yyfree(yyg->yy_buffer_stack ,yyscanner);
+    yyg->yy_buffer_stack = NULL;
+
+    /* Destroy the start condition stack. */
+        yyfree(yyg->yy_start_stack ,yyscanner );
+        yyg->yy_start_stack = NULL;
 
     /* Reset the globals. This is important in a non-reentrant scanner so the next time
      * yylex() is called, initialization will occur. */
-    yy_init_globals( );
+    yy_init_globals( yyscanner);
 
+    /* Destroy the main struct (reentrant only). */
+    yyfree ( yyscanner , yyscanner );
+    yyscanner = NULL;
     return 0;
 }
 
@@ -2423,7 +2624,7 @@ int yylex_destroy  (void)
  */
 
 #ifndef yytext_ptr
-static void yy_flex_strncpy (char* s1, yyconst char * s2, int n )
+static void yy_flex_strncpy (char* s1, yyconst char * s2, int n , yyscan_t yyscanner)
 {
     int i;
     for ( i = 0; i < n; ++i )
@@ -2432,7 +2633,7 @@ static void yy_flex_strncpy (char* s1, yyconst char * s2, int n )
 #endif
 
 #ifdef YY_NEED_STRLEN
-static int yy_flex_strlen (yyconst char * s )
+static int yy_flex_strlen (yyconst char * s , yyscan_t yyscanner)
 {
     int n;
     for ( n = 0; s[n]; ++n )
@@ -2442,12 +2643,12 @@ static int yy_flex_strlen (yyconst char * s )
 }
 #endif
 
-void *yyalloc (yy_size_t  size )
+void *yyalloc (yy_size_t  size , yyscan_t yyscanner)
 {
     return (void *) malloc( size );
 }
 
-void *yyrealloc  (void * ptr, yy_size_t  size )
+void *yyrealloc  (void * ptr, yy_size_t  size , yyscan_t yyscanner)
 {
     /* The cast to (char *) in the following accommodates both
      * implementations that use char* generic pointers, and those
@@ -2459,22 +2660,20 @@ void *yyrealloc  (void * ptr, yy_size_t  size )
     return (void *) realloc( (char *) ptr, size );
 }
 
-void yyfree (void * ptr )
+void yyfree (void * ptr , yyscan_t yyscanner)
 {
     free( (char *) ptr );	/* see yyrealloc() for (char *) cast */
 }
 
 #define YYTABLES_NAME "yytables"
 
-#line 406 "KDbSqlScanner.l"
+#line 407 "KDbSqlScanner.l"
 
 
 
-void tokenize(const char *data)
+void tokenize(const char *data, yyscan_t scanner)
 {
-    yy_switch_to_buffer(yy_scan_string(data));
-    globalToken.clear();
-    globalCurrentPos = 0;
+    yy_switch_to_buffer(yy_scan_string(data, scanner), scanner);
 }
 
 
@@ -26,3 +26,37 @@ KDbSqlRecord::KDbSqlRecord()
 KDbSqlRecord::~KDbSqlRecord()
 {
 }
+
+bool KDbSqlRecord::isNull(int index)
+{
+    return !cstringValue(index).string;
+}
+
+qint64 KDbSqlRecord::int64Value(int index)
+{
+    const KDbSqlString value = cstringValue(index);
+    return value.isEmpty() ? 0 : value.rawDataToByteArray().toLongLong();
+}
+
+double KDbSqlRecord::doubleValue(int index)
+{
+    const KDbSqlString value = cstringValue(index);
+    return value.isEmpty() ? 0.0 : value.rawDataToByteArray().toDouble();
+}
+
+bool KDbSqlRecord::boolValue(int index)
+{
+    const KDbSqlString value = cstringValue(index);
+    if (value.isEmpty()) {
+        return false;
+    }
+    if (value.string[0] == 't' || value.string[0] == 'T') {
+        return true;
+    }
+    return value.rawDataToByteArray().toDouble() != 0.0;
+}
+
+KDbSqlString KDbSqlRecord::blobView(int index)
+{
+    return cstringValue(index);
+}
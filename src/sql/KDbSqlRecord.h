@@ -21,16 +21,18 @@
 #define KDB_SQLRECORD_H
 
 #include "kdb_export.h"
-#include <QtGlobal>
+#include "KDbSqlString.h"
 
-class QByteArray;
 class QString;
-class KDbSqlString;
 
 //! The KDbSqlRecord class abstracts a single record obtained from a KDbSqlResult object
 /**
  * KDbSqlRecord provides value of each column in a form of optimized KDbSqlString value,
  * QString or QByteArray.
+ *
+ * Typed accessors such as int64Value() or doubleValue() avoid converting values through
+ * QString or QByteArray copies. Drivers implement them using native API when possible;
+ * the default implementations convert the value returned by cstringValue().
  */
 class KDB_EXPORT KDbSqlRecord
 {
@@ -44,6 +46,31 @@ public:
     virtual QByteArray toByteArray(int index) = 0;
 
     virtual KDbSqlString cstringValue(int index) = 0;
+
+    //! @return true if value of column @a index is NULL
+    //! @since 3.2
+    virtual bool isNull(int index);
+
+    //! @return value of column @a index as 64-bit integer, 0 if the value is NULL
+    //! or is not a number
+    //! @since 3.2
+    virtual qint64 int64Value(int index);
+
+    //! @return value of column @a index as double, 0.0 if the value is NULL or is not a number
+    //! @since 3.2
+    virtual double doubleValue(int index);
+
+    //! @return value of column @a index as boolean, false if the value is NULL
+    //! Nonzero numbers and text values starting with 't' or 'T' (as in "true") are true.
+    //! @since 3.2
+    virtual bool boolValue(int index);
+
+    //! @return value of column @a index as raw bytes without copying them
+    //! The same bytes as for toByteArray() are returned. The data is valid only until
+    //! the next record is fetched from the parent KDbSqlResult object.
+    //! @since 3.2
+    virtual KDbSqlString blobView(int index);
+
 private:
     Q_DISABLE_COPY(KDbSqlRecord)
 };
@@ -36,6 +36,14 @@
 #include "kdb_debug.h"
 
 #include <QApplication>
+#include <QAtomicInt>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QThread>
+#include <QThreadPool>
+
+#include <functional>
+#include <limits>
 
 #include <unicode/coll.h>
 
@@ -80,165 +88,309 @@ private:
 
 Q_GLOBAL_STATIC(CollatorInstance, KDb_collator)
 
-//! @internal A functor used in std::sort() in order to sort by a given column
-class LessThanFunctor
+//! @internal Value of a record's column converted once to a form that is fast to compare
+struct SortKeyValue
+{
+    bool isNull;
+    union {
+        qint64 integer;
+        quint64 unsignedInteger;
+        double real;
+    };
+    QByteArray bytes; //!< binary-comparable key for text values
+};
+
+//! @internal Sort key of a record, values of the sorted columns are stored elsewhere
+struct SortKey
+{
+    KDbRecordData *record;
+    const SortKeyValue *values; //!< one value for each sorted column
+};
+
+//! @internal Computes sort key values of a single sorted column and compares them
+/*! Sorting with keys avoids converting the values and calling the collator
+ for each comparison. Keys are computed only once per record. */
+class SortKeyColumn
 {
 private:
-    KDbOrderByColumn::SortOrder m_order;
-    QVariant m_leftTmp, m_rightTmp;
-    int m_sortColumn;
+    //! Types of keys, decide which member of SortKeyValue is used
+    enum class KeyType {
+        Integer,
+        UnsignedInteger,
+        Real,
+        Bytes
+    };
 
-    bool (*m_lessThanFunction)(const QVariant&, const QVariant&);
+    KDbOrderByColumn::SortOrder m_order;
+    int m_column;
+    KeyType m_keyType;
 
-#define CAST_AND_COMPARE(casting) \
-    return left.casting() < right.casting()
+    void (*m_keyFunction)(const QVariant&, SortKeyValue*);
 
-    static bool cmpInt(const QVariant& left, const QVariant& right) {
-        CAST_AND_COMPARE(toInt);
+    static void keyInt(const QVariant& value, SortKeyValue *key) {
+        key->integer = value.toInt();
     }
 
-    static bool cmpUInt(const QVariant& left, const QVariant& right) {
-        CAST_AND_COMPARE(toUInt);
+    static void keyUInt(const QVariant& value, SortKeyValue *key) {
+        key->unsignedInteger = value.toUInt();
     }
 
-    static bool cmpLongLong(const QVariant& left, const QVariant& right) {
-        CAST_AND_COMPARE(toLongLong);
+    static void keyLongLong(const QVariant& value, SortKeyValue *key) {
+        key->integer = value.toLongLong();
     }
 
-    static bool cmpULongLong(const QVariant& left, const QVariant& right) {
-        CAST_AND_COMPARE(toULongLong);
+    static void keyULongLong(const QVariant& value, SortKeyValue *key) {
+        key->unsignedInteger = value.toULongLong();
     }
 
-    static bool cmpDouble(const QVariant& left, const QVariant& right) {
-        CAST_AND_COMPARE(toDouble);
+    static void keyDouble(const QVariant& value, SortKeyValue *key) {
+        key->real = value.toDouble();
     }
 
-    static bool cmpDate(const QVariant& left, const QVariant& right) {
-        CAST_AND_COMPARE(toDate);
+    static void keyDate(const QVariant& value, SortKeyValue *key) {
+        key->integer = value.toDate().toJulianDay();
     }
 
-    static bool cmpDateTime(const QVariant& left, const QVariant& right) {
-        CAST_AND_COMPARE(toDateTime);
+    static void keyDateTime(const QVariant& value, SortKeyValue *key) {
+        const QDateTime dateTime(value.toDateTime());
+        key->integer = dateTime.isValid() ? dateTime.toMSecsSinceEpoch()
+                                          : std::numeric_limits<qint64>::min();
     }
 
-    static bool cmpTime(const QVariant& left, const QVariant& right) {
-        CAST_AND_COMPARE(toDate);
+    static void keyTime(const QVariant& value, SortKeyValue *key) {
+        key->integer = value.toTime().msecsSinceStartOfDay();
     }
 
-    static bool cmpString(const QVariant& left, const QVariant& right) {
-        const QString &as = left.toString();
-        const QString &bs = right.toString();
-
-        const QChar *a = as.isEmpty() ? nullptr : as.unicode();
-        const QChar *b = bs.isEmpty() ? nullptr : bs.unicode();
-
-        if (a == nullptr) {
-            return b != nullptr;
-        }
-        if (a == b || b == nullptr) {
-            return false;
-        }
-
-        int len = qMin(as.length(), bs.length());
-        forever {
-            unsigned short au = a->unicode();
-            unsigned short bu = b->unicode();
-            au = (au <= 0x17e ? charTable[au] : 0xffff);
-            bu = (bu <= 0x17e ? charTable[bu] : 0xffff);
-
-            if (len <= 0)
-                return false;
-            len--;
-
-            if (au != bu)
-                return au < bu;
-            a++;
-            b++;
+    //! Key for text using character weights of charTable, two bytes per character
+    static void keyString(const QVariant& value, SortKeyValue *key) {
+        const QString s(value.toString());
+        key->bytes.resize(s.length() * 2);
+        char *data = key->bytes.data();
+        for (const QChar &c : s) {
+            const unsigned short u = c.unicode() <= 0x17e ? charTable[c.unicode()] : 0xffff;
+            *data++ = char(u >> 8);
+            *data++ = char(u & 0xff);
         }
-        return false;
     }
 
-    static bool cmpStringWithCollator(const QVariant& left, const QVariant& right) {
-        const QString &as = left.toString();
-        const QString &bs = right.toString();
-        return icu::Collator::LESS == KDb_collator->getCollator()->compare(
-                                        (const UChar *)as.constData(), as.size(),
-                                        (const UChar *)bs.constData(), bs.size());
+    //! Key for text computed by the collator, see icu::Collator::getSortKey()
+    static void keyStringWithCollator(const QVariant& value, SortKeyValue *key) {
+        const QString s(value.toString());
+        const icu::Collator *collator = KDb_collator->getCollator();
+        key->bytes.resize(s.length() * 4 + 16);
+        int length = collator->getSortKey((const UChar *)s.constData(), s.size(),
+                                          reinterpret_cast<uint8_t*>(key->bytes.data()),
+                                          key->bytes.size());
+        if (length > key->bytes.size()) { // too small buffer, try again
+            key->bytes.resize(length);
+            length = collator->getSortKey((const UChar *)s.constData(), s.size(),
+                                          reinterpret_cast<uint8_t*>(key->bytes.data()),
+                                          key->bytes.size());
+        }
+        key->bytes.truncate(qMax(0, length - 1)); // without the terminating 0
     }
 
-    //! Compare function for BLOB data (QByteArray). Uses size as the weight.
-    static bool cmpBLOB(const QVariant& left, const QVariant& right) {
-        return left.toByteArray().size() < right.toByteArray().size();
+    //! Key for BLOB data (QByteArray). Uses size as the weight.
+    static void keyBLOB(const QVariant& value, SortKeyValue *key) {
+        key->integer = value.toByteArray().size();
     }
 
 public:
-    LessThanFunctor()
+    SortKeyColumn()
             : m_order(KDbOrderByColumn::SortOrder::Ascending)
-            , m_sortColumn(-1)
-            , m_lessThanFunction(nullptr)
+            , m_column(-1)
+            , m_keyType(KeyType::Bytes)
+            , m_keyFunction(&keyString)
     {
     }
 
-    void setColumnType(const KDbField& field) {
+    SortKeyColumn(const KDbField& field, int column, KDbOrderByColumn::SortOrder order)
+            : m_order(order)
+            , m_column(column)
+    {
         const KDbField::Type t = field.type();
-        if (field.isTextType())
-            m_lessThanFunction = &cmpString;
-        if (KDbField::isFPNumericType(t))
-            m_lessThanFunction = &cmpDouble;
-        else if (t == KDbField::Integer && field.isUnsigned())
-            m_lessThanFunction = &cmpUInt;
-        else if (t == KDbField::Boolean || KDbField::isNumericType(t))
-            m_lessThanFunction = &cmpInt; //other integers
-        else if (t == KDbField::BigInteger) {
-            if (field.isUnsigned())
-                m_lessThanFunction = &cmpULongLong;
-            else
-                m_lessThanFunction = &cmpLongLong;
-        } else if (t == KDbField::Date)
-            m_lessThanFunction = &cmpDate;
-        else if (t == KDbField::Time)
-            m_lessThanFunction = &cmpTime;
-        else if (t == KDbField::DateTime)
-            m_lessThanFunction = &cmpDateTime;
-        else if (t == KDbField::BLOB)
+        m_keyType = KeyType::Integer;
+        if (KDbField::isFPNumericType(t)) {
+            m_keyFunction = &keyDouble;
+            m_keyType = KeyType::Real;
+        } else if (t == KDbField::Integer && field.isUnsigned()) {
+            m_keyFunction = &keyUInt;
+            m_keyType = KeyType::UnsignedInteger;
+        } else if (t == KDbField::Boolean || (KDbField::isNumericType(t) && t != KDbField::BigInteger)) {
+            m_keyFunction = &keyInt; //other integers
+        } else if (t == KDbField::BigInteger) {
+            if (field.isUnsigned()) {
+                m_keyFunction = &keyULongLong;
+                m_keyType = KeyType::UnsignedInteger;
+            } else {
+                m_keyFunction = &keyLongLong;
+            }
+        } else if (t == KDbField::Date) {
+            m_keyFunction = &keyDate;
+        } else if (t == KDbField::Time) {
+            m_keyFunction = &keyTime;
+        } else if (t == KDbField::DateTime) {
+            m_keyFunction = &keyDateTime;
+        } else if (t == KDbField::BLOB) {
             //! @todo allow users to define BLOB sorting function?
-            m_lessThanFunction = &cmpBLOB;
-        else { // anything else
+            m_keyFunction = &keyBLOB;
+        } else { // text and anything else
+            m_keyType = KeyType::Bytes;
             // check if CollatorInstance is not destroyed and has valid collator
             if (!KDb_collator.isDestroyed() && KDb_collator->getCollator()) {
-                m_lessThanFunction = &cmpStringWithCollator;
+                m_keyFunction = &keyStringWithCollator;
             }
             else {
-                m_lessThanFunction = &cmpString;
+                m_keyFunction = &keyString;
             }
         }
     }
 
-    void setSortOrder(KDbOrderByColumn::SortOrder order) {
-        m_order = order;
+    inline KDbOrderByColumn::SortOrder sortOrder() const {
+        return m_order;
+    }
+
+    //! Computes sort key value of @a record. Can be called from multiple threads at once.
+    inline void computeKeyValue(const KDbRecordData *record, SortKeyValue *key) const {
+        const QVariant &value = record->at(m_column);
+        key->isNull = value.isNull();
+        if (!key->isNull) {
+            m_keyFunction(value, key);
+        }
+    }
+
+    //! @return true if @a key1 is smaller than @a key2; NULL is smaller than everything
+    inline bool keyLessThan(const SortKeyValue &key1, const SortKeyValue &key2) const {
+        if (key1.isNull || key2.isNull) {
+            return key1.isNull && !key2.isNull;
+        }
+        switch (m_keyType) {
+        case KeyType::Integer:
+            return key1.integer < key2.integer;
+        case KeyType::UnsignedInteger:
+            return key1.unsignedInteger < key2.unsignedInteger;
+        case KeyType::Real:
+            return key1.real < key2.real;
+        case KeyType::Bytes:
+            return key1.bytes < key2.bytes;
+        }
+        return false;
+    }
+};
+
+//! @internal A functor used in sorting in order to sort by given columns
+class LessThanFunctor
+{
+public:
+    LessThanFunctor()
+    {
+    }
+
+    void clear() {
+        m_columns.clear();
+    }
+
+    void addColumn(const KDbField& field, int column, KDbOrderByColumn::SortOrder order) {
+        m_columns.append(SortKeyColumn(field, column, order));
+    }
+
+    inline int columnCount() const {
+        return m_columns.count();
+    }
+
+    //! Computes columnCount() sort key values of @a record. Can be called from multiple threads at once.
+    inline void computeKey(const KDbRecordData *record, SortKeyValue *values) const {
+        for (const SortKeyColumn &column : m_columns) {
+            column.computeKeyValue(record, values++);
+        }
     }
 
-    void setSortColumn(int column) {
-        m_sortColumn = column;
+    //! Main comparison operator that takes sort order of every column into account
+    inline bool operator()(const SortKey &key1, const SortKey &key2) const {
+        for (int i = 0; i < m_columns.count(); ++i) {
+            const SortKeyColumn &column = m_columns.at(i);
+            const SortKeyValue &value1 = key1.values[i];
+            const SortKeyValue &value2 = key2.values[i];
+            const bool ascending = column.sortOrder() == KDbOrderByColumn::SortOrder::Ascending;
+            if (column.keyLessThan(value1, value2)) {
+                return ascending;
+            }
+            if (column.keyLessThan(value2, value1)) {
+                return !ascending;
+            }
+        }
+        return false; // equal
     }
 
-#define _IIF(a,b) ((a) ? (b) : !(b))
+private:
+    QVector<SortKeyColumn> m_columns;
+};
+
+//! @internal Chunks processed by runInParallel(), shared with the threads of the pool
+class ParallelChunks
+{
+public:
+    ParallelChunks(int chunkCount, const std::function<void(int)> &function)
+        : m_chunkCount(chunkCount), m_function(function)
+    {
+    }
 
-    //! Main comparison operator that takes column number, type and order into account
-    bool operator()(KDbRecordData* record1, KDbRecordData* record2) {
-        // compare NULLs : NULL is smaller than everything
-        if ((m_leftTmp = record1->at(m_sortColumn)).isNull())
-            return _IIF(m_order == KDbOrderByColumn::SortOrder::Ascending,
-                        !record2->at(m_sortColumn).isNull());
-        if ((m_rightTmp = record2->at(m_sortColumn)).isNull())
-            return m_order == KDbOrderByColumn::SortOrder::Descending;
+    //! Calls the function for chunks that have not been taken by other threads yet
+    void process() {
+        int chunk;
+        while ((chunk = m_nextChunk.fetchAndAddOrdered(1)) < m_chunkCount) {
+            m_function(chunk);
+            m_done.release();
+        }
+    }
 
-        return _IIF(m_order == KDbOrderByColumn::SortOrder::Ascending,
-                    m_lessThanFunction(m_leftTmp, m_rightTmp));
+    //! Waits until the function has been called for all the chunks
+    void waitForDone() {
+        m_done.acquire(m_chunkCount);
     }
+
+private:
+    const int m_chunkCount;
+    const std::function<void(int)> &m_function; //!< only used while chunks are left
+    QAtomicInt m_nextChunk;
+    QSemaphore m_done; //!< released once for every processed chunk
 };
-#undef _IIF
-#undef CAST_AND_COMPARE
+
+//! @internal Takes part in processing the chunks from a thread of the pool
+class ChunkRunnable : public QRunnable
+{
+public:
+    explicit ChunkRunnable(const QSharedPointer<ParallelChunks> &chunks)
+        : m_chunks(chunks)
+    {
+    }
+    void run() override {
+        m_chunks->process();
+    }
+private:
+    const QSharedPointer<ParallelChunks> m_chunks;
+};
+
+//! @internal Calls @a function for chunks 0..chunkCount-1 in parallel and waits for the result
+//! Threads of the global pool are used. The calling thread processes chunks too so
+//! the work is finished even if all threads of the pool are busy.
+static void runInParallel(int chunkCount, const std::function<void(int)> &function)
+{
+    if (chunkCount == 1) {
+        function(0);
+        return;
+    }
+    QSharedPointer<ParallelChunks> chunks(new ParallelChunks(chunkCount, function));
+    QThreadPool *pool = QThreadPool::globalInstance();
+    for (int i = 1; i < chunkCount; ++i) {
+        pool->start(new ChunkRunnable(chunks));
+    }
+    chunks->process();
+    chunks->waitForDone();
+}
+
+//! @internal Minimal number of records sorted by a single thread
+static const int minimalRecordsPerThread = 20000;
 
 //! @internal
 class Q_DECL_HIDDEN KDbTableViewData::Private
@@ -253,6 +405,7 @@ public:
             , readOnly(false)
             , insertingEnabled(true)
             , containsRecordIdInfo(false)
+            , sortingMaintained(false)
             , autoIncrementedColumn(-2) {
     }
 
@@ -260,6 +413,34 @@ public:
         delete pRecordEditBuffer;
     }
 
+    //! Appends @a column to sorted columns
+    //! @return real column number of values that are compared
+    int addSortColumn(int column, KDbOrderByColumn::SortOrder order) {
+        // find proper column information for sorting (lookup column points to alternate column with visible data)
+        const KDbTableViewColumn *tvcol = columns.at(column);
+        const KDbQueryColumnInfo* visibleLookupColumnInfo = tvcol->visibleLookupColumnInfo();
+        const KDbField *field = visibleLookupColumnInfo ? visibleLookupColumnInfo->field() : tvcol->field();
+        const KDbQueryColumnInfo *columnInfo = tvcol->columnInfo();
+        const int realColumn = columnInfo && columnInfo->indexForVisibleLookupValue() != -1
+                                 ? columnInfo->indexForVisibleLookupValue() : column;
+        lessThanFunctor.addColumn(*field, realColumn, order);
+        sortColumns.append(column);
+        return realColumn;
+    }
+
+    //! @return number of column that matches @a orderByColumn or -1 if there is no such column
+    int columnIndex(const KDbOrderByColumn &orderByColumn) const {
+        const KDbQueryColumnInfo *columnInfo = orderByColumn.column();
+        const KDbField *field = columnInfo ? columnInfo->field() : orderByColumn.field();
+        for (int i = 0; i < columns.count(); ++i) {
+            const KDbTableViewColumn *tvcol = columns.at(i);
+            if ((columnInfo && tvcol->columnInfo() == columnInfo) || (field && tvcol->field() == field)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
     //! Number of physical columns
     int realColumnCount;
 
@@ -279,6 +460,9 @@ public:
     //! Specifies sorting order
     KDbOrderByColumn::SortOrder sortOrder;
 
+    //! (Logical) sorted column numbers, set by setSorting()
+    QList<int> sortColumns;
+
     LessThanFunctor lessThanFunctor;
 
     short type;
@@ -299,11 +483,42 @@ public:
     //! @see KDbTableViewData::containsRecordIdInfo()
     bool containsRecordIdInfo;
 
+    //! @see KDbTableViewData::isSortingMaintained()
+    bool sortingMaintained;
+
     mutable int autoIncrementedColumn;
 };
 
 //-------------------------------
 
+//! @internal @return index at which @a record can be inserted into sorted @a records
+//! so the order defined by @a lessThan is kept. Record at @a skipIndex is not taken into account
+//! if @a skipIndex is not -1. If @a upperBound is true the index is after records equal to
+//! @a record, otherwise before them.
+static int sortedInsertionIndex(const KDbTableViewDataBase &records, const LessThanFunctor &lessThan,
+                                const KDbRecordData *record, int skipIndex, bool upperBound)
+{
+    const int columnCount = lessThan.columnCount();
+    QVector<SortKeyValue> values(columnCount * 2);
+    SortKeyValue *valuesData = values.data();
+    lessThan.computeKey(record, valuesData);
+    const SortKey key = { const_cast<KDbRecordData*>(record), valuesData };
+    SortKey otherKey = { nullptr, valuesData + columnCount };
+    int first = 0;
+    int last = records.count() - (skipIndex == -1 ? 0 : 1);
+    while (first < last) {
+        const int middle = first + (last - first) / 2;
+        otherKey.record = records.at(skipIndex == -1 || middle < skipIndex ? middle : middle + 1);
+        lessThan.computeKey(otherKey.record, valuesData + columnCount);
+        if (upperBound ? lessThan(key, otherKey) : !lessThan(otherKey, key)) {
+            last = middle;
+        } else {
+            first = middle + 1;
+        }
+    }
+    return first;
+}
+
 KDbTableViewData::KDbTableViewData()
         : QObject()
         , KDbTableViewDataBase()
@@ -527,23 +742,55 @@ QString KDbTableViewData::dbTableName() const
 void KDbTableViewData::setSorting(int column, KDbOrderByColumn::SortOrder order)
 {
     d->sortOrder = order;
+    d->sortColumns.clear();
+    d->lessThanFunctor.clear();
     if (column < 0 || column >= d->columns.count()) {
         d->sortColumn = -1;
         d->realSortColumn = -1;
         return;
     }
-    // find proper column information for sorting (lookup column points to alternate column with visible data)
-    const KDbTableViewColumn *tvcol = d->columns.at(column);
-    const KDbQueryColumnInfo* visibleLookupColumnInfo = tvcol->visibleLookupColumnInfo();
-    const KDbField *field = visibleLookupColumnInfo ? visibleLookupColumnInfo->field() : tvcol->field();
     d->sortColumn = column;
-    d->realSortColumn = tvcol->columnInfo()->indexForVisibleLookupValue() != -1
-                          ? tvcol->columnInfo()->indexForVisibleLookupValue() : d->sortColumn;
+    d->realSortColumn = d->addSortColumn(column, order);
+}
 
-    // setup compare functor
-    d->lessThanFunctor.setColumnType(*field);
-    d->lessThanFunctor.setSortOrder(d->sortOrder);
-    d->lessThanFunctor.setSortColumn(column);
+bool KDbTableViewData::setSorting(const KDbOrderByColumnList &orderByColumnList)
+{
+    QList<int> columns;
+    for (QList<KDbOrderByColumn*>::ConstIterator it = orderByColumnList.constBegin();
+         it != orderByColumnList.constEnd(); ++it)
+    {
+        const int column = d->columnIndex(**it);
+        if (column == -1) {
+            kdbWarning() << "No column found for" << **it;
+            setSorting(-1);
+            return false;
+        }
+        columns.append(column);
+    }
+    if (columns.isEmpty()) {
+        setSorting(-1);
+        return true;
+    }
+    setSorting(columns.first(), orderByColumnList.value(0)->sortOrder());
+    for (int i = 1; i < columns.count(); ++i) {
+        d->addSortColumn(columns.at(i), orderByColumnList.value(i)->sortOrder());
+    }
+    return true;
+}
+
+QList<int> KDbTableViewData::sortColumns() const
+{
+    return d->sortColumns;
+}
+
+void KDbTableViewData::setSortingMaintained(bool set)
+{
+    d->sortingMaintained = set;
+}
+
+bool KDbTableViewData::isSortingMaintained() const
+{
+    return d->sortingMaintained;
 }
 
 int KDbTableViewData::sortColumn() const
@@ -558,10 +805,44 @@ KDbOrderByColumn::SortOrder KDbTableViewData::sortOrder() const
 
 void KDbTableViewData::sort()
 {
-    if (d->sortColumn < 0 || d->sortColumn >= d->columns.count()) {
+    const LessThanFunctor &lessThan = d->lessThanFunctor;
+    const int columnCount = lessThan.columnCount();
+    const int recordCount = count();
+    if (columnCount == 0 || recordCount < 2) {
         return;
     }
-    std::sort(begin(), end(), d->lessThanFunctor);
+    // Sort keys of records instead of the records. Large data is split into chunks
+    // that are processed in parallel and then merged.
+    QVector<SortKey> keys(recordCount);
+    SortKey *keysData = keys.data();
+    QVector<SortKeyValue> values(recordCount * columnCount);
+    SortKeyValue *valuesData = values.data();
+    const int chunkCount = qBound(1, recordCount / minimalRecordsPerThread,
+                                  QThread::idealThreadCount());
+    const int chunkSize = (recordCount + chunkCount - 1) / chunkCount;
+    runInParallel(chunkCount, [&](int chunk) {
+        const int first = chunk * chunkSize;
+        const int last = qMin(first + chunkSize, recordCount);
+        for (int i = first; i < last; ++i) {
+            keysData[i].record = KDbTableViewDataBase::at(i);
+            keysData[i].values = valuesData + i * columnCount;
+            lessThan.computeKey(keysData[i].record, valuesData + i * columnCount);
+        }
+        std::stable_sort(keysData + first, keysData + last, lessThan);
+    });
+    for (int width = chunkSize; width < recordCount; width *= 2) {
+        const int mergeCount = (recordCount + 2 * width - 1) / (2 * width);
+        runInParallel(mergeCount, [&](int merge) {
+            const int first = merge * 2 * width;
+            const int middle = qMin(first + width, recordCount);
+            const int last = qMin(first + 2 * width, recordCount);
+            std::inplace_merge(keysData + first, keysData + middle, keysData + last, lessThan);
+        });
+    }
+    KDbTableViewDataIterator it = begin();
+    for (int i = 0; i < recordCount; ++i, ++it) {
+        *it = keysData[i].record;
+    }
 }
 
 void KDbTableViewData::setReadOnly(bool set)
@@ -768,6 +1049,7 @@ bool KDbTableViewData::saveRecordChanges(KDbRecordData *record, bool repaint)
 
     if (saveRecord(record, false /*update*/, repaint)) {
         emit recordUpdated(record);
+        repositionRecord(record);
         return true;
     }
     return false;
@@ -782,6 +1064,7 @@ bool KDbTableViewData::saveNewRecord(KDbRecordData *record, bool repaint)
 
     if (saveRecord(record, true /*insert*/, repaint)) {
         emit recordInserted(record, repaint);
+        repositionRecord(record);
         return true;
     }
     return false;
@@ -842,6 +1125,36 @@ void KDbTableViewData::insertRecord(KDbRecordData *record, int index, bool repai
     emit recordInserted(record, index, repaint);
 }
 
+int KDbTableViewData::insertRecordSorted(KDbRecordData *record, bool repaint)
+{
+    const int index = d->lessThanFunctor.columnCount() == 0
+        ? count()
+        : sortedInsertionIndex(*this, d->lessThanFunctor, record, -1, true /*upper bound*/);
+    insertRecord(record, index, repaint);
+    return index;
+}
+
+void KDbTableViewData::repositionRecord(KDbRecordData *record)
+{
+    if (!d->sortingMaintained || d->lessThanFunctor.columnCount() == 0) {
+        return;
+    }
+    const int oldIndex = indexOf(record);
+    if (oldIndex == -1) {
+        return;
+    }
+    const int newIndex = sortedInsertionIndex(*this, d->lessThanFunctor, record, oldIndex,
+                                              true /*upper bound*/);
+    // the record can stay if it's between equal records
+    if (oldIndex <= newIndex
+        && oldIndex >= sortedInsertionIndex(*this, d->lessThanFunctor, record, oldIndex, false))
+    {
+        return;
+    }
+    move(oldIndex, newIndex);
+    emit recordRepositioned(record, oldIndex, newIndex);
+}
+
 void KDbTableViewData::clearInternal(bool processEvents)
 {
     clearRecordEditBuffer();
@@ -72,12 +72,40 @@ public:
 
     ~KDbTableViewData() override;
 
-    /*! Preloads all records provided by cursor (only for db-aware version). */
+    /*! Preloads all records provided by cursor (only for db-aware version).
+     Records are loaded within the calling thread, use KDbTableViewDataLoader
+     to load them asynchronously. */
     bool preloadAllRecords();
 
     /*! Sets sorting for @a column. If @a column is -1, sorting is disabled. */
     void setSorting(int column, KDbOrderByColumn::SortOrder order = KDbOrderByColumn::SortOrder::Ascending);
 
+    /*! Sets sorting by multiple columns defined by @a orderByColumnList.
+     Records that are equal in the first column are sorted by the second column, and so on.
+     Items of @a orderByColumnList are matched with columns of this data using query column
+     information or fields. If @a orderByColumnList is empty, sorting is disabled.
+     @return false and disables sorting if any of the items does not match a column.
+     @since 3.2 */
+    bool setSorting(const KDbOrderByColumnList &orderByColumnList);
+
+    /*! @return numbers of columns by which the data is sorted, in order of importance,
+     or empty list if sorting is disabled. The first number is equal to sortColumn().
+     @since 3.2 */
+    QList<int> sortColumns() const;
+
+    /*! Specifies whether sorted order of records should be maintained after editing.
+     If @a set is true and sorting is enabled, a record that is changed or inserted using
+     saveRecordChanges() or saveNewRecord() is moved to its sorted position without
+     sorting all the records again, and recordRepositioned() is emitted.
+     The data should be sorted using sort() first. Default is false.
+     @since 3.2 */
+    void setSortingMaintained(bool set);
+
+    /*! @return true if sorted order of records is maintained after editing.
+     @see setSortingMaintained()
+     @since 3.2 */
+    bool isSortingMaintained() const;
+
     /*! @return the column number by which the data is sorted,
      or -1 if sorting is disabled.
      Initial sorted column number for data after instantiating object is -1. */
@@ -88,7 +116,9 @@ public:
      (by default it is not). */
     KDbOrderByColumn::SortOrder sortOrder() const;
 
-    //! Sorts this data using previously set order.
+    /*! Sorts this data using previously set order.
+     Sorting is stable. Sort keys are computed once for every record, e.g. collation keys
+     for text, and large data is sorted using threads of QThreadPool::globalInstance(). */
     void sort();
 
     /*! Adds column @a col.
@@ -218,6 +248,14 @@ public:
      Note: Reasonable only for not not-db-aware version. */
     void insertRecord(KDbRecordData *record, int index, bool repaint = false);
 
+    /*! Inserts @a record at position that keeps the records sorted.
+     The position is found using binary search so the data should be sorted using sort() first.
+     If sorting is disabled, @a record is appended.
+     Like insertRecord(), emits recordInserted(KDbRecordData*, int, bool).
+     @return index of the inserted record
+     @since 3.2 */
+    int insertRecordSorted(KDbRecordData *record, bool repaint = false);
+
     //! @todo add this as well? void insertRecord(KDbRecordData *record, KDbRecordData *aboveRecord)
 
     //! @return index of autoincremented column. The result is cached.
@@ -336,6 +374,11 @@ Q_SIGNALS:
 
     void recordRepaintRequested(KDbRecordData*);
 
+    //! Record @a record has been moved from @a oldIndex to @a newIndex to keep sorted order.
+    //! @see setSortingMaintained()
+    //! @since 3.2
+    void recordRepositioned(KDbRecordData *record, int oldIndex, int newIndex);
+
 protected:
     //! Used by KDbTableViewColumn::setVisible()
     void columnVisibilityChanged(const KDbTableViewColumn &column);
@@ -344,6 +387,9 @@ private:
     //! @internal for saveRecordChanges() and saveNewRecord()
     bool saveRecord(KDbRecordData *record, bool insert, bool repaint);
 
+    //! @internal for saveRecordChanges() and saveNewRecord(), used if sorting is maintained
+    void repositionRecord(KDbRecordData *record);
+
     friend class KDbTableViewColumn;
 
     Q_DISABLE_COPY(KDbTableViewData)
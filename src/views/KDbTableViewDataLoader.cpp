@@ -0,0 +1,393 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#include "KDbTableViewDataLoader.h"
+#include "KDbConnection.h"
+#include "KDbConnectionOptions.h"
+#include "KDbCursor.h"
+#include "KDbDriver.h"
+#include "KDbError.h"
+#include "KDbNativeStatementBuilder.h"
+#include "KDbParser.h"
+#include "KDbQuerySchema.h"
+#include "KDbRecordData.h"
+#include "KDbTableSchema.h"
+#include "KDbTableViewData.h"
+#include "kdb_debug.h"
+
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QEvent>
+#include <QScopedPointer>
+#include <QThread>
+
+//! @internal Type of RecordsEvent
+static QEvent::Type recordsEventType()
+{
+    static const int type = QEvent::registerEventType();
+    return static_cast<QEvent::Type>(type);
+}
+
+//! @internal Type of FinishedEvent
+static QEvent::Type finishedEventType()
+{
+    static const int type = QEvent::registerEventType();
+    return static_cast<QEvent::Type>(type);
+}
+
+//! @internal Records loaded by the worker thread, posted to the loader
+class RecordsEvent : public QEvent
+{
+public:
+    RecordsEvent(const QList<KDbRecordData*> &records, int totalRecordCount)
+        : QEvent(recordsEventType())
+        , records(records)
+        , totalRecordCount(totalRecordCount)
+    {
+    }
+
+    //! Deletes records that have not been taken, e.g. if the event has not been delivered
+    ~RecordsEvent() override {
+        qDeleteAll(records);
+    }
+
+    QList<KDbRecordData*> records;
+    const int totalRecordCount;
+};
+
+//! @internal Posted to the loader by the worker thread when loading is complete
+class FinishedEvent : public QEvent
+{
+public:
+    FinishedEvent(bool success, const KDbResult &result)
+        : QEvent(finishedEventType())
+        , success(success)
+        , result(result)
+    {
+    }
+
+    const bool success;
+    const KDbResult result;
+};
+
+//! @internal Source of records for the worker thread.
+//! Schema objects of the loader's thread are never shared with the worker; the worker
+//! builds its own query using its own connection.
+struct KDbTableViewDataLoaderSource
+{
+    //! Name of the table if all records of a table are loaded
+    QString tableName;
+    //! KDbSQL statement of the query, or a native statement if nativeStatement is true
+    KDbEscapedString sql;
+    bool nativeStatement = false;
+};
+
+//! @internal Worker thread that fetches records using its own connection and cursor
+class KDbTableViewDataLoaderThread : public QThread
+{
+public:
+    KDbTableViewDataLoaderThread(KDbTableViewDataLoader *loader, KDbConnection *connection,
+                                 const QString &databaseName,
+                                 const KDbTableViewDataLoaderSource &source,
+                                 const QList<QVariant> &parameters, KDbCursor::Options options,
+                                 int chunkSize)
+        : m_loader(loader)
+        , m_connection(connection)
+        , m_databaseName(databaseName)
+        , m_source(source)
+        , m_parameters(parameters)
+        , m_options(options)
+        , m_chunkSize(chunkSize)
+    {
+    }
+
+    //! The connection is deleted here, in the thread of the loader
+    ~KDbTableViewDataLoaderThread() override {
+        delete m_connection;
+    }
+
+    void run() override {
+        KDbResult result;
+        const bool success = load(&result);
+        m_connection->disconnect();
+        QCoreApplication::postEvent(m_loader, new FinishedEvent(success && !isCanceled(), result));
+    }
+
+    void cancel() {
+        m_canceled.store(1);
+    }
+
+    bool isCanceled() const {
+        return m_canceled.load() != 0;
+    }
+
+private:
+    bool load(KDbResult *result) {
+        if (!m_connection->connect()
+            || !m_connection->useDatabase(m_databaseName, false /* !kexiCompatible */))
+        {
+            *result = m_connection->result();
+            return false;
+        }
+        int totalRecordCount;
+        KDbCursor *cursor;
+        QScopedPointer<KDbQuerySchema> parsedQuery;
+        if (m_source.nativeStatement) {
+            totalRecordCount = m_connection->recordCount(m_source.sql);
+            cursor = m_connection->executeQuery(m_source.sql, m_options);
+        } else {
+            KDbQuerySchema *query = nullptr;
+            if (m_source.tableName.isEmpty()) {
+                KDbParser parser(m_connection);
+                if (parser.parse(m_source.sql)) {
+                    parsedQuery.reset(parser.query());
+                }
+                if (!parsedQuery) {
+                    *result = KDbResult(ERR_SQL_PARSE_ERROR,
+                                        KDbTableViewDataLoader::tr("Could not parse query statement."));
+                    result->setServerMessage(parser.error().message());
+                    return false;
+                }
+                query = parsedQuery.data();
+            } else {
+                KDbTableSchema *table = m_connection->tableSchema(m_source.tableName);
+                if (!table) {
+                    *result = m_connection->result();
+                    if (!result->isError()) {
+                        *result = KDbResult(ERR_OBJECT_NOT_FOUND,
+                                            KDbTableViewDataLoader::tr("Table \"%1\" does not exist.")
+                                                .arg(m_source.tableName));
+                    }
+                    return false;
+                }
+                query = table->query(); // owned by the table
+            }
+            totalRecordCount = m_connection->recordCount(query, m_parameters);
+            cursor = m_connection->executeQuery(query, m_parameters, m_options);
+        }
+        if (!cursor) {
+            *result = m_connection->result();
+            return false;
+        }
+        bool ok = cursor->moveFirst() || !cursor->result().isError();
+        QList<KDbRecordData*> records;
+        while (ok && !cursor->eof() && !isCanceled()) {
+            KDbRecordData *record = cursor->storeCurrentRecord();
+            if (!record) {
+                ok = false;
+                break;
+            }
+            records.append(record);
+            if (records.count() >= m_chunkSize) {
+                QCoreApplication::postEvent(m_loader, new RecordsEvent(records, totalRecordCount));
+                records.clear();
+            }
+            ok = cursor->moveNext() || !cursor->result().isError();
+        }
+        if (!records.isEmpty()) {
+            QCoreApplication::postEvent(m_loader, new RecordsEvent(records, totalRecordCount));
+        }
+        if (!ok) {
+            *result = cursor->result();
+        }
+        m_connection->deleteCursor(cursor);
+        return ok;
+    }
+
+    KDbTableViewDataLoader * const m_loader;
+    KDbConnection * const m_connection;
+    const QString m_databaseName;
+    const KDbTableViewDataLoaderSource m_source;
+    const QList<QVariant> m_parameters;
+    const KDbCursor::Options m_options;
+    const int m_chunkSize;
+    QAtomicInt m_canceled;
+};
+
+//! @internal
+class Q_DECL_HIDDEN KDbTableViewDataLoader::Private
+{
+public:
+    Private(KDbTableViewData *d)
+        : data(d)
+    {
+    }
+
+    ~Private() {
+        deleteThread();
+    }
+
+    //! Waits for the thread and deletes it together with the connection
+    void deleteThread() {
+        if (thread) {
+            thread->cancel();
+            thread->wait();
+            delete thread;
+            thread = nullptr;
+        }
+    }
+
+    KDbTableViewData * const data;
+    KDbTableViewDataLoaderThread *thread = nullptr;
+    int chunkSize = 1000;
+    int loadedRecordCount = 0;
+    int totalRecordCount = -1;
+    bool canceled = false;
+};
+
+KDbTableViewDataLoader::KDbTableViewDataLoader(KDbTableViewData *data, QObject *parent)
+    : QObject(parent)
+    , d(new Private(data))
+{
+}
+
+KDbTableViewDataLoader::~KDbTableViewDataLoader()
+{
+    delete d;
+}
+
+KDbTableViewData *KDbTableViewDataLoader::data() const
+{
+    return d->data;
+}
+
+void KDbTableViewDataLoader::setChunkSize(int size)
+{
+    if (size > 0) {
+        d->chunkSize = size;
+    }
+}
+
+int KDbTableViewDataLoader::chunkSize() const
+{
+    return d->chunkSize;
+}
+
+bool KDbTableViewDataLoader::start()
+{
+    clearResult();
+    if (d->thread) {
+        m_result = KDbResult(ERR_OTHER, tr("Loading of records is already in progress."));
+        return false;
+    }
+    KDbCursor *cursor = d->data ? d->data->cursor() : nullptr;
+    if (!cursor || !cursor->query()) {
+        m_result = KDbResult(ERR_OBJECT_NOT_FOUND, tr("No query specified for loading records."));
+        return false;
+    }
+    KDbConnection *conn = cursor->connection();
+    // The query is passed to the worker as a table name or a statement, so that the worker
+    // builds a query of its own. Schema objects of this thread are never accessed by the worker.
+    KDbTableViewDataLoaderSource source;
+    KDbQuerySchema *query = cursor->query();
+    KDbTableSchema *masterTable = query->masterTable();
+    if (!query->statement().isEmpty()) {
+        source.sql = query->statement();
+        source.nativeStatement = true;
+    } else if (masterTable && masterTable->query() == query) {
+        source.tableName = masterTable->name();
+    } else {
+        KDbNativeStatementBuilder builder(conn, KDb::KDbEscaping);
+        // Lookup columns are not included; the worker's cursor adds them to the parsed query
+        // the same way as the cursor of this thread, so records have the expected columns.
+        KDbSelectStatementOptions selectOptions;
+        selectOptions.setAddVisibleLookupColumns(false);
+        if (!builder.generateSelectStatement(&source.sql, query, selectOptions)) { // parameters stay as [name]
+            m_result = KDbResult(ERR_OTHER, tr("Could not generate query statement."));
+            return false;
+        }
+    }
+    KDbConnectionOptions options(*conn->options());
+    options.setReadOnly(true);
+    options.setTableSchemaPreloading(KDbConnectionOptions::TableSchemaPreloading::None);
+    KDbConnection *loaderConn = conn->driver()->createConnection(conn->data(), options);
+    if (!loaderConn) {
+        m_result = conn->driver()->result();
+        return false;
+    }
+    d->loadedRecordCount = 0;
+    d->totalRecordCount = -1;
+    d->canceled = false;
+    d->thread = new KDbTableViewDataLoaderThread(
+        this, loaderConn, conn->currentDatabase(), source,
+        cursor->queryParameters(), cursor->options(), d->chunkSize);
+    d->thread->start();
+    return true;
+}
+
+bool KDbTableViewDataLoader::isRunning() const
+{
+    return d->thread != nullptr;
+}
+
+void KDbTableViewDataLoader::cancel()
+{
+    if (d->thread) {
+        d->canceled = true;
+        d->thread->cancel();
+    }
+}
+
+bool KDbTableViewDataLoader::isCanceled() const
+{
+    return d->canceled;
+}
+
+int KDbTableViewDataLoader::loadedRecordCount() const
+{
+    return d->loadedRecordCount;
+}
+
+int KDbTableViewDataLoader::totalRecordCount() const
+{
+    return d->totalRecordCount;
+}
+
+bool KDbTableViewDataLoader::event(QEvent *event)
+{
+    if (event->type() == recordsEventType()) {
+        RecordsEvent *recordsEvent = static_cast<RecordsEvent*>(event);
+        if (d->canceled) { // records fetched after canceling are dropped
+            return true;
+        }
+        const int first = d->data->count();
+        for (KDbRecordData *record : recordsEvent->records) {
+            d->data->append(record);
+        }
+        const int count = recordsEvent->records.count();
+        recordsEvent->records.clear(); // taken
+        d->loadedRecordCount += count;
+        d->totalRecordCount = recordsEvent->totalRecordCount;
+        emit recordsLoaded(first, count);
+        emit progress(d->loadedRecordCount, d->totalRecordCount);
+        return true;
+    }
+    if (event->type() == finishedEventType()) {
+        const FinishedEvent *finishedEvent = static_cast<FinishedEvent*>(event);
+        d->deleteThread();
+        m_result = finishedEvent->result;
+        if (!finishedEvent->success && !d->canceled && !m_result.isError()) {
+            m_result = KDbResult(ERR_CURSOR_RECORD_FETCHING, tr("Could not load records."));
+        }
+        // the thread could finish before it noticed canceling
+        emit finished(finishedEvent->success && !d->canceled);
+        return true;
+    }
+    return QObject::event(event);
+}
@@ -0,0 +1,114 @@
+/* This file is part of the KDE project
+   Copyright (C) 2026 Kexi Team <kexi@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+*/
+
+#ifndef KDB_TABLEVIEWDATALOADER_H
+#define KDB_TABLEVIEWDATALOADER_H
+
+#include <QObject>
+
+#include "KDbResult.h"
+
+class KDbTableViewData;
+
+/*! @brief Loads records of db-aware KDbTableViewData in a background thread
+
+ This is an asynchronous alternative to KDbTableViewData::preloadAllRecords().
+ The loader uses a separate, read-only connection to the database of the data's cursor,
+ with a cursor of its own for the same query and parameters. The query is rebuilt by the
+ worker thread from the table name or the statement of the original query, so schema
+ objects of the data are not accessed outside of the loader's thread. Records are fetched
+ in a worker thread and appended to the data in chunks within the thread of the loader,
+ so views can display the first records immediately.
+
+ Example:
+ @code
+ KDbTableViewDataLoader *loader = new KDbTableViewDataLoader(data, this);
+ connect(loader, &KDbTableViewDataLoader::recordsLoaded, view, &View::updateRecords);
+ connect(loader, &KDbTableViewDataLoader::finished, loader, &QObject::deleteLater);
+ loader->start();
+ @endcode
+
+ The data must not be modified or deleted while loading is in progress; the loader
+ should be canceled first.
+ @since 3.2 */
+class KDB_EXPORT KDbTableViewDataLoader : public QObject, public KDbResultable
+{
+    Q_OBJECT
+public:
+    /*! Creates loader for @a data. @a data should be db-aware,
+     i.e. KDbTableViewData::cursor() should not be @c nullptr. */
+    explicit KDbTableViewDataLoader(KDbTableViewData *data, QObject *parent = nullptr);
+
+    //! Cancels loading if it is in progress and waits for the worker thread to finish
+    ~KDbTableViewDataLoader() override;
+
+    //! @return data that is loaded
+    KDbTableViewData *data() const;
+
+    /*! Sets maximum number of records delivered by a single recordsLoaded() signal.
+     The default is 1000. Values smaller than 1 are ignored. */
+    void setChunkSize(int size);
+
+    //! @return maximum number of records delivered by a single recordsLoaded() signal
+    int chunkSize() const;
+
+    /*! Starts loading of records. Loaded records are appended to the data.
+     @return false if loading is already in progress, the data is not db-aware or
+     the connection for loading could not be created. */
+    bool start();
+
+    //! @return true if loading is in progress
+    bool isRunning() const;
+
+    /*! Requests canceling of the loading. Records already appended to the data stay there.
+     finished() is emitted with @c false when the worker thread stops. */
+    void cancel();
+
+    //! @return true if loading has been canceled
+    bool isCanceled() const;
+
+    //! @return number of records loaded so far
+    int loadedRecordCount() const;
+
+    /*! @return total number of records to load or -1 if it is not known yet.
+     The number is computed by the worker thread before fetching records. */
+    int totalRecordCount() const;
+
+Q_SIGNALS:
+    //! Emitted after @a count records have been appended to the data starting at index @a first
+    void recordsLoaded(int first, int count);
+
+    /*! Emitted after appending records with @a loadedRecordCount records loaded so far out of
+     @a totalRecordCount records. @a totalRecordCount is -1 if it is not known. */
+    void progress(int loadedRecordCount, int totalRecordCount);
+
+    /*! Emitted when loading is complete. @a success is false if loading failed or
+     has been canceled. Details of an error are available using result(). */
+    void finished(bool success);
+
+protected:
+    bool event(QEvent *event) override;
+
+private:
+    Q_DISABLE_COPY(KDbTableViewDataLoader)
+    class Private;
+    Private * const d;
+};
+
+#endif